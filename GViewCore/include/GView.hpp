@@ -5,6 +5,8 @@
 
 #include <AppCUI/include/AppCUI.hpp>
 
+#include <span>
+
 using namespace AppCUI::Controls;
 using namespace AppCUI::Utils;
 using namespace AppCUI::Graphics;
@@ -69,9 +71,10 @@ namespace Utils
 
         void PopulateListView(AppCUI::Utils::Reference<AppCUI::Controls::ListView> listView) const;
     };
+    struct SharedDataObject;
     class CORE_EXPORT DataCache
     {
-        AppCUI::OS::DataObject* fileObj;
+        std::shared_ptr<SharedDataObject> fileObj;
         uint64 fileSize, start, end, currentPos;
         uint8* cache;
         uint32 cacheSize;
@@ -95,6 +98,36 @@ namespace Utils
         {
             return CopyToBuffer(0, (uint32) fileSize, failIfRequestedSizeCanNotBeRead);
         }
+        // does not change the cached window (views obtained with Get remain valid)
+        Buffer CopyUncached(uint64 offset, uint32 requestedSize);
+
+        // reads straight from the file (no cache) --> can be used from a background thread, even after the cache is closed
+        class CORE_EXPORT Reader
+        {
+            std::shared_ptr<SharedDataObject> fileObj;
+            uint64 fileSize;
+
+          public:
+            Reader() : fileSize(0)
+            {
+            }
+            Reader(std::shared_ptr<SharedDataObject> obj, uint64 size) : fileObj(std::move(obj)), fileSize(size)
+            {
+            }
+            inline bool IsValid() const
+            {
+                return fileObj != nullptr;
+            }
+            inline uint64 GetSize() const
+            {
+                return fileSize;
+            }
+            Buffer Read(uint64 offset, uint32 requestedSize) const;
+        };
+        inline Reader GetReader() const
+        {
+            return Reader(fileObj, fileSize);
+        }
         inline uint8 GetFromCache(uint64 offset, uint8 defaultValue = 0) const
         {
             if ((offset >= start) && (offset < end))
@@ -137,6 +170,48 @@ namespace Utils
     };
     CORE_EXPORT bool Demangle(std::string_view input, String& output, DemangleKind format = DemangleKind::Auto);
 
+    // demangles many names at once: every distinct name is demangled only once (the results are cached between calls)
+    // and the work is split between the ParallelFor workers
+    class CORE_EXPORT Demangler
+    {
+        void* context;
+
+      public:
+        Demangler(DemangleKind format = DemangleKind::Auto);
+        ~Demangler();
+
+        // results[i] is the demangled form of names[i] (or an empty view if names[i] is not mangled)
+        // the results are stored in an arena owned by the demangler --> they remain valid until it is destroyed
+        bool Demangle(std::span<const std::string_view> names, std::vector<std::string_view>& results);
+        std::string_view Demangle(std::string_view name);
+        uint32 GetCachedNamesCount() const;
+    };
+
+    // number of worker threads used by ParallelFor (hardware threads)
+    CORE_EXPORT uint32 GetParallelWorkersCount();
+    // calls task(index) for every index in [0, count) from multiple threads and waits for all of them to finish
+    // DataCache is not thread safe --> tasks should only work on buffers that were read before
+    CORE_EXPORT void ParallelFor(uint32 count, const std::function<void(uint32 index)>& task);
+
+    // finds all the occurrences of a set of byte patterns with a single pass over the data (Aho-Corasick automaton)
+    // the data can be given in consecutive pieces (a match can start in one piece and end in the next one)
+    class CORE_EXPORT PatternScanner
+    {
+        void* context;
+
+      public:
+        PatternScanner();
+        ~PatternScanner();
+
+        // patterns can only be added before the first scan ('id' is reported for every match of the pattern)
+        bool AddPattern(BufferView pattern, uint32 id);
+        // starts a new stream of data (the offsets of the matches are relative to 'startOffset')
+        void Reset(uint64 startOffset = 0);
+        // 'onMatch' receives the offset where a match starts and can stop the scan (returns false) --> Scan returns false as well
+        bool Scan(BufferView data, const std::function<bool(uint64 offset, uint32 id)>& onMatch);
+        bool Scan(DataCache& cache, uint64 start, uint64 size, const std::function<bool(uint64 offset, uint32 id)>& onMatch);
+    };
+
 } // namespace Utils
 
 namespace Hashes
@@ -278,6 +353,7 @@ namespace Hashes
 
         bool Update(const void* input, uint32 length);
         bool Final();
+        bool Reset(); // starts a new hash (the context is reused)
         std::string_view GetHexValue();
         const uint8* Get() const;
         uint32 GetSize() const;
@@ -383,6 +459,19 @@ namespace DigitalSignature
     CORE_EXPORT bool CMSToHumanReadable(const Buffer& buffer, String& ouput);
     CORE_EXPORT bool CMSToPEMCerts(const Buffer& buffer, String output[32], uint32& count);
     CORE_EXPORT bool CMSToStructure(const Buffer& buffer, Signature& output);
+
+    // the image digest signed by an Authenticode signature (SpcIndirectDataContent)
+    struct CORE_EXPORT AuthenticodeDigest
+    {
+        Hashes::OpenSSLHashKind kind;
+        String algorithm;
+        uint8 digest[64];
+        uint32 digestSize      = 0;
+        bool signatureVerified = false; // the signer signed the digest (the certificates chain is not verified)
+        String errorMessage;
+    };
+
+    CORE_EXPORT bool AuthenticodeToDigest(const Buffer& buffer, AuthenticodeDigest& output);
 } // namespace DigitalSignature
 
 namespace Golang
@@ -474,6 +563,21 @@ namespace Golang
         } fstEntry{ nullptr };
     };
 
+    enum class PcTableType : uint8
+    {
+        Sp   = 0, // stack pointer delta
+        File = 1, // index of the source file
+        Line = 2, // source line
+    };
+
+    struct CORE_EXPORT PcValue
+    {
+        uint64 start; // the pcs in [start, end) have the same value
+        uint64 end;
+        int32 value;
+    };
+
+    // the functions, files and pc-value tables are decoded on request from the buffer given to Process
     struct CORE_EXPORT PcLnTab
     {
       private:
@@ -490,6 +594,11 @@ namespace Golang
         uint64 GetFunctionsCount() const;
         bool GetFunction(uint64 index, Function& func) const;
         uint64 GetEntriesCount() const;
+        // index of the function that contains 'pc' (binary search in the functions table)
+        bool FindFunction(uint64 pc, uint64& index) const;
+        bool GetPcTable(uint64 index, PcTableType type, std::vector<PcValue>& values) const;
+        // source file and line of the instruction at 'pc'
+        bool GetSourceLine(uint64 pc, std::string_view& file, uint32& line) const;
         void SetBuildId(std::string_view buildId);
         const std::string& GetBuildId() const;
         void SetRuntimeBuildVersion(std::string_view runtimeBuildVersion);
@@ -499,12 +608,54 @@ namespace Golang
     };
 
     CORE_EXPORT const char* GetNameForGoMagic(GoMagic magic);
+
+    constexpr uint32 PCLNTAB_HEADER_MAX_SIZE = sizeof(GoFunctionHeader) + 8 * 8; // up to 8 fields of (at most) 8 bytes
+
+    // file offsets of the pclntab magics found in the [start, end) ranges of a file (a single pass over the data)
+    CORE_EXPORT std::vector<uint64> FindPcLnTabSigsCandidates(
+          Utils::DataCache& cache, const std::vector<std::pair<uint64, uint64>>& ranges);
+    // cheap check of a candidate: only the header of the table is needed (PCLNTAB_HEADER_MAX_SIZE bytes)
+    CORE_EXPORT bool IsValidPcLnTabHeader(BufferView header, Architecture arch);
 } // namespace Golang
 
 namespace ZLIB
 {
     CORE_EXPORT bool Decompress(const Buffer& input, uint64 inputSize, Buffer& output, uint64 outputSize);
-}
+
+    enum class StreamFormat : uint8
+    {
+        Raw,  // deflate data without any header
+        ZLIB, // RFC 1950
+        GZIP, // RFC 1952
+        Auto  // ZLIB or GZIP (detected from the header)
+    };
+
+    // decompresses a deflate stream given in consecutive pieces (the size of the output does not have to be known)
+    class CORE_EXPORT Inflater
+    {
+        void* context;
+
+      public:
+        Inflater();
+        ~Inflater();
+
+        bool Init(StreamFormat format);
+        // starts a new stream with the same format (e.g. the next member of a gzip file)
+        bool Reset();
+        // 'onOutput' receives the decompressed data one chunk at a time
+        // it can stop the decompression (by returning false) --> Inflate returns false as well
+        // the input after the end of the stream is not consumed
+        bool Inflate(BufferView input, const std::function<bool(BufferView output)>& onOutput);
+        bool Inflate(Utils::DataCache& cache, uint64 start, uint64 size, const std::function<bool(BufferView output)>& onOutput);
+        // if the input ended before the stream --> the stream is truncated
+        bool IsFinished() const;
+        uint64 GetConsumed() const;
+        uint64 GetProduced() const;
+    };
+
+    // 'sizeHint' is only used to preallocate the output (the stream must be complete)
+    CORE_EXPORT bool DecompressStream(BufferView input, Buffer& output, StreamFormat format, uint64 sizeHint = 0);
+} // namespace ZLIB
 
 namespace Dissasembly
 {
@@ -535,15 +686,33 @@ namespace Dissasembly
         char opStr[OP_STR_SIZE];
     };
 
+    // compact result of a batch decode: the text is not formatted (DissasembleInstruction formats one instruction on demand)
+    struct CORE_EXPORT InstructionInfo
+    {
+        uint64 address;
+        uint64 target; // destination of a direct call or jump (0 otherwise)
+        uint32 id;     // 0 for a byte that is not part of a valid instruction
+        uint16 size;
+        uint8 type;    // one of the Opcodes values (or 0)
+        bool isConditionalJump;
+    };
+
     class CORE_EXPORT DissasemblerIntel
     {
       private:
         size_t handle{ 0 };
+        size_t batchHandle{ 0 };           // DissasembleInstructions: the details are always on (branch targets)
+        void* batchInstruction{ nullptr }; // cs_insn reused by every DissasembleInstructions call
         bool isX64{ false };
 
       public:
         bool Init(bool isx64, bool isLittleEndian);
         bool DissasembleInstruction(BufferView buf, uint64 va, Instruction& instruction);
+        // decodes up to 'maxCount' consecutive instructions --> returns the number of records written in 'output'
+        // invalid bytes are skipped one at a time (each one gets its own record)
+        uint32 DissasembleInstructions(BufferView buf, uint64 va, InstructionInfo* output, uint32 maxCount);
+        // decodes the whole buffer
+        bool DissasembleInstructions(BufferView buf, uint64 va, std::vector<InstructionInfo>& output);
         bool IsCallInstruction(const Instruction& instruction) const;
         bool IsLCallInstruction(const Instruction& instruction) const;
         bool IsJmpInstruction(const Instruction& instruction) const;
@@ -553,6 +722,92 @@ namespace Dissasembly
         bool IsFunctionEndInstruction(const Instruction& instruction) const;
         ~DissasemblerIntel();
     };
+
+    // classifies the instruction found at every offset of a file (Call, Jmp, FunctionStart, ...)
+    // a whole page is decoded at once and only the most recently used pages are kept
+    class CORE_EXPORT OpcodesCache
+    {
+      private:
+        void* context{ nullptr };
+
+      public:
+        OpcodesCache();
+        OpcodesCache(const OpcodesCache&)            = delete;
+        OpcodesCache& operator=(const OpcodesCache&) = delete;
+        ~OpcodesCache();
+
+        void Clear();
+        // 'type' is one of the Opcodes values (or 0 if the instruction is not highlighted)
+        bool Get(DissasemblerIntel& dissasembler, Utils::DataCache& cache, uint64 offset, uint32& type, uint32& size);
+    };
+
+    // linear sweep of the executable zones of a file, done on a background thread (each zone is split between several workers)
+    // keeps a bitmap with the start of every instruction and the type of the highlighted ones
+    class CORE_EXPORT LinearSweepDecoder
+    {
+      private:
+        void* context{ nullptr };
+
+      public:
+        LinearSweepDecoder();
+        LinearSweepDecoder(const LinearSweepDecoder&)            = delete;
+        LinearSweepDecoder& operator=(const LinearSweepDecoder&) = delete;
+        ~LinearSweepDecoder();
+
+        // the zones are read and decoded in background (through a reader obtained from 'cache')
+        bool Start(Utils::DataCache& cache, const std::vector<std::pair<uint64, uint64>>& zones, bool isx64, bool isLittleEndian);
+        bool IsStarted() const;
+        bool IsReady() const;
+        uint64 GetInstructionsCount() const;
+        // the methods below fail if the decoding is not done or if 'offset' is not part of a decoded zone
+        bool IsInstructionStart(uint64 offset, bool& isStart) const;
+        bool GetInstruction(uint64 offset, uint32& type, uint32& size) const;
+    };
+
+    struct CORE_EXPORT ExecutableZone
+    {
+        uint64 offset; // in file
+        uint64 size;
+        uint64 address; // where the zone is loaded
+    };
+
+    struct CORE_EXPORT FunctionInfo
+    {
+        uint64 address;
+        uint64 offset; // in file
+        uint64 size;   // up to the end of the last instruction
+        uint32 instructionsCount;
+        uint32 callersCount;
+        uint32 calleesCount;
+        std::string_view name; // empty for the functions that were found only through calls
+    };
+
+    // recursive descent from the known entry points (entry point, exports, symbols, Go functions): the direct calls and jumps are
+    // followed and every function that is reached is analyzed in background (idle workers steal functions from the busy ones)
+    class CORE_EXPORT FunctionsAnalyzer
+    {
+      private:
+        void* context{ nullptr };
+
+      public:
+        FunctionsAnalyzer();
+        FunctionsAnalyzer(const FunctionsAnalyzer&)            = delete;
+        FunctionsAnalyzer& operator=(const FunctionsAnalyzer&) = delete;
+        ~FunctionsAnalyzer();
+
+        // the entry points are added before Start (the ones outside of the zones are ignored)
+        bool AddEntryPoint(uint64 address, std::string_view name);
+        // the zones are read and analyzed in background (through a reader obtained from 'cache')
+        bool Start(Utils::DataCache& cache, const std::vector<ExecutableZone>& zones, bool isx64, bool isLittleEndian);
+        bool IsStarted() const;
+        bool IsReady() const;
+        // the methods below fail if the analysis is not done; the functions are sorted by address
+        uint32 GetFunctionsCount() const;
+        bool GetFunction(uint32 index, FunctionInfo& info) const;
+        bool FindFunction(uint64 address, uint32& index) const; // the function that starts at 'address'
+        bool GetCallees(uint32 index, std::vector<uint32>& output) const;
+        bool GetCallers(uint32 index, std::vector<uint32>& output) const;
+    };
 } // namespace Dissasembly
 
 namespace Compression
@@ -562,7 +817,27 @@ namespace Compression
         namespace Huffman
         {
             CORE_EXPORT bool Decompress(const BufferView& compressed, Buffer& uncompressed);
-        }
+
+            // decodes a stream one block (64K of output) at a time
+            // only the unconsumed input and the last 64K of output (the window of the back references) are kept in memory
+            class CORE_EXPORT Decoder
+            {
+                void* context;
+
+              public:
+                Decoder();
+                ~Decoder();
+
+                // starts a new stream (the end of the output can not be detected from the stream --> its size is required)
+                void Reset(uint64 uncompressedSize);
+                // 'isLast' --> no more input follows (the bits read after the end of the input are 0)
+                bool AddInput(BufferView data, bool isLast);
+                // 'block' is valid until the next call (if it is empty, more input is required --> NeedsInput)
+                bool DecodeBlock(BufferView& block);
+                bool NeedsInput() const;
+                bool IsFinished() const;
+            };
+        } // namespace Huffman
     } // namespace LZXPRESS
 } // namespace Compression
 
@@ -656,6 +931,64 @@ namespace View
         {
         }
     };
+
+    // a list for tables that are too big for a ListView: the rows are not stored, the model formats a cell when it is painted
+    struct VirtualListColumn
+    {
+        std::string_view name;
+        uint32 width;
+        bool alignLeft;
+    };
+    struct CORE_EXPORT VirtualListModel
+    {
+        virtual uint64 GetRowsCount()                                                   = 0;
+        virtual void FormatCell(uint64 row, uint32 column, AppCUI::Utils::String& text) = 0;
+        // optional sorting (a click on the header of a column): the model orders its rows and changes 'row' (the current one)
+        // to the row where the same item is after the sort --> false if the rows can not be sorted by that column
+        virtual bool SortByColumn(uint32 column, uint64& row)
+        {
+            return false;
+        }
+        // the column that shows the sort order in the header
+        virtual bool GetSortColumn(uint32& column, bool& ascending)
+        {
+            return false;
+        }
+        virtual ~VirtualListModel(){};
+    };
+    class CORE_EXPORT VirtualList : public AppCUI::Controls::UserControl
+    {
+        Reference<VirtualListModel> model;
+        std::vector<VirtualListColumn> columns;
+        uint64 rowsCount;
+        uint64 topRow;
+        uint64 currentRow;
+
+        uint32 GetVisibleRowsCount() const;
+        void PaintHeader(AppCUI::Graphics::Renderer& renderer);
+        void PaintRow(AppCUI::Graphics::Renderer& renderer, uint64 row, int y);
+
+      public:
+        VirtualList(std::string_view layout, Reference<VirtualListModel> model, std::initializer_list<VirtualListColumn> columns);
+
+        // the number of rows (or their content) was changed
+        void Refresh();
+        void MoveTo(uint64 row);
+        // sorts the rows through the model (the cursor stays on the same item)
+        void SortByColumn(uint32 column);
+        // INVALID_OFFSET if the list is empty
+        uint64 GetCurrentRow() const;
+        inline uint64 GetRowsCount() const
+        {
+            return rowsCount;
+        }
+
+        void Paint(AppCUI::Graphics::Renderer& renderer) override;
+        bool OnKeyEvent(AppCUI::Input::Key keyCode, char16 characterCode) override;
+        void OnMousePressed(int x, int y, AppCUI::Input::MouseButton button) override;
+        bool OnMouseWheel(int x, int y, AppCUI::Input::MouseWheel direction) override;
+        void OnUpdateScrollBars() override;
+    };
     namespace BufferViewer
     {
         struct BufferColor
@@ -849,6 +1182,13 @@ namespace View
             TextEditor();
 
           public:
+            struct Edit
+            {
+                uint32 offset;
+                uint32 size;              // number of characters (starting from offset) that will be replaced
+                std::u16string_view text; // empty for a delete operation (must be valid until ApplyEdits is called)
+            };
+
             bool Insert(uint32 offset, std::string_view text);
             bool Insert(uint32 offset, std::u16string_view text);
             bool InsertChar(uint32 offset, char16 ch);
@@ -856,6 +1196,8 @@ namespace View
             bool Replace(uint32 offset, uint32 size, std::string_view text);
             bool Replace(uint32 offset, uint32 size, std::u16string_view text);
             bool ReplaceAll(std::string_view textToSearch, std::string_view textToReplaceWith, bool ignoreCase = false);
+            // applies all (non-overlapping) edits in one pass --> the text after an edit is moved only once
+            bool ApplyEdits(std::vector<Edit>& edits);
             bool DeleteChar(uint32 offset);
             bool Delete(uint32 offset, uint32 charactersCount);
             bool Add(std::string_view text);
@@ -1245,6 +1587,40 @@ namespace View
             return CreateViewer(name, settings);
         }
     };
+
+    // the "Functions" panel of the plugins that run a FunctionsAnalyzer: the analysis is started (through 'startAnalysis') the first
+    // time the panel is activated and the names of the functions are shown through 'formatName' (if set, for example to demangle them)
+    class CORE_EXPORT FunctionsPanel : public AppCUI::Controls::TabPage, public VirtualListModel
+    {
+      public:
+        using NameFormatter = std::function<std::string_view(std::string_view name)>;
+
+      private:
+        Reference<Dissasembly::FunctionsAnalyzer> analyzer;
+        Reference<WindowInterface> win;
+        std::function<bool()> startAnalysis;
+        NameFormatter formatName;
+        Reference<VirtualList> list;
+        int32 base;
+
+        std::string_view GetValue(NumericFormatter& n, uint64 value);
+        std::string_view GetName(std::string_view name);
+        bool GetSelectedFunction(Dissasembly::FunctionInfo& f);
+
+      public:
+        FunctionsPanel(
+              Reference<Dissasembly::FunctionsAnalyzer> analyzer,
+              Reference<WindowInterface> win,
+              std::function<bool()> startAnalysis,
+              NameFormatter formatName = nullptr);
+
+        void Update();
+        bool OnUpdateCommandBar(AppCUI::Application::CommandBar& commandBar) override;
+        bool OnEvent(Reference<Control>, Event evnt, int controlID) override;
+
+        uint64 GetRowsCount() override;
+        void FormatCell(uint64 row, uint32 column, AppCUI::Utils::String& text) override;
+    };
 }; // namespace View
 namespace App
 {
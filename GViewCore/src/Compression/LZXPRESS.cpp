@@ -11,364 +11,268 @@
 
 namespace GView::Compression::LZXPRESS::Huffman
 {
-constexpr uint32 MAX_BITS_COUNT     = 32U;
-constexpr uint32 UINT32_BITS_COUNT  = 32U;
-constexpr uint32 UINT16_BITS_COUNT  = 16U;
-constexpr uint32 CHUNK_SIZE         = 0x10000;
-constexpr uint32 MAXIMUM_CODE_SIZE  = 15U;
-constexpr uint32 SYMBOLS_ARRAY_SIZE = 512U;
-constexpr uint32 SYMBOL_MAX_SIZE    = 256U;
-
-struct Stream
+constexpr uint32 BLOCK_SIZE        = 0x10000; // output of a block (every block has its own Huffman table)
+constexpr uint32 WINDOW_SIZE       = 0x10000; // the farthest back reference
+constexpr uint32 TABLE_SIZE        = 256U;    // 512 code sizes of 4 bits
+constexpr uint32 SYMBOLS_COUNT     = 512U;
+constexpr uint32 SYMBOL_MAX_SIZE   = 256U; // smaller symbols are literals
+constexpr uint32 MAXIMUM_CODE_SIZE = 15U;
+constexpr uint16 INVALID_SYMBOL    = 0xFFFF;
+
+struct DecoderContext
 {
-  private:
-    const uint8* stream;
-    size_t size;
-    size_t offset;
+    std::vector<uint8> input; // not consumed yet (starting with 'inputOffset')
+    size_t inputOffset{ 0 };
+    bool inputFinished{ false };
+    std::vector<uint8> output; // the window (at most WINDOW_SIZE bytes) followed by the last decoded block
+    uint64 uncompressedSize{ 0 };
+    uint64 produced{ 0 };
+    bool needsInput{ true };
+    uint8 codeSizes[SYMBOLS_COUNT];
+    uint16 table[1U << MAXIMUM_CODE_SIZE]; // the next MAXIMUM_CODE_SIZE bits --> symbol
+};
 
+// the bits are stored in 16 bit little endian words (the most significant bit first)
+// the long match lengths are stored as bytes between the words (at the position where the next word would be read)
+struct BitReader
+{
+    const uint8* data;
+    size_t size;
+    size_t position;
+    bool isLast;
+    bool truncated;
     uint32 bits;
-    uint8 bitsCount;
-
-  public:
-    bool Initialize(const uint8* _stream, size_t _size)
-    {
-        CHECK(_stream != nullptr, false, "");
-        CHECK(_size <= (size_t) INT32_MAX, false, "");
-
-        stream = _stream;
-        size   = _size;
-
-        return true;
-    }
-
-    inline void PushUInt16()
-    {
-        bits <<= UINT16_BITS_COUNT;
-        bitsCount += UINT16_BITS_COUNT;
-
-        if (size >= sizeof(uint16) || offset <= (size - sizeof(uint16)))
-        {
-            *((uint16*) &bits) = *((uint16*) (stream + offset));
-            offset += sizeof(uint16);
-        }
-    }
-
-    inline void Next()
-    {
-        if (bitsCount < UINT16_BITS_COUNT)
-        {
-            PushUInt16();
-        }
-    }
+    int32 extraBits;
 
-    inline void PushUInt32()
+    inline uint8 ReadUInt8()
     {
-        PushUInt16();
-        PushUInt16();
+        uint8 value = 0;
+        if (position < size)
+            value = data[position];
+        else
+            truncated |= !isLast;
+        position++;
+        return value;
     }
 
-    inline uint32 GetBits() const
+    inline uint16 ReadUInt16()
     {
-        return bits;
+        const uint16 value = ReadUInt8();
+        return value | (ReadUInt8() << 8);
     }
 
-    inline uint8 GetBitsCount() const
+    inline uint32 ReadUInt32()
     {
-        return bitsCount;
+        const uint32 value = ReadUInt16();
+        return value | (ReadUInt16() << 16);
     }
 
-    inline void ResetBits()
+    inline void Start()
     {
-        bitsCount = 0;
+        bits      = ReadUInt16() << 16;
+        bits      = bits | ReadUInt16();
+        extraBits = 16;
     }
 
-    bool GetValue(uint8 bitsToRead, uint32& value)
+    // at most MAXIMUM_CODE_SIZE bits --> a single word is enough to refill
+    inline void Consume(uint32 count)
     {
-        CHECK(bitsToRead <= MAX_BITS_COUNT, false, "");
-
-        value = 0;
-        CHECK(bitsToRead != 0, true, "");
-
-        if (bitsCount < bitsToRead)
-        {
-            CHECK(Read(bitsToRead), false, "");
-        }
-
-        value = bits;
-
-        if (bitsToRead < MAX_BITS_COUNT)
-        {
-            value >>= bitsCount - bitsToRead;
-        }
-        bitsCount -= bitsToRead;
-
-        if (bitsCount == 0)
-        {
-            bits = 0;
-        }
-        else
+        bits <<= count;
+        extraBits -= count;
+        if (extraBits < 0)
         {
-            const uint8 bitBufferSizeLeft = MAX_BITS_COUNT - bitsCount;
-            bits &= 0xffffffffUL >> bitBufferSizeLeft;
+            bits |= ReadUInt16() << (-extraBits);
+            extraBits += 16;
         }
-
-        return true;
-    }
-
-    template <typename V>
-    inline bool Read(V& value)
-    {
-        CHECK(offset <= size - sizeof(V), false, "");
-
-        value = *(V*) (stream + offset);
-        offset += sizeof(V);
-
-        return true;
-    }
-
-    inline size_t GetSize() const
-    {
-        return size;
-    }
-
-    inline size_t GetOffset() const
-    {
-        return offset;
     }
 };
 
-struct HuffmanTree
+// canonical code: the codes are assigned in the order of their size and then in the order of the symbols
+static bool BuildTable(DecoderContext& ctx, const uint8* data)
 {
-    uint8 maximumCodeSize;
-    std::unique_ptr<int32> symbols;
-    std::unique_ptr<int32> codeSizeCounts;
-
-    bool Initialize(int32 symbolsCount, uint8 _maximumCodeSize)
+    for (auto i = 0U; i < TABLE_SIZE; i++)
     {
-        CHECK(symbolsCount >= 0, false, "");
-        CHECK(symbolsCount <= 1024, false, "");
-
-        size_t size = sizeof(int32) * symbolsCount;
-
-        symbols.reset(new int32[size]);
-        CHECK(symbols.get() != nullptr, false, "");
-        memset(symbols.get(), 0, size);
-
-        size = sizeof(int32) * (_maximumCodeSize + 1ULL);
-
-        codeSizeCounts.reset(new int32[size]);
-        CHECK(codeSizeCounts.get() != nullptr, false, "");
-        memset(codeSizeCounts.get(), 0, size);
-
-        maximumCodeSize = _maximumCodeSize;
-
-        return true;
+        ctx.codeSizes[i * 2]     = data[i] & 0x0F;
+        ctx.codeSizes[i * 2 + 1] = data[i] >> 4;
     }
 
-    bool Build(const uint8* codeSizes, int32 _codeSizesCount)
+    std::fill(std::begin(ctx.table), std::end(ctx.table), INVALID_SYMBOL);
+    uint32 next = 0;
+    for (auto size = 1U; size <= MAXIMUM_CODE_SIZE; size++)
     {
-        CHECK(codeSizes != nullptr, false, "");
-        CHECK(_codeSizesCount >= 0, false, "");
-
-        size_t size = sizeof(int32) * (maximumCodeSize + 1ULL);
-        memset(codeSizeCounts.get(), 0, size);
-
-        for (int32 i = 0; i < _codeSizesCount; i++)
-        {
-            const uint8 size = codeSizes[i];
-            CHECK(size <= maximumCodeSize, false, "");
-
-            codeSizeCounts.get()[size] += 1;
-        }
-
-        CHECK(codeSizeCounts.get()[0] != _codeSizesCount, true, "");
-
-        int32 leftValue = 1;
-        for (auto i = 1; i <= maximumCodeSize; i++)
-        {
-            leftValue <<= 1;
-            leftValue -= codeSizeCounts.get()[i];
-            CHECK(leftValue >= 0, false, "");
-        }
-
-        std::unique_ptr<int32> symbolOffsets(new int32[size]);
-        CHECK(symbolOffsets.get() != nullptr, false, "");
-
-        symbolOffsets.get()[0] = 0;
-        symbolOffsets.get()[1] = 0;
-
-        for (uint8 i = 1; i < maximumCodeSize; i++)
+        const auto count = 1U << (MAXIMUM_CODE_SIZE - size);
+        for (auto symbol = 0U; symbol < SYMBOLS_COUNT; symbol++)
         {
-            symbolOffsets.get()[i + 1] = symbolOffsets.get()[i] + codeSizeCounts.get()[i];
-        }
-
-        for (int32 symbol = 0; symbol < _codeSizesCount; symbol++)
-        {
-            const uint8 codeSize = codeSizes[symbol];
-            if (codeSize == 0)
-            {
+            if (ctx.codeSizes[symbol] != size)
                 continue;
-            }
-
-            const int32 offset = symbolOffsets.get()[codeSize];
-            CHECK(offset >= 0, false, "");
-            CHECK(offset <= _codeSizesCount, false, "");
-
-            symbolOffsets.get()[codeSize] += 1;
-            symbols.get()[offset] = symbol;
+            CHECK(next + count <= ARRAY_LEN(ctx.table), false, "Invalid Huffman table (oversubscribed) !");
+            std::fill_n(ctx.table + next, count, static_cast<uint16>(symbol));
+            next += count;
         }
-
-        return true;
     }
+    CHECK(next > 0, false, "Invalid Huffman table (no symbols) !");
+    return true;
+}
 
-    bool GetSymbol(Stream& stream, uint32& symbol)
-    {
-        while (stream.GetBitsCount() < maximumCodeSize)
-        {
-            CHECK(stream.Read(maximumCodeSize), false, "");
-        }
-
-        const uint8 bitsCount = maximumCodeSize < stream.GetBitsCount() ? maximumCodeSize : stream.GetBitsCount();
-
-        uint32 value       = 0;
-        int32 code         = 0;
-        int32 initialCode  = 0;
-        int32 initialIndex = 0;
-        symbol             = 0;
-        bool result        = false;
-        for (uint8 i = 1; i <= bitsCount; i++)
-        {
-            CHECK(stream.GetValue(1, value), false, "");
-
-            code <<= 1;
-            code |= (int32) value;
-
-            const int32 codeSizeCount = codeSizeCounts.get()[i];
-
-            if ((code - codeSizeCount) < initialCode)
-            {
-                symbol = symbols.get()[initialIndex + (code - initialCode)];
-                result = true;
-                break;
-            }
-            initialCode += codeSizeCount;
-            initialCode <<= 1;
-            initialIndex += codeSizeCount;
-        }
-
-        CHECK(result, false, "");
+Decoder::Decoder()
+{
+    context = new DecoderContext;
+}
 
-        return true;
-    }
-};
+Decoder::~Decoder()
+{
+    delete reinterpret_cast<DecoderContext*>(context);
+    context = nullptr;
+}
 
-bool Update(Stream& stream, Buffer& uncompressed, size_t& uncompressedDataOffset)
+void Decoder::Reset(uint64 uncompressedSize)
 {
-    CHECK((stream.GetSize() - stream.GetOffset()) >= 260, false, "");
-    CHECK(uncompressed.GetLength() <= (size_t) INT32_MAX, false, "");
-    CHECK(uncompressedDataOffset < uncompressed.GetLength(), false, "");
+    auto ctx = reinterpret_cast<DecoderContext*>(context);
+    ctx->input.clear();
+    ctx->inputOffset   = 0;
+    ctx->inputFinished = false;
+    ctx->output.clear();
+    ctx->uncompressedSize = uncompressedSize;
+    ctx->produced         = 0;
+    ctx->needsInput       = true;
+}
 
-    uint32 i = 0;
-    uint8 codeSizes[SYMBOLS_ARRAY_SIZE]{ 0 };
-    while (i < SYMBOLS_ARRAY_SIZE)
-    {
-        uint8 value;
-        CHECK(stream.Read<decltype(value)>(value), false, "");
-        codeSizes[i++] = value & 0x0f;
-        codeSizes[i++] = (value & 0xf0) >> 4;
-    }
+bool Decoder::AddInput(BufferView data, bool isLast)
+{
+    auto ctx = reinterpret_cast<DecoderContext*>(context);
+    CHECK(!ctx->inputFinished, false, "The last input was already added !");
+
+    // the consumed input is dropped (only the part of the block that is not complete yet is kept)
+    ctx->input.erase(ctx->input.begin(), ctx->input.begin() + ctx->inputOffset);
+    ctx->inputOffset = 0;
+    if (data.IsValid())
+        ctx->input.insert(ctx->input.end(), data.begin(), data.end());
+    ctx->inputFinished = isLast;
+    ctx->needsInput    = false;
+    return true;
+}
 
-    HuffmanTree tree{};
-    CHECK(tree.Initialize(SYMBOLS_ARRAY_SIZE, MAXIMUM_CODE_SIZE), false, "");
-    CHECK(tree.Build(codeSizes, SYMBOLS_ARRAY_SIZE), false, "");
+bool Decoder::DecodeBlock(BufferView& block)
+{
+    auto ctx = reinterpret_cast<DecoderContext*>(context);
+    block    = BufferView();
+    if (ctx->produced >= ctx->uncompressedSize)
+        return true;
 
-    stream.PushUInt32();
+    auto& output = ctx->output;
+    if (output.size() > WINDOW_SIZE)
+        output.erase(output.begin(), output.end() - WINDOW_SIZE);
+    const auto blockStart = output.size();
 
-    size_t nextChunk = uncompressedDataOffset + CHUNK_SIZE;
-    if (nextChunk > uncompressed.GetLength())
+    const auto available = ctx->input.size() - ctx->inputOffset;
+    if (available < TABLE_SIZE)
     {
-        nextChunk = uncompressed.GetLength();
+        CHECK(!ctx->inputFinished, false, "Truncated stream (expecting a Huffman table) !");
+        ctx->needsInput = true;
+        return true;
     }
-
-    while ((stream.GetOffset() < stream.GetSize()) || (stream.GetBitsCount() > 0))
+    CHECK(BuildTable(*ctx, ctx->input.data() + ctx->inputOffset), false, "");
+
+    BitReader reader{ ctx->input.data() + ctx->inputOffset + TABLE_SIZE, available - TABLE_SIZE, 0, ctx->inputFinished, false, 0, 0 };
+    reader.Start();
+
+    // the last match of a block can end after the block
+    const auto remaining = ctx->uncompressedSize - ctx->produced;
+    const auto blockEnd  = blockStart + static_cast<size_t>(std::min<uint64>(BLOCK_SIZE, remaining));
+    const auto outputEnd = blockStart + static_cast<size_t>(remaining);
+    output.resize(blockEnd);
+    auto position = blockStart;
+    while ((position < blockEnd) && (!reader.truncated))
     {
-        CHECKBK(uncompressedDataOffset < nextChunk, "");
-
-        uint32 symbol = 0;
-        CHECK(tree.GetSymbol(stream, symbol), false, "");
+        const auto symbol = ctx->table[reader.bits >> (32 - MAXIMUM_CODE_SIZE)];
+        CHECK(symbol != INVALID_SYMBOL, false, "Invalid Huffman code !");
+        reader.Consume(ctx->codeSizes[symbol]);
 
         if (symbol < SYMBOL_MAX_SIZE)
         {
-            uncompressed.GetData()[uncompressedDataOffset++] = (uint8) symbol;
+            output[position++] = static_cast<uint8>(symbol);
+            continue;
         }
 
-        stream.Next();
-
-        if (stream.GetBits() == 0 && uncompressedDataOffset >= uncompressed.GetLength())
-        {
-            break;
-        }
-
-        if (symbol >= SYMBOL_MAX_SIZE)
+        uint64 length           = symbol & 0x0F;
+        const uint32 offsetBits = (symbol - SYMBOL_MAX_SIZE) >> 4;
+        if (length == 15)
         {
-            symbol -= SYMBOL_MAX_SIZE;
-            uint32 compressionSize = symbol & 0x000f;
-            symbol >>= 4;
-
-            uint32 compressionOffset = 0;
-            if (symbol != 0)
+            length += reader.ReadUInt8();
+            if (length == 270)
             {
-                CHECK(stream.GetValue((uint8) symbol, compressionOffset), false, "");
+                length = reader.ReadUInt16();
+                if (length == 0)
+                    length = reader.ReadUInt32();
+                CHECK(length >= 15, false, "Invalid match length !");
             }
-            compressionOffset = (uint32) ((1 << symbol) | compressionOffset);
-
-            if (compressionSize == 15)
-            {
-                uint8 val8;
-                CHECK(stream.Read<decltype(val8)>(val8), false, "");
-                compressionSize += val8;
-
-                if (compressionSize == 270)
-                {
-                    uint16 val16;
-                    CHECK(stream.Read<decltype(val16)>(val16), false, "");
-                    compressionSize = val16;
-
-                    if (compressionSize == 0)
-                    {
-                        CHECK(stream.Read<decltype(compressionSize)>(compressionSize), false, "");
-                    }
-                }
-            }
-            compressionSize += 3;
-
-            CHECK(compressionOffset <= uncompressedDataOffset, false, "");
-            CHECK(compressionSize <= (uncompressed.GetLength() - uncompressedDataOffset), false, "");
+        }
+        length += 3;
 
-            compressionOffset = (uint32) (uncompressedDataOffset - compressionOffset);
+        uint32 offset = 1U << offsetBits;
+        if (offsetBits > 0)
+        {
+            offset |= reader.bits >> (32 - offsetBits);
+            reader.Consume(offsetBits);
+        }
 
-            memcpy(uncompressed.GetData() + uncompressedDataOffset, uncompressed.GetData() + compressionOffset, compressionSize);
-            uncompressedDataOffset += compressionSize;
-            compressionOffset += compressionSize;
-            compressionSize = 0;
+        if (reader.truncated)
+            break;
+        CHECK(offset <= position, false, "Invalid back reference !");
+        CHECK(length <= outputEnd - position, false, "Match after the end of the output !");
+
+        if (position + length > output.size())
+            output.resize(position + length);
+        // the source and the destination can overlap (the copy repeats the last 'offset' bytes)
+        auto* destination  = output.data() + position;
+        const auto* source = destination - offset;
+        for (size_t i = 0; i < length; i++)
+            destination[i] = source[i];
+        position += length;
+    }
 
-            stream.Next();
-        }
+    if (reader.truncated)
+    {
+        // the block is decoded again when the rest of it is available
+        output.resize(blockStart);
+        ctx->needsInput = true;
+        return true;
     }
 
+    output.resize(position);
+    ctx->inputOffset += std::min<size_t>(TABLE_SIZE + reader.position, available);
+    ctx->produced += position - blockStart;
+    ctx->needsInput = false;
+    block           = BufferView(output.data() + blockStart, position - blockStart);
     return true;
 }
 
+bool Decoder::NeedsInput() const
+{
+    auto ctx = reinterpret_cast<DecoderContext*>(context);
+    return ctx->needsInput && (!ctx->inputFinished);
+}
+
+bool Decoder::IsFinished() const
+{
+    auto ctx = reinterpret_cast<DecoderContext*>(context);
+    return ctx->produced >= ctx->uncompressedSize;
+}
+
 bool Decompress_FallBack(const BufferView& compressed, Buffer& decompressed)
 {
-    Stream stream{};
-    CHECK(stream.Initialize(compressed.GetData(), compressed.GetLength()), false, "");
+    Decoder decoder;
+    decoder.Reset(decompressed.GetLength());
+    CHECK(decoder.AddInput(compressed, true), false, "");
 
     size_t offset = 0;
-    while (stream.GetOffset() < stream.GetSize() && offset < decompressed.GetLength())
+    while (!decoder.IsFinished())
     {
-        stream.ResetBits();
-        CHECK(Update(stream, decompressed, offset), false, "");
+        BufferView block;
+        CHECK(decoder.DecodeBlock(block), false, "");
+        CHECK(block.GetLength() > 0, false, "");
+        memcpy(decompressed.GetData() + offset, block.GetData(), block.GetLength());
+        offset += block.GetLength();
     }
     CHECK(decompressed.GetLength() == offset, false, "");
 
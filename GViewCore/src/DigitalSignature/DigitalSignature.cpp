@@ -4,6 +4,7 @@
 #include <openssl/cms.h>
 #include <openssl/err.h>
 #include <openssl/crypto.h>
+#include <openssl/pkcs7.h>
 
 namespace GView::DigitalSignature
 {
@@ -67,6 +68,26 @@ struct WrapperEVP_PKEY
     }
 };
 
+struct WrapperPKCS7
+{
+    PKCS7* data = nullptr;
+
+    ~WrapperPKCS7()
+    {
+        PKCS7_free(data);
+    }
+};
+
+struct WrapperASN1_OBJECT
+{
+    ASN1_OBJECT* data = nullptr;
+
+    ~WrapperASN1_OBJECT()
+    {
+        ASN1_OBJECT_free(data);
+    }
+};
+
 struct WrapperBUF_MEM
 {
     BUF_MEM* data = nullptr;
@@ -97,6 +118,17 @@ inline static void GetError(uint32& errorCode, String& output)
     output.Set(ERR_error_string(errorCode, nullptr));
 }
 
+// moves 'p' to the content of the DER element that starts at 'p'
+inline static bool ReadDERHeader(const unsigned char*& p, const unsigned char* end, int32 expectedTag, long& length)
+{
+    int32 tag    = 0;
+    int32 xclass = 0;
+    CHECK(p < end, false, "");
+    CHECK((ASN1_get_object(&p, &length, &tag, &xclass, static_cast<long>(end - p)) & 0x80) == 0, false, "Invalid DER element!");
+    CHECK(tag == expectedTag, false, "Expecting tag %d (found %d)!", expectedTag, tag);
+    return true;
+}
+
 bool CMSToHumanReadable(const Buffer& buffer, String& output)
 {
     CHECK(buffer.GetData() != nullptr, "Nullptr data provided!", "");
@@ -462,4 +494,90 @@ bool CMSToStructure(const Buffer& buffer, Signature& output)
 
     return true;
 }
+
+bool AuthenticodeToDigest(const Buffer& buffer, AuthenticodeDigest& output)
+{
+    constexpr std::string_view SPC_INDIRECT_DATA_OID = "1.3.6.1.4.1.311.2.1.4";
+
+    CHECK(buffer.GetData() != nullptr, false, "Nullptr data provided!");
+    output.digestSize        = 0;
+    output.signatureVerified = false;
+    output.errorMessage.Set("");
+
+    // the content of an Authenticode signature is a SEQUENCE (not an OCTET STRING) --> CMS can not decode it, PKCS7 keeps it as is
+    uint32 error = 0;
+    auto data    = reinterpret_cast<const unsigned char*>(buffer.GetData());
+    ERR_clear_error();
+    WrapperPKCS7 p7{ d2i_PKCS7(nullptr, &data, static_cast<long>(buffer.GetLength())) };
+    if (p7.data == nullptr)
+    {
+        GetError(error, output.errorMessage);
+        RETURNERROR(false, output.errorMessage.GetText());
+    }
+    CHECK(PKCS7_type_is_signed(p7.data), false, "Expecting a PKCS7 SignedData structure!");
+
+    const auto contents = p7.data->d.sign->contents;
+    CHECK(contents != nullptr && contents->type != nullptr, false, "");
+    char oid[64]{};
+    OBJ_obj2txt(oid, sizeof(oid), contents->type, 1);
+    CHECK(std::string_view{ oid } == SPC_INDIRECT_DATA_OID, false, "Expecting a SpcIndirectDataContent (found %s)!", oid);
+    CHECK(contents->d.other != nullptr && contents->d.other->type == V_ASN1_SEQUENCE, false, "");
+
+    // SpcIndirectDataContent ::= SEQUENCE { data SpcAttributeTypeAndOptionalValue, messageDigest DigestInfo }
+    // DigestInfo ::= SEQUENCE { digestAlgorithm AlgorithmIdentifier, digest OCTET STRING }
+    const auto sequence = contents->d.other->value.sequence;
+    const unsigned char* p = sequence->data;
+    const auto end         = p + sequence->length;
+    long length            = 0;
+    CHECK(ReadDERHeader(p, end, V_ASN1_SEQUENCE, length), false, "");
+    const auto content       = p;
+    const auto contentLength = length;
+    CHECK(ReadDERHeader(p, end, V_ASN1_SEQUENCE, length), false, "");
+    p += length;
+    CHECK(ReadDERHeader(p, end, V_ASN1_SEQUENCE, length), false, "");
+    CHECK(ReadDERHeader(p, end, V_ASN1_SEQUENCE, length), false, "");
+    const auto algorithmEnd = p + length;
+    WrapperASN1_OBJECT algorithm{ d2i_ASN1_OBJECT(nullptr, &p, length) };
+    CHECK(algorithm.data != nullptr, false, "Invalid digest algorithm!");
+    p = algorithmEnd; // the parameters of the algorithm (usually NULL) are not used
+    CHECK(ReadDERHeader(p, end, V_ASN1_OCTET_STRING, length), false, "");
+    CHECK(length > 0 && static_cast<size_t>(length) <= sizeof(output.digest), false, "Invalid digest size (%ld)!", length);
+
+    const auto nid = OBJ_obj2nid(algorithm.data);
+    switch (nid)
+    {
+    case NID_md5:
+        output.kind = Hashes::OpenSSLHashKind::Md5;
+        break;
+    case NID_sha1:
+        output.kind = Hashes::OpenSSLHashKind::Sha1;
+        break;
+    case NID_sha256:
+        output.kind = Hashes::OpenSSLHashKind::Sha256;
+        break;
+    case NID_sha384:
+        output.kind = Hashes::OpenSSLHashKind::Sha384;
+        break;
+    case NID_sha512:
+        output.kind = Hashes::OpenSSLHashKind::Sha512;
+        break;
+    default:
+        RETURNERROR(false, "Unsupported digest algorithm (%d)!", nid);
+    }
+    output.algorithm.Set(OBJ_nid2sn(nid));
+    memcpy(output.digest, p, length);
+    output.digestSize = static_cast<uint32>(length);
+
+    // the signer hashed the content of SpcIndirectDataContent (without its tag and length)
+    ERR_clear_error();
+    WrapperBIO in{ BIO_new_mem_buf(content, static_cast<int32>(contentLength)) };
+    CHECK(in.memory != nullptr, false, "");
+    output.signatureVerified = PKCS7_verify(p7.data, nullptr, nullptr, in.memory, nullptr, PKCS7_NOVERIFY | PKCS7_BINARY) == 1;
+    if (!output.signatureVerified)
+    {
+        GetError(error, output.errorMessage);
+    }
+
+    return true;
+}
 } // namespace GView::DigitalSignature
@@ -15,6 +15,12 @@ bool DissasemblerIntel::Init(bool isx64, bool isLittleEndian)
 
         const auto result = cs_open(arch, mode, &handle);
         CHECK(result == CS_ERR_OK, false, "Error: %u!", result);
+
+        const auto batchResult = cs_open(arch, mode, &batchHandle);
+        CHECK(batchResult == CS_ERR_OK, false, "Error: %u!", batchResult);
+        CHECK(cs_option(batchHandle, CS_OPT_DETAIL, CS_OPT_ON) == CS_ERR_OK, false, "");
+        batchInstruction = cs_malloc(batchHandle);
+        CHECK(batchInstruction != nullptr, false, "");
     }
     return true;
 }
@@ -60,9 +66,9 @@ bool DissasemblerIntel::IsLJmpInstruction(const Instruction& instruction) const
     return true;
 }
 
-bool DissasemblerIntel::IsBreakpointInstruction(const Instruction& instruction) const
+static bool IsBreakpointId(uint32 id)
 {
-    switch (instruction.id)
+    switch (id)
     {
     case X86_INS_INT:
     case X86_INS_INT1:
@@ -74,9 +80,15 @@ bool DissasemblerIntel::IsBreakpointInstruction(const Instruction& instruction)
     }
 }
 
-bool DissasemblerIntel::AreFunctionStartInstructions(const Instruction& instruction1, const Instruction& instruction2) const
+bool DissasemblerIntel::IsBreakpointInstruction(const Instruction& instruction) const
 {
-    switch (instruction1.id)
+    return IsBreakpointId(instruction.id);
+}
+
+// the text of the operands is needed only for the first instruction (the batch decoding does not keep it)
+static bool IsFunctionStartPair(bool isX64, uint32 id1, std::string_view opStr, uint32 id2)
+{
+    switch (id1)
     {
     case X86_INS_PUSH:
     case X86_INS_PUSHAW:
@@ -85,8 +97,7 @@ bool DissasemblerIntel::AreFunctionStartInstructions(const Instruction& instruct
     case X86_INS_PUSHFD:
     case X86_INS_PUSHFQ:
     {
-        const std::string_view opStr{ instruction1.opStr, GView::Dissasembly::OP_STR_SIZE };
-        if (this->isX64)
+        if (isX64)
         {
             CHECK(opStr.starts_with("rsp"), false, "");
         }
@@ -95,7 +106,7 @@ bool DissasemblerIntel::AreFunctionStartInstructions(const Instruction& instruct
             CHECK(opStr.starts_with("esp"), false, "");
         }
 
-        switch (instruction2.id)
+        switch (id2)
         {
         case X86_INS_MOV:
         case X86_INS_MOVABS:
@@ -153,8 +164,7 @@ bool DissasemblerIntel::AreFunctionStartInstructions(const Instruction& instruct
     case X86_INS_FISUB:
     case X86_INS_FSUBP:
     {
-        const std::string_view opStr{ instruction1.opStr, GView::Dissasembly::OP_STR_SIZE };
-        if (this->isX64)
+        if (isX64)
         {
             CHECK(opStr.starts_with("rsp"), false, "");
         }
@@ -169,7 +179,7 @@ bool DissasemblerIntel::AreFunctionStartInstructions(const Instruction& instruct
     case X86_INS_ENDBR64:
     case X86_INS_ENDBR32:
     {
-        CHECK(instruction2.id != X86_INS_RET, false, ""); // function end
+        CHECK(id2 != X86_INS_RET, false, ""); // function end
         return true;
     }
     default:
@@ -177,9 +187,14 @@ bool DissasemblerIntel::AreFunctionStartInstructions(const Instruction& instruct
     }
 }
 
-bool DissasemblerIntel::IsFunctionEndInstruction(const Instruction& instruction) const
+bool DissasemblerIntel::AreFunctionStartInstructions(const Instruction& instruction1, const Instruction& instruction2) const
+{
+    return IsFunctionStartPair(this->isX64, instruction1.id, { instruction1.opStr, GView::Dissasembly::OP_STR_SIZE }, instruction2.id);
+}
+
+static bool IsFunctionEndId(uint32 id)
 {
-    switch (instruction.id)
+    switch (id)
     {
         // case X86_INS_IRET:  // Interrupt return (16-bit operand size).
         // case X86_INS_IRETD: // Interrupt return (32-bit operand size).
@@ -197,8 +212,165 @@ bool DissasemblerIntel::IsFunctionEndInstruction(const Instruction& instruction)
     }
 }
 
+bool DissasemblerIntel::IsFunctionEndInstruction(const Instruction& instruction) const
+{
+    return IsFunctionEndId(instruction.id);
+}
+
+static bool IsConditionalJumpId(uint32 id)
+{
+    switch (id)
+    {
+    case X86_INS_JA:
+    case X86_INS_JAE:
+    case X86_INS_JB:
+    case X86_INS_JBE:
+    case X86_INS_JCXZ:
+    case X86_INS_JECXZ:
+    case X86_INS_JRCXZ:
+    case X86_INS_JE:
+    case X86_INS_JNE:
+    case X86_INS_JG:
+    case X86_INS_JGE:
+    case X86_INS_JL:
+    case X86_INS_JLE:
+    case X86_INS_JO:
+    case X86_INS_JNO:
+    case X86_INS_JP:
+    case X86_INS_JNP:
+    case X86_INS_JS:
+    case X86_INS_JNS:
+    case X86_INS_LOOP:
+    case X86_INS_LOOPE:
+    case X86_INS_LOOPNE:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// direct branches have the absolute destination as their only (immediate) operand; the indirect ones have no target
+static uint64 GetBranchTarget(const cs_insn* insn)
+{
+    const auto& x86 = insn->detail->x86;
+    if ((x86.op_count == 1) && (x86.operands[0].type == X86_OP_IMM))
+        return static_cast<uint64>(x86.operands[0].imm);
+    return 0;
+}
+
+// the classes are exclusive: the highlighting mask is applied by the caller (FunctionStart depends on the next instruction)
+static uint8 GetInstructionType(uint32 id)
+{
+    switch (id)
+    {
+    case X86_INS_CALL:
+        return (uint8) Opcodes::Call;
+    case X86_INS_LCALL:
+        return (uint8) Opcodes::LCall;
+    case X86_INS_JMP:
+        return (uint8) Opcodes::Jmp;
+    case X86_INS_LJMP:
+        return (uint8) Opcodes::LJmp;
+    }
+    if (IsBreakpointId(id))
+        return (uint8) Opcodes::Breakpoint;
+    if (IsFunctionEndId(id))
+        return (uint8) Opcodes::FunctionEnd;
+    return 0;
+}
+
+uint32 DissasemblerIntel::DissasembleInstructions(BufferView buf, uint64 va, InstructionInfo* output, uint32 maxCount)
+{
+    CHECK(batchInstruction != nullptr, 0, "");
+    CHECK(output != nullptr, 0, "");
+
+    // one record (allocated by Init) is reused for every instruction and nothing is copied from its text
+    // (only the start of the operands is kept, to detect the 'push rsp' / 'sub rsp' function prologues)
+    auto insn = reinterpret_cast<cs_insn*>(batchInstruction);
+
+    auto data      = buf.GetData();
+    auto length    = buf.GetLength();
+    uint64 address = va;
+    uint32 count   = 0;
+    char operand[4]{};
+
+    while ((count < maxCount) && (length > 0))
+    {
+        auto& info = output[count];
+        if (cs_disasm_iter(batchHandle, &data, &length, &address, insn))
+        {
+            info = { insn->address, 0, insn->id, insn->size, GetInstructionType(insn->id), IsConditionalJumpId(insn->id) };
+            if ((info.type == (uint8) Opcodes::Call) || (info.type == (uint8) Opcodes::Jmp) || info.isConditionalJump)
+                info.target = GetBranchTarget(insn);
+            if ((count > 0) && (output[count - 1].id != 0) && IsFunctionStartPair(this->isX64, output[count - 1].id, operand, insn->id))
+                output[count - 1].type = (uint8) Opcodes::FunctionStart;
+            memcpy(operand, insn->op_str, 3);
+        }
+        else
+        {
+            // not a valid instruction (or a truncated one) --> skipped one byte at a time
+            info = { address, 0, 0, 1, 0, false };
+            data++;
+            length--;
+            address++;
+        }
+        count++;
+    }
+
+    // the last instruction of the batch can start a function as well
+    if ((count == maxCount) && (count > 0) && (output[count - 1].id != 0) && (length > 0))
+    {
+        const auto& last = output[count - 1];
+        if (cs_disasm_iter(batchHandle, &data, &length, &address, insn) && IsFunctionStartPair(this->isX64, last.id, operand, insn->id))
+            output[count - 1].type = (uint8) Opcodes::FunctionStart;
+    }
+
+    return count;
+}
+
+bool DissasemblerIntel::DissasembleInstructions(BufferView buf, uint64 va, std::vector<InstructionInfo>& output)
+{
+    constexpr uint32 BATCH_SIZE = 4096;
+
+    output.clear();
+    size_t position = 0;
+    while (position < buf.GetLength())
+    {
+        const auto start = output.size();
+        output.resize(start + BATCH_SIZE);
+        const auto count = DissasembleInstructions(
+              { buf.GetData() + position, buf.GetLength() - position }, va + position, output.data() + start, BATCH_SIZE);
+        output.resize(start + count);
+        CHECK(count > 0, false, "");
+        position = static_cast<size_t>(output.back().address + output.back().size - va);
+    }
+    return true;
+}
+
+bool ClassifyInstruction(DissasemblerIntel& dissasembler, BufferView window, uint64 offset, ClassifiedInstruction& result)
+{
+    // the second instruction is needed only when the first one starts a function (it is highlighted as well)
+    InstructionInfo pair[2]{};
+    const auto count = dissasembler.DissasembleInstructions(window, offset, pair, 2);
+    // most of the offsets are not the start of an instruction --> not an error
+    if ((count == 0) || (pair[0].id == 0))
+        return false;
+
+    result.type          = pair[0].type;
+    result.size          = pair[0].size;
+    result.highlightSize = pair[0].size;
+    if ((result.type == (uint32) Opcodes::FunctionStart) && (count == 2))
+        result.highlightSize += pair[1].size;
+
+    return true;
+}
+
 DissasemblerIntel::~DissasemblerIntel()
 {
+    if (batchInstruction != nullptr)
+        cs_free(reinterpret_cast<cs_insn*>(batchInstruction), 1);
+    if (batchHandle != 0)
+        cs_close(&batchHandle);
     CHECKRET(cs_close(&handle), "");
     handle = 0;
 }
@@ -0,0 +1,471 @@
+#include "Internal.hpp"
+#include <capstone/capstone.h>
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+
+namespace GView::Dissasembly
+{
+constexpr uint64 ANALYSIS_MAX_ZONE_SIZE    = 0x10000000; // bigger zones are not analyzed
+constexpr uint32 ANALYSIS_MAX_INSTRUCTIONS = 0x10000;    // the rest of a bigger function is not followed
+constexpr uint32 ANALYSIS_BATCH_SIZE       = 16;         // most of the blocks are short
+
+struct AnalysisZone
+{
+    uint64 offset;
+    uint64 address;
+    Buffer data;
+};
+
+struct AnalysisEntryPoint
+{
+    uint64 address;
+    uint32 nameOffset; // in FunctionsAnalyzerContext::names
+    uint32 nameSize;
+};
+
+struct AnalyzedFunction
+{
+    uint64 address;
+    uint64 end;
+    uint32 instructionsCount;
+    std::vector<uint64> callees;
+};
+
+struct AnalysisFunction
+{
+    uint64 address;
+    uint64 offset;
+    uint64 size;
+    uint32 instructionsCount;
+    uint32 firstCallee; // in FunctionsAnalyzerContext::callees
+    uint32 calleesCount;
+    uint32 firstCaller; // in FunctionsAnalyzerContext::callers
+    uint32 callersCount;
+    uint32 nameOffset;
+    uint32 nameSize;
+};
+
+// the owner takes functions from the back of its queue, the idle workers steal them from the front
+struct AnalysisWorker
+{
+    std::mutex lock;
+    std::deque<uint64> queue;
+    std::vector<AnalyzedFunction> functions;
+};
+
+struct FunctionsAnalyzerContext
+{
+    std::vector<AnalysisZone> zones;
+    std::vector<AnalysisEntryPoint> entryPoints; // sorted by address once the analysis starts
+    std::string names;
+    std::thread worker;
+    std::atomic<bool> ready{ false };
+    std::atomic<bool> cancel{ false };
+    bool started{ false };
+    bool isX64{ false };
+    bool isLittleEndian{ true };
+
+    // used only during the analysis
+    std::vector<std::unique_ptr<AnalysisWorker>> workers;
+    std::mutex visitedLock;
+    std::unordered_set<uint64> visited; // functions that were already queued
+    std::atomic<uint64> pending{ 0 };   // functions that were queued but not analyzed yet
+
+    // the call graph is kept in two flat arrays (the callees and the callers of a function are consecutive)
+    std::vector<AnalysisFunction> functions; // sorted by address
+    std::vector<uint32> callees;
+    std::vector<uint32> callers;
+};
+
+static const AnalysisZone* FindZone(const FunctionsAnalyzerContext& ctx, uint64 address)
+{
+    for (const auto& zone : ctx.zones)
+    {
+        if ((address >= zone.address) && (address - zone.address < zone.data.GetLength()))
+            return &zone;
+    }
+    return nullptr;
+}
+
+static const AnalysisEntryPoint* FindEntryPoint(const FunctionsAnalyzerContext& ctx, uint64 address)
+{
+    const auto& entryPoints = ctx.entryPoints;
+    const auto it           = std::lower_bound(
+          entryPoints.begin(), entryPoints.end(), address, [](const AnalysisEntryPoint& e, uint64 value) { return e.address < value; });
+    // most of the addresses are not entry points --> not an error
+    if ((it == entryPoints.end()) || (it->address != address))
+        return nullptr;
+    return &(*it);
+}
+
+static bool IsBlockEnd(const InstructionInfo& info)
+{
+    switch (info.id)
+    {
+    case X86_INS_INT3:
+    case X86_INS_HLT:
+    case X86_INS_UD2:
+        return true;
+    }
+    return (info.type == (uint8) Opcodes::FunctionEnd) || (info.type == (uint8) Opcodes::LJmp);
+}
+
+// direct calls create new functions; conditional jumps continue on both branches, jumps only at their destination
+// (unless the destination is another known function --> tail call)
+static void AnalyzeFunction(const FunctionsAnalyzerContext& ctx, DissasemblerIntel& dissasembler, AnalyzedFunction& function)
+{
+    InstructionInfo batch[ANALYSIS_BATCH_SIZE];
+    std::unordered_set<uint64> decoded;
+    std::vector<uint64> blocks{ function.address };
+
+    while ((!blocks.empty()) && (function.instructionsCount < ANALYSIS_MAX_INSTRUCTIONS))
+    {
+        auto address  = blocks.back();
+        auto blockEnd = false;
+        blocks.pop_back();
+
+        while (!blockEnd)
+        {
+            const auto zone = FindZone(ctx, address);
+            if (zone == nullptr)
+                break;
+            const auto index = static_cast<size_t>(address - zone->address);
+            const auto code  = BufferView{ zone->data.GetData() + index, zone->data.GetLength() - index };
+            const auto count = dissasembler.DissasembleInstructions(code, address, batch, ANALYSIS_BATCH_SIZE);
+
+            for (auto i = 0U; (i < count) && (!blockEnd); i++)
+            {
+                const auto& info = batch[i];
+                // invalid code, an instruction that was already reached or a function that is too big
+                if ((info.id == 0) || (function.instructionsCount >= ANALYSIS_MAX_INSTRUCTIONS) || (!decoded.insert(info.address).second))
+                {
+                    blockEnd = true;
+                    break;
+                }
+
+                function.instructionsCount++;
+                function.end = std::max<uint64>(function.end, info.address + info.size);
+                address      = info.address + info.size;
+
+                if (info.type == (uint8) Opcodes::Call)
+                {
+                    if (info.target != 0)
+                        function.callees.push_back(info.target);
+                }
+                else if (info.type == (uint8) Opcodes::Jmp)
+                {
+                    if ((info.target != 0) && (info.target != function.address) && (FindEntryPoint(ctx, info.target) != nullptr))
+                        function.callees.push_back(info.target);
+                    else if (info.target != 0)
+                        blocks.push_back(info.target);
+                    blockEnd = true;
+                }
+                else if (info.isConditionalJump)
+                {
+                    if (info.target != 0)
+                        blocks.push_back(info.target);
+                }
+                else
+                {
+                    blockEnd = IsBlockEnd(info);
+                }
+            }
+            if (count == 0)
+                break;
+        }
+    }
+
+    std::sort(function.callees.begin(), function.callees.end());
+    function.callees.erase(std::unique(function.callees.begin(), function.callees.end()), function.callees.end());
+}
+
+static bool QueueFunction(FunctionsAnalyzerContext& ctx, uint32 workerIndex, uint64 address)
+{
+    // targets outside of the code and the functions that were already queued are skipped (quietly: it happens for most calls)
+    if (FindZone(ctx, address) == nullptr)
+        return false;
+    {
+        std::lock_guard<std::mutex> guard(ctx.visitedLock);
+        if (!ctx.visited.insert(address).second)
+            return false;
+    }
+
+    // counted before it can be taken by another worker
+    ctx.pending.fetch_add(1);
+    auto& worker = *ctx.workers[workerIndex];
+    std::lock_guard<std::mutex> guard(worker.lock);
+    worker.queue.push_back(address);
+    return true;
+}
+
+static bool NextFunction(FunctionsAnalyzerContext& ctx, uint32 workerIndex, uint64& address)
+{
+    const auto workersCount = static_cast<uint32>(ctx.workers.size());
+    for (auto i = 0U; i < workersCount; i++)
+    {
+        auto& worker = *ctx.workers[(workerIndex + i) % workersCount];
+        std::lock_guard<std::mutex> guard(worker.lock);
+        if (worker.queue.empty())
+            continue;
+        if (i == 0)
+        {
+            address = worker.queue.back();
+            worker.queue.pop_back();
+        }
+        else
+        {
+            address = worker.queue.front();
+            worker.queue.pop_front();
+        }
+        return true;
+    }
+    return false;
+}
+
+static void RunWorker(FunctionsAnalyzerContext& ctx, uint32 workerIndex)
+{
+    DissasemblerIntel dissasembler;
+    CHECKRET(dissasembler.Init(ctx.isX64, ctx.isLittleEndian), "");
+
+    uint64 address = 0;
+    while (!ctx.cancel.load(std::memory_order_relaxed))
+    {
+        if (!NextFunction(ctx, workerIndex, address))
+        {
+            // the functions that are still analyzed can queue new ones
+            if (ctx.pending.load() == 0)
+                break;
+            std::this_thread::yield();
+            continue;
+        }
+
+        AnalyzedFunction function{ address, address, 0, {} };
+        AnalyzeFunction(ctx, dissasembler, function);
+        for (const auto callee : function.callees)
+            QueueFunction(ctx, workerIndex, callee);
+        ctx.workers[workerIndex]->functions.push_back(std::move(function));
+        ctx.pending.fetch_sub(1);
+    }
+}
+
+static bool FindFunctionIndex(const FunctionsAnalyzerContext& ctx, uint64 address, uint32& index)
+{
+    const auto it = std::lower_bound(
+          ctx.functions.begin(), ctx.functions.end(), address, [](const AnalysisFunction& f, uint64 value) { return f.address < value; });
+    if ((it == ctx.functions.end()) || (it->address != address))
+        return false;
+    index = static_cast<uint32>(it - ctx.functions.begin());
+    return true;
+}
+
+static void ReadZones(FunctionsAnalyzerContext& ctx, const Utils::DataCache::Reader& reader, const std::vector<ExecutableZone>& zones)
+{
+    for (const auto& zone : zones)
+    {
+        if (ctx.cancel.load())
+            return;
+        if ((zone.size == 0) || (zone.size > ANALYSIS_MAX_ZONE_SIZE))
+            continue;
+
+        AnalysisZone analysisZone{ zone.offset, zone.address, reader.Read(zone.offset, static_cast<uint32>(zone.size)) };
+        if (analysisZone.data.IsValid())
+            ctx.zones.push_back(std::move(analysisZone));
+    }
+}
+
+static void Analyze(FunctionsAnalyzerContext& ctx)
+{
+    const auto workersCount = GView::Utils::GetParallelWorkersCount();
+    for (auto i = 0U; i < workersCount; i++)
+        ctx.workers.push_back(std::make_unique<AnalysisWorker>());
+
+    auto next = 0U;
+    for (const auto& entryPoint : ctx.entryPoints)
+    {
+        if (QueueFunction(ctx, next % workersCount, entryPoint.address))
+            next++;
+    }
+
+    GView::Utils::ParallelFor(workersCount, [&ctx](uint32 index) { RunWorker(ctx, index); });
+    CHECKRET(!ctx.cancel.load(), "");
+
+    std::vector<AnalyzedFunction> analyzed;
+    for (auto& worker : ctx.workers)
+        std::move(worker->functions.begin(), worker->functions.end(), std::back_inserter(analyzed));
+    ctx.workers.clear();
+    ctx.visited.clear();
+    std::sort(analyzed.begin(), analyzed.end(), [](const AnalyzedFunction& a, const AnalyzedFunction& b) { return a.address < b.address; });
+
+    ctx.functions.reserve(analyzed.size());
+    for (const auto& function : analyzed)
+    {
+        const auto zone       = FindZone(ctx, function.address);
+        const auto entryPoint = FindEntryPoint(ctx, function.address);
+
+        AnalysisFunction f{};
+        f.address           = function.address;
+        f.offset            = zone->offset + (function.address - zone->address);
+        f.size              = function.end - function.address;
+        f.instructionsCount = function.instructionsCount;
+        f.nameOffset        = entryPoint ? entryPoint->nameOffset : 0;
+        f.nameSize          = entryPoint ? entryPoint->nameSize : 0;
+        ctx.functions.push_back(f);
+    }
+
+    for (auto i = 0U; i < analyzed.size(); i++)
+    {
+        auto& f       = ctx.functions[i];
+        f.firstCallee = static_cast<uint32>(ctx.callees.size());
+        for (const auto callee : analyzed[i].callees)
+        {
+            uint32 index = 0;
+            if (FindFunctionIndex(ctx, callee, index))
+            {
+                ctx.callees.push_back(index);
+                ctx.functions[index].callersCount++;
+            }
+        }
+        f.calleesCount = static_cast<uint32>(ctx.callees.size()) - f.firstCallee;
+    }
+
+    uint32 firstCaller = 0;
+    for (auto& f : ctx.functions)
+    {
+        f.firstCaller = firstCaller;
+        firstCaller += f.callersCount;
+        f.callersCount = 0; // counted again below, while the callers are added
+    }
+    ctx.callers.resize(ctx.callees.size());
+    for (auto i = 0U; i < ctx.functions.size(); i++)
+    {
+        const auto& f = ctx.functions[i];
+        for (auto j = f.firstCallee; j < f.firstCallee + f.calleesCount; j++)
+        {
+            auto& callee                                        = ctx.functions[ctx.callees[j]];
+            ctx.callers[callee.firstCaller + callee.callersCount] = i;
+            callee.callersCount++;
+        }
+    }
+}
+
+static const FunctionsAnalyzerContext* GetResults(const void* context)
+{
+    const auto ctx = reinterpret_cast<const FunctionsAnalyzerContext*>(context);
+    CHECK(ctx->ready.load(std::memory_order_acquire), nullptr, "");
+    return ctx;
+}
+
+FunctionsAnalyzer::FunctionsAnalyzer()
+{
+    context = new FunctionsAnalyzerContext;
+}
+
+FunctionsAnalyzer::~FunctionsAnalyzer()
+{
+    auto ctx = reinterpret_cast<FunctionsAnalyzerContext*>(context);
+    ctx->cancel.store(true);
+    if (ctx->worker.joinable())
+        ctx->worker.join();
+    delete ctx;
+    context = nullptr;
+}
+
+bool FunctionsAnalyzer::AddEntryPoint(uint64 address, std::string_view name)
+{
+    auto ctx = reinterpret_cast<FunctionsAnalyzerContext*>(context);
+    CHECK(!ctx->started, false, "Already started !");
+    ctx->entryPoints.push_back({ address, static_cast<uint32>(ctx->names.size()), static_cast<uint32>(name.size()) });
+    ctx->names.append(name);
+    return true;
+}
+
+bool FunctionsAnalyzer::Start(Utils::DataCache& cache, const std::vector<ExecutableZone>& zones, bool isx64, bool isLittleEndian)
+{
+    auto ctx = reinterpret_cast<FunctionsAnalyzerContext*>(context);
+    CHECK(!ctx->started, false, "Already started !");
+    ctx->started        = true;
+    ctx->isX64          = isx64;
+    ctx->isLittleEndian = isLittleEndian;
+
+    // the first name that was added for an address is kept
+    std::stable_sort(ctx->entryPoints.begin(), ctx->entryPoints.end(), [](const AnalysisEntryPoint& a, const AnalysisEntryPoint& b) {
+        return a.address < b.address;
+    });
+
+    auto reader = cache.GetReader();
+    CHECK(reader.IsValid(), false, "");
+    ctx->worker = std::thread([ctx, reader, zones]() {
+        ReadZones(*ctx, reader, zones);
+        Analyze(*ctx);
+        ctx->ready.store(!ctx->cancel.load(), std::memory_order_release);
+    });
+    return true;
+}
+
+bool FunctionsAnalyzer::IsStarted() const
+{
+    return reinterpret_cast<FunctionsAnalyzerContext*>(context)->started;
+}
+
+bool FunctionsAnalyzer::IsReady() const
+{
+    return reinterpret_cast<FunctionsAnalyzerContext*>(context)->ready.load(std::memory_order_acquire);
+}
+
+uint32 FunctionsAnalyzer::GetFunctionsCount() const
+{
+    const auto ctx = GetResults(context);
+    CHECK(ctx != nullptr, 0, "");
+    return static_cast<uint32>(ctx->functions.size());
+}
+
+bool FunctionsAnalyzer::GetFunction(uint32 index, FunctionInfo& info) const
+{
+    const auto ctx = GetResults(context);
+    CHECK(ctx != nullptr, false, "");
+    CHECK(index < ctx->functions.size(), false, "");
+
+    const auto& f          = ctx->functions[index];
+    info.address           = f.address;
+    info.offset            = f.offset;
+    info.size              = f.size;
+    info.instructionsCount = f.instructionsCount;
+    info.callersCount      = f.callersCount;
+    info.calleesCount      = f.calleesCount;
+    info.name              = std::string_view{ ctx->names }.substr(f.nameOffset, f.nameSize);
+    return true;
+}
+
+bool FunctionsAnalyzer::FindFunction(uint64 address, uint32& index) const
+{
+    const auto ctx = GetResults(context);
+    CHECK(ctx != nullptr, false, "");
+    return FindFunctionIndex(*ctx, address, index);
+}
+
+bool FunctionsAnalyzer::GetCallees(uint32 index, std::vector<uint32>& output) const
+{
+    const auto ctx = GetResults(context);
+    CHECK(ctx != nullptr, false, "");
+    CHECK(index < ctx->functions.size(), false, "");
+
+    const auto& f = ctx->functions[index];
+    output.assign(ctx->callees.begin() + f.firstCallee, ctx->callees.begin() + f.firstCallee + f.calleesCount);
+    return true;
+}
+
+bool FunctionsAnalyzer::GetCallers(uint32 index, std::vector<uint32>& output) const
+{
+    const auto ctx = GetResults(context);
+    CHECK(ctx != nullptr, false, "");
+    CHECK(index < ctx->functions.size(), false, "");
+
+    const auto& f = ctx->functions[index];
+    output.assign(ctx->callers.begin() + f.firstCaller, ctx->callers.begin() + f.firstCaller + f.callersCount);
+    return true;
+}
+} // namespace GView::Dissasembly
@@ -0,0 +1,313 @@
+#include "Internal.hpp"
+
+#include <atomic>
+#include <bit>
+#include <thread>
+
+namespace GView::Dissasembly
+{
+constexpr uint64 SWEEP_SHARD_SIZE    = 0x100000;   // 1 MB (a multiple of 64 --> every shard owns whole words of the bitmap)
+constexpr uint64 SWEEP_MAX_ZONE_SIZE = 0x10000000; // bigger zones are not pre-decoded
+constexpr uint32 SWEEP_WINDOW        = 16;
+constexpr uint32 SWEEP_BATCH_SIZE    = 256; // instructions decoded at once
+
+struct SweepEntry
+{
+    uint64 offset;
+    uint8 type;
+    uint8 size;
+};
+
+struct SweepZone
+{
+    uint64 start{ 0 };
+    uint64 end{ 0 };
+    Buffer data;                     // released after the zone is swept
+    std::vector<uint64> starts;      // one bit for every byte of the zone
+    std::vector<SweepEntry> entries; // highlighted instructions (sorted by offset)
+};
+
+struct SweepShard
+{
+    uint32 zone;
+    uint64 start; // relative to the start of the zone
+    uint64 end;
+    uint64 exit; // where the first instruction after the shard starts
+    std::vector<SweepEntry> entries;
+};
+
+struct LinearSweepContext
+{
+    std::vector<SweepZone> zones;
+    std::thread worker;
+    std::atomic<bool> ready{ false };
+    std::atomic<bool> cancel{ false };
+    bool started{ false };
+    bool isX64{ false };
+    bool isLittleEndian{ true };
+    uint64 instructionsCount{ 0 };
+};
+
+static inline bool TestBit(const std::vector<uint64>& bits, uint64 index)
+{
+    return (bits[index >> 6] >> (index & 63)) & 1ULL;
+}
+
+static inline void SetBit(std::vector<uint64>& bits, uint64 index)
+{
+    bits[index >> 6] |= 1ULL << (index & 63);
+}
+
+static inline void ClearBit(std::vector<uint64>& bits, uint64 index)
+{
+    bits[index >> 6] &= ~(1ULL << (index & 63));
+}
+
+// decodes the instructions that start in [position, end) --> returns where the first instruction after the range starts
+// 'callback' can stop the sweep (the instruction it received is not consumed)
+template <typename Callback>
+static uint64 SweepRange(
+      DissasemblerIntel& dissasembler,
+      const SweepZone& zone,
+      uint64 position,
+      uint64 end,
+      const std::atomic<bool>& cancel,
+      Callback&& callback)
+{
+    InstructionInfo batch[SWEEP_BATCH_SIZE];
+    while (position < end)
+    {
+        if (cancel.load(std::memory_order_relaxed))
+            break;
+
+        // the instructions that start at the end of the range use a few bytes from after it
+        const auto available = std::min<uint64>(zone.data.GetLength(), end + SWEEP_WINDOW * 2) - position;
+        const auto count     = dissasembler.DissasembleInstructions(
+              { zone.data.GetData() + position, static_cast<size_t>(available) }, zone.start + position, batch, SWEEP_BATCH_SIZE);
+        CHECK(count > 0, position, "");
+
+        for (auto i = 0U; (i < count) && (position < end); i++)
+        {
+            const auto& info   = batch[i];
+            auto highlightSize = static_cast<uint32>(info.size);
+            if (info.type == (uint8) Opcodes::FunctionStart)
+            {
+                // the second instruction of the prologue is highlighted as well (if it is not part of this batch, the next one starts here)
+                if (i + 1 == count)
+                    break;
+                highlightSize += batch[i + 1].size;
+            }
+            if (!callback(position, info, highlightSize))
+                return position;
+            position += info.size;
+        }
+    }
+    return position;
+}
+
+static void SweepShardRange(DissasemblerIntel& dissasembler, SweepZone& zone, SweepShard& shard, const std::atomic<bool>& cancel)
+{
+    const auto onInstruction = [&](uint64 offset, const InstructionInfo& info, uint32 highlightSize) {
+        if (info.id != 0)
+        {
+            SetBit(zone.starts, offset);
+            if (info.type != 0)
+                shard.entries.push_back({ zone.start + offset, static_cast<uint8>(info.type), static_cast<uint8>(highlightSize) });
+        }
+        return true;
+    };
+    shard.exit = SweepRange(dissasembler, zone, shard.start, shard.end, cancel, onInstruction);
+}
+
+// every shard was decoded from its first byte, but the real instruction stream enters the shard at 'entry'
+// x86 decoding synchronizes itself: after a few instructions both streams usually reach the same instruction start
+static void ResyncShard(DissasemblerIntel& dissasembler, SweepZone& zone, SweepShard& shard, uint64 entry, const std::atomic<bool>& cancel)
+{
+    std::vector<uint64> newStarts;
+    std::vector<SweepEntry> newEntries;
+    const auto onInstruction = [&](uint64 offset, const InstructionInfo& info, uint32 highlightSize) {
+        if (TestBit(zone.starts, offset))
+            return false; // synchronized
+        if (info.id != 0)
+        {
+            newStarts.push_back(offset);
+            if (info.type != 0)
+                newEntries.push_back({ zone.start + offset, static_cast<uint8>(info.type), static_cast<uint8>(highlightSize) });
+        }
+        return true;
+    };
+    const auto position = SweepRange(dissasembler, zone, entry, shard.end, cancel, onInstruction);
+
+    // the instructions decoded before the synchronization point are not part of the stream
+    const auto syncPoint = std::min<uint64>(position, shard.end);
+    for (auto index = shard.start; index < syncPoint; index++)
+        ClearBit(zone.starts, index);
+    for (const auto index : newStarts)
+        SetBit(zone.starts, index);
+
+    auto it = shard.entries.begin();
+    while ((it != shard.entries.end()) && (it->offset < zone.start + syncPoint))
+        it++;
+    shard.entries.erase(shard.entries.begin(), it);
+    shard.entries.insert(shard.entries.begin(), newEntries.begin(), newEntries.end());
+
+    if (position >= shard.end)
+        shard.exit = position; // never synchronized
+}
+
+static void Sweep(LinearSweepContext& ctx)
+{
+    std::vector<SweepShard> shards;
+    for (auto zoneIndex = 0U; zoneIndex < ctx.zones.size(); zoneIndex++)
+    {
+        const auto length = ctx.zones[zoneIndex].data.GetLength();
+        for (uint64 start = 0; start < length; start += SWEEP_SHARD_SIZE)
+            shards.push_back({ zoneIndex, start, std::min<uint64>(start + SWEEP_SHARD_SIZE, length), 0, {} });
+    }
+
+    GView::Utils::ParallelFor(static_cast<uint32>(shards.size()), [&](uint32 index) {
+        DissasemblerIntel dissasembler;
+        CHECKRET(dissasembler.Init(ctx.isX64, ctx.isLittleEndian), "");
+        auto& shard = shards[index];
+        SweepShardRange(dissasembler, ctx.zones[shard.zone], shard, ctx.cancel);
+    });
+    CHECKRET(!ctx.cancel.load(), "");
+
+    // the shards are joined in order (the exit of a shard is the entry of the next one)
+    DissasemblerIntel dissasembler;
+    CHECKRET(dissasembler.Init(ctx.isX64, ctx.isLittleEndian), "");
+    for (auto index = 0U; index < shards.size(); index++)
+    {
+        auto& shard = shards[index];
+        auto& zone  = ctx.zones[shard.zone];
+        if ((index > 0) && (shards[index - 1].zone == shard.zone))
+        {
+            const auto entry = shards[index - 1].exit;
+            if ((entry >= shard.end) || (!TestBit(zone.starts, entry)))
+                ResyncShard(dissasembler, zone, shard, entry, ctx.cancel);
+        }
+        zone.entries.insert(zone.entries.end(), shard.entries.begin(), shard.entries.end());
+
+        // the last shard of the zone --> only the bitmap and the entries are needed from now on
+        if ((index + 1 == shards.size()) || (shards[index + 1].zone != shard.zone))
+            zone.data = Buffer();
+    }
+
+    for (const auto& zone : ctx.zones)
+        for (const auto word : zone.starts)
+            ctx.instructionsCount += std::popcount(word);
+}
+
+static void ReadZones(LinearSweepContext& ctx, const Utils::DataCache::Reader& reader, const std::vector<std::pair<uint64, uint64>>& zones)
+{
+    for (const auto& [start, end] : zones)
+    {
+        if (ctx.cancel.load())
+            return;
+        if ((end <= start) || (end - start > SWEEP_MAX_ZONE_SIZE))
+            continue;
+
+        SweepZone zone;
+        zone.data = reader.Read(start, static_cast<uint32>(end - start));
+        if (!zone.data.IsValid())
+            continue;
+        zone.start = start;
+        zone.end   = start + zone.data.GetLength();
+        zone.starts.resize((zone.data.GetLength() + 63) / 64);
+        ctx.zones.push_back(std::move(zone));
+    }
+}
+
+// called for every colored byte --> no logging while the sweep is still running
+static const SweepZone* FindZone(const LinearSweepContext* ctx, uint64 offset)
+{
+    if (!ctx->ready.load(std::memory_order_acquire))
+        return nullptr;
+    for (const auto& zone : ctx->zones)
+    {
+        if ((offset >= zone.start) && (offset < zone.end))
+            return &zone;
+    }
+    return nullptr;
+}
+
+LinearSweepDecoder::LinearSweepDecoder()
+{
+    context = new LinearSweepContext;
+}
+
+LinearSweepDecoder::~LinearSweepDecoder()
+{
+    auto ctx = reinterpret_cast<LinearSweepContext*>(context);
+    ctx->cancel.store(true);
+    if (ctx->worker.joinable())
+        ctx->worker.join();
+    delete ctx;
+    context = nullptr;
+}
+
+bool LinearSweepDecoder::Start(
+      Utils::DataCache& cache, const std::vector<std::pair<uint64, uint64>>& zones, bool isx64, bool isLittleEndian)
+{
+    auto ctx = reinterpret_cast<LinearSweepContext*>(context);
+    CHECK(!ctx->started, false, "Already started !");
+    ctx->started        = true;
+    ctx->isX64          = isx64;
+    ctx->isLittleEndian = isLittleEndian;
+
+    auto reader = cache.GetReader();
+    CHECK(reader.IsValid(), false, "");
+    ctx->worker = std::thread([ctx, reader, zones]() {
+        ReadZones(*ctx, reader, zones);
+        Sweep(*ctx);
+        ctx->ready.store(!ctx->cancel.load(), std::memory_order_release);
+    });
+    return true;
+}
+
+bool LinearSweepDecoder::IsStarted() const
+{
+    return reinterpret_cast<LinearSweepContext*>(context)->started;
+}
+
+bool LinearSweepDecoder::IsReady() const
+{
+    return reinterpret_cast<LinearSweepContext*>(context)->ready.load(std::memory_order_acquire);
+}
+
+uint64 LinearSweepDecoder::GetInstructionsCount() const
+{
+    CHECK(IsReady(), 0, "");
+    return reinterpret_cast<LinearSweepContext*>(context)->instructionsCount;
+}
+
+bool LinearSweepDecoder::IsInstructionStart(uint64 offset, bool& isStart) const
+{
+    const auto zone = FindZone(reinterpret_cast<LinearSweepContext*>(context), offset);
+    if (zone == nullptr)
+        return false;
+    isStart = TestBit(zone->starts, offset - zone->start);
+    return true;
+}
+
+bool LinearSweepDecoder::GetInstruction(uint64 offset, uint32& type, uint32& size) const
+{
+    const auto zone = FindZone(reinterpret_cast<LinearSweepContext*>(context), offset);
+    if (zone == nullptr)
+        return false;
+
+    type = 0;
+    size = 0;
+    if (!TestBit(zone->starts, offset - zone->start))
+        return true;
+
+    const auto it = std::lower_bound(
+          zone->entries.begin(), zone->entries.end(), offset, [](const SweepEntry& entry, uint64 value) { return entry.offset < value; });
+    if ((it != zone->entries.end()) && (it->offset == offset))
+    {
+        type = it->type;
+        size = it->size;
+    }
+    return true;
+}
+} // namespace GView::Dissasembly
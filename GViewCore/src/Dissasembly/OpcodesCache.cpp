@@ -0,0 +1,118 @@
+#include "Internal.hpp"
+
+#include <unordered_map>
+
+namespace GView::Dissasembly
+{
+constexpr uint32 OPCODES_PAGE_SIZE  = 0x1000;
+constexpr uint32 OPCODES_MAX_PAGES  = 64; // 512 KB for each opened file
+constexpr uint32 INSTRUCTION_WINDOW = 16; // bytes available to the dissasembler for every offset
+
+struct OpcodesPage
+{
+    uint64 start{ 0 };
+    uint64 lastUsed{ 0 };
+    uint8 types[OPCODES_PAGE_SIZE]{};
+    uint8 sizes[OPCODES_PAGE_SIZE]{};
+};
+
+struct OpcodesCacheContext
+{
+    std::vector<std::unique_ptr<OpcodesPage>> pages;
+    std::unordered_map<uint64, uint32> pagesIndexes; // page start -> index in pages
+    OpcodesPage* lastPage{ nullptr };
+    uint64 usageCounter{ 0 };
+};
+
+static void DecodePage(DissasemblerIntel& dissasembler, BufferView view, OpcodesPage& page)
+{
+    const auto length = static_cast<uint32>(std::min<uint64>(view.GetLength(), OPCODES_PAGE_SIZE));
+    memset(page.types, 0, sizeof(page.types));
+    memset(page.sizes, 0, sizeof(page.sizes));
+
+    for (auto i = 0U; i < length; i++)
+    {
+        const auto available = std::min<uint32>(INSTRUCTION_WINDOW, static_cast<uint32>(view.GetLength()) - i);
+        ClassifiedInstruction ci{};
+        if (ClassifyInstruction(dissasembler, { view.GetData() + i, available }, page.start + i, ci) && (ci.type != 0))
+        {
+            page.types[i] = static_cast<uint8>(ci.type);
+            page.sizes[i] = static_cast<uint8>(ci.highlightSize);
+        }
+    }
+}
+
+OpcodesCache::OpcodesCache()
+{
+    context = new OpcodesCacheContext;
+}
+
+OpcodesCache::~OpcodesCache()
+{
+    delete reinterpret_cast<OpcodesCacheContext*>(context);
+    context = nullptr;
+}
+
+void OpcodesCache::Clear()
+{
+    auto ctx = reinterpret_cast<OpcodesCacheContext*>(context);
+    ctx->pages.clear();
+    ctx->pagesIndexes.clear();
+    ctx->lastPage     = nullptr;
+    ctx->usageCounter = 0;
+}
+
+bool OpcodesCache::Get(DissasemblerIntel& dissasembler, Utils::DataCache& cache, uint64 offset, uint32& type, uint32& size)
+{
+    CHECK(context != nullptr, false, "");
+    auto ctx             = reinterpret_cast<OpcodesCacheContext*>(context);
+    const auto pageStart = offset & ~static_cast<uint64>(OPCODES_PAGE_SIZE - 1);
+
+    auto page = ctx->lastPage;
+    if ((page == nullptr) || (page->start != pageStart))
+    {
+        const auto it = ctx->pagesIndexes.find(pageStart);
+        if (it != ctx->pagesIndexes.end())
+        {
+            page = ctx->pages[it->second].get();
+        }
+        else
+        {
+            // the instructions that start at the end of the page need the bytes from the next one
+            // (the cached window is not moved: the viewer that requested the color still uses it)
+            const auto view = cache.CopyUncached(pageStart, OPCODES_PAGE_SIZE + INSTRUCTION_WINDOW);
+            CHECK(view.IsValid(), false, "");
+
+            uint32 index = 0;
+            if (ctx->pages.size() < OPCODES_MAX_PAGES)
+            {
+                index = static_cast<uint32>(ctx->pages.size());
+                ctx->pages.emplace_back(std::make_unique<OpcodesPage>());
+            }
+            else
+            {
+                // evict the least recently used page
+                for (auto i = 1U; i < ctx->pages.size(); i++)
+                {
+                    if (ctx->pages[i]->lastUsed < ctx->pages[index]->lastUsed)
+                        index = i;
+                }
+                ctx->pagesIndexes.erase(ctx->pages[index]->start);
+            }
+
+            page        = ctx->pages[index].get();
+            page->start = pageStart;
+            DecodePage(dissasembler, view, *page);
+            ctx->pagesIndexes[pageStart] = index;
+        }
+
+        page->lastUsed = ++ctx->usageCounter;
+        ctx->lastPage  = page;
+    }
+
+    const auto position = static_cast<uint32>(offset - pageStart);
+    type                = page->types[position];
+    size                = page->sizes[position];
+    return true;
+}
+} // namespace GView::Dissasembly
@@ -17,6 +17,74 @@ const char* GetNameForGoMagic(GoMagic magic)
     }
 }
 
+constexpr uint32 PCLNTAB_MAX_ENTRIES = 0xA00000; // sanity checks for invalid sigs
+
+std::vector<uint64> FindPcLnTabSigsCandidates(Utils::DataCache& cache, const std::vector<std::pair<uint64, uint64>>& ranges)
+{
+    // the magic (little and big endian) followed by the padding of the header
+    constexpr std::string_view pclntabSigs[6]{ { "\xFB\xFF\xFF\xFF\x00\x00", 6 }, { "\xFA\xFF\xFF\xFF\x00\x00", 6 },
+                                               { "\xF0\xFF\xFF\xFF\x00\x00", 6 }, { "\xFF\xFF\xFF\xFB\x00\x00", 6 },
+                                               { "\xFF\xFF\xFF\xFA\x00\x00", 6 }, { "\xFF\xFF\xFF\xF0\x00\x00", 6 } };
+
+    Utils::PatternScanner scanner;
+    for (auto i = 0U; i < ARRAY_LEN(pclntabSigs); i++)
+    {
+        scanner.AddPattern({ reinterpret_cast<const uint8*>(pclntabSigs[i].data()), pclntabSigs[i].size() }, i);
+    }
+
+    std::vector<uint64> candidates;
+    candidates.reserve(10); // usually not that many sigs found matching
+    const auto onMatch = [&candidates](uint64 offset, uint32) {
+        candidates.push_back(offset);
+        return true;
+    };
+    for (const auto& [start, end] : ranges)
+    {
+        if (end > start)
+            scanner.Scan(cache, start, end - start, onMatch);
+    }
+
+    return candidates;
+}
+
+bool IsValidPcLnTabHeader(BufferView header, Architecture arch)
+{
+    constexpr auto hSize = sizeof(Golang::GoFunctionHeader);
+    CHECK(header.IsValid() && header.GetLength() >= hSize, false, "");
+    CHECK(arch != Architecture::Unknown, false, "");
+
+    const auto h = reinterpret_cast<const GoFunctionHeader*>(header.GetData());
+    CHECK(h->magic == GoMagic::_116 || h->magic == GoMagic::_118 || h->magic == GoMagic::_12, false, "");
+    CHECK(h->padding == 0, false, "");
+    CHECK(h->instructionSizeQuantum == 1 || h->instructionSizeQuantum == 2 || h->instructionSizeQuantum == 4, false, "");
+    CHECK(h->sizeOfUintptr == (arch == Architecture::x64 ? 8 : 4), false, "");
+
+    // nfunctab [, nfiletab, (textStart), funcnametab, cutab, filetab, pctab, functab]
+    const auto fieldsCount = h->magic == GoMagic::_12 ? 1U : (h->magic == GoMagic::_116 ? 7U : 8U);
+    CHECK(header.GetLength() >= hSize + fieldsCount * h->sizeOfUintptr, false, "");
+    const auto field = [&header, h](uint32 index) -> uint64 {
+        const auto p = header.GetData() + hSize + index * h->sizeOfUintptr;
+        return h->sizeOfUintptr == 8 ? *reinterpret_cast<const uint64*>(p) : *reinterpret_cast<const uint32*>(p);
+    };
+
+    CHECK(field(0) < PCLNTAB_MAX_ENTRIES, false, "");
+    if (h->magic != GoMagic::_12)
+    {
+        CHECK(field(1) < PCLNTAB_MAX_ENTRIES, false, "");
+
+        // the tables follow the header in this order
+        auto previous = static_cast<uint64>(hSize + fieldsCount * h->sizeOfUintptr);
+        for (auto i = (h->magic == GoMagic::_116 ? 2U : 3U); i < fieldsCount; i++)
+        {
+            const auto offset = field(i);
+            CHECK(offset >= previous, false, "");
+            previous = offset;
+        }
+    }
+
+    return true;
+}
+
 struct PcLnTabContext
 {
     Buffer buffer{};
@@ -29,16 +97,14 @@ struct PcLnTabContext
     uint8* funcnametab{ nullptr };
     uint8* functab{ nullptr };
     uint8* pctab{ nullptr };
-    int32 functabsize{ 0 };
-    uint32 fileoff{ 0 };
+    uint32 functabFieldSize{ 0 }; // a (pc, function offset) pair of functab uses 2 fields
+    uint64 textStart{ 0 };        // Go 1.18+: the pcs of functab are relative to it
     uint8* filetab{ nullptr };
     uint8* cutab{ nullptr };
     uint32 nfiletab{ 0 };
 
-    std::vector<std::string_view> files;
-    std::vector<FstEntry32*> entries32;
-    std::vector<FstEntry64*> entries64;
-    std::vector<Function> functions;
+    // Go 1.16+ stores the file names one after another --> their offsets are found the first time a file is requested
+    std::vector<uint32> filesOffsets;
 
     bool processed{ false };
 
@@ -47,6 +113,162 @@ struct PcLnTabContext
     std::string runtimeBuildModInfo{ "UNKNOWN" }; // this gets set from outside
 };
 
+// every value is read from the retained buffer (an invalid table can not make a read go past its end)
+static bool ReadValue(const PcLnTabContext& ctx, const uint8* p, uint32 size, uint64& value)
+{
+    const auto data = ctx.buffer.GetData();
+    CHECK(p >= data && p + size <= data + ctx.buffer.GetLength(), false, "");
+    if (size == 8)
+    {
+        memcpy(&value, p, sizeof(uint64));
+    }
+    else
+    {
+        uint32 result = 0;
+        memcpy(&result, p, sizeof(uint32));
+        value = result;
+    }
+    return true;
+}
+
+static bool ReadString(const PcLnTabContext& ctx, const uint8* p, std::string_view& text)
+{
+    const auto data = ctx.buffer.GetData();
+    const auto end  = data + ctx.buffer.GetLength();
+    CHECK(p >= data && p < end, false, "");
+    const auto zero = reinterpret_cast<const uint8*>(memchr(p, 0, end - p));
+    CHECK(zero != nullptr, false, "");
+    text = { reinterpret_cast<const char*>(p), static_cast<size_t>(zero - p) };
+    return true;
+}
+
+static bool ReadVarint(const PcLnTabContext& ctx, const uint8*& p, uint32& value)
+{
+    const auto end = ctx.buffer.GetData() + ctx.buffer.GetLength();
+    value          = 0;
+    for (uint32 shift = 0; shift < 35; shift += 7)
+    {
+        CHECK(p < end, false, "");
+        const auto b = *p++;
+        value |= static_cast<uint32>(b & 0x7F) << shift;
+        if ((b & 0x80) == 0)
+            return true;
+    }
+    return false;
+}
+
+// the pc where the index-th function starts (index == nfunctab is the end of the last function)
+static bool GetFunctionPc(const PcLnTabContext& ctx, uint64 index, uint64& pc)
+{
+    CHECK(ReadValue(ctx, ctx.functab + 2 * index * ctx.functabFieldSize, ctx.functabFieldSize, pc), false, "");
+    if (ctx.header->magic == GoMagic::_118)
+        pc += ctx.textStart;
+    return true;
+}
+
+static bool GetFunctionData(const PcLnTabContext& ctx, uint64 index, uint8*& data)
+{
+    uint64 offset = 0;
+    CHECK(index < ctx.nfunctab, false, "");
+    CHECK(ReadValue(ctx, ctx.functab + (2 * index + 1) * ctx.functabFieldSize, ctx.functabFieldSize, offset), false, "");
+    data = ctx.funcdata + offset;
+    return true;
+}
+
+// the n-th (n >= 1) field of a _func structure: 1 = name, 2 = args, 3 = frame (deferreturn), 4 = pcsp, 5 = pcfile, 6 = pcln, 7 = npcdata,
+// 8 = nfuncdata (Go 1.2) or cuOffset (Go 1.16+), 9 = nfuncdata (Go 1.16+); the first one (entry) is a pointer (Go 1.18+: 4 bytes)
+static bool ReadFunctionField(const PcLnTabContext& ctx, const uint8* function, uint32 n, uint32& value)
+{
+    const auto entrySize = ctx.header->magic == GoMagic::_118 ? 4U : ctx.header->sizeOfUintptr;
+    uint64 result        = 0;
+    CHECK(ReadValue(ctx, function + entrySize + (n - 1) * 4, 4, result), false, "");
+    value = static_cast<uint32>(result);
+    return true;
+}
+
+static bool DecodeFunction(const PcLnTabContext& ctx, uint64 index, Function& func)
+{
+    uint8* data = nullptr;
+    CHECK(GetFunctionData(ctx, index, data), false, "");
+
+    uint64 entry = 0;
+    CHECK(ReadValue(ctx, data, ctx.header->magic == GoMagic::_118 ? 4U : ctx.header->sizeOfUintptr, entry), false, "");
+    uint32 fields[9]{};
+    for (auto n = 1U; n <= (ctx.header->magic == GoMagic::_12 ? 8U : 9U); n++)
+    {
+        CHECK(ReadFunctionField(ctx, data, n, fields[n - 1]), false, "");
+    }
+
+    std::string_view name;
+    CHECK(ReadString(ctx, ctx.funcnametab + fields[0], name), false, "");
+
+    func.name           = const_cast<char*>(name.data());
+    func.func.entry     = ctx.header->magic == GoMagic::_118 ? ctx.textStart + entry : entry;
+    func.func.name      = static_cast<int32>(fields[0]);
+    func.func.args      = static_cast<int32>(fields[1]);
+    func.func.frame     = static_cast<int32>(fields[2]);
+    func.func.pcsp      = static_cast<int32>(fields[3]);
+    func.func.pcfile    = static_cast<int32>(fields[4]);
+    func.func.pcln      = static_cast<int32>(fields[5]);
+    func.func.npcdata   = static_cast<int32>(fields[6]);
+    // 1.2: a whole int32 field; 1.16+: the last byte of the funcID/flag/nfuncdata word
+    func.func.nfuncdata = static_cast<int32>(ctx.header->magic == GoMagic::_12 ? fields[7] : (fields[8] >> 24));
+
+    const auto entryField = ctx.functab + 2 * index * ctx.functabFieldSize;
+    if (ctx.functabFieldSize == 4)
+        func.fstEntry._32 = reinterpret_cast<FstEntry32*>(entryField);
+    else
+        func.fstEntry._64 = reinterpret_cast<FstEntry64*>(entryField);
+    return true;
+}
+
+// walks a pc-value table (https://go.dev/src/debug/gosym/pclntab.go) --> 'onValue(start, end, value)' can stop the walk
+template <typename Callback>
+static bool WalkPcTable(const PcLnTabContext& ctx, uint32 offset, uint64 entry, Callback&& onValue)
+{
+    const auto data = ctx.buffer.GetData();
+    const uint8* p  = ctx.pctab + offset;
+    CHECK(p >= data && p < data + ctx.buffer.GetLength(), false, "");
+
+    uint64 pc   = entry;
+    int32 value = -1;
+    for (auto first = true;; first = false)
+    {
+        uint32 valueDelta = 0;
+        uint32 pcDelta    = 0;
+        CHECK(ReadVarint(ctx, p, valueDelta), false, "");
+        if ((valueDelta == 0) && (!first))
+            break;
+        CHECK(ReadVarint(ctx, p, pcDelta), false, "");
+
+        value += static_cast<int32>((valueDelta & 1) != 0 ? ~(valueDelta >> 1) : (valueDelta >> 1));
+        const auto end = pc + static_cast<uint64>(pcDelta) * ctx.header->instructionSizeQuantum;
+        if (!onValue(pc, end, value))
+            break;
+        pc = end;
+    }
+    return true;
+}
+
+static bool GetFileName(const PcLnTabContext& ctx, const uint8* function, int32 fileIndex, std::string_view& file)
+{
+    uint64 offset = 0;
+    if (ctx.header->magic == GoMagic::_12)
+    {
+        CHECK(fileIndex > 0, false, "");
+        CHECK(ReadValue(ctx, ctx.filetab + 4ULL * fileIndex, 4, offset), false, "");
+        return ReadString(ctx, ctx.buffer.GetData() + offset, file);
+    }
+
+    // Go 1.16+: the file index is relative to the compilation unit of the function
+    uint32 cuOffset = 0;
+    CHECK(fileIndex >= 0, false, "");
+    CHECK(ReadFunctionField(ctx, function, 8, cuOffset), false, "");
+    CHECK(ReadValue(ctx, ctx.cutab + 4ULL * (static_cast<uint64>(cuOffset) + fileIndex), 4, offset), false, "");
+    CHECK(offset != 0xFFFFFFFF, false, "");
+    return ReadString(ctx, ctx.filetab + offset, file);
+}
+
 PcLnTab::PcLnTab()
 {
     context = new PcLnTabContext;
@@ -67,207 +289,83 @@ bool PcLnTab::Process(const Buffer& buffer, Architecture arch)
 {
     CHECK(context != nullptr, false, "");
     CHECK(buffer.IsValid(), false, "");
-    CHECK(buffer.GetLength() > sizeof(Golang::GoFunctionHeader), false, "");
-    CHECK(arch != Architecture::Unknown, false, "");
+    CHECK(IsValidPcLnTabHeader({ buffer.GetData(), buffer.GetLength() }, arch), false, "");
 
     auto goCtx = reinterpret_cast<PcLnTabContext*>(this->context);
     CHECK(goCtx->processed == false, false, "");
     goCtx->buffer = buffer;
     goCtx->arch   = arch;
+    goCtx->filesOffsets.clear();
 
-    goCtx->header = reinterpret_cast<Golang::GoFunctionHeader*>(goCtx->buffer.GetData());
-    // data validation
-    CHECK(goCtx->header->magic == GoMagic::_116 || goCtx->header->magic == GoMagic::_118 || goCtx->header->magic == GoMagic::_12,
-          false,
-          "");
-    CHECK(goCtx->header->instructionSizeQuantum <= 4, false, "");
-    CHECK(goCtx->header->sizeOfUintptr <= 8, false, "");
-
+    // only the header is decoded here, the functions and the files are decoded when they are requested
     const auto data      = goCtx->buffer.GetData();
+    const auto size      = goCtx->buffer.GetLength();
     constexpr auto hSize = sizeof(Golang::GoFunctionHeader);
+    goCtx->header        = reinterpret_cast<Golang::GoFunctionHeader*>(data);
+    const auto field     = [goCtx, data](uint32 index) {
+        uint64 value = 0;
+        ReadValue(*goCtx, data + hSize + index * goCtx->header->sizeOfUintptr, goCtx->header->sizeOfUintptr, value);
+        return value;
+    };
+    const auto table = [data, size](uint64 offset) { return offset < size ? data + offset : nullptr; };
+
     switch (goCtx->header->magic) // functabsize = sizeOfUintptr when version <= 118 else 4
     {
     case GoMagic::_116:
-        goCtx->nfunctab    = *reinterpret_cast<uint32*>(data + hSize);
-        goCtx->nfiletab    = *reinterpret_cast<uint32*>(data + hSize + 1 * goCtx->header->sizeOfUintptr);
-        goCtx->funcnametab = data + *reinterpret_cast<uint32*>(data + hSize + 2 * goCtx->header->sizeOfUintptr);
-        goCtx->cutab       = data + *reinterpret_cast<uint32*>(data + hSize + 3 * goCtx->header->sizeOfUintptr);
-        goCtx->filetab     = data + *reinterpret_cast<uint32*>(data + hSize + 4 * goCtx->header->sizeOfUintptr);
-        goCtx->pctab       = data + *reinterpret_cast<uint32*>(data + hSize + 5 * goCtx->header->sizeOfUintptr);
-        goCtx->funcdata    = data + *reinterpret_cast<uint32*>(data + hSize + 6 * goCtx->header->sizeOfUintptr);
-        goCtx->functab     = data + *reinterpret_cast<uint32*>(data + hSize + 6 * goCtx->header->sizeOfUintptr);
-        goCtx->functabsize = (goCtx->nfunctab * 2 + 1) * goCtx->header->sizeOfUintptr;
+        goCtx->nfunctab         = static_cast<uint32>(field(0));
+        goCtx->nfiletab         = static_cast<uint32>(field(1));
+        goCtx->funcnametab      = table(field(2));
+        goCtx->cutab            = table(field(3));
+        goCtx->filetab          = table(field(4));
+        goCtx->pctab            = table(field(5));
+        goCtx->funcdata         = table(field(6));
+        goCtx->functab          = table(field(6));
+        goCtx->functabFieldSize = goCtx->header->sizeOfUintptr;
         break;
     case GoMagic::_118:
-        goCtx->nfunctab    = *reinterpret_cast<uint32*>(data + hSize);
-        goCtx->nfiletab    = *reinterpret_cast<uint32*>(data + hSize + 1 * goCtx->header->sizeOfUintptr);
-        goCtx->funcnametab = data + *reinterpret_cast<uint32*>(data + hSize + 3 * goCtx->header->sizeOfUintptr);
-        goCtx->cutab       = data + *reinterpret_cast<uint32*>(data + hSize + 4 * goCtx->header->sizeOfUintptr);
-        goCtx->filetab     = data + *reinterpret_cast<uint32*>(data + hSize + 5 * goCtx->header->sizeOfUintptr);
-        goCtx->pctab       = data + *reinterpret_cast<uint32*>(data + hSize + 6 * goCtx->header->sizeOfUintptr);
-        goCtx->funcdata    = data + *reinterpret_cast<uint32*>(data + hSize + 7 * goCtx->header->sizeOfUintptr);
-        goCtx->functab     = data + *reinterpret_cast<uint32*>(data + hSize + 7 * goCtx->header->sizeOfUintptr);
-        goCtx->functabsize = (goCtx->nfunctab * 2 + 1) * goCtx->header->sizeOfUintptr;
+        goCtx->nfunctab         = static_cast<uint32>(field(0));
+        goCtx->nfiletab         = static_cast<uint32>(field(1));
+        goCtx->textStart        = field(2);
+        goCtx->funcnametab      = table(field(3));
+        goCtx->cutab            = table(field(4));
+        goCtx->filetab          = table(field(5));
+        goCtx->pctab            = table(field(6));
+        goCtx->funcdata         = table(field(7));
+        goCtx->functab          = table(field(7));
+        goCtx->functabFieldSize = 4;
         break;
     case GoMagic::_12:
-        goCtx->header      = reinterpret_cast<Golang::GoFunctionHeader*>(data);
-        goCtx->nfunctab    = *reinterpret_cast<uint32*>(data + hSize);
-        goCtx->funcdata    = data;
-        goCtx->funcnametab = data;
-        goCtx->functab     = data + 8 + goCtx->header->sizeOfUintptr;
-        goCtx->pctab       = data;
-        goCtx->functabsize = (goCtx->nfunctab * 2 + 1) * goCtx->header->sizeOfUintptr;
-        goCtx->fileoff     = *reinterpret_cast<uint32*>(goCtx->functab + goCtx->functabsize);
-        goCtx->filetab     = data + goCtx->fileoff;
-        goCtx->nfiletab    = *reinterpret_cast<uint32*>(goCtx->filetab);
-        goCtx->filetab     = goCtx->filetab + goCtx->nfiletab * 4;
-        break;
-    default:
-        throw std::runtime_error("Not implemented!");
-    }
-
-    CHECK(goCtx->nfiletab < 0xA00000, false, ""); // sanity checks for invalid sigs
-    CHECK(goCtx->nfunctab < 0xA00000, false, ""); // sanity checks for invalid sigs
-
     {
-        goCtx->files.reserve(goCtx->nfiletab);
-
-        uint32 offset = 0;
-        for (uint32 i = 0; i < goCtx->nfiletab - 1; i++)
-        {
-            auto fname      = reinterpret_cast<char*>(goCtx->filetab + offset);
-            const auto& res = goCtx->files.emplace_back(fname);
-
-            switch (goCtx->header->magic)
-            {
-            case GoMagic::_116:
-            case GoMagic::_118:
-                offset += static_cast<uint32>(res.size()) + 1;
-                break;
-            case GoMagic::_12:
-                offset += static_cast<uint32>(res.size()) + 2;
-                break;
-            default:
-                break;
-            }
-        }
+        goCtx->nfunctab         = static_cast<uint32>(field(0));
+        goCtx->funcdata         = data;
+        goCtx->funcnametab      = data;
+        goCtx->functab          = data + hSize + goCtx->header->sizeOfUintptr;
+        goCtx->pctab            = data;
+        goCtx->functabFieldSize = goCtx->header->sizeOfUintptr;
+
+        // the files table follows functab: number of files (+1) and the offsets of their names
+        uint64 fileoff          = 0;
+        uint64 nfiletab         = 0;
+        const auto functabsize  = (goCtx->nfunctab * 2ULL + 1) * goCtx->functabFieldSize;
+        CHECK(ReadValue(*goCtx, goCtx->functab + functabsize, 4, fileoff), false, "");
+        goCtx->filetab = table(fileoff);
+        CHECK(goCtx->filetab != nullptr, false, "");
+        CHECK(ReadValue(*goCtx, goCtx->filetab, 4, nfiletab), false, "");
+        goCtx->nfiletab = static_cast<uint32>(nfiletab);
     }
-
-    if (arch == Architecture::x86)
-    {
-        goCtx->entries32.reserve(goCtx->nfunctab);
-        goCtx->functions.reserve(goCtx->nfunctab);
-
-        auto entries = reinterpret_cast<Golang::FstEntry32*>(goCtx->functab);
-        for (auto i = 0U; i < goCtx->nfunctab; i++)
-        {
-            const auto entry32 = entries + i;
-            goCtx->entries32.emplace_back(entry32);
-        }
-
-        for (const auto& entry : goCtx->entries32)
-        {
-            switch (goCtx->header->magic)
-            {
-            case GoMagic::_116:
-            case GoMagic::_118:
-            {
-                auto& e          = goCtx->functions.emplace_back(Function{ nullptr, {} });
-                const auto index = goCtx->functions.size() - 1;
-                if (index == 0)
-                {
-                    e.name = reinterpret_cast<char*>(goCtx->funcnametab) + e.func.name;
-                }
-                else
-                {
-                    const auto& ePrevious = goCtx->functions.at(goCtx->functions.size() - 2);
-                    e.name                = ePrevious.name + strlen(ePrevious.name) + 1;
-                }
-            }
-            break;
-            case GoMagic::_12:
-            {
-                const auto f32 = reinterpret_cast<Golang::Func32*>(goCtx->buffer.GetData() + entry->functionOffset);
-
-                auto& e      = goCtx->functions.emplace_back();
-                e.func.entry = f32->entry;
-                memcpy(
-                      reinterpret_cast<char*>(&e.func.entry) + sizeof(e.func.entry),
-                      reinterpret_cast<char*>(&f32->entry) + sizeof(f32->entry),
-                      sizeof(Golang::Func32) - sizeof(Golang::Func32::entry));
-                e.name = reinterpret_cast<char*>(goCtx->funcnametab) + e.func.name;
-            }
-            break;
-            default:
-                throw std::runtime_error("Check this magic");
-            }
-        }
+    break;
+    default:
+        RETURNERROR(false, "Not implemented!");
     }
-    else if (arch == Architecture::x64)
-    {
-        goCtx->entries64.reserve(goCtx->nfunctab);
-        goCtx->functions.reserve(goCtx->nfunctab);
 
-        auto entries = reinterpret_cast<Golang::FstEntry64*>(goCtx->functab);
-        for (auto i = 0U; i < goCtx->nfunctab; i++)
-        {
-            const auto entry64 = entries + i;
-            goCtx->entries64.emplace_back(entry64);
-        }
+    CHECK(goCtx->nfiletab < PCLNTAB_MAX_ENTRIES, false, "");
+    CHECK(goCtx->nfunctab < PCLNTAB_MAX_ENTRIES, false, "");
+    CHECK(goCtx->funcnametab != nullptr && goCtx->filetab != nullptr && goCtx->pctab != nullptr && goCtx->functab != nullptr, false, "");
+    CHECK(goCtx->header->magic == GoMagic::_12 || goCtx->cutab != nullptr, false, "");
 
-        for (const auto& entry : goCtx->entries64)
-        {
-            switch (goCtx->header->magic)
-            {
-            case GoMagic::_116:
-            case GoMagic::_118:
-            {
-                auto& e          = goCtx->functions.emplace_back(Function{ .name = nullptr, .func = {}, .fstEntry{ ._64 = entry } });
-                const auto index = goCtx->functions.size() - 1;
-                if (index == 0)
-                {
-                    e.name = reinterpret_cast<char*>(goCtx->funcnametab) + e.func.name;
-                }
-                else
-                {
-                    const auto& ePrevious = goCtx->functions.at(goCtx->functions.size() - 2);
-                    e.name                = ePrevious.name + strlen(ePrevious.name) + 1;
-                }
-            }
-            break;
-            case GoMagic::_12:
-            {
-                auto& e = goCtx->functions.emplace_back(
-                      Function{ nullptr, *reinterpret_cast<Golang::Func64*>(buffer.GetData() + entry->functionOffset) });
-                e.name = reinterpret_cast<char*>(goCtx->funcnametab) + e.func.name;
-            }
-            break;
-            default:
-                throw std::runtime_error("Check this magic");
-            }
-        }
-    }
-
-    switch (goCtx->header->magic)
-    {
-    case GoMagic::_116:
-    case GoMagic::_118:
-    {
-        auto ePrevious = &goCtx->functions.at(goCtx->functions.size() - 1);
-        auto ptr       = ePrevious->name + strlen(ePrevious->name) + 1;
-        while (*reinterpret_cast<char*>(ePrevious->name + strlen(ePrevious->name) + 1) != 0 &&
-               ptr < reinterpret_cast<char*>(goCtx->cutab)) // it is risky
-        {
-            auto& e   = goCtx->functions.emplace_back(Function{ .name = nullptr, .func = {}, .fstEntry{ ._64 = nullptr } });
-            e.name    = ptr;
-            ePrevious = &goCtx->functions.at(goCtx->functions.size() - 1);
-            ptr       = ePrevious->name + strlen(ePrevious->name) + 1;
-        }
-    }
-    case GoMagic::_12:
-    default:
-        break;
-    }
+    // nfunctab (pc, function offset) pairs + the end pc of the last function
+    const auto functabEnd = static_cast<uint64>(goCtx->functab - data) + (goCtx->nfunctab * 2ULL + 1) * goCtx->functabFieldSize;
+    CHECK(functabEnd <= size, false, "");
 
     goCtx->processed = true;
 
@@ -287,7 +385,11 @@ uint64 PcLnTab::GetFilesCount() const
     CHECK(context != nullptr, 0, "");
     const auto goContext = reinterpret_cast<PcLnTabContext*>(this->context);
     CHECK(goContext->processed, 0, "");
-    return goContext->files.size();
+
+    // Go 1.2: the first entry of the table is the number of files
+    if (goContext->header->magic == GoMagic::_12)
+        return goContext->nfiletab > 0 ? goContext->nfiletab - 1ULL : 0;
+    return goContext->nfiletab;
 }
 
 bool PcLnTab::GetFile(uint64 index, std::string_view& file) const
@@ -295,9 +397,32 @@ bool PcLnTab::GetFile(uint64 index, std::string_view& file) const
     CHECK(context != nullptr, false, "");
     const auto goContext = reinterpret_cast<PcLnTabContext*>(this->context);
     CHECK(goContext->processed, false, "");
-    CHECK(index < goContext->files.size(), false, "");
-    file = goContext->files.at(index);
-    return true;
+    CHECK(index < GetFilesCount(), false, "");
+
+    if (goContext->header->magic == GoMagic::_12)
+    {
+        uint64 offset = 0;
+        CHECK(ReadValue(*goContext, goContext->filetab + 4 * (index + 1), 4, offset), false, "");
+        return ReadString(*goContext, goContext->buffer.GetData() + offset, file);
+    }
+
+    if (goContext->filesOffsets.empty())
+    {
+        // built aside --> a table that can not be read completely is not kept (half built)
+        std::vector<uint32> offsets;
+        offsets.reserve(goContext->nfiletab);
+        uint32 offset = 0;
+        for (auto i = 0U; i < goContext->nfiletab; i++)
+        {
+            std::string_view name;
+            CHECK(ReadString(*goContext, goContext->filetab + offset, name), false, "");
+            offsets.push_back(offset);
+            offset += static_cast<uint32>(name.size()) + 1;
+        }
+        goContext->filesOffsets = std::move(offsets);
+    }
+    CHECK(index < goContext->filesOffsets.size(), false, "");
+    return ReadString(*goContext, goContext->filetab + goContext->filesOffsets[index], file);
 }
 
 uint64 PcLnTab::GetFunctionsCount() const
@@ -305,7 +430,7 @@ uint64 PcLnTab::GetFunctionsCount() const
     CHECK(context != nullptr, 0, "");
     const auto goContext = reinterpret_cast<PcLnTabContext*>(this->context);
     CHECK(goContext->processed, 0, "");
-    return goContext->functions.size();
+    return goContext->nfunctab;
 }
 
 bool PcLnTab::GetFunction(uint64 index, Function& func) const
@@ -313,9 +438,8 @@ bool PcLnTab::GetFunction(uint64 index, Function& func) const
     CHECK(context != nullptr, false, "");
     const auto goContext = reinterpret_cast<PcLnTabContext*>(this->context);
     CHECK(goContext->processed, false, "");
-    CHECK(index < goContext->functions.size(), false, "");
-    func = goContext->functions.at(index);
-    return true;
+    CHECK(index < goContext->nfunctab, false, "");
+    return DecodeFunction(*goContext, index, func);
 }
 
 uint64 PcLnTab::GetEntriesCount() const
@@ -323,18 +447,81 @@ uint64 PcLnTab::GetEntriesCount() const
     CHECK(context != nullptr, 0, "");
     const auto goContext = reinterpret_cast<PcLnTabContext*>(this->context);
     CHECK(goContext->processed, 0, "");
+    return goContext->nfunctab;
+}
 
-    if (goContext->arch == Architecture::x86)
-    {
-        return goContext->entries32.size();
-    }
+bool PcLnTab::FindFunction(uint64 pc, uint64& index) const
+{
+    CHECK(context != nullptr, false, "");
+    const auto goContext = reinterpret_cast<PcLnTabContext*>(this->context);
+    CHECK(goContext->processed, false, "");
+    CHECK(goContext->nfunctab > 0, false, "");
 
-    if (goContext->arch == Architecture::x64)
+    // functab is sorted by pc: the last function that starts before (or at) 'pc'
+    uint64 first = 0, last = goContext->nfunctab, value = 0;
+    CHECK(GetFunctionPc(*goContext, 0, value) && pc >= value, false, "");
+    CHECK(GetFunctionPc(*goContext, goContext->nfunctab, value) && pc < value, false, "");
+    while (last - first > 1)
     {
-        return goContext->entries64.size();
+        const auto middle = first + (last - first) / 2;
+        CHECK(GetFunctionPc(*goContext, middle, value), false, "");
+        if (value <= pc)
+            first = middle;
+        else
+            last = middle;
     }
+    index = first;
+    return true;
+}
+
+bool PcLnTab::GetPcTable(uint64 index, PcTableType type, std::vector<PcValue>& values) const
+{
+    CHECK(context != nullptr, false, "");
+    const auto goContext = reinterpret_cast<PcLnTabContext*>(this->context);
+    CHECK(goContext->processed, false, "");
 
-    return 0;
+    Function func{};
+    CHECK(GetFunction(index, func), false, "");
+    const auto offset = type == PcTableType::Sp ? func.func.pcsp : (type == PcTableType::File ? func.func.pcfile : func.func.pcln);
+
+    values.clear();
+    const auto onValue = [&values](uint64 start, uint64 end, int32 value) {
+        values.push_back({ start, end, value });
+        return true;
+    };
+    return WalkPcTable(*goContext, static_cast<uint32>(offset), func.func.entry, onValue);
+}
+
+bool PcLnTab::GetSourceLine(uint64 pc, std::string_view& file, uint32& line) const
+{
+    CHECK(context != nullptr, false, "");
+    const auto goContext = reinterpret_cast<PcLnTabContext*>(this->context);
+
+    uint64 index = 0;
+    Function func{};
+    uint8* data = nullptr;
+    CHECK(FindFunction(pc, index), false, "");
+    CHECK(GetFunction(index, func), false, "");
+    CHECK(GetFunctionData(*goContext, index, data), false, "");
+
+    // only the part of the tables that precedes 'pc' is decoded
+    int32 fileIndex = -1, lineNumber = -1;
+    const auto valueAt = [pc](int32& result) {
+        return [pc, &result](uint64, uint64 end, int32 value) {
+            if (pc < end)
+            {
+                result = value;
+                return false;
+            }
+            return true;
+        };
+    };
+    CHECK(WalkPcTable(*goContext, static_cast<uint32>(func.func.pcfile), func.func.entry, valueAt(fileIndex)), false, "");
+    CHECK(WalkPcTable(*goContext, static_cast<uint32>(func.func.pcln), func.func.entry, valueAt(lineNumber)), false, "");
+    CHECK(lineNumber >= 0, false, "");
+    CHECK(GetFileName(*goContext, data, fileIndex, file), false, "");
+    line = static_cast<uint32>(lineNumber);
+    return true;
 }
 
 void PcLnTab::SetBuildId(std::string_view buildId)
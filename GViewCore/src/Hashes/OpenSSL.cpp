@@ -54,6 +54,13 @@ bool OpenSSLHash::Update(const void* input, uint32 length)
     return EVP_DigestUpdate((EVP_MD_CTX*) handle, input, length);
 }
 
+bool OpenSSLHash::Reset()
+{
+    // the digest that was already set is kept --> no new context is allocated
+    size = 0;
+    return EVP_DigestInit_ex((EVP_MD_CTX*) handle, nullptr, nullptr);
+}
+
 bool OpenSSLHash::Final()
 {
     if (size != 0)
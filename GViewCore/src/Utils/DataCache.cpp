@@ -1,12 +1,32 @@
 #include "GView.hpp"
 
+#include <mutex>
+
 using namespace GView::Utils;
 
 constexpr uint32 MAX_CACHE_SIZE = 0x1000000U; // 16 M
 
+// the file object is shared with the readers obtained through GetReader (they can outlive the cache)
+struct GView::Utils::SharedDataObject
+{
+    std::unique_ptr<AppCUI::OS::DataObject> object;
+    std::mutex lock; // every read moves the position of the file object
+    ~SharedDataObject()
+    {
+        if (object)
+            object->Close();
+    }
+    bool Read(uint64 offset, uint8* buffer, uint32 size)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (object->SetCurrentPos(offset) == false)
+            return false;
+        return object->Read(buffer, size);
+    }
+};
+
 DataCache::DataCache()
 {
-    this->fileObj    = nullptr;
     this->cache      = nullptr;
     this->cacheSize  = 0;
     this->start      = 0;
@@ -16,14 +36,13 @@ DataCache::DataCache()
 }
 DataCache::DataCache(DataCache&& obj)
 {
-    fileObj        = obj.fileObj;
+    fileObj        = std::move(obj.fileObj);
     fileSize       = obj.fileSize;
     start          = obj.start;
     end            = obj.end;
     currentPos     = obj.currentPos;
     cache          = obj.cache;
     cacheSize      = obj.cacheSize;
-    obj.fileObj    = nullptr;
     obj.fileSize   = 0;
     obj.start      = 0;
     obj.end        = 0;
@@ -33,12 +52,7 @@ DataCache::DataCache(DataCache&& obj)
 }
 DataCache::~DataCache()
 {
-    if (this->fileObj)
-    {
-        this->fileObj->Close();
-        delete this->fileObj;
-    }
-    this->fileObj = nullptr;
+    this->fileObj.reset();
     if (this->cache)
         delete[] this->cache;
     this->cache = nullptr;
@@ -47,13 +61,14 @@ DataCache::~DataCache()
 bool DataCache::Init(std::unique_ptr<AppCUI::OS::DataObject> file, uint32 _cacheSize)
 {
     CHECK(this->cacheSize == 0, false, "Cache object already initialized !");
-    this->fileObj = file.release(); // take ownership of the pointer
-    CHECK(this->fileObj, false, "Expecting a valid file object poiner !");
+    CHECK(file, false, "Expecting a valid file object poiner !");
+    this->fileObj         = std::make_shared<SharedDataObject>();
+    this->fileObj->object = std::move(file); // take ownership of the pointer
     _cacheSize = (_cacheSize | 0xFFFF) + 1; // a minimum of 64 K for cache
     if (_cacheSize == 0)
         _cacheSize = MAX_CACHE_SIZE;
     _cacheSize     = std::min(_cacheSize, MAX_CACHE_SIZE);
-    this->fileSize = fileObj->GetSize();
+    this->fileSize = fileObj->object->GetSize();
 
     this->cache = new uint8[_cacheSize];
     CHECK(this->cache, false, "Fail to allocate: %u bytes", _cacheSize);
@@ -114,9 +129,7 @@ BufferView DataCache::Get(uint64 offset, uint32 requestedSize, bool failIfReques
             _end = this->fileSize;
     }
     // read new data in cache
-    if (this->fileObj->SetCurrentPos(_start) == false)
-        return BufferView();
-    if (this->fileObj->Read(this->cache, (uint32) (_end - _start)) == false)
+    if (this->fileObj->Read(_start, this->cache, (uint32) (_end - _start)) == false)
     {
         this->start = 0;
         this->end   = 0;
@@ -198,6 +211,31 @@ Buffer DataCache::CopyToBuffer(uint64 offset, uint32 requestedSize, bool failIfR
     }
     return b;
 }
+Buffer DataCache::CopyUncached(uint64 offset, uint32 requestedSize)
+{
+    CHECK(this->fileObj, Buffer(), "File was not properly initialized !");
+    CHECK(requestedSize > 0, Buffer(), "Invalid requested size (should be bigger than 0)");
+    CHECK(offset < this->fileSize, Buffer(), "Invalid offset (%llu) , should be less than %llu ", offset, this->fileSize);
+
+    // the data is read straight from the file --> the cached window (and the views returned by Get) remain valid
+    const auto size = (uint32) std::min<uint64>(requestedSize, this->fileSize - offset);
+    Buffer b{};
+    b.Resize(size);
+    CHECK(this->fileObj->Read(offset, b.GetData(), size), Buffer(), "Unable to read %u bytes from %llu offset", size, offset);
+    return b;
+}
+Buffer DataCache::Reader::Read(uint64 offset, uint32 requestedSize) const
+{
+    CHECK(this->fileObj, Buffer(), "Invalid reader !");
+    CHECK(requestedSize > 0, Buffer(), "Invalid requested size (should be bigger than 0)");
+    CHECK(offset < this->fileSize, Buffer(), "Invalid offset (%llu) , should be less than %llu ", offset, this->fileSize);
+
+    const auto size = (uint32) std::min<uint64>(requestedSize, this->fileSize - offset);
+    Buffer b{};
+    b.Resize(size);
+    CHECK(this->fileObj->Read(offset, b.GetData(), size), Buffer(), "Unable to read %u bytes from %llu offset", size, offset);
+    return b;
+}
 bool DataCache::WriteTo(Reference<AppCUI::OS::DataObject> output, uint64 offset, uint32 size)
 {
     CHECK(output->SetSize(size), false, "");
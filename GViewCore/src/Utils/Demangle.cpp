@@ -1,4 +1,5 @@
 #include <memory>
+#include <unordered_map>
 #include <GView.hpp>
 #include <llvm/Demangle/Demangle.h>
 
@@ -6,36 +7,164 @@ using namespace llvm;
 
 namespace GView::Utils
 {
-bool Demangle(std::string_view input, String& output, DemangleKind format)
+constexpr uint32 DEMANGLER_ARENA_BLOCK_SIZE = 0x100000; // 1 MB (longer names get their own block)
+constexpr uint32 DEMANGLER_CHUNK_SIZE       = 256;      // names demangled by a worker at once
+
+// the LLVM demanglers expect NUL terminated strings --> the input is copied (without any size limit)
+static bool DemangleName(std::string_view input, std::string& output, DemangleKind format)
 {
-    LocalString<1024> temp;
-    CHECK(temp.Set(input.data(), (uint32) input.size()), false, "");
+    const std::string temp{ input };
 
     unique_ptr<char, decltype(free)*> result(nullptr, free);
     switch (format)
     {
     case DemangleKind::Itanium:
-        result.reset(itaniumDemangle(temp.GetText(), nullptr, nullptr, nullptr));
+        result.reset(itaniumDemangle(temp.c_str(), nullptr, nullptr, nullptr));
         break;
     case DemangleKind::Microsoft:
-        result.reset(microsoftDemangle(temp.GetText(), nullptr, nullptr, nullptr, nullptr));
+        result.reset(microsoftDemangle(temp.c_str(), nullptr, nullptr, nullptr, nullptr));
         break;
     case DemangleKind::Rust:
-        result.reset(rustDemangle(temp.GetText(), nullptr, nullptr, nullptr));
+        result.reset(rustDemangle(temp.c_str(), nullptr, nullptr, nullptr));
         break;
     case DemangleKind::Auto:
     {
-        const auto sResult = demangle(temp.GetText());
-        CHECK(sResult != temp.GetText(), false, "");
-        CHECK(output.Add(sResult), false, "");
+        // Itanium (_Z, ___Z), Rust (_R) and Microsoft (?, .) names --> the others are not even tried
+        // (plain C names are the most common ones --> not an error, nothing is logged)
+        if (input.empty() || (input[0] != '_' && input[0] != '?' && input[0] != '.'))
+            return false;
+        auto sResult = demangle(temp);
+        if (sResult == temp)
+            return false;
+        output = std::move(sResult);
 
         return true;
     }
     }
 
-    CHECK(result != nullptr, false, "");
-    CHECK(output.Add(&*result), false, "");
+    if (result == nullptr)
+        return false;
+    output = result.get();
+
+    return true;
+}
+
+bool Demangle(std::string_view input, String& output, DemangleKind format)
+{
+    std::string result;
+    CHECK(DemangleName(input, result, format), false, "");
+    CHECK(output.Add(result), false, "");
+
+    return true;
+}
+
+struct DemanglerContext
+{
+    DemangleKind format;
+    std::vector<std::unique_ptr<char[]>> blocks;
+    size_t blockSize{ 0 };
+    size_t blockUsed{ 0 };
+    std::unordered_map<std::string_view, std::string_view> cache; // mangled --> demangled (both in the arena)
+
+    std::string_view Store(std::string_view text)
+    {
+        if (text.empty())
+            return {};
+        if (blockUsed + text.size() > blockSize)
+        {
+            blockSize = std::max<size_t>(DEMANGLER_ARENA_BLOCK_SIZE, text.size());
+            blockUsed = 0;
+            blocks.push_back(std::make_unique<char[]>(blockSize));
+        }
+
+        const auto start = blocks.back().get() + blockUsed;
+        memcpy(start, text.data(), text.size());
+        blockUsed += text.size();
+        return { start, text.size() };
+    }
+};
+
+Demangler::Demangler(DemangleKind format)
+{
+    auto ctx    = new DemanglerContext();
+    ctx->format = format;
+    context     = ctx;
+}
+
+Demangler::~Demangler()
+{
+    delete reinterpret_cast<DemanglerContext*>(context);
+}
+
+bool Demangler::Demangle(std::span<const std::string_view> names, std::vector<std::string_view>& results)
+{
+    auto ctx = reinterpret_cast<DemanglerContext*>(context);
+    results.assign(names.size(), std::string_view{});
+
+    // distinct names that are not cached yet
+    constexpr auto NOT_PENDING = 0xFFFFFFFFU;
+    std::unordered_map<std::string_view, uint32> pendingIndexes;
+    std::vector<std::string_view> pending;
+    std::vector<uint32> slots(names.size(), NOT_PENDING);
+    for (auto i = 0U; i < names.size(); i++)
+    {
+        const auto name = names[i];
+        if (name.empty())
+            continue;
+
+        const auto it = ctx->cache.find(name);
+        if (it != ctx->cache.end())
+        {
+            results[i] = it->second;
+            continue;
+        }
+
+        const auto [slot, inserted] = pendingIndexes.try_emplace(name, static_cast<uint32>(pending.size()));
+        if (inserted)
+            pending.push_back(name);
+        slots[i] = slot->second;
+    }
+    if (pending.empty())
+        return true;
+
+    // the workers only write their own outputs --> the arena and the cache are updated afterwards (by this thread)
+    std::vector<std::string> outputs(pending.size());
+    const auto chunks = static_cast<uint32>((pending.size() + DEMANGLER_CHUNK_SIZE - 1) / DEMANGLER_CHUNK_SIZE);
+    ParallelFor(chunks, [&](uint32 chunk) {
+        const auto end = std::min<size_t>(pending.size(), (static_cast<size_t>(chunk) + 1) * DEMANGLER_CHUNK_SIZE);
+        for (auto i = static_cast<size_t>(chunk) * DEMANGLER_CHUNK_SIZE; i < end; i++)
+        {
+            if (!DemangleName(pending[i], outputs[i], ctx->format))
+                outputs[i].clear();
+        }
+    });
+
+    ctx->cache.reserve(ctx->cache.size() + pending.size());
+    std::vector<std::string_view> demangled(pending.size());
+    for (auto i = 0U; i < pending.size(); i++)
+    {
+        demangled[i] = ctx->Store(outputs[i]);
+        ctx->cache.emplace(ctx->Store(pending[i]), demangled[i]);
+    }
+
+    for (auto i = 0U; i < names.size(); i++)
+    {
+        if (slots[i] != NOT_PENDING)
+            results[i] = demangled[slots[i]];
+    }
 
     return true;
 }
-} // namespace GView::Utils
\ No newline at end of file
+
+std::string_view Demangler::Demangle(std::string_view name)
+{
+    std::vector<std::string_view> results;
+    CHECK(Demangle(std::span<const std::string_view>{ &name, 1 }, results), std::string_view{}, "");
+    return results[0];
+}
+
+uint32 Demangler::GetCachedNamesCount() const
+{
+    return static_cast<uint32>(reinterpret_cast<DemanglerContext*>(context)->cache.size());
+}
+} // namespace GView::Utils
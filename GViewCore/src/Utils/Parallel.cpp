@@ -0,0 +1,43 @@
+#include "GView.hpp"
+
+#include <atomic>
+#include <thread>
+
+namespace GView::Utils
+{
+uint32 GetParallelWorkersCount()
+{
+    const auto count = std::thread::hardware_concurrency();
+    return count == 0 ? 1 : std::min<uint32>(count, 64);
+}
+void ParallelFor(uint32 count, const std::function<void(uint32 index)>& task)
+{
+    CHECKRET(task, "Expecting a valid task !");
+    if (count == 0)
+        return;
+
+    const auto workersCount = std::min<uint32>(GetParallelWorkersCount(), count);
+    if (workersCount <= 1)
+    {
+        for (auto index = 0U; index < count; index++)
+            task(index);
+        return;
+    }
+
+    // workers pick the next available index (dynamic scheduling) --> uneven tasks are balanced automatically
+    std::atomic<uint32> next{ 0 };
+    auto worker = [&]()
+    {
+        for (auto index = next.fetch_add(1); index < count; index = next.fetch_add(1))
+            task(index);
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(workersCount - 1);
+    for (auto i = 1U; i < workersCount; i++)
+        threads.emplace_back(worker);
+    worker(); // current thread is also a worker
+    for (auto& t : threads)
+        t.join();
+}
+} // namespace GView::Utils
@@ -0,0 +1,148 @@
+#include "GView.hpp"
+
+#include <array>
+
+namespace GView::Utils
+{
+struct PatternScannerContext
+{
+    std::vector<std::array<uint32, 256>> transitions; // state 0 is the root (until the automaton is built, 0 means "no edge")
+    std::vector<std::vector<uint32>> outputs;         // the patterns that end in every state
+    std::vector<uint32> lengths;
+    std::vector<uint32> ids;
+    bool built{ false };
+    uint32 state{ 0 };
+    uint64 position{ 0 };
+};
+
+// every missing edge is replaced with the edge of the failure state --> scanning needs one lookup for every byte
+static void BuildAutomaton(PatternScannerContext& ctx)
+{
+    std::vector<uint32> fail(ctx.transitions.size(), 0);
+    std::vector<uint32> queue;
+    queue.reserve(ctx.transitions.size());
+
+    for (auto c = 0U; c < 256; c++)
+    {
+        if (ctx.transitions[0][c] != 0)
+            queue.push_back(ctx.transitions[0][c]);
+    }
+
+    // breadth first --> the failure state (less deep) is complete when a state is processed
+    for (size_t index = 0; index < queue.size(); index++)
+    {
+        const auto state = queue[index];
+        for (auto c = 0U; c < 256; c++)
+        {
+            const auto next = ctx.transitions[state][c];
+            if (next == 0)
+            {
+                ctx.transitions[state][c] = ctx.transitions[fail[state]][c];
+                continue;
+            }
+            fail[next]         = ctx.transitions[fail[state]][c];
+            const auto& suffix = ctx.outputs[fail[next]];
+            ctx.outputs[next].insert(ctx.outputs[next].end(), suffix.begin(), suffix.end());
+            queue.push_back(next);
+        }
+    }
+    ctx.built = true;
+}
+
+PatternScanner::PatternScanner()
+{
+    auto ctx = new PatternScannerContext;
+    ctx->transitions.emplace_back().fill(0);
+    ctx->outputs.emplace_back();
+    context = ctx;
+}
+
+PatternScanner::~PatternScanner()
+{
+    delete reinterpret_cast<PatternScannerContext*>(context);
+    context = nullptr;
+}
+
+bool PatternScanner::AddPattern(BufferView pattern, uint32 id)
+{
+    auto ctx = reinterpret_cast<PatternScannerContext*>(context);
+    CHECK(!ctx->built, false, "Patterns must be added before the first scan !");
+    CHECK(pattern.IsValid() && (pattern.GetLength() > 0), false, "Expecting a non empty pattern !");
+
+    uint32 state = 0;
+    for (const auto value : pattern)
+    {
+        auto next = ctx->transitions[state][value];
+        if (next == 0)
+        {
+            next = static_cast<uint32>(ctx->transitions.size());
+            ctx->transitions.emplace_back().fill(0);
+            ctx->outputs.emplace_back();
+            ctx->transitions[state][value] = next;
+        }
+        state = next;
+    }
+    ctx->outputs[state].push_back(static_cast<uint32>(ctx->ids.size()));
+    ctx->lengths.push_back(static_cast<uint32>(pattern.GetLength()));
+    ctx->ids.push_back(id);
+    return true;
+}
+
+void PatternScanner::Reset(uint64 startOffset)
+{
+    auto ctx      = reinterpret_cast<PatternScannerContext*>(context);
+    ctx->state    = 0;
+    ctx->position = startOffset;
+}
+
+bool PatternScanner::Scan(BufferView data, const std::function<bool(uint64 offset, uint32 id)>& onMatch)
+{
+    auto ctx = reinterpret_cast<PatternScannerContext*>(context);
+    CHECK(onMatch, false, "Expecting a valid callback !");
+    CHECK(data.IsValid(), false, "");
+    if (!ctx->built)
+        BuildAutomaton(*ctx);
+
+    const auto* transitions = ctx->transitions.data();
+    const auto* p           = data.GetData();
+    const auto length       = data.GetLength();
+    auto state              = ctx->state;
+    for (size_t index = 0; index < length; index++)
+    {
+        state = transitions[state][p[index]];
+        if (ctx->outputs[state].empty())
+            continue;
+
+        const auto end = ctx->position + index + 1;
+        for (const auto pattern : ctx->outputs[state])
+        {
+            if (!onMatch(end - ctx->lengths[pattern], ctx->ids[pattern]))
+            {
+                ctx->state    = state;
+                ctx->position = end;
+                return false;
+            }
+        }
+    }
+    ctx->state = state;
+    ctx->position += length;
+    return true;
+}
+
+bool PatternScanner::Scan(DataCache& cache, uint64 start, uint64 size, const std::function<bool(uint64 offset, uint32 id)>& onMatch)
+{
+    // the data is read one cache window at a time (the state of the automaton links the windows)
+    Reset(start);
+    const auto end = start + size;
+    for (auto offset = start; offset < end;)
+    {
+        const auto toRead = static_cast<uint32>(std::min<uint64>(cache.GetCacheSize(), end - offset));
+        const auto buffer = cache.Get(offset, toRead, false);
+        CHECK(buffer.IsValid() && (buffer.GetLength() > 0), false, "");
+        if (!Scan(buffer, onMatch))
+            return false;
+        offset += buffer.GetLength();
+    }
+    return true;
+}
+} // namespace GView::Utils
@@ -0,0 +1,245 @@
+#include "DissasmViewer.hpp"
+
+using namespace GView::View::DissasmViewer;
+
+constexpr uint64 DISSASM_CHUNK_SIZE         = 0x10000; // the instructions index is built 64 KB at a time
+constexpr uint32 DISSASM_AVERAGE_INS_SIZE   = 4;       // estimates the lines of the chunks that were not decoded yet
+constexpr uint32 DISSASM_MAX_CACHED_LINES   = 512;
+constexpr uint32 DISSASM_INSTRUCTION_WINDOW = 16;
+constexpr uint32 DISSASM_BATCH_SIZE         = 256;
+constexpr uint32 DISSASM_MAX_BYTES_SHOWN    = 8;
+constexpr uint32 DISSASM_OFFSET_SIZE        = 12; // "0x%08llX  "
+
+bool Instance::InitCodeZone(DissasmCodeZone* zone)
+{
+    const auto isX64 = zone->zoneDetails.language == DissasemblyLanguage::x64;
+    CHECK(zone->dissasembler.Init(isX64, true), false, "");
+
+    const auto size = zone->zoneDetails.size;
+    uint32 lines    = 0;
+    for (uint64 start = 0; start < size; start += DISSASM_CHUNK_SIZE)
+    {
+        DissasmCodeChunk chunk{};
+        chunk.entry      = start;
+        chunk.exit       = std::min<uint64>(start + DISSASM_CHUNK_SIZE, size);
+        chunk.firstLine  = lines;
+        chunk.linesCount = static_cast<uint32>((chunk.exit - start + DISSASM_AVERAGE_INS_SIZE - 1) / DISSASM_AVERAGE_INS_SIZE);
+        chunk.decoded    = false;
+        lines += chunk.linesCount;
+        zone->chunks.push_back(std::move(chunk));
+    }
+    zone->extendedSize = lines;
+    return true;
+}
+
+bool Instance::DecodeCodeChunk(DissasmCodeZone* zone, uint32 chunkIndex)
+{
+    auto& cache = this->obj->GetData();
+
+    // a chunk starts where the instructions of the previous one end (if that one was decoded) or at its first byte
+    // (x86 decoding synchronizes itself after a few instructions); if the entry of a decoded chunk changes, it is decoded again
+    while (chunkIndex < zone->chunks.size())
+    {
+        auto& chunk           = zone->chunks[chunkIndex];
+        const auto chunkStart = chunkIndex * DISSASM_CHUNK_SIZE;
+        const auto chunkEnd   = std::min<uint64>(chunkStart + DISSASM_CHUNK_SIZE, zone->zoneDetails.size);
+        const auto entry      = ((chunkIndex > 0) && zone->chunks[chunkIndex - 1].decoded) ? zone->chunks[chunkIndex - 1].exit : chunkStart;
+        if (chunk.decoded && (chunk.entry == entry))
+            break;
+
+        chunk.offsets.clear();
+        auto position = entry;
+        if (position < chunkEnd)
+        {
+            const auto toRead = static_cast<uint32>(std::min<uint64>(chunkEnd + DISSASM_INSTRUCTION_WINDOW, zone->zoneDetails.size) - position);
+            const auto buf    = cache.Get(zone->startingOffset + position, toRead, false);
+            CHECK(buf.IsValid(), false, "");
+
+            // only the offsets are needed here (the text of a line is formatted when it is painted)
+            GView::Dissasembly::InstructionInfo batch[DISSASM_BATCH_SIZE];
+            chunk.offsets.reserve(static_cast<size_t>((chunkEnd - position) / DISSASM_AVERAGE_INS_SIZE));
+            while ((position < chunkEnd) && (position - entry < buf.GetLength()))
+            {
+                const auto index = static_cast<size_t>(position - entry);
+                const auto count = zone->dissasembler.DissasembleInstructions(
+                      { buf.GetData() + index, buf.GetLength() - index }, zone->startingOffset + position, batch, DISSASM_BATCH_SIZE);
+                CHECK(count > 0, false, "");
+                for (auto i = 0U; (i < count) && (position < chunkEnd); i++)
+                {
+                    chunk.offsets.push_back(static_cast<uint32>(position));
+                    position += batch[i].size; // an invalid byte is shown as data
+                }
+            }
+        }
+
+        chunk.entry   = entry;
+        chunk.exit    = std::max<uint64>(position, chunkEnd);
+        chunk.decoded = true;
+
+        // the estimated lines are replaced with the real ones --> the lines that follow are moved
+        const auto delta = static_cast<int64>(chunk.offsets.size()) - static_cast<int64>(chunk.linesCount);
+        chunk.linesCount = static_cast<uint32>(chunk.offsets.size());
+        if (delta != 0)
+        {
+            for (auto next = chunkIndex + 1; next < zone->chunks.size(); next++)
+                zone->chunks[next].firstLine = static_cast<uint32>(zone->chunks[next].firstLine + delta);
+            zone->extendedSize = static_cast<uint32>(zone->extendedSize + delta);
+            if (!zone->isCollapsed)
+            {
+                zone->endingLineIndex = static_cast<uint32>(zone->endingLineIndex + delta);
+                ShiftZonesAfter(zone, delta);
+            }
+        }
+
+        chunkIndex++;
+        if ((chunkIndex >= zone->chunks.size()) || (!zone->chunks[chunkIndex].decoded))
+            break;
+    }
+
+    return true;
+}
+
+bool Instance::GetCodeLineOffset(DissasmCodeZone* zone, uint32 line, uint64& offset)
+{
+    auto& chunks = zone->chunks;
+    while (true)
+    {
+        CHECK(line < zone->extendedSize, false, "");
+
+        auto it = std::upper_bound(
+              chunks.begin(), chunks.end(), line, [](uint32 value, const DissasmCodeChunk& chunk) { return value < chunk.firstLine; });
+        CHECK(it != chunks.begin(), false, "");
+        it--;
+
+        if (!it->decoded)
+        {
+            // the lines of the zone change once the chunk is decoded --> search again
+            CHECK(DecodeCodeChunk(zone, static_cast<uint32>(it - chunks.begin())), false, "");
+            continue;
+        }
+
+        const auto index = line - it->firstLine;
+        CHECK(index < it->offsets.size(), false, "");
+        offset = zone->startingOffset + it->offsets[index];
+        return true;
+    }
+}
+
+bool Instance::GetCodeOffsetLine(DissasmCodeZone* zone, uint64 offset, uint32& line)
+{
+    CHECK(offset >= zone->startingOffset && offset < zone->startingOffset + zone->zoneDetails.size, false, "");
+    const auto relative   = offset - zone->startingOffset;
+    const auto chunkIndex = static_cast<uint32>(relative / DISSASM_CHUNK_SIZE);
+    if (!zone->chunks[chunkIndex].decoded)
+    {
+        CHECK(DecodeCodeChunk(zone, chunkIndex), false, "");
+    }
+
+    // the instruction that contains 'offset' (or the first one of the chunk)
+    const auto& chunk = zone->chunks[chunkIndex];
+    const auto it     = std::upper_bound(chunk.offsets.begin(), chunk.offsets.end(), static_cast<uint32>(relative));
+    line              = chunk.firstLine + static_cast<uint32>(it == chunk.offsets.begin() ? 0 : it - chunk.offsets.begin() - 1);
+    return true;
+}
+
+const DissasmCodeLine& Instance::GetFormattedCodeLine(DissasmCodeZone* zone, uint64 offset)
+{
+    // only the lines that are painted are formatted (and kept for the next paint)
+    const auto it = zone->cachedLinesIndex.find(offset);
+    if (it != zone->cachedLinesIndex.end())
+    {
+        zone->cachedLines.splice(zone->cachedLines.begin(), zone->cachedLines, it->second);
+        return zone->cachedLines.front();
+    }
+    if (zone->cachedLines.size() >= DISSASM_MAX_CACHED_LINES)
+    {
+        zone->cachedLinesIndex.erase(zone->cachedLines.back().offset);
+        zone->cachedLines.pop_back();
+    }
+
+    LocalString<256> text;
+    GView::Dissasembly::Instruction ins{};
+    const auto zoneEnd   = zone->startingOffset + zone->zoneDetails.size;
+    const auto available = static_cast<uint32>(std::min<uint64>(DISSASM_INSTRUCTION_WINDOW, zoneEnd - offset));
+    const auto buf       = this->obj->GetData().Get(offset, available, false);
+
+    text.Format("0x%08llX  ", offset);
+    if (buf.IsValid() && zone->dissasembler.DissasembleInstruction(buf, offset, ins))
+    {
+        for (auto i = 0U; i < DISSASM_MAX_BYTES_SHOWN; i++)
+        {
+            if (i < ins.size)
+                text.AddFormat("%02X ", ins.bytes[i]);
+            else
+                text.Add("   ");
+        }
+        text.Add(ins.size > DISSASM_MAX_BYTES_SHOWN ? "+ " : "  ");
+        text.AddFormat("%-8s %s", ins.mnemonic, ins.opStr);
+    }
+    else
+    {
+        const auto value = (buf.IsValid() && buf.GetLength() > 0) ? buf[0] : 0;
+        text.AddFormat("%02X ", value);
+        for (auto i = 1U; i < DISSASM_MAX_BYTES_SHOWN; i++)
+            text.Add("   ");
+        text.AddFormat("  %-8s 0x%02X", "db", value);
+    }
+
+    zone->cachedLines.push_front({ offset, std::string(text.GetText(), text.Len()) });
+    zone->cachedLinesIndex[offset] = zone->cachedLines.begin();
+    return zone->cachedLines.front();
+}
+
+bool Instance::DrawDissasmCodeZone(DrawLineInfo& dli, DissasmCodeZone* codeZone)
+{
+    dli.chNameAndSize = this->chars.GetBuffer() + Layout.startingTextLineOffset;
+    dli.chText        = dli.chNameAndSize;
+
+    auto clearChar = this->chars.GetBuffer();
+    for (uint32 i = 0; i < Layout.startingTextLineOffset; i++)
+    {
+        clearChar->Code  = codePage[' '];
+        clearChar->Color = config.Colors.Normal;
+        clearChar++;
+    }
+
+    if (dli.textLineToDraw == 0)
+    {
+        const auto language = codeZone->zoneDetails.language == DissasemblyLanguage::x64 ? "x64" : "x86";
+        const auto start    = codeZone->startingOffset;
+        AddStringToChars(dli, config.Colors.StructureColor, "Code ");
+        AddStringToChars(dli, config.Colors.Normal, "0x%llX - 0x%llX (%s)", start, start + codeZone->zoneDetails.size, language);
+        RegisterStructureCollapseButton(dli, codeZone->isCollapsed ? SpecialChars::TriangleRight : SpecialChars::TriangleLeft, codeZone);
+    }
+    else
+    {
+        uint64 offset = 0;
+        if (GetCodeLineOffset(codeZone, dli.textLineToDraw - 1, offset))
+        {
+            // long operands are clipped to the width of the view
+            const std::string_view text = GetFormattedCodeLine(codeZone, offset).text;
+            const auto visible          = text.substr(0, Layout.textSize);
+            const auto offsetPart       = std::min<size_t>(DISSASM_OFFSET_SIZE, visible.size());
+            AddStringToChars(dli, config.Colors.DataTypeColor, visible.substr(0, offsetPart));
+            AddStringToChars(dli, config.Colors.Normal, visible.substr(offsetPart));
+        }
+    }
+
+    const size_t bufferSize = dli.chText - this->chars.GetBuffer();
+
+    const uint32 cursorLine = static_cast<uint32>((this->Cursor.currentPos - this->Cursor.startView) / Layout.textSize);
+    if (cursorLine == dli.screenLineToDraw)
+    {
+        const uint32 index = this->Cursor.currentPos % Layout.textSize;
+        if (index < bufferSize - Layout.startingTextLineOffset)
+            dli.chNameAndSize[index].Color = config.Colors.Selection;
+        else
+            dli.renderer.WriteCharacter(Layout.startingTextLineOffset + index, cursorLine + 1, codePage[' '], config.Colors.Selection);
+    }
+
+    HighlightSelectionText(dli, bufferSize - Layout.startingTextLineOffset);
+
+    const auto bufferToDraw = CharacterView{ chars.GetBuffer(), bufferSize };
+    dli.renderer.WriteSingleLineCharacterBuffer(0, dli.screenLineToDraw + 1, bufferToDraw, false);
+    return true;
+}
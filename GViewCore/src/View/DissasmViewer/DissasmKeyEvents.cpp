@@ -32,17 +32,19 @@ void Instance::AnalyzeMousePosition(int x, int y, MousePositionInfo& mpInfo)
     if (mpInfo.location == MouseLocation::OnView)
     {
         mpInfo.bufferOffset += Cursor.startView;
-        if (mpInfo.bufferOffset >= this->obj->GetData().GetSize())
+        if (mpInfo.bufferOffset >= GetViewSize())
             mpInfo.location = MouseLocation::Outside;
     }
 }
 
 void Instance::MoveTo(uint64 offset, bool select)
 {
-    if (this->obj->GetData().GetSize() == 0)
+    // the view also contains the lines of the zones (it can be bigger than the file)
+    const auto viewSize = GetViewSize();
+    if (viewSize == 0)
         return;
-    if (offset > (obj->GetData().GetSize() - 1))
-        offset = obj->GetData().GetSize() - 1;
+    if (offset > (viewSize - 1))
+        offset = viewSize - 1;
 
     // if (offset == this->Cursor.currentPos)
     //{
@@ -86,10 +88,12 @@ void Instance::MoveTo(uint64 offset, bool select)
 
 void Instance::MoveScrollTo(uint64 offset)
 {
-    if (this->obj->GetData().GetSize() == 0)
+    // the view also contains the lines of the zones (it can be bigger than the file)
+    const auto viewSize = GetViewSize();
+    if (viewSize == 0)
         return;
-    if (offset > (obj->GetData().GetSize() - 1))
-        offset = obj->GetData().GetSize() - 1;
+    if (offset > (viewSize - 1))
+        offset = viewSize - 1;
     auto old               = this->Cursor.startView;
     this->Cursor.startView = offset;
     if (this->Cursor.startView > old)
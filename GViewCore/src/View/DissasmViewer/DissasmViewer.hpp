@@ -92,6 +92,8 @@ namespace View
             bool isCollapsed;
 
             DissasmParseZoneType zoneType;
+
+            virtual ~ParseZone() = default;
         };
 
         struct DissasmParseStructureZone : public ParseZone
@@ -104,9 +106,30 @@ namespace View
             uint64 initalTextFileOffset;
         };
 
+        struct DissasmCodeChunk
+        {
+            uint64 entry;                // where the first instruction of the chunk starts (relative to the start of the zone)
+            uint64 exit;                 // where the first instruction after the chunk starts
+            uint32 firstLine;            // relative to the first instruction line of the zone
+            uint32 linesCount;           // estimated until the chunk is decoded
+            std::vector<uint32> offsets; // offsets of the instructions (relative to the start of the zone)
+            bool decoded;
+        };
+
+        struct DissasmCodeLine
+        {
+            uint64 offset;
+            std::string text;
+        };
+
         struct DissasmCodeZone : public ParseZone
         {
             DissasemblyZone zoneDetails;
+            uint64 startingOffset;
+            GView::Dissasembly::DissasemblerIntel dissasembler;
+            std::vector<DissasmCodeChunk> chunks; // the instructions index is built one chunk at a time (only when needed)
+            std::list<DissasmCodeLine> cachedLines; // formatted lines, the most recently used ones first
+            std::unordered_map<uint64, std::list<DissasmCodeLine>::iterator> cachedLinesIndex;
         };
 
         struct SettingsData
@@ -176,6 +199,7 @@ namespace View
                 uint32 textSize; // charactersPerLine minus the left parts
                 uint32 startingTextLineOffset;
                 bool structuresInitialCollapsedState;
+                bool codeZonesInitialCollapsedState;
             } Layout;
 
             struct
@@ -219,8 +243,17 @@ namespace View
             bool DrawStructureZone(DrawLineInfo& dli, DissasmParseStructureZone* structureZone);
             bool PrepareDrawLineInfo(DrawLineInfo& dli);
 
+            bool InitCodeZone(DissasmCodeZone* zone);
+            bool DecodeCodeChunk(DissasmCodeZone* zone, uint32 chunkIndex);
+            bool GetCodeLineOffset(DissasmCodeZone* zone, uint32 line, uint64& offset);
+            bool GetCodeOffsetLine(DissasmCodeZone* zone, uint64 offset, uint32& line);
+            const DissasmCodeLine& GetFormattedCodeLine(DissasmCodeZone* zone, uint64 offset);
+            bool DrawDissasmCodeZone(DrawLineInfo& dli, DissasmCodeZone* codeZone);
+
             void RegisterStructureCollapseButton(DrawLineInfo& dli, SpecialChars c, ParseZone* zone);
             void ChangeZoneCollapseState(ParseZone* zoneToChange);
+            void ShiftZonesAfter(ParseZone* zone, int64 linesCount);
+            uint64 GetViewSize();
 
             void AddStringToChars(DrawLineInfo& dli, ColorPair pair, const char* fmt, ...);
             void AddStringToChars(DrawLineInfo& dli, ColorPair pair, string_view stringToAdd);
@@ -41,12 +41,40 @@ Instance::Instance(const std::string_view& name, Reference<GView::Object> obj, S
     this->Layout.totalCharactersPerLine          = 1;
     this->Layout.startingTextLineOffset          = 5;
     this->Layout.structuresInitialCollapsedState = true;
+    this->Layout.codeZonesInitialCollapsedState  = false;
 
     this->codePage = CodePageID::DOS_437;
 }
 
 bool Instance::GoTo(uint64 offset)
 {
+    CHECK(offset < this->obj->GetData().GetSize(), false, "");
+    CHECK(Layout.textSize > 0, false, "");
+
+    // the lines of the zones are inserted between the text lines
+    const uint64 textLine = offset / Layout.textSize;
+    uint64 line           = textLine;
+    for (const auto& zone : settings->parseZones)
+    {
+        if (zone->textLinesOffset > textLine)
+            break;
+        if (zone->zoneType == DissasmParseZoneType::DissasmCodeParseZone)
+        {
+            auto codeZone = static_cast<DissasmCodeZone*>(zone.get());
+            if ((offset >= codeZone->startingOffset) && (offset < codeZone->startingOffset + codeZone->zoneDetails.size))
+            {
+                uint32 codeLine = 0;
+                line            = zone->startLineIndex;
+                if ((!zone->isCollapsed) && GetCodeOffsetLine(codeZone, offset, codeLine))
+                    line = zone->startLineIndex + 1ULL + codeLine; // zone lines might have moved (the chunk was decoded)
+                MoveTo(line * Layout.textSize, false);
+                return true;
+            }
+        }
+        line = zone->endingLineIndex + (textLine - zone->textLinesOffset);
+    }
+
+    MoveTo(line * Layout.textSize + offset % Layout.textSize, false);
     return true;
 }
 
@@ -107,10 +135,11 @@ int Instance::PrintCursorPosInfo(int x, int y, uint32 width, bool addSeparator,
     if (addSeparator)
         r.WriteSpecialCharacter(x++, y, SpecialChars::BoxVerticalSingleLine, this->CursorColors.Line);
 
-    if (this->obj->GetData().GetSize() > 0)
+    const auto viewSize = GetViewSize();
+    if (viewSize > 0)
     {
         LocalString<32> tmp;
-        tmp.Format("%3u%%", (this->Cursor.currentPos + 1) * 100ULL / this->obj->GetData().GetSize());
+        tmp.Format("%3u%%", (this->Cursor.currentPos + 1) * 100ULL / viewSize);
         r.WriteSingleLineText(x, y, tmp.GetText(), this->CursorColors.Normal);
     }
     else
@@ -151,52 +180,34 @@ bool Instance::PrepareDrawLineInfo(DrawLineInfo& dli)
     //          for example: search how many line from the text needs to be written -> write all of thems
 
     uint32 currentLineIndex = dli.currentLineFromOffset + dli.screenLineToDraw;
-    if (!settings->parseZones.empty())
+    dli.textLineToDraw      = currentLineIndex;
+
+    // zones are sorted by their lines: the text lines continue after every zone
+    // TODO: optimization -> instead of search every time keep the last zone index inside memmory and search from there
+    auto& zones             = settings->parseZones;
+    const uint32 zonesCount = (uint32) zones.size();
+    for (uint32 i = 0; i < zonesCount; i++)
     {
-        auto& zones       = settings->parseZones;
-        uint32 zonesCount = (uint32) settings->parseZones.size();
-        // TODO: optimization -> instead of search every time keep the last zone index inside memmory and search from there
-        for (uint32 i = 0; i < zonesCount; i++)
+        if (currentLineIndex < zones[i]->startLineIndex)
+            break;
+        if (currentLineIndex < zones[i]->endingLineIndex)
         {
-            if ((currentLineIndex >= zones[i]->startLineIndex && currentLineIndex < zones[i]->endingLineIndex))
-            {
-                // struct
-                dli.textLineToDraw       = currentLineIndex - zones[i]->startLineIndex;
-                dli.lastZoneIndexToReset = i;
-                switch (zones[i]->zoneType)
-                {
-                case DissasmParseZoneType::StructureParseZone:
-                    return DrawStructureZone(dli, (DissasmParseStructureZone*) zones[i].get());
-
-                // TODO:
-                case DissasmParseZoneType::DissasmCodeParseZone:
-                    return DrawStructureZone(dli, (DissasmParseStructureZone*) zones[i].get());
-                default:
-                    return false;
-                }
-            }
-            else
+            dli.textLineToDraw       = currentLineIndex - zones[i]->startLineIndex;
+            dli.lastZoneIndexToReset = i;
+            switch (zones[i]->zoneType)
             {
-                dli.textLineToDraw = currentLineIndex + zones[i]->textLinesOffset - zones[i]->endingLineIndex;
-                if (i + 1 >= zonesCount)
-                {
-                    return WriteTextLineToChars(dli);
-                    break;
-                }
-                if (currentLineIndex < zones[i + 1]->startLineIndex)
-                {
-                    return WriteTextLineToChars(dli);
-                }
+            case DissasmParseZoneType::StructureParseZone:
+                return DrawStructureZone(dli, (DissasmParseStructureZone*) zones[i].get());
+            case DissasmParseZoneType::DissasmCodeParseZone:
+                return DrawDissasmCodeZone(dli, (DissasmCodeZone*) zones[i].get());
+            default:
+                return false;
             }
         }
-    }
-    else
-    {
-        dli.textLineToDraw = currentLineIndex;
-        return WriteTextLineToChars(dli);
+        dli.textLineToDraw = currentLineIndex - zones[i]->endingLineIndex + zones[i]->textLinesOffset;
     }
 
-    return true;
+    return WriteTextLineToChars(dli);
 }
 
 inline void GView::View::DissasmViewer::Instance::UpdateCurrentZoneIndex(
@@ -646,55 +657,62 @@ void Instance::OnStart()
 
     // from dli, may need to be recomputed
     const uint32 textSize = Layout.textSize;
+    CHECKRET(textSize > 0, "");
 
-    uint32 lastEndMinusLastOffset = 0;
-    uint32 lastZoneEndingIndex    = 0;
-    uint16 currentIndex           = 0;
+    // TODO: rethink
+    if (settings->defaultLanguage == DissasemblyLanguage::Default)
+        settings->defaultLanguage = DissasemblyLanguage::x86;
 
+    std::vector<std::pair<uint64, std::unique_ptr<ParseZone>>> zones;
     for (const auto& mapping : this->settings->dissasmTypeMapped)
     {
         std::unique_ptr<DissasmParseStructureZone> parseZone = std::make_unique<DissasmParseStructureZone>();
-        parseZone->startLineIndex                            = (uint32) (mapping.first / textSize);
-        if (parseZone->startLineIndex < lastZoneEndingIndex)
-            parseZone->startLineIndex = lastZoneEndingIndex;
-        parseZone->endingLineIndex = parseZone->startLineIndex + 1;
-        parseZone->isCollapsed     = Layout.structuresInitialCollapsedState;
-        parseZone->extendedSize    = mapping.second.GetExpandedSize() - 1;
-        parseZone->textLinesOffset = parseZone->startLineIndex - lastEndMinusLastOffset;
-        parseZone->dissasmType     = mapping.second;
+        parseZone->isCollapsed                               = Layout.structuresInitialCollapsedState;
+        parseZone->extendedSize                              = mapping.second.GetExpandedSize() - 1;
+        parseZone->dissasmType                               = mapping.second;
         parseZone->levels.push_back(0);
         parseZone->types.emplace_back(mapping.second);
         parseZone->structureIndex       = 0;
         parseZone->textFileOffset       = mapping.first;
         parseZone->initalTextFileOffset = mapping.first;
-        parseZone->zoneID               = currentIndex++;
         parseZone->zoneType             = DissasmParseZoneType::StructureParseZone;
-
-        if (!parseZone->isCollapsed)
-            parseZone->endingLineIndex += parseZone->extendedSize;
-
-        lastEndMinusLastOffset = parseZone->endingLineIndex + parseZone->textLinesOffset;
-        lastZoneEndingIndex    = parseZone->endingLineIndex;
-        settings->parseZones.push_back(std::move(parseZone));
+        zones.emplace_back(mapping.first, std::move(parseZone));
     }
 
-    // TODO: rethink
-    if (settings->defaultLanguage == DissasemblyLanguage::Default)
-        settings->defaultLanguage = DissasemblyLanguage::x86;
-
-    // TODO: fix dissasemblyZones to be where they belong not really after structuress
-
+    const auto fileSize = this->obj->GetData().GetSize();
     for (const auto& dissasmZone : settings->dissasemblyZones)
     {
+        if ((dissasmZone.first >= fileSize) || (dissasmZone.second.size == 0))
+            continue;
+
         std::unique_ptr<DissasmCodeZone> codeZone = std::make_unique<DissasmCodeZone>();
         codeZone->zoneDetails                     = dissasmZone.second;
-        codeZone->startLineIndex                  = (uint32) (dissasmZone.first / textSize);
-        if (codeZone->startLineIndex < lastZoneEndingIndex)
-            codeZone->startLineIndex = lastZoneEndingIndex;
-        codeZone->endingLineIndex = codeZone->startLineIndex + 1;
-        codeZone->textLinesOffset = codeZone->startLineIndex - lastEndMinusLastOffset;
-        codeZone->zoneID          = currentIndex++;
-        codeZone->zoneType        = DissasmParseZoneType::DissasmCodeParseZone;
+        codeZone->zoneDetails.size                = std::min<uint64>(codeZone->zoneDetails.size, fileSize - dissasmZone.first);
+        if (codeZone->zoneDetails.language == DissasemblyLanguage::Default)
+            codeZone->zoneDetails.language = settings->defaultLanguage;
+        codeZone->startingOffset = dissasmZone.first;
+        codeZone->isCollapsed    = Layout.codeZonesInitialCollapsedState;
+        codeZone->zoneType       = DissasmParseZoneType::DissasmCodeParseZone;
+        // the instructions are not decoded here (only when their lines are painted)
+        if (InitCodeZone(codeZone.get()))
+            zones.emplace_back(dissasmZone.first, std::move(codeZone));
+    }
+
+    // the zones are inserted (in the order of their offsets) between the text lines
+    std::stable_sort(zones.begin(), zones.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    uint32 insertedLines = 0;
+    uint16 currentIndex  = 0;
+    for (auto& [offset, parseZone] : zones)
+    {
+        parseZone->textLinesOffset = (uint32) (offset / textSize);
+        parseZone->startLineIndex  = parseZone->textLinesOffset + insertedLines;
+        parseZone->endingLineIndex = parseZone->startLineIndex + 1;
+        parseZone->zoneID          = currentIndex++;
+        if (!parseZone->isCollapsed)
+            parseZone->endingLineIndex += parseZone->extendedSize;
+
+        insertedLines += parseZone->endingLineIndex - parseZone->startLineIndex;
+        settings->parseZones.push_back(std::move(parseZone));
     }
 }
 
@@ -709,26 +727,39 @@ void GView::View::DissasmViewer::Instance::RecomputeDissasmLayout()
 
 void Instance::ChangeZoneCollapseState(ParseZone* zoneToChange)
 {
-    int16 sizeToAdjust;
-    sizeToAdjust = zoneToChange->extendedSize;
+    int64 sizeToAdjust = zoneToChange->extendedSize;
     if (!zoneToChange->isCollapsed)
         sizeToAdjust *= -1;
-    zoneToChange->isCollapsed = !zoneToChange->isCollapsed;
-    zoneToChange->endingLineIndex += sizeToAdjust;
+    zoneToChange->isCollapsed     = !zoneToChange->isCollapsed;
+    zoneToChange->endingLineIndex = static_cast<uint32>(zoneToChange->endingLineIndex + sizeToAdjust);
 
+    ShiftZonesAfter(zoneToChange, sizeToAdjust);
+}
+
+void Instance::ShiftZonesAfter(ParseZone* zone, int64 linesCount)
+{
     bool foundZone = false;
-    for (auto& zone : settings->parseZones)
+    for (auto& parseZone : settings->parseZones)
     {
         if (foundZone)
         {
-            zone->startLineIndex += sizeToAdjust;
-            zone->endingLineIndex += sizeToAdjust;
+            parseZone->startLineIndex  = static_cast<uint32>(parseZone->startLineIndex + linesCount);
+            parseZone->endingLineIndex = static_cast<uint32>(parseZone->endingLineIndex + linesCount);
         }
-        if (zoneToChange->zoneID == zone->zoneID)
+        if (zone->zoneID == parseZone->zoneID)
             foundZone = true;
     }
+}
+
+uint64 Instance::GetViewSize()
+{
+    CHECK(Layout.textSize > 0, 0, "");
 
-    // TODO: search for following zones and update their size
+    // text lines and the lines inserted by the zones
+    uint64 lines = (this->obj->GetData().GetSize() + Layout.textSize - 1) / Layout.textSize;
+    for (const auto& zone : settings->parseZones)
+        lines += zone->endingLineIndex - zone->startLineIndex;
+    return lines * Layout.textSize;
 }
 
 Instance::~Instance()
@@ -0,0 +1,173 @@
+#include "GView.hpp"
+
+namespace GView::View
+{
+using namespace AppCUI::Controls;
+using namespace AppCUI::Input;
+
+constexpr int32 FUNCTIONS_GOTO        = 1;
+constexpr int32 FUNCTIONS_SELECT      = 2;
+constexpr int32 FUNCTIONS_CHANGE_BASE = 3;
+constexpr uint32 FUNCTIONS_MAX_CALLS  = 8; // callees listed for every function
+
+FunctionsPanel::FunctionsPanel(
+      Reference<Dissasembly::FunctionsAnalyzer> _analyzer,
+      Reference<WindowInterface> _win,
+      std::function<bool()> _startAnalysis,
+      NameFormatter _formatName)
+    : TabPage("&Functions"), analyzer(_analyzer), win(_win), startAnalysis(std::move(_startAnalysis)), formatName(std::move(_formatName)),
+      base(16)
+{
+    // the analysis starts when the panel is first activated; the rows are formatted only when they are visible
+    list = this->CreateChildControl<VirtualList>(
+          "d:c",
+          this,
+          std::initializer_list<VirtualListColumn>{ { "Address", 18, false },
+                                                    { "Offset", 14, false },
+                                                    { "Size", 10, false },
+                                                    { "Instructions", 14, false },
+                                                    { "Callers", 9, false },
+                                                    { "Callees", 9, false },
+                                                    { "Name", 40, true },
+                                                    { "Calls", 80, true } });
+}
+
+std::string_view FunctionsPanel::GetValue(NumericFormatter& n, uint64 value)
+{
+    if (base == 10)
+    {
+        return n.ToString(value, { NumericFormatFlags::None, 10, 3, ',' });
+    }
+
+    return n.ToString(value, { NumericFormatFlags::HexPrefix, 16 });
+}
+
+std::string_view FunctionsPanel::GetName(std::string_view name)
+{
+    // the names are given to the analysis as they are --> only the visible ones are formatted
+    if (name.empty() || !formatName)
+        return name;
+    return formatName(name);
+}
+
+bool FunctionsPanel::GetSelectedFunction(Dissasembly::FunctionInfo& f)
+{
+    // nothing to select while the analysis runs
+    if (!analyzer->IsReady())
+        return false;
+    const auto row = list->GetCurrentRow();
+    CHECK(row != GView::Utils::INVALID_OFFSET, false, "");
+    return analyzer->GetFunction(static_cast<uint32>(row), f);
+}
+
+void FunctionsPanel::Update()
+{
+    list->Refresh();
+}
+
+uint64 FunctionsPanel::GetRowsCount()
+{
+    // a single row (the status of the analysis) until the results are available
+    if (!analyzer->IsReady())
+        return 1;
+    return analyzer->GetFunctionsCount();
+}
+
+void FunctionsPanel::FormatCell(uint64 row, uint32 column, String& text)
+{
+    if (!analyzer->IsReady())
+    {
+        if (column == 6)
+            text.Set(analyzer->IsStarted() ? "Analysis in progress ..." : "Analysis not started");
+        return;
+    }
+
+    const auto index = static_cast<uint32>(row);
+    Dissasembly::FunctionInfo f{};
+    CHECKRET(analyzer->GetFunction(index, f), "");
+
+    NumericFormatter n;
+    std::vector<uint32> callees;
+    switch (column)
+    {
+    case 0:
+        text.Set(GetValue(n, f.address));
+        break;
+    case 1:
+        text.Set(GetValue(n, f.offset));
+        break;
+    case 2:
+        text.Set(GetValue(n, f.size));
+        break;
+    case 3:
+        text.Set(GetValue(n, f.instructionsCount));
+        break;
+    case 4:
+        text.Set(GetValue(n, f.callersCount));
+        break;
+    case 5:
+        text.Set(GetValue(n, f.calleesCount));
+        break;
+    case 6:
+        text.Set(GetName(f.name));
+        break;
+    case 7:
+        CHECKRET(analyzer->GetCallees(index, callees), "");
+        for (auto j = 0U; j < callees.size() && j < FUNCTIONS_MAX_CALLS; j++)
+        {
+            Dissasembly::FunctionInfo callee{};
+            CHECKRET(analyzer->GetFunction(callees[j], callee), "");
+            if (j > 0)
+                text.Add(", ");
+            const auto name = GetName(callee.name);
+            if (name.empty())
+                text.AddFormat("0x%llX", callee.address);
+            else
+                text.AddFormat("%.*s", static_cast<int32>(name.size()), name.data());
+        }
+        if (callees.size() > FUNCTIONS_MAX_CALLS)
+            text.Add(", ...");
+        break;
+    }
+}
+
+bool FunctionsPanel::OnUpdateCommandBar(AppCUI::Application::CommandBar& commandBar)
+{
+    // called when the panel is activated --> the analysis (in background) starts the first time
+    if (!analyzer->IsStarted())
+        startAnalysis();
+
+    commandBar.SetCommand(Key::Enter, "GoTo", FUNCTIONS_GOTO);
+    commandBar.SetCommand(Key::F9, "Select", FUNCTIONS_SELECT);
+    commandBar.SetCommand(Key::F2, base == 10 ? "Dec" : "Hex", FUNCTIONS_CHANGE_BASE);
+
+    return true;
+}
+
+bool FunctionsPanel::OnEvent(Reference<Control> ctrl, Event evnt, int controlID)
+{
+    CHECK(TabPage::OnEvent(ctrl, evnt, controlID) == false, true, "");
+
+    if (evnt == Event::Command)
+    {
+        Dissasembly::FunctionInfo f{};
+        switch (controlID)
+        {
+        case FUNCTIONS_GOTO:
+            if (GetSelectedFunction(f))
+                win->GetCurrentView()->GoTo(f.offset);
+            return true;
+        case FUNCTIONS_SELECT:
+            if (GetSelectedFunction(f))
+                win->GetCurrentView()->Select(f.offset, f.size);
+            return true;
+        case FUNCTIONS_CHANGE_BASE:
+            base = 26 - base;
+            Update();
+            return true;
+        }
+    }
+
+    return false;
+}
+} // namespace GView::View
@@ -0,0 +1,263 @@
+#include "GridViewer.hpp"
+
+#include <algorithm>
+
+using namespace GView::View::GridViewer;
+
+constexpr uint32 MIN_SLICE_SIZE    = 0x40000; // 256K
+constexpr uint32 DELIMITER_NEWLINE = 0x80000000U;
+constexpr uint32 DELIMITER_CR      = 0x40000000U;
+constexpr uint32 DELIMITER_OFFSET  = 0x3FFFFFFFU;
+constexpr uint32 MAX_ROW_SIZE      = 0xFFFFFFFFU;
+
+// Result of scanning one slice of a block. A delimiter (separator or new line) is valid only if it is outside of a quoted field.
+// Whether we are in a quoted field at the start of the slice is only known after the previous slices were scanned, so the
+// delimiters are split in two lists: delimiters[0] (valid if the slice starts outside quotes) and delimiters[1] (valid otherwise).
+struct SliceScan
+{
+    std::vector<uint32> delimiters[2];
+    uint32 start;
+    uint32 size;
+    uint8 quotesParity;
+};
+
+static void ScanSlice(const uint8* data, SliceScan& slice, uint8 separator)
+{
+    const auto* s = data + slice.start;
+    const auto* e = s + slice.size;
+    uint8 parity  = 0;
+
+    slice.delimiters[0].clear();
+    slice.delimiters[1].clear();
+    for (const auto* p = s; p < e; p++)
+    {
+        const auto ch = *p;
+        if (ch == '"')
+            parity ^= 1;
+        else if (ch == separator)
+            slice.delimiters[parity].push_back(static_cast<uint32>(p - s));
+        else if (ch == '\n')
+            slice.delimiters[parity].push_back(static_cast<uint32>(p - s) | DELIMITER_NEWLINE);
+        else if (ch == '\r')
+            slice.delimiters[parity].push_back(static_cast<uint32>(p - s) | DELIMITER_NEWLINE | DELIMITER_CR);
+    }
+    slice.quotesParity = parity;
+}
+
+// builds the index from the (valid) delimiters, in file order
+class IndexBuilder
+{
+    std::vector<CellIndex::Chunk>& chunks;
+    uint64 nextRowStart;
+    uint64 lastCR;
+    uint32 maxCells;
+    bool rowOpened;
+    bool newChunk;
+
+    inline CellIndex::Chunk& Current()
+    {
+        return chunks.back();
+    }
+    inline void OpenRow()
+    {
+        if ((newChunk) || (chunks.empty()) || (nextRowStart - Current().offset >= MAX_ROW_SIZE))
+        {
+            chunks.emplace_back();
+            Current().offset = nextRowStart;
+            newChunk         = false;
+        }
+        auto& c = Current();
+        c.rows.push_back(static_cast<uint32>(c.cells.size()));
+        c.cells.push_back(static_cast<uint32>(nextRowStart - c.offset));
+        rowOpened = true;
+    }
+    inline void CloseRow(uint64 end)
+    {
+        auto& c = Current();
+        // rows bigger than 4G are truncated
+        c.cells.push_back(static_cast<uint32>(std::min<uint64>(end - c.offset, MAX_ROW_SIZE)));
+        maxCells  = std::max<uint32>(maxCells, static_cast<uint32>(c.cells.size() - c.rows.back() - 1));
+        rowOpened = false;
+    }
+
+  public:
+    IndexBuilder(std::vector<CellIndex::Chunk>& _chunks)
+        : chunks(_chunks), nextRowStart(0), lastCR(GView::Utils::INVALID_OFFSET), maxCells(0), rowOpened(false), newChunk(true)
+    {
+    }
+    inline void StartNewChunk()
+    {
+        newChunk = true;
+    }
+    void Add(uint64 sliceOffset, const std::vector<uint32>& delimiters)
+    {
+        for (auto d : delimiters)
+        {
+            const auto pos = sliceOffset + (d & DELIMITER_OFFSET);
+            if ((d & DELIMITER_NEWLINE) == 0)
+            {
+                if (!rowOpened)
+                    OpenRow();
+                auto& c = Current();
+                if (pos + 1 - c.offset < MAX_ROW_SIZE)
+                    c.cells.push_back(static_cast<uint32>(pos + 1 - c.offset));
+                continue;
+            }
+            if ((!rowOpened) && (lastCR != GView::Utils::INVALID_OFFSET) && (lastCR + 1 == pos) && ((d & DELIMITER_CR) == 0))
+            {
+                // second part of a CRLF sequence
+                nextRowStart = pos + 1;
+                lastCR       = GView::Utils::INVALID_OFFSET;
+                continue;
+            }
+            if (!rowOpened)
+                OpenRow();
+            CloseRow(pos);
+            nextRowStart = pos + 1;
+            lastCR       = (d & DELIMITER_CR) ? pos : GView::Utils::INVALID_OFFSET;
+        }
+    }
+    void Finish(uint64 fileSize)
+    {
+        if ((!rowOpened) && (nextRowStart < fileSize))
+            OpenRow();
+        if (rowOpened)
+            CloseRow(fileSize);
+    }
+    inline uint32 GetMaxCells() const
+    {
+        return maxCells;
+    }
+};
+
+CellIndex::CellIndex() : rowsCount(0), columnsCount(0)
+{
+}
+
+void CellIndex::Clear()
+{
+    chunks.clear();
+    rowsCount    = 0;
+    columnsCount = 0;
+}
+
+bool CellIndex::Build(Reference<GView::Object> obj, char separator)
+{
+    Clear();
+
+    auto& cache           = obj->GetData();
+    const auto fileSize   = cache.GetSize();
+    const auto blockSize  = cache.GetCacheSize();
+    const auto maxSlices  = GView::Utils::GetParallelWorkersCount();
+    uint8 quotesParity    = 0;
+    uint64 offset         = 0;
+    IndexBuilder builder(chunks);
+    std::vector<SliceScan> slices(maxSlices);
+    LocalString<128> ls;
+
+    ProgressStatus::Init("Indexing rows...", fileSize);
+    while (offset < fileSize)
+    {
+        // the block stays valid (in cache) until the next Get call
+        const auto block = cache.Get(offset, blockSize, false);
+        CHECK(block.IsValid() && block.GetLength() > 0, false, "Fail to read %u bytes from offset %llu", blockSize, offset);
+
+        // each slice of the block is scanned on a different thread
+        const auto slicesCount = std::max<uint32>(1, std::min<uint32>(maxSlices, block.GetLength() / MIN_SLICE_SIZE));
+        const auto sliceSize   = block.GetLength() / slicesCount;
+        for (auto i = 0U; i < slicesCount; i++)
+        {
+            slices[i].start = i * sliceSize;
+            slices[i].size  = (i + 1 == slicesCount) ? block.GetLength() - slices[i].start : sliceSize;
+        }
+        GView::Utils::ParallelFor(slicesCount, [&](uint32 index) { ScanSlice(block.GetData(), slices[index], (uint8) separator); });
+
+        // now we know (for each slice) if it starts within a quoted field or not --> keep only the valid delimiters
+        builder.StartNewChunk();
+        for (auto i = 0U; i < slicesCount; i++)
+        {
+            builder.Add(offset + slices[i].start, slices[i].delimiters[quotesParity]);
+            quotesParity ^= slices[i].quotesParity;
+        }
+
+        offset += block.GetLength();
+        if (ProgressStatus::Update(offset, ls.Format("Indexing rows (%llu MB / %llu MB)...", offset >> 20, fileSize >> 20)))
+            break;
+    }
+    builder.Finish(std::min<>(offset, fileSize));
+
+    // compute the index of the first row for each chunk
+    for (auto& c : chunks)
+    {
+        c.firstRow = rowsCount;
+        rowsCount += c.rows.size();
+        c.rows.shrink_to_fit();
+        c.cells.shrink_to_fit();
+    }
+    columnsCount = builder.GetMaxCells();
+
+    return true;
+}
+
+const CellIndex::Chunk* CellIndex::GetChunk(uint64 row, uint32& rowInChunk) const
+{
+    CHECK(row < rowsCount, nullptr, "");
+    auto it = std::upper_bound(chunks.begin(), chunks.end(), row, [](uint64 r, const Chunk& c) { return r < c.firstRow; });
+    CHECK(it != chunks.begin(), nullptr, "");
+    it--;
+    rowInChunk = static_cast<uint32>(row - it->firstRow);
+    return &(*it);
+}
+
+uint32 CellIndex::GetCellsCount(uint64 row) const
+{
+    uint32 r;
+    const auto* c = GetChunk(row, r);
+    CHECK(c, 0, "");
+    const auto first = c->rows[r];
+    const auto last  = (r + 1 < c->rows.size()) ? c->rows[r + 1] : static_cast<uint32>(c->cells.size());
+    return last - first - 1;
+}
+
+bool CellIndex::GetCell(uint64 row, uint32 column, uint64& start, uint64& end) const
+{
+    uint32 r;
+    const auto* c = GetChunk(row, r);
+    CHECK(c, false, "");
+    const auto first = c->rows[r];
+    const auto last  = (r + 1 < c->rows.size()) ? c->rows[r + 1] : static_cast<uint32>(c->cells.size());
+    CHECK(first + column + 1 < last, false, "");
+
+    start = c->offset + c->cells[first + column];
+    // a cell ends where the next one begins (without the separator) or at the end of the row
+    if (first + column + 2 < last)
+        end = c->offset + c->cells[first + column + 1] - 1;
+    else
+        end = c->offset + c->cells[last - 1];
+    return true;
+}
+
+bool CellIndex::GetRow(uint64 row, uint64& start, uint64& end) const
+{
+    uint32 r;
+    const auto* c = GetChunk(row, r);
+    CHECK(c, false, "");
+    const auto last = (r + 1 < c->rows.size()) ? c->rows[r + 1] : static_cast<uint32>(c->cells.size());
+    start           = c->offset + c->cells[c->rows[r]];
+    end             = c->offset + c->cells[last - 1];
+    return true;
+}
+
+bool CellIndex::OffsetToRow(uint64 offset, uint64& row) const
+{
+    CHECK(rowsCount > 0, false, "");
+    CHECK(offset >= chunks.front().offset, false, "");
+    auto it = std::upper_bound(chunks.begin(), chunks.end(), offset, [](uint64 o, const Chunk& c) { return o < c.offset; });
+    it--;
+    const auto relative = offset - it->offset;
+    auto rowIt          = std::upper_bound(
+          it->rows.begin(), it->rows.end(), relative, [&it](uint64 o, uint32 rowFirstCell) { return o < it->cells[rowFirstCell]; });
+    CHECK(rowIt != it->rows.begin(), false, "");
+    row = it->firstRow + static_cast<uint64>((rowIt - it->rows.begin()) - 1);
+    return true;
+}
@@ -6,12 +6,20 @@ using namespace AppCUI::Input;
 constexpr Key KEY_REPLACE_HEADER_WITH_1ST_ROW = Key::Space;
 constexpr Key KEY_TOGGLE_HORIZONTAL_LINES     = Key::H;
 constexpr Key KEY_TOGGLE_VERTICAL_LINES       = Key::V;
+constexpr Key KEY_SORT_COLUMN                 = Key::S;
+constexpr Key KEY_FILTER_COLUMN               = Key::F;
+constexpr Key KEY_RESET_VIEW                  = Key::R;
+constexpr Key KEY_COLUMN_STATISTICS           = Key::I;
 
 void Config::Update(IniSection sect)
 {
     sect.UpdateValue("Key.ReplaceHeaderWith1stRow", KEY_REPLACE_HEADER_WITH_1ST_ROW, true);
     sect.UpdateValue("Key.ToggleHorizontalLines", KEY_TOGGLE_HORIZONTAL_LINES, true);
     sect.UpdateValue("Key.ToggleVerticalLines", KEY_TOGGLE_VERTICAL_LINES, true);
+    sect.UpdateValue("Key.SortColumn", KEY_SORT_COLUMN, true);
+    sect.UpdateValue("Key.FilterColumn", KEY_FILTER_COLUMN, true);
+    sect.UpdateValue("Key.ResetView", KEY_RESET_VIEW, true);
+    sect.UpdateValue("Key.ColumnStatistics", KEY_COLUMN_STATISTICS, true);
 }
 
 void Config::Initialize()
@@ -23,12 +31,20 @@ void Config::Initialize()
         this->keys.replaceHeaderWith1stRow = sect.GetValue("Key.ReplaceHeaderWith1stRow").ToKey(KEY_REPLACE_HEADER_WITH_1ST_ROW);
         this->keys.toggleHorizontalLines   = sect.GetValue("Key.ToggleHorizontalLines").ToKey(KEY_TOGGLE_HORIZONTAL_LINES);
         this->keys.toggleVerticalLines     = sect.GetValue("Key.ToggleVerticalLines").ToKey(KEY_TOGGLE_VERTICAL_LINES);
+        this->keys.sortColumn              = sect.GetValue("Key.SortColumn").ToKey(KEY_SORT_COLUMN);
+        this->keys.filterColumn            = sect.GetValue("Key.FilterColumn").ToKey(KEY_FILTER_COLUMN);
+        this->keys.resetView               = sect.GetValue("Key.ResetView").ToKey(KEY_RESET_VIEW);
+        this->keys.columnStatistics        = sect.GetValue("Key.ColumnStatistics").ToKey(KEY_COLUMN_STATISTICS);
     }
     else
     {
         this->keys.replaceHeaderWith1stRow = KEY_REPLACE_HEADER_WITH_1ST_ROW;
         this->keys.toggleHorizontalLines   = KEY_TOGGLE_HORIZONTAL_LINES;
         this->keys.toggleVerticalLines     = KEY_TOGGLE_VERTICAL_LINES;
+        this->keys.sortColumn              = KEY_SORT_COLUMN;
+        this->keys.filterColumn            = KEY_FILTER_COLUMN;
+        this->keys.resetView               = KEY_RESET_VIEW;
+        this->keys.columnStatistics        = KEY_COLUMN_STATISTICS;
     }
 
     loaded = true;
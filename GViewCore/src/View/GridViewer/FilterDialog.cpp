@@ -0,0 +1,71 @@
+#include "GridViewer.hpp"
+
+using namespace GView::View::GridViewer;
+using namespace AppCUI::Input;
+
+constexpr int32 BTN_ID_OK     = 1;
+constexpr int32 BTN_ID_CANCEL = 2;
+
+FilterDialog::FilterDialog(std::string_view columnName, ColumnType type)
+    : Window("Filter", "d:c,w:60,h:11", WindowFlags::ProcessReturn), operation(FilterOperation::Equals)
+{
+    LocalString<128> tmp;
+    Factory::Label::Create(this, tmp.Format("Column: %.*s", (int) columnName.size(), columnName.data()), "x:1,y:1,w:40");
+    Factory::Label::Create(this, tmp.Format("Type  : %s", TableEngine::ColumnTypeToString(type).data()), "x:42,y:1,w:16");
+    Factory::Label::Create(this, "&Operation", "x:1,y:3,w:10");
+    Factory::Label::Create(this, "&Value", "x:1,y:5,w:10");
+    comboOperation = Factory::ComboBox::Create(
+          this, "x:12,y:3,w:44", "Equals,Not equals,Contains,Starts with,Less than,Less or equal,Greater than,Greater or equal");
+    txValue = Factory::TextField::Create(this, "", "x:12,y:5,w:44");
+    comboOperation->SetHotKey('O');
+    comboOperation->SetCurentItemIndex(0);
+    txValue->SetHotKey('V');
+
+    Factory::Button::Create(this, "&OK", "l:16,b:0,w:13", BTN_ID_OK);
+    Factory::Button::Create(this, "&Cancel", "l:31,b:0,w:13", BTN_ID_CANCEL);
+
+    txValue->SetFocus();
+}
+
+void FilterDialog::Validate()
+{
+    LocalString<256> tmp;
+    if (tmp.Set(txValue->GetText()) == false)
+    {
+        Dialogs::MessageBox::ShowError("Error", "Invalid value (expecting ascii characters) !");
+        txValue->SetFocus();
+        return;
+    }
+    // the order of the items from the combo box is the same as the order of FilterOperation values
+    operation = static_cast<FilterOperation>(comboOperation->GetCurrentItemIndex());
+    value     = tmp.GetText();
+    Exit(Dialogs::Result::Ok);
+}
+
+bool FilterDialog::OnEvent(Reference<Control> control, Event eventType, int ID)
+{
+    if (eventType == Event::ButtonClicked)
+    {
+        switch (ID)
+        {
+        case BTN_ID_CANCEL:
+            Exit(Dialogs::Result::Cancel);
+            return true;
+        case BTN_ID_OK:
+            Validate();
+            return true;
+        }
+    }
+
+    switch (eventType)
+    {
+    case Event::WindowAccept:
+        Validate();
+        return true;
+    case Event::WindowClose:
+        Exit(Dialogs::Result::Cancel);
+        return true;
+    }
+
+    return false;
+}
@@ -10,15 +10,153 @@ namespace View
     {
         struct SettingsData
         {
-            std::map<uint64, std::pair<uint64, uint64>> lines;
-            std::map<uint64, std::vector<std::pair<uint64, uint64>>> tokens;
             char separator[2]{ "," };
-            uint64 rows           = 0;
-            uint64 cols           = 0;
             bool firstRowAsHeader = false;
             SettingsData();
         };
 
+        // Index of all the rows and cells of a CSV/TSV object.
+        // Rows are grouped in chunks (one chunk for each block of the file that was parsed). Each chunk keeps the absolute offset of
+        // its first row and stores every other offset relative to it (uint32), so that the index stays small for very large files.
+        // Quoted fields (that may contain separators or new lines) are supported.
+        class CellIndex
+        {
+          public:
+            struct Chunk
+            {
+                uint64 offset;             // file offset of the first row from this chunk
+                uint64 firstRow;           // index of the first row from this chunk
+                std::vector<uint32> rows;  // for each row --> index (in 'cells') of its first cell
+                std::vector<uint32> cells; // for each row --> the start of each cell followed by the end of the row
+            };
+
+          private:
+            std::vector<Chunk> chunks;
+            uint64 rowsCount;
+            uint32 columnsCount;
+
+            const Chunk* GetChunk(uint64 row, uint32& rowInChunk) const;
+
+          public:
+            CellIndex();
+
+            bool Build(Reference<GView::Object> obj, char separator);
+            void Clear();
+
+            inline uint64 GetRowsCount() const
+            {
+                return rowsCount;
+            }
+            inline uint32 GetColumnsCount() const
+            {
+                return columnsCount;
+            }
+            uint32 GetCellsCount(uint64 row) const;
+            bool GetCell(uint64 row, uint32 column, uint64& start, uint64& end) const;
+            bool GetRow(uint64 row, uint64& start, uint64& end) const;
+            bool OffsetToRow(uint64 offset, uint64& row) const;
+        };
+
+        enum class ColumnType : uint8
+        {
+            Empty,
+            Integer,
+            Float,
+            Date,
+            String
+        };
+
+        enum class FilterOperation : uint8
+        {
+            Equals,
+            NotEquals,
+            Contains,
+            StartsWith,
+            Less,
+            LessOrEqual,
+            Greater,
+            GreaterOrEqual
+        };
+
+        struct ColumnStatistics
+        {
+            ColumnType type;
+            uint64 count;    // non-empty cells
+            uint64 empty;    // empty cells
+            uint64 distinct; // distinct (non-empty) values
+            bool approximateDistinct; // too many distinct values --> counted by their hashes
+            std::string min;
+            std::string max;
+        };
+
+        // Sort / filter / statistics engine over the cells of a CellIndex.
+        // The file is never copied: the engine only keeps a permutation of rows (the current view) and, while sorting, one 64-bit key
+        // for each row. Without any sort or filter the view is the identity (no memory is used for it).
+        class TableEngine
+        {
+            struct SortEntry
+            {
+                uint64 key;
+                uint64 row;
+            };
+
+            Reference<GView::Object> obj;
+            const CellIndex* index;
+            std::vector<uint64> rows; // current view (file rows) - only used if 'allRows' is false
+            std::string value;        // last value read by GetCellValue
+            uint64 firstRow;          // first row that contains data (1 if the first row is the header)
+            uint32 sortColumn;
+            bool sortAscending;
+            bool allRows;
+
+            bool ForEachRow(std::string_view message, std::function<void(uint64 position, uint64 fileRow)> callback);
+            bool RefineStringRuns(std::vector<SortEntry>& entries, uint32 column, bool ascending);
+
+          public:
+            static constexpr uint32 NO_COLUMN = 0xFFFFFFFF;
+
+            TableEngine();
+
+            void Init(Reference<GView::Object> obj, const CellIndex& index, uint64 firstRow);
+            void Reset();
+
+            inline uint64 GetAllRowsCount() const
+            {
+                return (index) && (index->GetRowsCount() > firstRow) ? index->GetRowsCount() - firstRow : 0;
+            }
+            inline uint64 GetRowsCount() const
+            {
+                return allRows ? GetAllRowsCount() : rows.size();
+            }
+            inline uint64 GetFileRow(uint64 row) const
+            {
+                return allRows ? row + firstRow : rows[row];
+            }
+            inline bool IsFiltered() const
+            {
+                return GetRowsCount() != GetAllRowsCount();
+            }
+            inline uint32 GetSortColumn() const
+            {
+                return sortColumn;
+            }
+            inline bool IsSortAscending() const
+            {
+                return sortAscending;
+            }
+            bool FileRowToRow(uint64 fileRow, uint64& row) const;
+
+            // unquoted content of a cell (only the first bytes of large cells are read) - valid until the next call
+            std::string_view GetCellValue(uint64 fileRow, uint32 column);
+
+            ColumnType DetectColumnType(uint32 column);
+            bool Sort(uint32 column, bool ascending);
+            bool Filter(uint32 column, FilterOperation operation, std::string_view value);
+            bool ComputeStatistics(uint32 column, ColumnStatistics& stats);
+
+            static std::string_view ColumnTypeToString(ColumnType type);
+        };
+
         struct Config
         {
             struct
@@ -26,6 +164,10 @@ namespace View
                 AppCUI::Input::Key replaceHeaderWith1stRow;
                 AppCUI::Input::Key toggleHorizontalLines;
                 AppCUI::Input::Key toggleVerticalLines;
+                AppCUI::Input::Key sortColumn;
+                AppCUI::Input::Key filterColumn;
+                AppCUI::Input::Key resetView;
+                AppCUI::Input::Key columnStatistics;
             } keys;
             struct
             {
@@ -47,15 +189,36 @@ namespace View
           private:
             Reference<GView::Object> obj;
             FixSizeString<29> name;
-
-            Reference<AppCUI::Controls::Grid> grid;
             Pointer<SettingsData> settings;
+            CellIndex index;
+            TableEngine engine;
+            std::vector<uint32> columnsWidth;
+            uint32 rowNumberWidth;
+            bool showHorizontalLines;
+            bool showVerticalLines;
+
+            struct
+            {
+                uint64 row;
+                uint32 column;
+            } Cursor;
+            struct
+            {
+                uint64 row;
+                uint32 column;
+            } ViewPort;
 
             static Config config;
 
           public:
             Instance(const std::string_view& name, Reference<GView::Object> obj, Settings* settings);
 
+            virtual void Paint(Graphics::Renderer& renderer) override;
+            virtual bool OnKeyEvent(AppCUI::Input::Key keyCode, char16 characterCode) override;
+            virtual void OnMousePressed(int x, int y, AppCUI::Input::MouseButton button) override;
+            virtual bool OnMouseWheel(int x, int y, AppCUI::Input::MouseWheel direction) override;
+            virtual void OnUpdateScrollBars() override;
+
             bool GoTo(uint64 offset) override;
             bool Select(uint64 offset, uint64 size) override;
             virtual bool ShowGoToDialog() override;
@@ -77,15 +240,45 @@ namespace View
             const vector<Property> GetPropertiesList() override;
 
           private:
-            void PopulateGrid();
             void ProcessContent();
-            void PaintCursorInformationWidth(AppCUI::Graphics::Renderer& renderer, unsigned int x, unsigned int y);
-            void PaintCursorInformationHeight(AppCUI::Graphics::Renderer& renderer, unsigned int x, unsigned int y);
-            void PaintCursorInformationCells(AppCUI::Graphics::Renderer& renderer, unsigned int x, unsigned int y);
-            void PaintCursorInformationCurrentLocation(AppCUI::Graphics::Renderer& renderer, unsigned int x, unsigned int y);
-            void PaintCursorInformationSelection(AppCUI::Graphics::Renderer& renderer, unsigned int x, unsigned int y);
+            void ComputeColumnsWidth();
+            void SortCurrentColumn();
+            void FilterCurrentColumn();
+            void ShowColumnStatistics();
+            std::string_view FormatRowsCount(LocalString<128>& text);
+            uint64 GetRowsCount() const;
+            uint64 GetFileRow(uint64 row) const;
+            uint32 GetVisibleRowsCount() const;
+            uint32 GetLastVisibleColumn() const;
+            void MoveTo(uint64 row, uint32 column);
+            void FormatCell(uint64 fileRow, uint32 column, uint32 width, LocalString<256>& text);
+            void FormatColumnName(uint32 column, LocalString<256>& text);
+            void PaintHeader(Graphics::Renderer& renderer);
+            void PaintRow(Graphics::Renderer& renderer, uint64 row, int y);
             void PaintCursorInformationSeparator(AppCUI::Graphics::Renderer& renderer, unsigned int x, unsigned int y);
         };
+
+        class FilterDialog : public Window
+        {
+            Reference<ComboBox> comboOperation;
+            Reference<TextField> txValue;
+            FilterOperation operation;
+            std::string value;
+            void Validate();
+
+          public:
+            FilterDialog(std::string_view columnName, ColumnType type);
+
+            virtual bool OnEvent(Reference<Control>, Event eventType, int ID) override;
+            inline FilterOperation GetOperation() const
+            {
+                return operation;
+            }
+            inline std::string_view GetValue() const
+            {
+                return value;
+            }
+        };
     } // namespace GridViewer
 } // namespace View
 }; // namespace GView
\ No newline at end of file
@@ -6,14 +6,28 @@ using namespace AppCUI::Input;
 constexpr uint32 PROP_ID_REPLACE_HEADER_WITH_1ST_ROW = 0;
 constexpr uint32 PROP_ID_TOGGLE_HORIZONTAL_LINES     = 1;
 constexpr uint32 PROP_ID_TOGGLE_VERTICAL_LINES       = 2;
+constexpr uint32 PROP_ID_SORT_COLUMN                 = 3;
+constexpr uint32 PROP_ID_FILTER_COLUMN               = 4;
+constexpr uint32 PROP_ID_RESET_VIEW                  = 5;
+constexpr uint32 PROP_ID_COLUMN_STATISTICS           = 6;
 
 constexpr uint32 COMMAND_ID_REPLACE_HEADER_WITH_1ST_ROW = 0x1000;
 constexpr uint32 COMMAND_ID_TOGGLE_HORIZONTAL_LINES     = 0x1001;
 constexpr uint32 COMMAND_ID_TOGGLE_VERTICAL_LINES       = 0x1002;
+constexpr uint32 COMMAND_ID_SORT_COLUMN                 = 0x1003;
+constexpr uint32 COMMAND_ID_FILTER_COLUMN               = 0x1004;
+constexpr uint32 COMMAND_ID_RESET_VIEW                  = 0x1005;
+constexpr uint32 COMMAND_ID_COLUMN_STATISTICS           = 0x1006;
+
+constexpr uint32 MIN_COLUMN_WIDTH       = 3;
+constexpr uint32 MAX_COLUMN_WIDTH       = 40;
+constexpr uint32 ROWS_TO_SAMPLE         = 256;
+constexpr uint32 MAX_CELL_BYTES_TO_READ = 1024;
 
 Config Instance::config;
 
-Instance::Instance(const std::string_view& name, Reference<GView::Object> obj, Settings* _settings) : settings(nullptr)
+Instance::Instance(const std::string_view& name, Reference<GView::Object> obj, Settings* _settings)
+    : settings(nullptr), ViewControl(UserControlFlags::ShowVerticalScrollBar | UserControlFlags::ScrollBarOutsideControl)
 {
     this->obj  = obj;
     this->name = name;
@@ -31,17 +45,13 @@ Instance::Instance(const std::string_view& name, Reference<GView::Object> obj, S
         settings.reset(new SettingsData());
     }
 
-    if (settings)
-    {
-        grid = AppCUI::Controls::Factory::Grid::Create(
-              this,
-              "d:c,w:100%,h:100%",
-              static_cast<uint32>(settings->cols),
-              static_cast<uint32>(settings->rows),
-              AppCUI::Controls::GridFlags::Sort | AppCUI::Controls::GridFlags::Filter | GridFlags::DisableDuplicates);
-
-        grid->SetSeparator(settings->separator);
-    }
+    this->rowNumberWidth      = 1;
+    this->showHorizontalLines = false;
+    this->showVerticalLines   = true;
+    this->Cursor.row          = 0;
+    this->Cursor.column       = 0;
+    this->ViewPort.row        = 0;
+    this->ViewPort.column     = 0;
 
     if (config.loaded == false)
         config.Initialize();
@@ -54,12 +64,17 @@ std::string_view Instance::GetName()
 
 bool Instance::GoTo(uint64 offset)
 {
+    uint64 fileRow, row;
+    CHECK(index.OffsetToRow(offset, fileRow), false, "");
+    // the header row (if any) or the rows that were filtered out are not part of the grid
+    CHECK(engine.FileRowToRow(fileRow, row), false, "");
+    MoveTo(row, Cursor.column);
     return true;
 }
 
 bool Instance::Select(uint64 offset, uint64 size)
 {
-    return true;
+    return GoTo(offset);
 }
 
 bool Instance::ShowGoToDialog()
@@ -77,341 +92,463 @@ bool Instance::ShowCopyDialog()
     NOT_IMPLEMENTED(false);
 }
 
-void Instance::PaintCursorInformation(AppCUI::Graphics::Renderer& renderer, unsigned int width, unsigned int height)
+uint64 Instance::GetRowsCount() const
 {
-    if (height == 1)
+    return engine.GetRowsCount();
+}
+
+uint64 Instance::GetFileRow(uint64 row) const
+{
+    return engine.GetFileRow(row);
+}
+
+uint32 Instance::GetVisibleRowsCount() const
+{
+    const auto height = this->GetHeight();
+    if (height <= 1)
+        return 1;
+    const auto count = static_cast<uint32>(height - 1); // first line is the header
+    return showHorizontalLines ? std::max<uint32>(1, (count + 1) / 2) : count;
+}
+
+uint32 Instance::GetLastVisibleColumn() const
+{
+    if (columnsWidth.empty())
+        return 0;
+    auto x      = rowNumberWidth + 1;
+    auto column = ViewPort.column;
+    while (column < columnsWidth.size())
     {
-        const uint32 x1 = 1;
-        const uint32 x2 = x1 + config.cursorInformationCellSpace + 1;
-        const uint32 x3 = x2 + config.cursorInformationCellSpace + 1;
-        const uint32 x4 = x3 + config.cursorInformationCellSpace + 1;
-        const uint32 x5 = x4 + config.cursorInformationCellSpace + 1;
-        const uint32 x6 = x5 + config.cursorInformationCellSpace + 1;
-        const uint32 y  = 0;
-
-        PaintCursorInformationWidth(renderer, x1, y);
-        PaintCursorInformationSeparator(renderer, x2 - 1, y);
-        PaintCursorInformationHeight(renderer, x2, y);
-        PaintCursorInformationSeparator(renderer, x3 - 1, y);
-        PaintCursorInformationCells(renderer, x3, y);
-        PaintCursorInformationSeparator(renderer, x4 - 1, y);
-        PaintCursorInformationCurrentLocation(renderer, x4, y);
-        PaintCursorInformationSeparator(renderer, x5 - 1, y);
-        PaintCursorInformationSelection(renderer, x5, y);
+        x += columnsWidth[column] + 1;
+        if (x > static_cast<uint32>(this->GetWidth()))
+            break;
+        column++;
     }
-    else if (height > 1)
+    return column > ViewPort.column ? column - 1 : ViewPort.column;
+}
+
+void Instance::MoveTo(uint64 row, uint32 column)
+{
+    const auto rowsCount = GetRowsCount();
+    if (rowsCount == 0)
+        return;
+    row    = std::min<uint64>(row, rowsCount - 1);
+    column = std::min<uint32>(column, columnsWidth.empty() ? 0 : static_cast<uint32>(columnsWidth.size() - 1));
+
+    const auto visibleRows = GetVisibleRowsCount();
+    if (row < ViewPort.row)
+        ViewPort.row = row;
+    else if (row >= ViewPort.row + visibleRows)
+        ViewPort.row = row + 1 - visibleRows;
+
+    if (column < ViewPort.column)
+        ViewPort.column = column;
+    else
     {
-        const uint32 x1 = 1;
-        const uint32 x2 = 1;
-        const uint32 x3 = x1 + config.cursorInformationCellSpace + 1;
-        const uint32 x4 = x2 + config.cursorInformationCellSpace + 1;
-        const uint32 x5 = x3 + config.cursorInformationCellSpace + 1;
-        const uint32 x6 = x4 + config.cursorInformationCellSpace + 1;
-        const uint32 y1 = 0;
-        const uint32 y2 = 1;
-
-        PaintCursorInformationWidth(renderer, x1, y1);
-        PaintCursorInformationHeight(renderer, x2, y2);
-        PaintCursorInformationSeparator(renderer, x2 - 1, y1);
-        PaintCursorInformationCells(renderer, x3, y1);
-        PaintCursorInformationCurrentLocation(renderer, x4, y2);
-        PaintCursorInformationSeparator(renderer, x4 - 1, y1);
-        PaintCursorInformationSelection(renderer, x5, y1);
+        while ((column > GetLastVisibleColumn()) && (ViewPort.column < column))
+            ViewPort.column++;
     }
+
+    Cursor.row    = row;
+    Cursor.column = column;
 }
 
-bool Instance::OnUpdateCommandBar(AppCUI::Application::CommandBar& commandBar)
+void Instance::FormatColumnName(uint32 column, LocalString<256>& text)
 {
-    commandBar.SetCommand(config.keys.replaceHeaderWith1stRow, "ReplaceHeader", COMMAND_ID_REPLACE_HEADER_WITH_1ST_ROW);
-    commandBar.SetCommand(config.keys.toggleHorizontalLines, "ToggleHorizontalLines", COMMAND_ID_TOGGLE_HORIZONTAL_LINES);
-    commandBar.SetCommand(config.keys.toggleVerticalLines, "ToggleVerticalLines", COMMAND_ID_TOGGLE_VERTICAL_LINES);
-    return false;
+    if (settings->firstRowAsHeader)
+    {
+        FormatCell(0, column, MAX_COLUMN_WIDTH, text);
+        return;
+    }
+    // A, B, ... Z, AA, AB, ...
+    char temp[16];
+    auto pos = sizeof(temp);
+    auto n   = column + 1;
+    while ((n > 0) && (pos > 0))
+    {
+        temp[--pos] = 'A' + static_cast<char>((n - 1) % 26);
+        n           = (n - 1) / 26;
+    }
+    text.Set(temp + pos, static_cast<uint32>(sizeof(temp) - pos));
 }
 
-bool Instance::OnEvent(Reference<Control> control, Event eventType, int ID)
+void Instance::FormatCell(uint64 fileRow, uint32 column, uint32 width, LocalString<256>& text)
 {
-    if (eventType == Event::Command)
+    text.Clear();
+    uint64 start, end;
+    if ((!index.GetCell(fileRow, column, start, end)) || (start >= end))
+        return;
+
+    const auto buf = obj->GetData().Get(start, static_cast<uint32>(std::min<uint64>(end - start, MAX_CELL_BYTES_TO_READ)), false);
+    auto* p        = buf.GetData();
+    auto* e        = p + buf.GetLength();
+    if ((p < e) && (*p == '"'))
     {
-        if (ID == COMMAND_ID_REPLACE_HEADER_WITH_1ST_ROW)
-        {
-            settings->firstRowAsHeader = !settings->firstRowAsHeader;
-            PopulateGrid();
-            return true;
-        }
-        else if (ID == COMMAND_ID_TOGGLE_HORIZONTAL_LINES)
-        {
-            grid->ToggleHorizontalLines();
-            return true;
-        }
-        else if (ID == COMMAND_ID_TOGGLE_VERTICAL_LINES)
+        // quoted field --> show the content (without quotes and with "" converted to ")
+        p++;
+        if ((end - start <= MAX_CELL_BYTES_TO_READ) && (p < e) && (*(e - 1) == '"'))
+            e--;
+    }
+    width = std::min<uint32>(width, 255);
+    for (; (p < e) && (text.Len() < width); p++)
+    {
+        auto ch = static_cast<char>(*p);
+        if ((ch == '"') && (p + 1 < e) && (p[1] == '"'))
+            p++;
+        if ((ch == '\n') || (ch == '\r') || (ch == '\t'))
+            ch = ' ';
+        text.AddChar(ch);
+    }
+}
+
+void Instance::ComputeColumnsWidth()
+{
+    LocalString<256> text;
+    columnsWidth.clear();
+    columnsWidth.resize(index.GetColumnsCount(), MIN_COLUMN_WIDTH);
+
+    // only the first rows are used to estimate the width of a column (the content is never fully read)
+    const auto rowsToSample = std::min<uint64>(index.GetRowsCount(), ROWS_TO_SAMPLE);
+    for (auto row = 0ULL; row < rowsToSample; row++)
+    {
+        const auto cells = std::min<uint32>(index.GetCellsCount(row), static_cast<uint32>(columnsWidth.size()));
+        for (auto column = 0U; column < cells; column++)
         {
-            grid->ToggleVerticalLines();
-            return true;
+            FormatCell(row, column, MAX_COLUMN_WIDTH, text);
+            columnsWidth[column] = std::max<uint32>(columnsWidth[column], text.Len());
         }
     }
+    for (auto column = 0U; column < columnsWidth.size(); column++)
+    {
+        FormatColumnName(column, text);
+        columnsWidth[column] = std::min<uint32>(std::max<uint32>(columnsWidth[column], text.Len()), MAX_COLUMN_WIDTH);
+    }
 
-    return false;
+    // row number column
+    rowNumberWidth = 1;
+    for (auto n = GetRowsCount(); n >= 10; n /= 10)
+        rowNumberWidth++;
 }
 
-void Instance::OnStart()
+void Instance::PaintHeader(Graphics::Renderer& renderer)
 {
-    ProcessContent();
-    grid->SetGridDimensions({ static_cast<uint32>(settings->cols), static_cast<uint32>(settings->rows) });
-    PopulateGrid();
+    LocalString<256> text;
+    const auto col     = this->HasFocus() ? Cfg.Header.Text.Focused : Cfg.Header.Text.Normal;
+    const auto width   = static_cast<uint32>(this->GetWidth());
+    const auto lastCol = GetLastVisibleColumn();
+    auto x             = rowNumberWidth + 1;
+
+    renderer.FillHorizontalLine(0, 0, width, ' ', col);
+    if (engine.IsFiltered())
+        renderer.WriteSpecialCharacter(0, 0, SpecialChars::TriangleRight, col);
+    for (auto column = ViewPort.column; (column <= lastCol) && (column < columnsWidth.size()); column++)
+    {
+        FormatColumnName(column, text);
+        renderer.WriteSingleLineText(x, 0, columnsWidth[column], text.GetText(), col, TextAlignament::Center);
+        if (column == engine.GetSortColumn())
+        {
+            const auto sortChar = engine.IsSortAscending() ? SpecialChars::TriangleUp : SpecialChars::TriangleDown;
+            renderer.WriteSpecialCharacter(x + columnsWidth[column] - 1, 0, sortChar, col);
+        }
+        x += columnsWidth[column];
+        if (showVerticalLines)
+            renderer.WriteSpecialCharacter(x, 0, SpecialChars::BoxVerticalSingleLine, col);
+        x++;
+    }
 }
 
-void Instance::PopulateGrid()
+void Instance::PaintRow(Graphics::Renderer& renderer, uint64 row, int y)
 {
-    const auto& content = settings->tokens;
-    auto it             = content.begin();
-
-    if (settings->firstRowAsHeader)
+    LocalString<256> text;
+    NumericFormatter n;
+    const auto state      = this->HasFocus() ? ControlState::Focused : ControlState::Normal;
+    const auto lineColor  = Cfg.Lines.GetColor(state);
+    const auto textColor  = this->HasFocus() ? Cfg.Text.Focused : Cfg.Text.Inactive;
+    const auto rowNoColor = row == Cursor.row ? Cfg.Selection.Editor : Cfg.LineMarker.GetColor(state);
+    const auto fileRow    = GetFileRow(row);
+    const auto lastCol    = GetLastVisibleColumn();
+    const auto cellsCount = index.GetCellsCount(fileRow);
+    auto x                = rowNumberWidth + 1;
+
+    renderer.WriteSingleLineText(0, y, rowNumberWidth, n.ToDec(row + 1), rowNoColor, TextAlignament::Right);
+    renderer.WriteSpecialCharacter(rowNumberWidth, y, SpecialChars::BoxVerticalSingleLine, lineColor);
+
+    for (auto column = ViewPort.column; (column <= lastCol) && (column < columnsWidth.size()); column++)
     {
-        const auto& header = it->second;
-        std::vector<AppCUI::Utils::ConstString> headerCS;
-        for (const auto& [start, end] : header)
+        const auto w = columnsWidth[column];
+        auto color   = textColor;
+        if ((row == Cursor.row) && (column == Cursor.column))
         {
-            const auto token = obj->GetData().Get(start, static_cast<uint32>(end - start), false);
-            headerCS.push_back(token);
+            color = Cfg.Cursor.Normal;
+            renderer.FillHorizontalLine(x, y, x + w - 1, ' ', color);
         }
-        std::advance(it, 1);
-        grid->UpdateHeaderValues(headerCS);
+        if (column < cellsCount)
+        {
+            FormatCell(fileRow, column, w, text);
+            renderer.WriteSingleLineText(x, y, w, text.GetText(), color);
+        }
+        x += w;
+        if (showVerticalLines)
+            renderer.WriteSpecialCharacter(x, y, SpecialChars::BoxVerticalSingleLine, lineColor);
+        x++;
     }
-    else
+    if (showHorizontalLines)
+        renderer.FillHorizontalLineWithSpecialChar(0, y + 1, x, SpecialChars::BoxHorizontalSingleLine, lineColor);
+}
+
+void Instance::Paint(Graphics::Renderer& renderer)
+{
+    renderer.Clear();
+    PaintHeader(renderer);
+
+    const auto rowsCount   = GetRowsCount();
+    const auto visibleRows = GetVisibleRowsCount();
+    auto y                 = 1;
+    for (auto row = ViewPort.row; (row < rowsCount) && (row < ViewPort.row + visibleRows); row++)
     {
-        grid->SetDefaultHeaderValues();
+        // only the visible rows are read from the file
+        PaintRow(renderer, row, y);
+        y += showHorizontalLines ? 2 : 1;
     }
+}
 
-    const auto dimensions = grid->GetGridDimensions();
-    if (static_cast<uint32>(settings->rows - settings->firstRowAsHeader) != dimensions.Height)
+bool Instance::OnKeyEvent(AppCUI::Input::Key keyCode, char16 characterCode)
+{
+    const auto pageSize = GetVisibleRowsCount();
+    switch (keyCode)
     {
-        grid->SetGridDimensions({ static_cast<uint32>(settings->cols), static_cast<uint32>(settings->rows - settings->firstRowAsHeader) });
+    case Key::Up:
+        MoveTo(Cursor.row > 0 ? Cursor.row - 1 : 0, Cursor.column);
+        return true;
+    case Key::Down:
+        MoveTo(Cursor.row + 1, Cursor.column);
+        return true;
+    case Key::Left:
+        MoveTo(Cursor.row, Cursor.column > 0 ? Cursor.column - 1 : 0);
+        return true;
+    case Key::Right:
+        MoveTo(Cursor.row, Cursor.column + 1);
+        return true;
+    case Key::PageUp:
+        MoveTo(Cursor.row > pageSize ? Cursor.row - pageSize : 0, Cursor.column);
+        return true;
+    case Key::PageDown:
+        MoveTo(Cursor.row + pageSize, Cursor.column);
+        return true;
+    case Key::Home:
+        MoveTo(Cursor.row, 0);
+        return true;
+    case Key::End:
+        MoveTo(Cursor.row, 0xFFFFFFFF);
+        return true;
+    case Key::Home | Key::Ctrl:
+        MoveTo(0, Cursor.column);
+        return true;
+    case Key::End | Key::Ctrl:
+        MoveTo(GView::Utils::INVALID_OFFSET, Cursor.column);
+        return true;
     }
 
-    while (it != content.end())
+    return false;
+}
+
+void Instance::OnMousePressed(int x, int y, AppCUI::Input::MouseButton button)
+{
+    if ((y < 1) || (x <= static_cast<int>(rowNumberWidth)))
+        return;
+    const auto row = ViewPort.row + static_cast<uint64>(showHorizontalLines ? (y - 1) / 2 : y - 1);
+
+    const auto lastCol = GetLastVisibleColumn();
+    auto xPos          = static_cast<int>(rowNumberWidth + 1);
+    for (auto column = ViewPort.column; (column <= lastCol) && (column < columnsWidth.size()); column++)
     {
-        const auto i    = it->first;
-        const auto& row = it->second;
-        for (auto itRow = row.begin(); itRow != row.end(); itRow++)
+        xPos += columnsWidth[column] + 1;
+        if (x < xPos)
         {
-            const auto j     = row.size() - std::abs(std::distance(row.end(), itRow));
-            const auto token = obj->GetData().Get(itRow->first, static_cast<uint32>(itRow->second - itRow->first), false);
-            const ConstString value{ token };
-            grid->UpdateCell(static_cast<uint32>(j), static_cast<uint32>(i - settings->firstRowAsHeader), value);
+            MoveTo(row, column);
+            return;
         }
-        std::advance(it, 1);
     }
+}
 
-    grid->Sort();
+bool Instance::OnMouseWheel(int x, int y, AppCUI::Input::MouseWheel direction)
+{
+    switch (direction)
+    {
+    case MouseWheel::Up:
+        return OnKeyEvent(Key::Up, false);
+    case MouseWheel::Down:
+        return OnKeyEvent(Key::Down, false);
+    }
+
+    return false;
 }
 
-void GView::View::GridViewer::Instance::ProcessContent()
+void Instance::OnUpdateScrollBars()
 {
-    std::map<uint64, std::pair<uint64, uint64>> lines;
-    std::map<uint64, std::vector<std::pair<uint64, uint64>>> tokens;
+    const auto rowsCount = GetRowsCount();
+    this->UpdateVScrollBar(Cursor.row, rowsCount > 0 ? rowsCount - 1 : 0);
+}
 
-    const auto oSize = obj->GetData().GetSize();
-    const auto cSize = obj->GetData().GetCacheSize();
+void Instance::PaintCursorInformation(AppCUI::Graphics::Renderer& r, unsigned int width, unsigned int height)
+{
+    LocalString<128> tmp;
+    uint64 start = 0, end = 0;
 
-    auto oSizeProcessed = 0ULL;
-    auto lineStart      = 0ULL;
-    auto currentLine    = 0ULL;
+    index.GetCell(GetFileRow(Cursor.row), Cursor.column, start, end);
 
-    do
+    auto xPoz = 0;
+    if (height == 1)
     {
-        const auto buf = obj->GetData().Get(oSizeProcessed, static_cast<uint32>(cSize), false);
-        const std::string_view data{ reinterpret_cast<const char*>(buf.GetData()), buf.GetLength() };
-
-        auto nPos       = data.find_first_of('\n', 0);
-        const auto rPos = data.find_first_of('\r', 0);
+        xPoz = this->WriteCursorInfo(r, xPoz, 0, 28, "Rows:", FormatRowsCount(tmp));
+        xPoz = this->WriteCursorInfo(r, xPoz, 0, 16, "Columns:", tmp.Format("%u", index.GetColumnsCount()));
+        xPoz = this->WriteCursorInfo(r, xPoz, 0, 24, "Cell:", tmp.Format("%llu,%u", Cursor.row + 1, Cursor.column + 1));
+        xPoz = this->WriteCursorInfo(r, xPoz, 0, 24, "File ofs:", tmp.Format("%llu", start));
+    }
+    else
+    {
+        this->WriteCursorInfo(r, xPoz, 0, 28, "Rows:", FormatRowsCount(tmp));
+        xPoz = this->WriteCursorInfo(r, xPoz, 1, 28, "Columns:", tmp.Format("%u", index.GetColumnsCount()));
+        this->WriteCursorInfo(r, xPoz, 0, 24, "Cell:", tmp.Format("%llu,%u", Cursor.row + 1, Cursor.column + 1));
+        xPoz = this->WriteCursorInfo(r, xPoz, 1, 24, "File ofs:", tmp.Format("%llu", start));
+    }
+}
 
-        const auto oldOSizeProcessed = oSizeProcessed;
+bool Instance::OnUpdateCommandBar(AppCUI::Application::CommandBar& commandBar)
+{
+    commandBar.SetCommand(config.keys.replaceHeaderWith1stRow, "ReplaceHeader", COMMAND_ID_REPLACE_HEADER_WITH_1ST_ROW);
+    commandBar.SetCommand(config.keys.toggleHorizontalLines, "ToggleHorizontalLines", COMMAND_ID_TOGGLE_HORIZONTAL_LINES);
+    commandBar.SetCommand(config.keys.toggleVerticalLines, "ToggleVerticalLines", COMMAND_ID_TOGGLE_VERTICAL_LINES);
+    commandBar.SetCommand(config.keys.sortColumn, "Sort", COMMAND_ID_SORT_COLUMN);
+    commandBar.SetCommand(config.keys.filterColumn, "Filter", COMMAND_ID_FILTER_COLUMN);
+    commandBar.SetCommand(config.keys.resetView, "ResetView", COMMAND_ID_RESET_VIEW);
+    commandBar.SetCommand(config.keys.columnStatistics, "Statistics", COMMAND_ID_COLUMN_STATISTICS);
+    return false;
+}
 
-        if (nPos < rPos)
+bool Instance::OnEvent(Reference<Control> control, Event eventType, int ID)
+{
+    if (eventType == Event::Command)
+    {
+        if (ID == COMMAND_ID_REPLACE_HEADER_WITH_1ST_ROW)
         {
-            if (nPos + 1 < data.size() && data[nPos + 1] == '\r')
-            {
-                oSizeProcessed += nPos + 2;
-            }
-            else
-            {
-                oSizeProcessed += nPos + 1;
-            }
+            settings->firstRowAsHeader = !settings->firstRowAsHeader;
+            // the header row changes --> the current view (sort/filter) is no longer valid
+            engine.Init(obj, index, settings->firstRowAsHeader ? 1 : 0);
+            ComputeColumnsWidth();
+            MoveTo(Cursor.row, Cursor.column);
+            return true;
         }
-        else if (nPos > rPos)
+        else if (ID == COMMAND_ID_TOGGLE_HORIZONTAL_LINES)
         {
-            if (rPos + 1 < data.size() && data[rPos + 1] == '\n')
-            {
-                oSizeProcessed += rPos + 2;
-            }
-            else
-            {
-                oSizeProcessed += rPos + 1;
-            }
+            showHorizontalLines = !showHorizontalLines;
+            MoveTo(Cursor.row, Cursor.column);
+            return true;
         }
-        else
+        else if (ID == COMMAND_ID_TOGGLE_VERTICAL_LINES)
         {
-            nPos = oSize - oldOSizeProcessed;
-            oSizeProcessed += nPos;
+            showVerticalLines = !showVerticalLines;
+            return true;
         }
-
-        lines.insert({ currentLine, { lineStart + oldOSizeProcessed, nPos + oldOSizeProcessed } });
-        const std::string_view line{ reinterpret_cast<const char*>(buf.GetData() + lineStart), nPos };
-
-        std::vector<uint64> separators;
+        else if (ID == COMMAND_ID_SORT_COLUMN)
         {
-            size_t pos = line.find(settings->separator[0]);
-            while (pos != std::string::npos)
-            {
-                separators.push_back(pos + oldOSizeProcessed);
-                pos = line.find(settings->separator[0], pos + 1);
-            }
-            separators.push_back(line.size() + oldOSizeProcessed);
+            SortCurrentColumn();
+            return true;
         }
-
-        std::vector<std::pair<uint64, uint64>> lTokens;
-        if (separators.size() == 0)
+        else if (ID == COMMAND_ID_FILTER_COLUMN)
         {
-            lTokens.push_back({ lineStart + oldOSizeProcessed, nPos + oldOSizeProcessed });
+            FilterCurrentColumn();
+            return true;
         }
-
+        else if (ID == COMMAND_ID_RESET_VIEW)
         {
-            auto tStart = oldOSizeProcessed;
-            auto tEnd   = oldOSizeProcessed;
-            for (const auto& i : separators)
-            {
-                tEnd = i;
-                lTokens.push_back({ tStart, tEnd });
-                tStart = tEnd + 1;
-            }
+            engine.Reset();
+            MoveTo(0, Cursor.column);
+            return true;
         }
+        else if (ID == COMMAND_ID_COLUMN_STATISTICS)
+        {
+            ShowColumnStatistics();
+            return true;
+        }
+    }
 
-        tokens.insert({ currentLine, std::move(lTokens) });
-
-        currentLine++;
-
-    } while (oSizeProcessed < oSize);
-
-    settings->rows   = lines.size();
-    settings->cols   = tokens.size() > 0 ? tokens.begin()->second.size() : 0;
-    settings->lines  = std::move(lines);
-    settings->tokens = std::move(tokens);
+    return false;
 }
 
-void GView::View::GridViewer::Instance::PaintCursorInformationWidth(AppCUI::Graphics::Renderer& renderer, unsigned int x, unsigned int y)
+void Instance::OnStart()
 {
-    WriteTextParams params{ WriteTextFlags::SingleLine };
-    params.Color = config.color.cursorInformation.name;
-    params.X     = x;
-    params.Y     = y;
-    params.Width = config.cursorInformationCellSpace;
-    params.Align = TextAlignament::Left;
-
-    LocalString<256> ls;
-
-    const auto width = grid->GetWidth();
-    renderer.WriteText("Width:", params);
-    params.Color = config.color.cursorInformation.value;
-    params.X += 6;
-    ls.Format("%d", width);
-    renderer.WriteText(ls, params);
+    ProcessContent();
 }
 
-void GView::View::GridViewer::Instance::PaintCursorInformationHeight(AppCUI::Graphics::Renderer& renderer, unsigned int x, unsigned int y)
+void Instance::ProcessContent()
 {
-    WriteTextParams params{ WriteTextFlags::SingleLine };
-    params.Color = config.color.cursorInformation.name;
-    params.X     = x;
-    params.Y     = y;
-    params.Width = config.cursorInformationCellSpace;
-    params.Align = TextAlignament::Left;
-
-    LocalString<256> ls;
-
-    const auto height = grid->GetHeight();
-    renderer.WriteText("Height:", params);
-    params.Color = config.color.cursorInformation.value;
-    params.X += 7;
-    ls.Format("%d", height);
-    renderer.WriteText(ls, params);
+    index.Build(obj, settings->separator[0]);
+    engine.Init(obj, index, settings->firstRowAsHeader ? 1 : 0);
+    ComputeColumnsWidth();
+    MoveTo(0, 0);
 }
 
-void GView::View::GridViewer::Instance::PaintCursorInformationCells(AppCUI::Graphics::Renderer& renderer, unsigned int x, unsigned int y)
+void Instance::SortCurrentColumn()
 {
-    WriteTextParams params{ WriteTextFlags::SingleLine };
-    params.Color = config.color.cursorInformation.name;
-    params.X     = x;
-    params.Y     = y;
-    params.Width = config.cursorInformationCellSpace;
-    params.Align = TextAlignament::Left;
-
-    LocalString<256> ls;
-
-    const auto cells = grid->GetCellsCount();
-    renderer.WriteText("Cells:", params);
-    params.Color = config.color.cursorInformation.value;
-    params.X += 6;
-    ls.Format("%d", cells);
-    renderer.WriteText(ls, params);
+    CHECKRET(Cursor.column < index.GetColumnsCount(), "");
+    // same column --> toggle the sort order
+    const auto ascending = (engine.GetSortColumn() != Cursor.column) || (!engine.IsSortAscending());
+    if (!engine.Sort(Cursor.column, ascending))
+        return;
+    MoveTo(0, Cursor.column);
 }
 
-void GView::View::GridViewer::Instance::PaintCursorInformationCurrentLocation(
-      AppCUI::Graphics::Renderer& renderer, unsigned int x, unsigned int y)
+void Instance::FilterCurrentColumn()
 {
-    WriteTextParams params{ WriteTextFlags::SingleLine };
-    params.Color = config.color.cursorInformation.name;
-    params.X     = x;
-    params.Y     = y;
-    params.Width = config.cursorInformationCellSpace;
-    params.Align = TextAlignament::Left;
-
-    LocalString<256> ls;
-
-    const auto location = grid->GetHoveredLocation();
-    renderer.WriteText("Hovered:", params);
-    params.Color = config.color.cursorInformation.value;
-    params.X += 9;
-    if (location == Point{ -1, -1 })
+    LocalString<256> name;
+    CHECKRET(Cursor.column < index.GetColumnsCount(), "");
+    FormatColumnName(Cursor.column, name);
+    FilterDialog dlg(name.ToStringView(), engine.DetectColumnType(Cursor.column));
+    if (dlg.Show() != Dialogs::Result::Ok)
+        return;
+    if (!engine.Filter(Cursor.column, dlg.GetOperation(), dlg.GetValue()))
+        return;
+    if (engine.GetRowsCount() == 0)
     {
-        ls.Format("- | -");
+        Dialogs::MessageBox::ShowNotification("Filter", "No row matches the filter (the filter was removed) !");
+        engine.Reset();
     }
-    else
-    {
-        ls.Format("%d | %d", location.X, location.Y);
-    }
-    renderer.WriteText(ls, params);
+    Cursor.row   = 0;
+    ViewPort.row = 0;
+    MoveTo(0, Cursor.column);
 }
 
-void GView::View::GridViewer::Instance::PaintCursorInformationSelection(
-      AppCUI::Graphics::Renderer& renderer, unsigned int x, unsigned int y)
+void Instance::ShowColumnStatistics()
 {
-    WriteTextParams params{ WriteTextFlags::SingleLine };
-    params.Color = config.color.cursorInformation.name;
-    params.X     = x;
-    params.Y     = y;
-    params.Width = config.cursorInformationCellSpace;
-    params.Align = TextAlignament::Left;
-
-    LocalString<256> ls;
+    ColumnStatistics stats;
+    LocalString<256> name;
+    LocalString<1024> text;
+    CHECKRET(Cursor.column < index.GetColumnsCount(), "");
+    if (!engine.ComputeStatistics(Cursor.column, stats))
+        return;
+    FormatColumnName(Cursor.column, name);
+    text.Format(
+          "Column  : %s\nType    : %s\nValues  : %llu\nEmpty   : %llu\nDistinct: %llu%s\nMin     : %.64s\nMax     : %.64s",
+          name.GetText(),
+          TableEngine::ColumnTypeToString(stats.type).data(),
+          stats.count,
+          stats.empty,
+          stats.distinct,
+          stats.approximateDistinct ? " (approximate)" : "",
+          stats.min.c_str(),
+          stats.max.c_str());
+    Dialogs::MessageBox::ShowNotification("Statistics", text.ToStringView());
+}
 
-    const auto start = grid->GetSelectionLocationsStart();
-    const auto end   = grid->GetSelectionLocationsEnd();
-    renderer.WriteText("Selection:", params);
-    params.Color = config.color.cursorInformation.value;
-    params.X += 10;
-    if (start == Point{ -1, -1 } || end == Point{ -1, -1 })
-    {
-        ls.Format("- & - -> - & -");
-    }
-    else
-    {
-        ls.Format("%d & %d -> %d & %d", start.X, start.Y, end.X, end.Y);
-    }
-    renderer.WriteText(ls, params);
+std::string_view Instance::FormatRowsCount(LocalString<128>& text)
+{
+    if (engine.IsFiltered())
+        return text.Format("%llu / %llu", engine.GetRowsCount(), engine.GetAllRowsCount());
+    return text.Format("%llu", engine.GetRowsCount());
 }
 
-void GView::View::GridViewer::Instance::PaintCursorInformationSeparator(
-      AppCUI::Graphics::Renderer& renderer, unsigned int x, unsigned int y)
+void Instance::PaintCursorInformationSeparator(AppCUI::Graphics::Renderer& renderer, unsigned int x, unsigned int y)
 {
     renderer.DrawVerticalLine(x, y, y + 4, config.color.cursorInformation.value);
 }
@@ -434,6 +571,18 @@ bool Instance::GetPropertyValue(uint32 id, PropertyValue& value)
     case PROP_ID_TOGGLE_VERTICAL_LINES:
         value = config.keys.toggleVerticalLines;
         return true;
+    case PROP_ID_SORT_COLUMN:
+        value = config.keys.sortColumn;
+        return true;
+    case PROP_ID_FILTER_COLUMN:
+        value = config.keys.filterColumn;
+        return true;
+    case PROP_ID_RESET_VIEW:
+        value = config.keys.resetView;
+        return true;
+    case PROP_ID_COLUMN_STATISTICS:
+        value = config.keys.columnStatistics;
+        return true;
     default:
         break;
     }
@@ -453,6 +602,18 @@ bool Instance::SetPropertyValue(uint32 id, const PropertyValue& value, String& e
     case PROP_ID_TOGGLE_VERTICAL_LINES:
         config.keys.toggleVerticalLines = std::get<Key>(value);
         return true;
+    case PROP_ID_SORT_COLUMN:
+        config.keys.sortColumn = std::get<Key>(value);
+        return true;
+    case PROP_ID_FILTER_COLUMN:
+        config.keys.filterColumn = std::get<Key>(value);
+        return true;
+    case PROP_ID_RESET_VIEW:
+        config.keys.resetView = std::get<Key>(value);
+        return true;
+    case PROP_ID_COLUMN_STATISTICS:
+        config.keys.columnStatistics = std::get<Key>(value);
+        return true;
     default:
         break;
     }
@@ -474,5 +635,9 @@ const vector<Property> Instance::GetPropertiesList()
         { PROP_ID_REPLACE_HEADER_WITH_1ST_ROW, "Content", "Replace header with first row", PropertyType::Key },
         { PROP_ID_TOGGLE_HORIZONTAL_LINES, "Look", "Hide/Show horizontal lines", PropertyType::Key },
         { PROP_ID_TOGGLE_VERTICAL_LINES, "Look", "Hide/Show vertical lines", PropertyType::Key },
+        { PROP_ID_SORT_COLUMN, "Content", "Sort by current column", PropertyType::Key },
+        { PROP_ID_FILTER_COLUMN, "Content", "Filter by current column", PropertyType::Key },
+        { PROP_ID_RESET_VIEW, "Content", "Remove sort and filters", PropertyType::Key },
+        { PROP_ID_COLUMN_STATISTICS, "Content", "Current column statistics", PropertyType::Key },
     };
 }
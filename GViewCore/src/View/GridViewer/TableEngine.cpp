@@ -0,0 +1,576 @@
+#include "GridViewer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_set>
+
+using namespace GView::View::GridViewer;
+
+constexpr uint32 MAX_VALUE_SIZE        = 1024;
+constexpr uint32 ROWS_TO_DETECT_TYPE   = 1000;
+constexpr uint32 MAX_STRING_SORT_DEPTH = MAX_VALUE_SIZE / 8;
+constexpr uint32 MIN_ROWS_FOR_PARALLEL = 0x10000;
+constexpr uint64 PROGRESS_UPDATE_MASK  = 0xFFFF;
+constexpr uint64 SIGN_BIT              = 0x8000000000000000ULL;
+constexpr uint64 FNV_OFFSET_BASIS      = 0xCBF29CE484222325ULL;
+constexpr uint64 FNV_PRIME             = 0x00000100000001B3ULL;
+constexpr uint64 MAX_DISTINCT_SIZE     = 0x4000000; // distinct values kept to count them exactly (only their hashes after that)
+
+namespace
+{
+std::string_view Trim(std::string_view text)
+{
+    while ((!text.empty()) && ((text.front() == ' ') || (text.front() == '\t')))
+        text.remove_prefix(1);
+    while ((!text.empty()) && ((text.back() == ' ') || (text.back() == '\t')))
+        text.remove_suffix(1);
+    return text;
+}
+
+bool ParseInteger(std::string_view text, int64& result)
+{
+    text = Trim(text);
+    if (text.empty())
+        return false;
+    auto negative = false;
+    if ((text.front() == '-') || (text.front() == '+'))
+    {
+        negative = text.front() == '-';
+        text.remove_prefix(1);
+    }
+    if (text.empty())
+        return false;
+    uint64 value = 0;
+    for (auto ch : text)
+    {
+        if ((ch < '0') || (ch > '9'))
+            return false;
+        if (value > (SIGN_BIT - 9) / 10) // overflow
+            return false;
+        value = value * 10 + static_cast<uint64>(ch - '0');
+    }
+    result = negative ? -static_cast<int64>(value) : static_cast<int64>(value);
+    return true;
+}
+
+bool ParseFloat(std::string_view text, double& result)
+{
+    char temp[64];
+    text = Trim(text);
+    if ((text.empty()) || (text.size() >= sizeof(temp)))
+        return false;
+    // only decimal notation (strtod also accepts hex numbers, 'inf' or 'nan')
+    for (auto ch : text)
+    {
+        if (((ch < '0') || (ch > '9')) && (ch != '.') && (ch != '-') && (ch != '+') && (ch != 'e') && (ch != 'E'))
+            return false;
+    }
+    memcpy(temp, text.data(), text.size());
+    temp[text.size()] = 0;
+    char* end         = nullptr;
+    result            = strtod(temp, &end);
+    return (end == temp + text.size()) && (std::isfinite(result));
+}
+
+bool ParseDigits(std::string_view& text, uint32 count, uint32& result)
+{
+    if (text.size() < count)
+        return false;
+    result = 0;
+    for (auto i = 0U; i < count; i++)
+    {
+        if ((text[i] < '0') || (text[i] > '9'))
+            return false;
+        result = result * 10 + static_cast<uint32>(text[i] - '0');
+    }
+    text.remove_prefix(count);
+    return true;
+}
+
+// YYYY-MM-DD or YYYY/MM/DD followed (optionally) by HH:MM or HH:MM:SS (separated by ' ' or 'T')
+bool ParseDate(std::string_view text, uint64& result)
+{
+    uint32 year, month, day, hour = 0, minute = 0, second = 0;
+    text = Trim(text);
+    if (!ParseDigits(text, 4, year))
+        return false;
+    if ((text.empty()) || ((text.front() != '-') && (text.front() != '/')))
+        return false;
+    const auto separator = text.front();
+    text.remove_prefix(1);
+    if (!ParseDigits(text, 2, month))
+        return false;
+    if ((text.empty()) || (text.front() != separator))
+        return false;
+    text.remove_prefix(1);
+    if (!ParseDigits(text, 2, day))
+        return false;
+    if ((month < 1) || (month > 12) || (day < 1) || (day > 31))
+        return false;
+    if (!text.empty())
+    {
+        if ((text.front() != ' ') && (text.front() != 'T'))
+            return false;
+        text.remove_prefix(1);
+        if (!ParseDigits(text, 2, hour))
+            return false;
+        if ((text.empty()) || (text.front() != ':'))
+            return false;
+        text.remove_prefix(1);
+        if (!ParseDigits(text, 2, minute))
+            return false;
+        if (!text.empty())
+        {
+            if (text.front() != ':')
+                return false;
+            text.remove_prefix(1);
+            if (!ParseDigits(text, 2, second))
+                return false;
+        }
+        if ((!text.empty()) || (hour >= 24) || (minute >= 60) || (second >= 61))
+            return false;
+    }
+    result = ((((static_cast<uint64>(year) * 13 + month) * 32 + day) * 24 + hour) * 60 + minute) * 61 + second;
+    return true;
+}
+
+// converts a value into a 64-bit key that preserves the order of the values (for strings only 8 bytes starting from 'depth'*8
+// are used - 'hasMore' is set if the string is longer than that)
+bool ComputeKey(ColumnType type, std::string_view text, uint32 depth, uint64& key, bool& hasMore)
+{
+    hasMore = false;
+    switch (type)
+    {
+    case ColumnType::Integer:
+    {
+        int64 v;
+        if (!ParseInteger(text, v))
+            return false;
+        key = static_cast<uint64>(v) ^ SIGN_BIT;
+        return true;
+    }
+    case ColumnType::Float:
+    {
+        double v;
+        if (!ParseFloat(text, v))
+            return false;
+        if (v == 0)
+            v = 0; // -0.0 and 0.0 should have the same key
+        memcpy(&key, &v, sizeof(key));
+        key = (key & SIGN_BIT) ? ~key : key | SIGN_BIT;
+        return true;
+    }
+    case ColumnType::Date:
+        return ParseDate(text, key);
+    case ColumnType::String:
+    {
+        if (text.empty())
+            return false;
+        const auto start = static_cast<size_t>(depth) * 8;
+        key              = 0;
+        for (auto i = 0U; i < 8; i++)
+        {
+            key <<= 8;
+            if (start + i < text.size())
+                key |= static_cast<uint8>(text[start + i]);
+        }
+        hasMore = text.size() > start + 8;
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+bool Compare(ColumnType type, std::string_view a, std::string_view b, int& result)
+{
+    if (type != ColumnType::String)
+    {
+        uint64 ka, kb;
+        bool hasMore;
+        if ((ComputeKey(type, a, 0, ka, hasMore)) && (ComputeKey(type, b, 0, kb, hasMore)))
+        {
+            result = ka < kb ? -1 : (ka > kb ? 1 : 0);
+            return true;
+        }
+    }
+    const auto r = a.compare(b);
+    result       = r < 0 ? -1 : (r > 0 ? 1 : 0);
+    return true;
+}
+
+uint64 HashValue(std::string_view text)
+{
+    auto hash = FNV_OFFSET_BASIS;
+    for (auto ch : text)
+    {
+        hash ^= static_cast<uint8>(ch);
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+// sorts each segment on a different thread and then merges (also in parallel) pairs of sorted segments
+template <typename T, typename Less>
+void ParallelSort(std::vector<T>& data, Less less)
+{
+    const auto size = data.size();
+    if (size < MIN_ROWS_FOR_PARALLEL)
+    {
+        std::sort(data.begin(), data.end(), less);
+        return;
+    }
+    const auto segments    = static_cast<size_t>(GView::Utils::GetParallelWorkersCount());
+    const auto segmentSize = (size + segments - 1) / segments;
+    GView::Utils::ParallelFor(static_cast<uint32>(segments), [&](uint32 index) {
+        const auto start = std::min<size_t>(size, index * segmentSize);
+        const auto end   = std::min<size_t>(size, start + segmentSize);
+        std::sort(data.begin() + start, data.begin() + end, less);
+    });
+
+    std::vector<T> temp(size);
+    for (auto width = segmentSize; width < size; width *= 2)
+    {
+        const auto pairs = static_cast<uint32>((size + 2 * width - 1) / (2 * width));
+        GView::Utils::ParallelFor(pairs, [&](uint32 index) {
+            const auto start  = static_cast<size_t>(index) * 2 * width;
+            const auto middle = std::min<size_t>(size, start + width);
+            const auto end    = std::min<size_t>(size, start + 2 * width);
+            std::merge(data.begin() + start, data.begin() + middle, data.begin() + middle, data.begin() + end, temp.begin() + start, less);
+        });
+        data.swap(temp);
+    }
+}
+} // namespace
+
+TableEngine::TableEngine() : index(nullptr), firstRow(0), sortColumn(NO_COLUMN), sortAscending(true), allRows(true)
+{
+}
+
+void TableEngine::Init(Reference<GView::Object> _obj, const CellIndex& _index, uint64 _firstRow)
+{
+    this->obj      = _obj;
+    this->index    = &_index;
+    this->firstRow = _firstRow;
+    Reset();
+}
+
+void TableEngine::Reset()
+{
+    rows.clear();
+    rows.shrink_to_fit();
+    allRows       = true;
+    sortColumn    = NO_COLUMN;
+    sortAscending = true;
+}
+
+bool TableEngine::FileRowToRow(uint64 fileRow, uint64& row) const
+{
+    CHECK(fileRow >= firstRow, false, "");
+    if (allRows)
+    {
+        CHECK(fileRow - firstRow < GetAllRowsCount(), false, "");
+        row = fileRow - firstRow;
+        return true;
+    }
+    auto it = std::find(rows.begin(), rows.end(), fileRow);
+    CHECK(it != rows.end(), false, "Row %llu is not part of the current view", fileRow);
+    row = static_cast<uint64>(it - rows.begin());
+    return true;
+}
+
+std::string_view TableEngine::GetCellValue(uint64 fileRow, uint32 column)
+{
+    value.clear();
+    uint64 start, end;
+    if ((!index) || (!index->GetCell(fileRow, column, start, end)) || (start >= end))
+        return value;
+
+    const auto buf = obj->GetData().Get(start, static_cast<uint32>(std::min<uint64>(end - start, MAX_VALUE_SIZE)), false);
+    auto* p        = buf.GetData();
+    auto* e        = p + buf.GetLength();
+    if ((p < e) && (*p == '"'))
+    {
+        // quoted field --> remove the quotes and convert "" to "
+        p++;
+        if ((end - start <= MAX_VALUE_SIZE) && (p < e) && (*(e - 1) == '"'))
+            e--;
+        for (; p < e; p++)
+        {
+            if ((*p == '"') && (p + 1 < e) && (p[1] == '"'))
+                p++;
+            value.push_back(static_cast<char>(*p));
+        }
+        return value;
+    }
+    value.assign(reinterpret_cast<const char*>(p), static_cast<size_t>(e - p));
+    // a CR before a LF is not part of the last cell
+    if ((!value.empty()) && (value.back() == '\r'))
+        value.pop_back();
+    return value;
+}
+
+bool TableEngine::ForEachRow(std::string_view message, std::function<void(uint64 position, uint64 fileRow)> callback)
+{
+    const auto count = GetRowsCount();
+    LocalString<128> ls;
+
+    // rows are always read in file order (the cache is used sequentially, even if the view is sorted)
+    std::vector<uint64> order;
+    if (!allRows)
+    {
+        order.resize(count);
+        for (auto i = 0ULL; i < count; i++)
+            order[i] = i;
+        ParallelSort(order, [this](uint64 a, uint64 b) { return rows[a] < rows[b]; });
+    }
+
+    ProgressStatus::Init(message, count);
+    for (auto i = 0ULL; i < count; i++)
+    {
+        const auto position = allRows ? i : order[i];
+        callback(position, GetFileRow(position));
+        if (((i & PROGRESS_UPDATE_MASK) == 0) &&
+            (ProgressStatus::Update(i, ls.Format("%.*s (%llu / %llu rows)", (int) message.size(), message.data(), i, count))))
+            return false;
+    }
+    return true;
+}
+
+ColumnType TableEngine::DetectColumnType(uint32 column)
+{
+    auto isInteger = true, isFloat = true, isDate = true;
+    auto found     = 0U;
+    const auto end = firstRow + GetAllRowsCount();
+    for (auto fileRow = firstRow; (fileRow < end) && (found < ROWS_TO_DETECT_TYPE); fileRow++)
+    {
+        const auto text = Trim(GetCellValue(fileRow, column));
+        if (text.empty())
+            continue;
+        found++;
+        int64 i;
+        double d;
+        uint64 date;
+        isInteger = isInteger && ParseInteger(text, i);
+        isFloat   = isFloat && (isInteger || ParseFloat(text, d));
+        isDate    = isDate && ParseDate(text, date);
+        if ((!isFloat) && (!isDate))
+            return ColumnType::String;
+    }
+    if (found == 0)
+        return ColumnType::Empty;
+    if (isInteger)
+        return ColumnType::Integer;
+    if (isFloat)
+        return ColumnType::Float;
+    return isDate ? ColumnType::Date : ColumnType::String;
+}
+
+bool TableEngine::RefineStringRuns(std::vector<SortEntry>& entries, uint32 column, bool ascending)
+{
+    struct Run
+    {
+        size_t start, end;
+        uint32 depth;
+    };
+    std::vector<Run> runs;
+    const auto less = [](const SortEntry& a, const SortEntry& b) { return (a.key < b.key) || ((a.key == b.key) && (a.row < b.row)); };
+    const auto addRuns = [&runs, &entries](size_t start, size_t end, uint32 depth) {
+        for (auto i = start; i < end;)
+        {
+            auto j = i + 1;
+            while ((j < end) && (entries[j].key == entries[i].key))
+                j++;
+            if (j - i > 1)
+                runs.push_back({ i, j, depth });
+            i = j;
+        }
+    };
+
+    // the first 8 bytes of each string were used as key --> rows with the same key are sorted again using the next 8 bytes
+    addRuns(0, entries.size(), 1);
+    while (!runs.empty())
+    {
+        const auto run = runs.back();
+        runs.pop_back();
+        if (run.depth >= MAX_STRING_SORT_DEPTH)
+            continue;
+        auto hasMore = false;
+        for (auto i = run.start; i < run.end; i++)
+        {
+            bool more;
+            ComputeKey(ColumnType::String, GetCellValue(entries[i].row, column), run.depth, entries[i].key, more);
+            entries[i].key = ascending ? entries[i].key : ~entries[i].key;
+            hasMore |= more;
+        }
+        std::sort(entries.begin() + run.start, entries.begin() + run.end, less);
+        if (hasMore)
+            addRuns(run.start, run.end, run.depth + 1);
+    }
+    return true;
+}
+
+bool TableEngine::Sort(uint32 column, bool ascending)
+{
+    CHECK(index, false, "");
+    CHECK(column < index->GetColumnsCount(), false, "Invalid column: %u", column);
+    const auto type = DetectColumnType(column);
+
+    std::vector<SortEntry> entries;
+    std::vector<uint64> emptyRows;
+    entries.reserve(GetRowsCount());
+    auto hasMore  = false;
+    auto finished = ForEachRow("Reading values", [&](uint64, uint64 fileRow) {
+        uint64 key;
+        bool more;
+        if (ComputeKey(type, GetCellValue(fileRow, column), 0, key, more))
+        {
+            entries.push_back({ ascending ? key : ~key, fileRow });
+            hasMore |= more;
+        }
+        else
+        {
+            // empty (or invalid) values are always placed at the end
+            emptyRows.push_back(fileRow);
+        }
+    });
+    CHECK(finished, false, "Sort canceled");
+
+    // rows with the same key remain in file order
+    ParallelSort(entries, [](const SortEntry& a, const SortEntry& b) { return (a.key < b.key) || ((a.key == b.key) && (a.row < b.row)); });
+    if ((type == ColumnType::String) && (hasMore))
+        RefineStringRuns(entries, column, ascending);
+    std::sort(emptyRows.begin(), emptyRows.end());
+
+    rows.resize(entries.size() + emptyRows.size());
+    for (auto i = 0ULL; i < entries.size(); i++)
+        rows[i] = entries[i].row;
+    std::copy(emptyRows.begin(), emptyRows.end(), rows.begin() + entries.size());
+
+    allRows       = false;
+    sortColumn    = column;
+    sortAscending = ascending;
+    return true;
+}
+
+bool TableEngine::Filter(uint32 column, FilterOperation operation, std::string_view filterValue)
+{
+    CHECK(index, false, "");
+    CHECK(column < index->GetColumnsCount(), false, "Invalid column: %u", column);
+    const auto type        = DetectColumnType(column);
+    const std::string what = std::string(Trim(filterValue));
+
+    std::vector<uint8> matches(GetRowsCount(), 0);
+    auto finished = ForEachRow("Filtering", [&](uint64 position, uint64 fileRow) {
+        const auto text = Trim(GetCellValue(fileRow, column));
+        int result      = 0;
+        bool match      = false;
+        switch (operation)
+        {
+        case FilterOperation::Contains:
+            match = text.find(what) != std::string_view::npos;
+            break;
+        case FilterOperation::StartsWith:
+            match = text.substr(0, what.size()) == what;
+            break;
+        default:
+            Compare(type, text, what, result);
+            match = (operation == FilterOperation::Equals && result == 0) || (operation == FilterOperation::NotEquals && result != 0) ||
+                    (operation == FilterOperation::Less && result < 0) || (operation == FilterOperation::LessOrEqual && result <= 0) ||
+                    (operation == FilterOperation::Greater && result > 0) || (operation == FilterOperation::GreaterOrEqual && result >= 0);
+            break;
+        }
+        matches[position] = match ? 1 : 0;
+    });
+    CHECK(finished, false, "Filter canceled");
+
+    // the order of the current view (if sorted) is preserved
+    std::vector<uint64> result;
+    for (auto i = 0ULL; i < matches.size(); i++)
+    {
+        if (matches[i])
+            result.push_back(GetFileRow(i));
+    }
+    rows    = std::move(result);
+    allRows = false;
+    return true;
+}
+
+bool TableEngine::ComputeStatistics(uint32 column, ColumnStatistics& stats)
+{
+    CHECK(index, false, "");
+    CHECK(column < index->GetColumnsCount(), false, "Invalid column: %u", column);
+    stats.type     = DetectColumnType(column);
+    stats.count    = 0;
+    stats.empty    = 0;
+    stats.distinct = 0;
+    stats.min.clear();
+    stats.max.clear();
+
+    // the distinct values are kept while they fit in MAX_DISTINCT_SIZE --> after that only their hashes (and the count is approximate)
+    struct ValueHash
+    {
+        using is_transparent = void;
+        size_t operator()(std::string_view text) const
+        {
+            return static_cast<size_t>(HashValue(text));
+        }
+    };
+    std::unordered_set<std::string, ValueHash, std::equal_to<>> values;
+    std::unordered_set<uint64> hashes;
+    uint64 valuesSize         = 0;
+    stats.approximateDistinct = false;
+
+    auto finished = ForEachRow("Computing statistics", [&](uint64, uint64 fileRow) {
+        const auto text = Trim(GetCellValue(fileRow, column));
+        if (text.empty())
+        {
+            stats.empty++;
+            return;
+        }
+        int result;
+        if ((stats.count == 0) || (Compare(stats.type, text, stats.min, result) && result < 0))
+            stats.min = text;
+        if ((stats.count == 0) || (Compare(stats.type, text, stats.max, result) && result > 0))
+            stats.max = text;
+        stats.count++;
+
+        if (stats.approximateDistinct)
+        {
+            hashes.insert(HashValue(text));
+        }
+        else if (values.find(text) == values.end())
+        {
+            values.emplace(text);
+            valuesSize += text.size();
+            if (valuesSize > MAX_DISTINCT_SIZE)
+            {
+                for (const auto& value : values)
+                    hashes.insert(HashValue(value));
+                values.clear();
+                stats.approximateDistinct = true;
+            }
+        }
+    });
+    CHECK(finished, false, "Statistics canceled");
+    stats.distinct = stats.approximateDistinct ? hashes.size() : values.size();
+    return true;
+}
+
+std::string_view TableEngine::ColumnTypeToString(ColumnType type)
+{
+    switch (type)
+    {
+    case ColumnType::Empty:
+        return "Empty";
+    case ColumnType::Integer:
+        return "Integer";
+    case ColumnType::Float:
+        return "Float";
+    case ColumnType::Date:
+        return "Date";
+    case ColumnType::String:
+        return "String";
+    }
+    return "Unknown";
+}
@@ -801,23 +801,21 @@ void Instance::Reparse(bool openInNewWindow)
 }
 bool Instance::RebuildTextFromTokens(TextEditor& editor)
 {
-    auto it  = this->tokens.crbegin();
-    auto end = this->tokens.crend();
-    for (; it != end; it++)
+    std::vector<TextEditor::Edit> edits;
+    for (const auto& tok : this->tokens)
     {
-        if (it->IsMarkForDeletion())
+        if (tok.IsMarkForDeletion())
         {
-            editor.Delete(it->start, it->end - it->start);
+            edits.push_back({ tok.start, tok.end - tok.start, u"" });
             continue;
         }
-        if (it->value.Len() > 0)
+        if (tok.value.Len() > 0)
         {
-            if (!editor.Replace(it->start, it->end - it->start, it->value.ToStringView()))
-                return false;
+            edits.push_back({ tok.start, tok.end - tok.start, tok.value.ToStringView() });
             continue;
         }
     }
-    return true;
+    return editor.ApplyEdits(edits);
 }
 void Instance::BakupTokensPositions()
 {
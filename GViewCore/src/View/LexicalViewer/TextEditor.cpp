@@ -1,4 +1,10 @@
 #include "LexicalViewer.hpp"
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#    include <emmintrin.h>
+#    define TEXT_EDITOR_USE_SSE2
+#endif
 
 namespace GView::View::LexicalViewer
 {
@@ -47,7 +53,11 @@ bool TextEditor::Grow(size_t newSize)
 {
     if (newSize <= allocated)
         return true;
-    newSize = (newSize | 0xFF) + 1; // 256 bytes blocks
+    // grow geometrically (x1.5) so that repeated inserts are amortized O(1)
+    const auto requestedSize = (newSize | 0xFF) + 1; // 256 bytes blocks
+    newSize                  = std::max<size_t>(requestedSize, (((size_t) allocated + (allocated >> 1)) | 0xFF) + 1);
+    if (newSize > MAX_MEMORY_TO_ALLOCATE)
+        newSize = requestedSize;
     if (newSize > MAX_MEMORY_TO_ALLOCATE)
         return false;
     try
@@ -78,56 +88,79 @@ char16& TextEditor::operator[](uint32 index)
     };
 }
 
+inline char16 LowerCase(char16 ch)
+{
+    return ch < 256 ? string_lowercase_table[ch] : ch;
+}
+
+// returns the first position in [p, e) that contains either ch1 or ch2 (or e if there is no such position)
+// ch1 and ch2 can be the same character (for case sensitive searches)
+inline const char16* FindFirstOf(const char16* p, const char16* e, char16 ch1, char16 ch2)
+{
+#ifdef TEXT_EDITOR_USE_SSE2
+    const auto v1 = _mm_set1_epi16(static_cast<short>(ch1));
+    const auto v2 = _mm_set1_epi16(static_cast<short>(ch2));
+    while (p + 8 <= e)
+    {
+        const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const auto mask  = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi16(block, v1), _mm_cmpeq_epi16(block, v2)));
+        if (mask != 0)
+        {
+            for (uint32 idx = 0; idx < 8; idx++)
+            {
+                if (mask & (1 << (idx * 2)))
+                    return p + idx;
+            }
+        }
+        p += 8;
+    }
+#endif
+    for (; p < e; p++)
+    {
+        if ((*p == ch1) || (*p == ch2))
+            return p;
+    }
+    return e;
+}
+
 std::optional<uint32> TextEditor::Find(uint32 startOffset, std::string_view textToSearch, bool ignoreCase)
 {
     if ((textToSearch.empty()) || (this->size == 0))
         return std::nullopt;
-    if ((startOffset + textToSearch.size()) > this->size)
+    if (((size_t) startOffset + textToSearch.size()) > this->size)
         return std::nullopt;
 
     const auto* p      = this->text + startOffset;
     const auto* e      = this->text + size + 1 - textToSearch.size();
     const uint8* txt   = reinterpret_cast<const uint8*>(textToSearch.data());
     const uint8* txt_e = txt + textToSearch.size();
-    auto firstChar     = *txt;
+    char16 firstChar   = *txt;
+    char16 altChar     = firstChar;
     if (ignoreCase)
     {
         firstChar = string_lowercase_table[firstChar];
-        while (p < e)
-        {
-            if (string_lowercase_table[*p] == firstChar)
-            {
-                const auto* s = p;
-                const auto* t = txt;
-                for (; (t < txt_e); t++, s++)
-                {
-                    if (string_lowercase_table[*t] != string_lowercase_table[*s])
-                        break;
-                }
-                if (t == txt_e)
-                    return static_cast<uint32>(p - this->text);
-            }
-            p++;
-        }
+        altChar   = ((firstChar >= 'a') && (firstChar <= 'z')) ? static_cast<char16>(firstChar - ('a' - 'A')) : firstChar;
     }
-    else
+    while (p < e)
     {
-        while (p < e)
+        p = FindFirstOf(p, e, firstChar, altChar);
+        if (p >= e)
+            break;
+        const auto* s = p + 1;
+        const auto* t = txt + 1;
+        if (ignoreCase)
         {
-            if ((*p) == firstChar)
-            {
-                const auto* s = p;
-                const auto* t = txt;
-                for (; (t < txt_e); t++, s++)
-                {
-                    if ((*t) != (*s))
-                        break;
-                }
-                if (t == txt_e)
-                    return static_cast<uint32>(p - this->text);
-            }
-            p++;
+            for (; (t < txt_e) && (string_lowercase_table[*t] == LowerCase(*s)); t++, s++)
+                ;
+        }
+        else
+        {
+            for (; (t < txt_e) && ((*t) == (*s)); t++, s++)
+                ;
         }
+        if (t == txt_e)
+            return static_cast<uint32>(p - this->text);
+        p++;
     }
     // nothing found
     return std::nullopt;
@@ -224,18 +257,116 @@ bool TextEditor::ReplaceAll(std::string_view textToSearch, std::string_view text
     if ((textToSearch.empty()) || (this->size == 0))
         return false;
 
-    auto pos = 0;
-    auto len = static_cast<uint32>(textToSearch.size());
+    const auto searchLen  = static_cast<uint32>(textToSearch.size());
+    const auto replaceLen = static_cast<uint32>(textToReplaceWith.size());
 
-    do
+    if (replaceLen <= searchLen)
     {
-        auto res = Find(pos, textToSearch, ignoreCase);
-        if (!res.has_value())
-            break;
-        if (Replace(res.value(), len, textToReplaceWith) == false)
+        // the text can only shrink --> compact it in place (write pointer never gets ahead of the read pointer)
+        uint32 readPos  = 0;
+        uint32 writePos = 0;
+        while (true)
+        {
+            auto res       = Find(readPos, textToSearch, ignoreCase);
+            const auto end = res.has_value() ? res.value() : this->size;
+            if ((writePos != readPos) && (end > readPos))
+                memmove(this->text + writePos, this->text + readPos, (end - readPos) * sizeof(char16));
+            writePos += end - readPos;
+            if (!res.has_value())
+                break;
+            COPY_ASCII(writePos, textToReplaceWith.data(), replaceLen);
+            writePos += replaceLen;
+            readPos = end + searchLen;
+        }
+        this->size = writePos;
+        return true;
+    }
+
+    // the text will grow --> find all occurrences first and build the result in one new buffer
+    std::vector<uint32> positions;
+    for (auto res = Find(0, textToSearch, ignoreCase); res.has_value(); res = Find(res.value() + searchLen, textToSearch, ignoreCase))
+        positions.push_back(res.value());
+    if (positions.empty())
+        return true;
+
+    const auto newSize = (size_t) this->size + positions.size() * (size_t) (replaceLen - searchLen);
+    if (newSize > MAX_MEMORY_TO_ALLOCATE)
+        return false;
+    char16* result = nullptr;
+    try
+    {
+        result = new char16[(newSize | 0xFF) + 1];
+    }
+    catch (...)
+    {
+        return false;
+    }
+    auto* w        = result;
+    uint32 readPos = 0;
+    for (auto pos : positions)
+    {
+        memcpy(w, this->text + readPos, (pos - readPos) * sizeof(char16));
+        w += pos - readPos;
+        for (auto ch : textToReplaceWith)
+            *w++ = static_cast<uint8>(ch);
+        readPos = pos + searchLen;
+    }
+    memcpy(w, this->text + readPos, (this->size - readPos) * sizeof(char16));
+
+    delete[] this->text;
+    this->text      = result;
+    this->size      = static_cast<uint32>(newSize);
+    this->allocated = static_cast<uint32>((newSize | 0xFF) + 1);
+    return true;
+}
+bool TextEditor::ApplyEdits(std::vector<Edit>& edits)
+{
+    if (edits.empty())
+        return true;
+
+    // edits are applied in offset order and must not overlap
+    std::stable_sort(edits.begin(), edits.end(), [](const Edit& e1, const Edit& e2) { return e1.offset < e2.offset; });
+    size_t newSize = this->size;
+    uint32 lastEnd = 0;
+    for (const auto& e : edits)
+    {
+        if ((e.offset < lastEnd) || ((size_t) e.offset + e.size > this->size))
             return false;
-        pos += len;
-    } while (true);
+        lastEnd = e.offset + e.size;
+        newSize = newSize - e.size + e.text.size();
+    }
+    if (newSize > MAX_MEMORY_TO_ALLOCATE)
+        return false;
+
+    char16* result = nullptr;
+    try
+    {
+        result = new char16[(newSize | 0xFF) + 1];
+    }
+    catch (...)
+    {
+        return false;
+    }
+    auto* w        = result;
+    uint32 readPos = 0;
+    for (const auto& e : edits)
+    {
+        memcpy(w, this->text + readPos, (e.offset - readPos) * sizeof(char16));
+        w += e.offset - readPos;
+        if (!e.text.empty())
+        {
+            memcpy(w, e.text.data(), e.text.size() * sizeof(char16));
+            w += e.text.size();
+        }
+        readPos = e.offset + e.size;
+    }
+    if (readPos < this->size)
+        memcpy(w, this->text + readPos, (this->size - readPos) * sizeof(char16));
+
+    delete[] this->text;
+    this->text      = result;
+    this->size      = static_cast<uint32>(newSize);
+    this->allocated = static_cast<uint32>((newSize | 0xFF) + 1);
     return true;
 }
 bool TextEditor::DeleteChar(uint32 offset)
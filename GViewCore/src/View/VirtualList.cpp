@@ -0,0 +1,192 @@
+#include "GView.hpp"
+
+namespace GView::View
+{
+using namespace AppCUI::Controls;
+using namespace AppCUI::Graphics;
+using namespace AppCUI::Input;
+
+VirtualList::VirtualList(std::string_view layout, Reference<VirtualListModel> _model, std::initializer_list<VirtualListColumn> _columns)
+    : UserControl(layout, UserControlFlags::ShowVerticalScrollBar), model(_model), columns(_columns), rowsCount(0), topRow(0), currentRow(0)
+{
+    Refresh();
+}
+
+void VirtualList::Refresh()
+{
+    rowsCount = model->GetRowsCount();
+    if (currentRow >= rowsCount)
+    {
+        topRow     = 0;
+        currentRow = 0;
+    }
+    MoveTo(currentRow);
+}
+
+uint64 VirtualList::GetCurrentRow() const
+{
+    return currentRow < rowsCount ? currentRow : GView::Utils::INVALID_OFFSET;
+}
+
+uint32 VirtualList::GetVisibleRowsCount() const
+{
+    const auto height = this->GetHeight();
+    return height <= 1 ? 1 : static_cast<uint32>(height - 1); // first line is the header
+}
+
+void VirtualList::MoveTo(uint64 row)
+{
+    if (rowsCount == 0)
+        return;
+    row = std::min<uint64>(row, rowsCount - 1);
+
+    const auto visibleRows = GetVisibleRowsCount();
+    if (row < topRow)
+        topRow = row;
+    else if (row >= topRow + visibleRows)
+        topRow = row + 1 - visibleRows;
+    currentRow = row;
+}
+
+void VirtualList::SortByColumn(uint32 column)
+{
+    auto row = currentRow;
+    if (!model->SortByColumn(column, row))
+        return;
+    rowsCount  = model->GetRowsCount();
+    topRow     = 0;
+    currentRow = 0;
+    MoveTo(row);
+}
+
+void VirtualList::PaintHeader(Renderer& renderer)
+{
+    const auto& cfg = this->GetConfig();
+    const auto col  = this->HasFocus() ? cfg.Header.Text.Focused : cfg.Header.Text.Normal;
+    auto x          = 0;
+    auto sortColumn = 0U;
+    auto ascending  = true;
+    const auto sort = model->GetSortColumn(sortColumn, ascending);
+
+    renderer.FillHorizontalLine(0, 0, this->GetWidth(), ' ', col);
+    for (auto i = 0U; i < columns.size(); i++)
+    {
+        const auto& column = columns[i];
+        renderer.WriteSingleLineText(x, 0, column.width, column.name, col, TextAlignament::Center);
+        if (sort && (sortColumn == i))
+            renderer.WriteSpecialCharacter(x + column.width - 1, 0, ascending ? SpecialChars::TriangleUp : SpecialChars::TriangleDown, col);
+        x += column.width;
+        renderer.WriteSpecialCharacter(x, 0, SpecialChars::BoxVerticalSingleLine, col);
+        x++;
+    }
+}
+
+void VirtualList::PaintRow(Renderer& renderer, uint64 row, int y)
+{
+    LocalString<256> text;
+    const auto& cfg      = this->GetConfig();
+    const auto state     = this->HasFocus() ? ControlState::Focused : ControlState::Normal;
+    const auto lineColor = cfg.Lines.GetColor(state);
+    const auto textColor = row == currentRow ? cfg.Cursor.Normal : (this->HasFocus() ? cfg.Text.Focused : cfg.Text.Inactive);
+
+    if (row == currentRow)
+        renderer.FillHorizontalLine(0, y, this->GetWidth(), ' ', textColor);
+
+    auto x = 0;
+    for (auto column = 0U; column < columns.size(); column++)
+    {
+        text.Clear();
+        model->FormatCell(row, column, text);
+
+        const auto w = columns[column].width;
+        renderer.WriteSingleLineText(
+              x, y, w, text.ToStringView(), textColor, columns[column].alignLeft ? TextAlignament::Left : TextAlignament::Right);
+        x += w;
+        renderer.WriteSpecialCharacter(x, y, SpecialChars::BoxVerticalSingleLine, lineColor);
+        x++;
+    }
+}
+
+void VirtualList::Paint(Renderer& renderer)
+{
+    // the model can change in background (for example when an analysis finishes)
+    if (model->GetRowsCount() != rowsCount)
+        Refresh();
+
+    renderer.Clear();
+    PaintHeader(renderer);
+
+    const auto visibleRows = GetVisibleRowsCount();
+    auto y                 = 1;
+    for (auto row = topRow; (row < rowsCount) && (row < topRow + visibleRows); row++, y++)
+    {
+        PaintRow(renderer, row, y);
+    }
+}
+
+bool VirtualList::OnKeyEvent(Key keyCode, char16 characterCode)
+{
+    const auto pageSize = GetVisibleRowsCount();
+    switch (keyCode)
+    {
+    case Key::Up:
+        MoveTo(currentRow > 0 ? currentRow - 1 : 0);
+        return true;
+    case Key::Down:
+        MoveTo(currentRow + 1);
+        return true;
+    case Key::PageUp:
+        MoveTo(currentRow > pageSize ? currentRow - pageSize : 0);
+        return true;
+    case Key::PageDown:
+        MoveTo(currentRow + pageSize);
+        return true;
+    case Key::Home:
+        MoveTo(0);
+        return true;
+    case Key::End:
+        MoveTo(GView::Utils::INVALID_OFFSET);
+        return true;
+    }
+
+    return false;
+}
+
+void VirtualList::OnMousePressed(int x, int y, MouseButton button)
+{
+    if (y < 1)
+    {
+        // a click on the header sorts by that column
+        auto xPos = 0;
+        for (auto i = 0U; i < columns.size(); i++)
+        {
+            xPos += columns[i].width + 1;
+            if (x < xPos)
+            {
+                SortByColumn(i);
+                return;
+            }
+        }
+        return;
+    }
+    MoveTo(topRow + static_cast<uint64>(y - 1));
+}
+
+bool VirtualList::OnMouseWheel(int x, int y, MouseWheel direction)
+{
+    switch (direction)
+    {
+    case MouseWheel::Up:
+        return OnKeyEvent(Key::Up, false);
+    case MouseWheel::Down:
+        return OnKeyEvent(Key::Down, false);
+    }
+
+    return false;
+}
+
+void VirtualList::OnUpdateScrollBars()
+{
+    this->UpdateVScrollBar(currentRow, rowsCount > 0 ? rowsCount - 1 : 0);
+}
+} // namespace GView::View
@@ -18,4 +18,168 @@ bool Decompress(const Buffer& input, uint64 inputSize, Buffer& output, uint64 ou
 
     return true;
 }
+
+constexpr uint32 INFLATE_CHUNK_SIZE = 0x10000;
+
+struct InflaterContext
+{
+    z_stream stream{};
+    bool initialized{ false };
+    bool finished{ false };
+    uint64 consumed{ 0 };
+    uint64 produced{ 0 };
+    uint8 output[INFLATE_CHUNK_SIZE];
+};
+
+static int32 GetWindowBits(StreamFormat format)
+{
+    switch (format)
+    {
+    case StreamFormat::Raw:
+        return -MAX_WBITS;
+    case StreamFormat::GZIP:
+        return MAX_WBITS + 16;
+    case StreamFormat::Auto:
+        return MAX_WBITS + 32;
+    default:
+        return MAX_WBITS;
+    }
+}
+
+Inflater::Inflater()
+{
+    context = new InflaterContext;
+}
+
+Inflater::~Inflater()
+{
+    auto ctx = reinterpret_cast<InflaterContext*>(context);
+    if (ctx->initialized)
+        inflateEnd(&ctx->stream);
+    delete ctx;
+    context = nullptr;
+}
+
+bool Inflater::Init(StreamFormat format)
+{
+    auto ctx = reinterpret_cast<InflaterContext*>(context);
+    if (ctx->initialized)
+        inflateEnd(&ctx->stream);
+
+    ctx->stream      = {};
+    ctx->finished    = false;
+    ctx->consumed    = 0;
+    ctx->produced    = 0;
+    const auto ret   = inflateInit2(&ctx->stream, GetWindowBits(format));
+    ctx->initialized = (ret == Z_OK);
+    CHECK(ctx->initialized, false, "ZLIB error: %d!", ret);
+
+    return true;
+}
+
+bool Inflater::Reset()
+{
+    auto ctx = reinterpret_cast<InflaterContext*>(context);
+    CHECK(ctx->initialized, false, "Init must be called first !");
+
+    const auto ret = inflateReset(&ctx->stream);
+    CHECK(ret == Z_OK, false, "ZLIB error: %d!", ret);
+    ctx->finished = false;
+    ctx->consumed = 0;
+    ctx->produced = 0;
+
+    return true;
+}
+
+bool Inflater::Inflate(BufferView input, const std::function<bool(BufferView output)>& onOutput)
+{
+    auto ctx = reinterpret_cast<InflaterContext*>(context);
+    CHECK(ctx->initialized, false, "Init must be called first !");
+    CHECK(onOutput, false, "Expecting a valid callback !");
+    CHECK(input.IsValid(), false, "");
+
+    auto& stream  = ctx->stream;
+    size_t offset = 0;
+    while ((offset < input.GetLength()) && (!ctx->finished))
+    {
+        // zlib counts the input in 32 bit values
+        const auto piece = static_cast<uInt>(std::min<size_t>(input.GetLength() - offset, UINT32_MAX));
+        stream.next_in   = const_cast<Bytef*>(input.GetData() + offset);
+        stream.avail_in  = piece;
+        do
+        {
+            stream.next_out  = ctx->output;
+            stream.avail_out = INFLATE_CHUNK_SIZE;
+            const auto ret   = inflate(&stream, Z_NO_FLUSH);
+            CHECK((ret == Z_OK) || (ret == Z_STREAM_END) || (ret == Z_BUF_ERROR), false, "ZLIB error: %d!", ret);
+
+            const auto produced = INFLATE_CHUNK_SIZE - stream.avail_out;
+            ctx->produced += produced;
+            if ((produced > 0) && (!onOutput(BufferView(ctx->output, produced))))
+            {
+                ctx->consumed += piece - stream.avail_in;
+                return false;
+            }
+            if (ret == Z_STREAM_END)
+                ctx->finished = true;
+            else if (ret == Z_BUF_ERROR)
+                break; // no progress is possible without more input
+        } while ((!ctx->finished) && ((stream.avail_in > 0) || (stream.avail_out == 0)));
+
+        const auto used = piece - stream.avail_in;
+        ctx->consumed += used;
+        offset += used;
+        if (used == 0)
+            break;
+    }
+
+    return true;
+}
+
+bool Inflater::Inflate(Utils::DataCache& cache, uint64 start, uint64 size, const std::function<bool(BufferView output)>& onOutput)
+{
+    // the data is read one cache window at a time (zlib keeps the state of the stream between the windows)
+    const auto end = start + size;
+    for (auto offset = start; (offset < end) && (!IsFinished());)
+    {
+        const auto toRead = static_cast<uint32>(std::min<uint64>(cache.GetCacheSize(), end - offset));
+        const auto buffer = cache.Get(offset, toRead, false);
+        CHECK(buffer.IsValid() && (buffer.GetLength() > 0), false, "");
+        if (!Inflate(buffer, onOutput))
+            return false;
+        offset += buffer.GetLength();
+    }
+    return true;
+}
+
+bool Inflater::IsFinished() const
+{
+    return reinterpret_cast<InflaterContext*>(context)->finished;
+}
+
+uint64 Inflater::GetConsumed() const
+{
+    return reinterpret_cast<InflaterContext*>(context)->consumed;
+}
+
+uint64 Inflater::GetProduced() const
+{
+    return reinterpret_cast<InflaterContext*>(context)->produced;
+}
+
+bool DecompressStream(BufferView input, Buffer& output, StreamFormat format, uint64 sizeHint)
+{
+    Inflater inflater;
+    CHECK(inflater.Init(format), false, "");
+
+    output.Resize(0);
+    output.Reserve(sizeHint);
+    CHECK(inflater.Inflate(input, [&output](BufferView chunk) {
+        output.Add(chunk);
+        return true;
+    }), false, "");
+    CHECK(inflater.IsFinished(), false, "Truncated stream (%llu bytes decompressed) !", inflater.GetProduced());
+
+    return true;
+}
 } // namespace GView::ZLIB
@@ -275,6 +275,17 @@ namespace Utils
     }; // namespace CharacterEncoding
 } // namespace Utils
 
+namespace Dissasembly
+{
+    struct ClassifiedInstruction
+    {
+        uint32 type;          // one of the Opcodes values (or 0 if the instruction is not highlighted)
+        uint32 size;          // size of the instruction
+        uint32 highlightSize; // a function start also includes the next instruction
+    };
+    bool ClassifyInstruction(DissasemblerIntel& dissasembler, BufferView window, uint64 offset, ClassifiedInstruction& result);
+} // namespace Dissasembly
+
 namespace Generic
 {
     constexpr uint32 MAX_PLUGINS_COMMANDS = 8;
@@ -981,7 +981,8 @@ void CPPFile::CreateFoldUnfoldLinks(GView::View::LexicalViewer::SyntaxManager& s
 }
 void CPPFile::RemoveLineContinuityCharacter(TextEditor& editor)
 {
-    auto pos = 0;
+    std::vector<TextEditor::Edit> edits;
+    auto pos = 0U;
     do
     {
         auto res = editor.Find(pos, "\\");
@@ -995,15 +996,18 @@ void CPPFile::RemoveLineContinuityCharacter(TextEditor& editor)
             if (((nextAfterNext == '\n') || (nextAfterNext == '\r')) && (nextAfterNext != next))
             {
                 // case like \CRLF or \LFCR
-                editor.Delete(res.value(), 3);
+                edits.push_back({ res.value(), 3, u"" });
+                pos += 2;
             }
             else
             {
                 // case line \CR or \LF
-                editor.Delete(res.value(), 2);
+                edits.push_back({ res.value(), 2, u"" });
+                pos++;
             }
         }
     } while (true);
+    editor.ApplyEdits(edits);
 }
 void CPPFile::PreprocessText(GView::View::LexicalViewer::TextEditor& editor)
 {
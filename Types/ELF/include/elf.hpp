@@ -2,6 +2,8 @@
 
 #include "utils.hpp"
 
+#include <unordered_map>
+
 namespace GView::Type::ELF
 {
 enum class AddressType : uint8
@@ -12,6 +14,12 @@ enum class AddressType : uint8
 
 constexpr auto ELF_INVALID_ADDRESS = 0xFFFFFFFFFFFFFFFF;
 
+enum class SymbolTable : uint8
+{
+    Static  = 0, // .symtab
+    Dynamic = 1  // .dynsym
+};
+
 static constexpr auto INS_CALL_COLOR  = ColorPair{ Color::White, Color::DarkGreen };
 static constexpr auto INS_LCALL_COLOR = ColorPair{ Color::Red, Color::DarkGreen };
 
@@ -36,6 +44,7 @@ namespace Panels
         StaticSymbols  = 0x4,
         DynamicSymbols = 0x5,
         OpCodes        = 0x6,
+        Functions      = 0x7,
     };
 };
 
@@ -60,13 +69,16 @@ class ELFFile : public TypeInterface,
     std::vector<std::string> sectionNames;
     std::vector<uint32> sectionsToSegments;
 
+    // the names of the symbols are not copied --> st_name is an offset in the string table of the symbols
     std::vector<Elf32_Sym> staticSymbols32;
     std::vector<Elf64_Sym> staticSymbols64;
-    std::vector<std::string> staticSymbolsNames;
+    Buffer staticSymbolsStrings;
 
     std::vector<Elf32_Sym> dynamicSymbols32;
     std::vector<Elf64_Sym> dynamicSymbols64;
-    std::vector<std::string> dynamicSymbolsNames;
+    Buffer dynamicSymbolsStrings;
+    Buffer gnuHashTable;  // .gnu.hash of the dynamic symbols
+    Buffer sysvHashTable; // .hash of the dynamic symbols
 
     // GO
     uint32 nameSize = 0;
@@ -79,6 +91,16 @@ class ELFFile : public TypeInterface,
     uint32 showOpcodesMask{ 0 };
     std::vector<std::pair<uint64, uint64>> executableZonesFAs;
     GView::Dissasembly::DissasemblerIntel dissasembler{};
+    GView::Dissasembly::OpcodesCache opcodesCache;
+    GView::Dissasembly::LinearSweepDecoder linearSweep;
+    GView::Dissasembly::FunctionsAnalyzer functionsAnalyzer;
+
+  private:
+    GView::Utils::Demangler demangler;                                // caches the names it demangled
+    std::unordered_map<std::string_view, uint32> staticSymbolsByName; // built on the first lookup
+
+    bool FindGnuHashSymbol(std::string_view name, uint32& index, uint32& firstHashedSymbol) const;
+    bool FindSysVHashSymbol(std::string_view name, uint32& index) const;
 
   public:
     ELFFile();
@@ -91,8 +113,17 @@ class ELFFile : public TypeInterface,
     bool ParseGoData();
     bool ParseSymbols();
 
+    uint32 GetSymbolsCount(SymbolTable table) const;
+    std::string_view GetSymbolName(SymbolTable table, uint32 index) const;
+    // a name is demangled the first time it is needed (the name itself is returned if it is not mangled)
+    std::string_view GetDemangledName(std::string_view name);
+    std::string_view GetSymbolDemangledName(SymbolTable table, uint32 index);
+    // the dynamic symbols are found through the hash tables of the binary (.gnu.hash / .hash)
+    bool FindSymbol(SymbolTable table, std::string_view name, uint32& index);
+    bool StartFunctionsAnalysis();
+
     bool GetColorForBuffer(uint64 offset, BufferView buf, GView::View::BufferViewer::BufferColor& result) override;
-    bool GetColorForBufferIntel(uint64 offset, BufferView buf, GView::View::BufferViewer::BufferColor& result);
+    bool GetColorForBufferIntel(uint64 offset, GView::View::BufferViewer::BufferColor& result);
 
     uint64 TranslateToFileOffset(uint64 value, uint32 fromTranslationIndex) override;
     uint64 TranslateFromFileOffset(uint64 value, uint32 toTranslationIndex) override;
@@ -275,11 +306,11 @@ namespace Panels
         void OnAfterResize(int newWidth, int newHeight) override;
     };
 
-    class GoFunctions : public AppCUI::Controls::TabPage
+    class GoFunctions : public AppCUI::Controls::TabPage, public GView::View::VirtualListModel
     {
         Reference<ELFFile> elf;
         Reference<GView::View::WindowInterface> win;
-        Reference<AppCUI::Controls::ListView> list;
+        Reference<GView::View::VirtualList> list;
         int32 Base;
 
         std::string_view GetValue(NumericFormatter& n, uint64 value);
@@ -292,18 +323,41 @@ namespace Panels
         void Update();
         bool OnUpdateCommandBar(AppCUI::Application::CommandBar& commandBar) override;
         bool OnEvent(Reference<Control>, Event evnt, int controlID) override;
+
+        uint64 GetRowsCount() override;
+        void FormatCell(uint64 row, uint32 column, String& text) override;
+    };
+
+    // asks for a symbol name and finds it with ELFFile::FindSymbol
+    class FindSymbolDialog : public AppCUI::Controls::Window
+    {
+        Reference<ELFFile> elf;
+        Reference<AppCUI::Controls::TextField> txName;
+        SymbolTable table;
+        uint32 index;
+        void Validate();
+
+      public:
+        FindSymbolDialog(Reference<ELFFile> elf, SymbolTable table);
+
+        bool OnEvent(Reference<Control>, Event eventType, int ID) override;
+        inline uint32 GetSymbolIndex() const
+        {
+            return index;
+        }
     };
 
-    class DynamicSymbols : public AppCUI::Controls::TabPage
+    class DynamicSymbols : public AppCUI::Controls::TabPage, public GView::View::VirtualListModel
     {
         Reference<ELFFile> elf;
         Reference<GView::View::WindowInterface> win;
-        Reference<AppCUI::Controls::ListView> list;
+        Reference<GView::View::VirtualList> list;
         int32 Base;
 
         std::string_view GetValue(NumericFormatter& n, uint64 value);
         void GoToSelectedSection();
         void SelectCurrentSection();
+        void FindSymbol();
 
       public:
         DynamicSymbols(Reference<ELFFile> elf, Reference<GView::View::WindowInterface> win);
@@ -311,18 +365,21 @@ namespace Panels
         void Update();
         bool OnUpdateCommandBar(AppCUI::Application::CommandBar& commandBar) override;
         bool OnEvent(Reference<Control>, Event evnt, int controlID) override;
+        uint64 GetRowsCount() override;
+        void FormatCell(uint64 row, uint32 column, String& text) override;
     };
 
-    class StaticSymbols : public AppCUI::Controls::TabPage
+    class StaticSymbols : public AppCUI::Controls::TabPage, public GView::View::VirtualListModel
     {
         Reference<ELFFile> elf;
         Reference<GView::View::WindowInterface> win;
-        Reference<AppCUI::Controls::ListView> list;
+        Reference<GView::View::VirtualList> list;
         int32 Base;
 
         std::string_view GetValue(NumericFormatter& n, uint64 value);
         void GoToSelectedSection();
         void SelectCurrentSection();
+        void FindSymbol();
 
       public:
         StaticSymbols(Reference<ELFFile> elf, Reference<GView::View::WindowInterface> win);
@@ -330,6 +387,8 @@ namespace Panels
         void Update();
         bool OnUpdateCommandBar(AppCUI::Application::CommandBar& commandBar) override;
         bool OnEvent(Reference<Control>, Event evnt, int controlID) override;
+        uint64 GetRowsCount() override;
+        void FormatCell(uint64 row, uint32 column, String& text) override;
     };
 
     class OpCodes : public AppCUI::Controls::TabPage
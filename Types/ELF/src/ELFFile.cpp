@@ -12,19 +12,6 @@ bool ELFFile::Update()
     panelsMask |= (1ULL << (uint8) Panels::IDs::Segments);
     panelsMask |= (1ULL << (uint8) Panels::IDs::Sections);
 
-    switch (is64 ? header64.e_machine : header32.e_machine)
-    {
-    case EM_386:
-    case EM_486:
-    case EM_860:
-    case EM_960:
-    case EM_8051:
-    case EM_X86_64:
-        panelsMask |= (1ULL << (uint8) Panels::IDs::OpCodes);
-    default:
-        break;
-    }
-
     uint64 offset = 0;
     CHECK(obj->GetData().Copy<Elf32_Ehdr>(offset, header32), false, "");
     if (header32.e_ident[EI_CLASS] != ELFCLASS32)
@@ -41,6 +28,24 @@ bool ELFFile::Update()
 
     isLittleEndian = (header32.e_ident[EI_DATA] == ELFDATA2LSB);
 
+    // the machine is known only once the header was read
+    switch (is64 ? header64.e_machine : header32.e_machine)
+    {
+    case EM_386:
+    case EM_486:
+    case EM_X86_64:
+        panelsMask |= (1ULL << (uint8) Panels::IDs::OpCodes);
+        panelsMask |= (1ULL << (uint8) Panels::IDs::Functions); // only x86/x64 code is analyzed
+        break;
+    case EM_860:
+    case EM_960:
+    case EM_8051:
+        panelsMask |= (1ULL << (uint8) Panels::IDs::OpCodes);
+        break;
+    default:
+        break;
+    }
+
     if (is64)
     {
         offset = header64.e_phoff;
@@ -171,6 +176,7 @@ bool ELFFile::HasPanel(Panels::IDs id)
 bool ELFFile::ParseGoData()
 {
     Buffer noteBuffer;
+    bool hasGoBuildId = false;
     if (is64)
     {
         for (const auto& segment : segments64)
@@ -204,6 +210,7 @@ bool ELFFile::ParseGoData()
             noteNameView == Golang::ELF_GO_NOTE)
         {
             pcLnTab.SetBuildId({ (char*) noteBuffer.GetData() + 16, valSize });
+            hasGoBuildId = true;
         }
 
         if (nameSize == 4 && 16ULL + valSize <= noteBuffer.GetLength() && tag == Golang::GNU_BUILD_ID_TAG &&
@@ -238,131 +245,311 @@ bool ELFFile::ParseGoData()
             }
 
             CHECK(pcLnTab.Process(obj->GetData().CopyToBuffer(bufferOffset, (uint32) bufferSize), arch), false, "");
-            break;
+            return true;
         }
     }
 
-    return true;
-}
+    // no .gopclntab section (stripped) --> the table is searched in the loaded segments of a Go binary
+    if (!hasGoBuildId)
+        return true;
 
-bool ELFFile::ParseSymbols()
-{
+    std::vector<std::pair<uint64, uint64>> ranges;
     if (is64)
     {
-        for (auto i = 0; i < sections64.size(); i++)
+        for (const auto& segment : segments64)
         {
-            const auto& section = sections64.at(i);
-            if (section.sh_type == SHT_SYMTAB) /* Static symbol table */
-            {
-                panelsMask |= (1ULL << (uint8) Panels::IDs::StaticSymbols);
-
-                const auto staticSymbolsBuffer = obj->GetData().CopyToBuffer(section.sh_offset, (uint32) section.sh_size);
+            if (segment.p_type == PT_LOAD)
+                ranges.emplace_back(segment.p_offset, segment.p_offset + segment.p_filesz);
+        }
+    }
+    else
+    {
+        for (const auto& segment : segments32)
+        {
+            if (segment.p_type == PT_LOAD)
+                ranges.emplace_back(segment.p_offset, (uint64) segment.p_offset + segment.p_filesz);
+        }
+    }
 
-                const auto& strtabSection = sections64.at(section.sh_link);
-                const auto strtabBuffer   = obj->GetData().CopyToBuffer(strtabSection.sh_offset, (uint32) strtabSection.sh_size);
+    // only the header of a candidate is read, the whole table is read for the first valid one
+    const auto arch = is64 ? Golang::Architecture::x64 : Golang::Architecture::x86;
+    for (const auto offset : Golang::FindPcLnTabSigsCandidates(obj->GetData(), ranges))
+    {
+        if (!Golang::IsValidPcLnTabHeader(obj->GetData().Get(offset, Golang::PCLNTAB_HEADER_MAX_SIZE, false), arch))
+            continue;
 
-                auto offset = 0U;
-                while (offset < section.sh_size)
+        for (const auto& [start, end] : ranges)
+        {
+            if ((offset >= start) && (offset < end))
+            {
+                if (pcLnTab.Process(obj->GetData().CopyToBuffer(offset, static_cast<uint32>(end - offset), false), arch))
                 {
-                    const auto& sym = staticSymbols64.emplace_back(*(Elf64_Sym*) (staticSymbolsBuffer.GetData() + offset));
-                    offset += sizeof(Elf64_Sym);
-
-                    String demangled;
-                    const auto str = reinterpret_cast<char*>((char*) (strtabBuffer.GetData() + sym.st_name));
-                    if (GView::Utils::Demangle(str, demangled) == false)
-                    {
-                        demangled = str;
-                    }
-
-                    staticSymbolsNames.emplace_back(demangled.GetText());
+                    panelsMask |= (1ULL << (uint8) Panels::IDs::GoInformation);
+                    return true;
                 }
+                break;
             }
-            else if (section.sh_type == SHT_DYNSYM) /* Dynamic symbol table */
-            {
-                panelsMask |= (1ULL << (uint8) Panels::IDs::DynamicSymbols);
+        }
+    }
 
-                const auto dynamicSymbolsBuffer = obj->GetData().CopyToBuffer(section.sh_offset, (uint32) section.sh_size);
+    return true;
+}
 
-                const auto& dstrtabSection = sections64.at(section.sh_link);
-                const auto dstrtabBuffer   = obj->GetData().CopyToBuffer(dstrtabSection.sh_offset, (uint32) dstrtabSection.sh_size);
+template <typename Section, typename Symbol>
+static bool ReadSymbolsTable(
+      GView::Utils::DataCache& cache,
+      const std::vector<Section>& sections,
+      const Section& section,
+      std::vector<Symbol>& symbols,
+      Buffer& strings)
+{
+    // the whole table is read at once and its entries are copied as they are
+    const auto count = static_cast<size_t>(section.sh_size / sizeof(Symbol));
+    CHECK(count > 0, false, "");
+    const auto buffer = cache.CopyToBuffer(section.sh_offset, static_cast<uint32>(count * sizeof(Symbol)), false);
+    CHECK(buffer.IsValid(), false, "");
+    symbols.resize(count);
+    memcpy(symbols.data(), buffer.GetData(), count * sizeof(Symbol));
+
+    CHECK(section.sh_link < sections.size(), false, "");
+    const auto& strtab = sections[section.sh_link];
+    if (strtab.sh_size > 0)
+        strings = cache.CopyToBuffer(strtab.sh_offset, static_cast<uint32>(strtab.sh_size), false);
 
-                auto offset = 0U;
-                while (offset < section.sh_size)
-                {
-                    const auto& sym = dynamicSymbols64.emplace_back(*(Elf64_Sym*) (dynamicSymbolsBuffer.GetData() + offset));
-                    offset += sizeof(Elf64_Sym);
+    return true;
+}
 
-                    String demangled;
-                    const auto str = reinterpret_cast<char*>((char*) (dstrtabBuffer.GetData() + sym.st_name));
-                    if (GView::Utils::Demangle(str, demangled) == false)
-                    {
-                        demangled = str;
-                    }
+template <typename Section>
+static Buffer ReadHashTable(GView::Utils::DataCache& cache, const std::vector<Section>& sections, uint32 type, uint32 symbolsIndex)
+{
+    for (const auto& section : sections)
+    {
+        if ((section.sh_type == type) && (section.sh_link == symbolsIndex) && (section.sh_size > 0))
+            return cache.CopyToBuffer(section.sh_offset, static_cast<uint32>(section.sh_size), false);
+    }
+    return Buffer();
+}
 
-                    dynamicSymbolsNames.emplace_back(demangled.GetText());
-                }
+template <typename Section, typename Symbol>
+static void ReadSymbols(
+      ELFFile& elf,
+      const std::vector<Section>& sections,
+      std::vector<Symbol>& staticSymbols,
+      std::vector<Symbol>& dynamicSymbols)
+{
+    auto& cache = elf.obj->GetData();
+    for (auto i = 0U; i < sections.size(); i++)
+    {
+        const auto& section = sections[i];
+        if ((section.sh_type == SHT_SYMTAB) && (staticSymbols.empty())) /* Static symbol table */
+        {
+            if (ReadSymbolsTable(cache, sections, section, staticSymbols, elf.staticSymbolsStrings))
+                elf.panelsMask |= (1ULL << (uint8) Panels::IDs::StaticSymbols);
+        }
+        else if ((section.sh_type == SHT_DYNSYM) && (dynamicSymbols.empty())) /* Dynamic symbol table */
+        {
+            if (ReadSymbolsTable(cache, sections, section, dynamicSymbols, elf.dynamicSymbolsStrings))
+            {
+                elf.panelsMask |= (1ULL << (uint8) Panels::IDs::DynamicSymbols);
+                elf.gnuHashTable  = ReadHashTable(cache, sections, SHT_GNU_HASH, i);
+                elf.sysvHashTable = ReadHashTable(cache, sections, SHT_HASH, i);
             }
         }
     }
+}
+
+bool ELFFile::ParseSymbols()
+{
+    if (is64)
+        ReadSymbols(*this, sections64, staticSymbols64, dynamicSymbols64);
     else
+        ReadSymbols(*this, sections32, staticSymbols32, dynamicSymbols32);
+
+    return true;
+}
+
+uint32 ELFFile::GetSymbolsCount(SymbolTable table) const
+{
+    if (table == SymbolTable::Static)
+        return static_cast<uint32>(is64 ? staticSymbols64.size() : staticSymbols32.size());
+    return static_cast<uint32>(is64 ? dynamicSymbols64.size() : dynamicSymbols32.size());
+}
+
+static inline std::string_view GetString(const Buffer& strings, uint32 offset)
+{
+    CHECK(offset < strings.GetLength(), std::string_view{}, "");
+    const auto start = reinterpret_cast<const char*>(strings.GetData()) + offset;
+    const auto end   = reinterpret_cast<const char*>(memchr(start, 0, strings.GetLength() - offset));
+    return std::string_view{ start, end != nullptr ? static_cast<size_t>(end - start) : strings.GetLength() - offset };
+}
+
+static inline uint32 GetSymbolNameOffset(const ELFFile& elf, SymbolTable table, uint32 index)
+{
+    if (table == SymbolTable::Static)
+        return elf.is64 ? elf.staticSymbols64[index].st_name : elf.staticSymbols32[index].st_name;
+    return elf.is64 ? elf.dynamicSymbols64[index].st_name : elf.dynamicSymbols32[index].st_name;
+}
+
+std::string_view ELFFile::GetSymbolName(SymbolTable table, uint32 index) const
+{
+    CHECK(index < GetSymbolsCount(table), std::string_view{}, "");
+    const auto& strings = table == SymbolTable::Static ? staticSymbolsStrings : dynamicSymbolsStrings;
+    return GetString(strings, GetSymbolNameOffset(*this, table, index));
+}
+
+std::string_view ELFFile::GetDemangledName(std::string_view name)
+{
+    if (name.empty())
+        return name;
+    const auto demangled = demangler.Demangle(name);
+    return demangled.empty() ? name : demangled;
+}
+
+std::string_view ELFFile::GetSymbolDemangledName(SymbolTable table, uint32 index)
+{
+    return GetDemangledName(GetSymbolName(table, index));
+}
+
+// https://flapenguin.me/elf-dt-gnu-hash
+static uint32 GnuHash(std::string_view name)
+{
+    uint32 h = 5381;
+    for (const auto c : name)
+        h = (h << 5) + h + static_cast<uint8>(c);
+    return h;
+}
+
+static uint32 SysVHash(std::string_view name)
+{
+    uint32 h = 0;
+    for (const auto c : name)
     {
-        for (auto i = 0; i < sections32.size(); i++)
-        {
-            const auto& section = sections32.at(i);
-            if (section.sh_type == SHT_SYMTAB) /* Static symbol table */
-            {
-                panelsMask |= (1ULL << (uint8) Panels::IDs::StaticSymbols);
+        h             = (h << 4) + static_cast<uint8>(c);
+        const auto hi = h & 0xF0000000;
+        if (hi != 0)
+            h ^= hi >> 24;
+        h &= ~hi;
+    }
+    return h;
+}
 
-                const auto staticSymbolsBuffer = obj->GetData().CopyToBuffer(section.sh_offset, section.sh_size);
+// nbuckets, symoffset, bloomSize, bloomShift, bloom[bloomSize] (ELFCLASS words), buckets[nbuckets], chain[]
+bool ELFFile::FindGnuHashSymbol(std::string_view name, uint32& index, uint32& firstHashedSymbol) const
+{
+    const auto data = gnuHashTable.GetData();
+    const auto size = static_cast<uint64>(gnuHashTable.GetLength());
+    CHECK(size >= 4 * sizeof(uint32), false, "");
+
+    const auto header     = reinterpret_cast<const uint32*>(data);
+    const auto nbuckets   = header[0];
+    const auto symoffset  = header[1];
+    const auto bloomSize  = header[2];
+    const auto bloomShift = header[3];
+    const auto wordBits   = is64 ? 64U : 32U;
+    const auto buckets    = 4 * sizeof(uint32) + static_cast<uint64>(bloomSize) * (wordBits / 8);
+    const auto chain      = buckets + static_cast<uint64>(nbuckets) * sizeof(uint32);
+    CHECK(nbuckets > 0 && bloomSize > 0 && bloomShift < 32 && chain <= size, false, "");
+    firstHashedSymbol = symoffset;
+
+    // the bloom filter rejects most of the missing names
+    const auto h        = GnuHash(name);
+    const auto bloom    = data + 4 * sizeof(uint32);
+    const auto position = (h / wordBits) % bloomSize;
+    const auto word     = is64 ? reinterpret_cast<const uint64*>(bloom)[position] : reinterpret_cast<const uint32*>(bloom)[position];
+    const auto mask     = (1ULL << (h % wordBits)) | (1ULL << ((h >> bloomShift) % wordBits));
+    CHECK((word & mask) == mask, false, "");
+
+    const auto count = GetSymbolsCount(SymbolTable::Dynamic);
+    for (auto i = reinterpret_cast<const uint32*>(data + buckets)[h % nbuckets]; (i >= symoffset) && (i < count); i++)
+    {
+        const auto position = chain + static_cast<uint64>(i - symoffset) * sizeof(uint32);
+        CHECK(position + sizeof(uint32) <= size, false, "");
+        const auto h2 = *reinterpret_cast<const uint32*>(data + position);
+        if (((h | 1) == (h2 | 1)) && (GetSymbolName(SymbolTable::Dynamic, i) == name))
+        {
+            index = i;
+            return true;
+        }
+        // the last symbol of the chain
+        if (h2 & 1)
+            break;
+    }
 
-                const auto& strtabSection = sections32.at(section.sh_link);
-                const auto strtabBuffer   = obj->GetData().CopyToBuffer(strtabSection.sh_offset, strtabSection.sh_size);
+    return false;
+}
 
-                auto offset = 0U;
-                while (offset < section.sh_size)
-                {
-                    const auto& sym = staticSymbols32.emplace_back(*(Elf32_Sym*) (staticSymbolsBuffer.GetData() + offset));
-                    offset += sizeof(Elf32_Sym);
+// nbucket, nchain, buckets[nbucket], chain[nchain]
+bool ELFFile::FindSysVHashSymbol(std::string_view name, uint32& index) const
+{
+    const auto data = reinterpret_cast<const uint32*>(sysvHashTable.GetData());
+    const auto size = static_cast<uint64>(sysvHashTable.GetLength()) / sizeof(uint32);
+    CHECK(size >= 2, false, "");
 
-                    String demangled;
-                    const auto str = reinterpret_cast<char*>((char*) (strtabBuffer.GetData() + sym.st_name));
-                    if (GView::Utils::Demangle(str, demangled) == false)
-                    {
-                        demangled = str;
-                    }
+    const auto nbucket = data[0];
+    const auto nchain  = data[1];
+    CHECK(nbucket > 0 && 2ULL + nbucket + nchain <= size, false, "");
 
-                    staticSymbolsNames.emplace_back(demangled.GetText());
-                }
-            }
-            else if (section.sh_type == SHT_DYNSYM) /* Dynamic symbol table */
-            {
-                panelsMask |= (1ULL << (uint8) Panels::IDs::DynamicSymbols);
+    const auto buckets = data + 2;
+    const auto chain   = buckets + nbucket;
+    const auto count   = std::min<uint32>(nchain, GetSymbolsCount(SymbolTable::Dynamic));
 
-                const auto dynamicSymbolsBuffer = obj->GetData().CopyToBuffer(section.sh_offset, section.sh_size);
+    // the chain can not be longer than the number of symbols (unless it has a loop)
+    auto i = buckets[SysVHash(name) % nbucket];
+    for (auto steps = 0U; (i != STN_UNDEF) && (i < count) && (steps < count); i = chain[i], steps++)
+    {
+        if (GetSymbolName(SymbolTable::Dynamic, i) == name)
+        {
+            index = i;
+            return true;
+        }
+    }
 
-                const auto& dstrtabSection = sections32.at(section.sh_link);
-                const auto dstrtabBuffer   = obj->GetData().CopyToBuffer(dstrtabSection.sh_offset, dstrtabSection.sh_size);
+    return false;
+}
 
-                auto offset = 0U;
-                while (offset < section.sh_size)
-                {
-                    const auto& sym = dynamicSymbols32.emplace_back(*(Elf32_Sym*) (dynamicSymbolsBuffer.GetData() + offset));
-                    offset += sizeof(Elf32_Sym);
+bool ELFFile::FindSymbol(SymbolTable table, std::string_view name, uint32& index)
+{
+    CHECK(!name.empty(), false, "");
+    const auto count = GetSymbolsCount(table);
 
-                    String demangled;
-                    const auto str = reinterpret_cast<char*>((char*) (dstrtabBuffer.GetData() + sym.st_name));
-                    if (GView::Utils::Demangle(str, demangled) == false)
-                    {
-                        demangled = str;
-                    }
+    if (table == SymbolTable::Static)
+    {
+        // no hash table for .symtab
+        if (staticSymbolsByName.empty() && (count > 0))
+        {
+            staticSymbolsByName.reserve(count);
+            for (auto i = 0U; i < count; i++)
+                staticSymbolsByName.try_emplace(GetSymbolName(SymbolTable::Static, i), i);
+        }
 
-                    dynamicSymbolsNames.emplace_back(demangled.GetText());
-                }
-            }
+        const auto it = staticSymbolsByName.find(name);
+        CHECK(it != staticSymbolsByName.end(), false, "");
+        index = it->second;
+        return true;
+    }
+
+    // .hash has all the symbols, .gnu.hash only the ones after symoffset (the undefined ones are not hashed)
+    if (sysvHashTable.IsValid())
+        return FindSysVHashSymbol(name, index);
+
+    auto linearSearchEnd = count;
+    if (gnuHashTable.IsValid())
+    {
+        if (FindGnuHashSymbol(name, index, linearSearchEnd))
+            return true;
+        linearSearchEnd = std::min<uint32>(linearSearchEnd, count);
+    }
+
+    for (auto i = 0U; i < linearSearchEnd; i++)
+    {
+        if (GetSymbolName(SymbolTable::Dynamic, i) == name)
+        {
+            index = i;
+            return true;
         }
     }
 
-    return true;
+    return false;
 }
 
 uint64 ELFFile::TranslateToFileOffset(uint64 value, uint32 fromTranslationIndex)
@@ -513,126 +700,110 @@ uint64 ELFFile::GetVirtualSize() const
     return -1;
 }
 
-bool ELFFile::GetColorForBufferIntel(uint64 offset, BufferView buf, GView::View::BufferViewer::BufferColor& result)
+template <typename T>
+static void AddFunctionSymbols(ELFFile& elf, SymbolTable table, const std::vector<T>& symbols)
 {
-    CHECK(dissasembler.Init(is64, isLittleEndian), false, "");
-
-    static auto previousOpcodeMask = showOpcodesMask;
-    static std::map<uint64, GView::View::BufferViewer::BufferColor> cacheBuffer{};
-    static std::map<uint64, bool> cacheDiscard{};
-
-    if (previousOpcodeMask != showOpcodesMask)
+    for (auto i = 0U; i < symbols.size(); i++)
     {
-        cacheBuffer.clear();
-        cacheDiscard.clear();
-        previousOpcodeMask = showOpcodesMask;
+        const auto& symbol = symbols[i];
+        if ((ELF_ST_TYPE(symbol.st_info) == STT_FUNC) && (symbol.st_shndx != SHN_UNDEF) && (symbol.st_value != 0))
+            elf.functionsAnalyzer.AddEntryPoint(symbol.st_value, elf.GetSymbolName(table, i));
     }
+}
 
-    if (cacheBuffer.count(offset) > 0)
-    {
-        result = cacheBuffer.at(offset);
+bool ELFFile::StartFunctionsAnalysis()
+{
+    if (functionsAnalyzer.IsStarted())
         return true;
-    }
 
-    if (cacheDiscard.count(offset) > 0)
+    // known functions first: their names are kept (the others are found by following the calls)
+    functionsAnalyzer.AddEntryPoint(is64 ? header64.e_entry : header32.e_entry, "EntryPoint");
+    if (is64)
     {
-        return false;
+        AddFunctionSymbols(*this, SymbolTable::Static, staticSymbols64);
+        AddFunctionSymbols(*this, SymbolTable::Dynamic, dynamicSymbols64);
     }
-
-    GView::Dissasembly::Instruction ins{ 0 };
-    CHECK(dissasembler.DissasembleInstruction(buf, offset, ins), false, "");
-
-    if (((showOpcodesMask & (uint32) GView::Dissasembly::Opcodes::Call) == (uint32) GView::Dissasembly::Opcodes::Call))
+    else
     {
-        if (dissasembler.IsCallInstruction(ins))
-        {
-            result.start        = offset;
-            result.end          = offset + ins.size;
-            result.color        = INS_CALL_COLOR;
-            cacheBuffer[offset] = result;
-            return true;
-        }
+        AddFunctionSymbols(*this, SymbolTable::Static, staticSymbols32);
+        AddFunctionSymbols(*this, SymbolTable::Dynamic, dynamicSymbols32);
     }
-
-    if (((showOpcodesMask & (uint32) GView::Dissasembly::Opcodes::LCall) == (uint32) GView::Dissasembly::Opcodes::LCall))
+    const auto goFunctionsCount = pcLnTab.GetFunctionsCount();
+    for (auto i = 0ULL; i < goFunctionsCount; i++)
     {
-        if (dissasembler.IsLCallInstruction(ins))
-        {
-            result.start        = offset;
-            result.end          = offset + ins.size;
-            result.color        = INS_LCALL_COLOR;
-            cacheBuffer[offset] = result;
-            return true;
-        }
+        Golang::Function f{};
+        if (pcLnTab.GetFunction(i, f))
+            functionsAnalyzer.AddEntryPoint(f.func.entry, f.name != nullptr ? f.name : "");
     }
 
-    if (((showOpcodesMask & (uint32) GView::Dissasembly::Opcodes::Jmp) == (uint32) GView::Dissasembly::Opcodes::Jmp))
+    std::vector<GView::Dissasembly::ExecutableZone> zones;
+    if (is64)
     {
-        if (dissasembler.IsJmpInstruction(ins))
+        for (const auto& segment : segments64)
         {
-            result.start        = offset;
-            result.end          = offset + ins.size;
-            result.color        = INS_JUMP_COLOR;
-            cacheBuffer[offset] = result;
-            return true;
+            if ((segment.p_flags & PF_X) == PF_X)
+                zones.push_back({ segment.p_offset, segment.p_filesz, segment.p_vaddr });
         }
     }
-
-    if (((showOpcodesMask & (uint32) GView::Dissasembly::Opcodes::LJmp) == (uint32) GView::Dissasembly::Opcodes::LJmp))
+    else
     {
-        if (dissasembler.IsLJmpInstruction(ins))
+        for (const auto& segment : segments32)
         {
-            result.start        = offset;
-            result.end          = offset + ins.size;
-            result.color        = INS_LJUMP_COLOR;
-            cacheBuffer[offset] = result;
-            return true;
+            if ((segment.p_flags & PF_X) == PF_X)
+                zones.push_back({ segment.p_offset, segment.p_filesz, segment.p_vaddr });
         }
     }
 
-    if (((showOpcodesMask & (uint32) GView::Dissasembly::Opcodes::Breakpoint) == (uint32) GView::Dissasembly::Opcodes::Breakpoint))
-    {
-        if (dissasembler.IsBreakpointInstruction(ins))
-        {
-            result.start        = offset;
-            result.end          = offset + ins.size;
-            result.color        = INS_BREAKPOINT_COLOR;
-            cacheBuffer[offset] = result;
-            return true;
-        }
-    }
+    return functionsAnalyzer.Start(obj->GetData(), zones, is64, isLittleEndian);
+}
 
-    if (((showOpcodesMask & (uint32) GView::Dissasembly::Opcodes::FunctionStart) == (uint32) GView::Dissasembly::Opcodes::FunctionStart))
-    {
-        GView::Dissasembly::Instruction ins2{ 0 };
-        const auto offset2 = offset + ins.size;
-        CHECK(dissasembler.DissasembleInstruction({ buf.GetData() + ins.size, buf.GetLength() - ins.size }, offset2, ins2), false, "");
+bool ELFFile::GetColorForBufferIntel(uint64 offset, GView::View::BufferViewer::BufferColor& result)
+{
+    CHECK(dissasembler.Init(is64, isLittleEndian), false, "");
 
-        if (dissasembler.AreFunctionStartInstructions(ins, ins2))
-        {
-            result.start        = offset;
-            result.end          = offset + ins.size + ins2.size;
-            result.color        = START_FUNCTION_COLOR;
-            cacheBuffer[offset] = result;
-            return true;
-        }
-    }
+    if (!linearSweep.IsStarted())
+        linearSweep.Start(obj->GetData(), executableZonesFAs, is64, isLittleEndian);
 
-    if (((showOpcodesMask & (uint32) GView::Dissasembly::Opcodes::FunctionEnd) == (uint32) GView::Dissasembly::Opcodes::FunctionEnd))
+    // once the background linear sweep is done only the real instruction starts are highlighted; until then (or outside the
+    // decoded zones) the whole page that contains 'offset' is decoded once (the mask is applied here, so it can change freely)
+    uint32 type = 0;
+    uint32 size = 0;
+    if (!linearSweep.GetInstruction(offset, type, size))
     {
-        if (dissasembler.IsFunctionEndInstruction(ins))
-        {
-            result.start        = offset;
-            result.end          = offset + ins.size;
-            result.color        = END_FUNCTION_COLOR;
-            cacheBuffer[offset] = result;
-            return true;
-        }
+        CHECK(opcodesCache.Get(dissasembler, obj->GetData(), offset, type, size), false, "");
     }
+    CHECK((showOpcodesMask & type) != 0, false, "");
 
-    cacheDiscard[offset] = false;
+    switch (static_cast<GView::Dissasembly::Opcodes>(type))
+    {
+    case GView::Dissasembly::Opcodes::Call:
+        result.color = INS_CALL_COLOR;
+        break;
+    case GView::Dissasembly::Opcodes::LCall:
+        result.color = INS_LCALL_COLOR;
+        break;
+    case GView::Dissasembly::Opcodes::Jmp:
+        result.color = INS_JUMP_COLOR;
+        break;
+    case GView::Dissasembly::Opcodes::LJmp:
+        result.color = INS_LJUMP_COLOR;
+        break;
+    case GView::Dissasembly::Opcodes::Breakpoint:
+        result.color = INS_BREAKPOINT_COLOR;
+        break;
+    case GView::Dissasembly::Opcodes::FunctionStart:
+        result.color = START_FUNCTION_COLOR;
+        break;
+    case GView::Dissasembly::Opcodes::FunctionEnd:
+        result.color = END_FUNCTION_COLOR;
+        break;
+    default:
+        return false;
+    }
 
-    return false;
+    result.start = offset;
+    result.end   = offset + size;
+    return true;
 }
 
 bool ELFFile::GetColorForBuffer(uint64 offset, BufferView buf, GView::View::BufferViewer::BufferColor& result)
@@ -672,7 +843,7 @@ bool ELFFile::GetColorForBuffer(uint64 offset, BufferView buf, GView::View::Buff
             {
                 if (offset >= start && offset < end)
                 {
-                    return GetColorForBufferIntel(offset, buf, result);
+                    return GetColorForBufferIntel(offset, result);
                 }
             }
             break;
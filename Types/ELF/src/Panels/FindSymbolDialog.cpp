@@ -0,0 +1,71 @@
+#include "elf.hpp"
+
+namespace GView::Type::ELF::Panels
+{
+using namespace AppCUI::Controls;
+using namespace AppCUI::Input;
+
+constexpr int32 BTN_ID_OK     = 1;
+constexpr int32 BTN_ID_CANCEL = 2;
+
+FindSymbolDialog::FindSymbolDialog(Reference<ELFFile> _elf, SymbolTable _table)
+    : Window("Find symbol", "d:c,w:60,h:8", WindowFlags::ProcessReturn), elf(_elf), table(_table), index(0)
+{
+    Factory::Label::Create(this, "&Name", "x:1,y:1,w:6");
+    txName = Factory::TextField::Create(this, "", "x:8,y:1,w:48");
+    txName->SetHotKey('N');
+
+    Factory::Button::Create(this, "&OK", "l:15,b:0,w:13", BTN_ID_OK);
+    Factory::Button::Create(this, "&Cancel", "l:30,b:0,w:13", BTN_ID_CANCEL);
+
+    txName->SetFocus();
+}
+
+void FindSymbolDialog::Validate()
+{
+    LocalString<512> tmp;
+    if (tmp.Set(txName->GetText()) == false)
+    {
+        Dialogs::MessageBox::ShowError("Error", "Invalid name (expecting ascii characters) !");
+        txName->SetFocus();
+        return;
+    }
+
+    // the (mangled) name as it is in the string table
+    if (elf->FindSymbol(table, tmp.ToStringView(), index) == false)
+    {
+        Dialogs::MessageBox::ShowError("Error", "Symbol not found !");
+        txName->SetFocus();
+        return;
+    }
+    Exit(Dialogs::Result::Ok);
+}
+
+bool FindSymbolDialog::OnEvent(Reference<Control> control, Event eventType, int ID)
+{
+    if (eventType == Event::ButtonClicked)
+    {
+        switch (ID)
+        {
+        case BTN_ID_CANCEL:
+            Exit(Dialogs::Result::Cancel);
+            return true;
+        case BTN_ID_OK:
+            Validate();
+            return true;
+        }
+    }
+
+    switch (eventType)
+    {
+    case Event::WindowAccept:
+        Validate();
+        return true;
+    case Event::WindowClose:
+        Exit(Dialogs::Result::Cancel);
+        return true;
+    }
+
+    return false;
+}
+} // namespace GView::Type::ELF::Panels
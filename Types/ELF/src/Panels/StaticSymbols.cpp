@@ -9,7 +9,8 @@ enum class ObjectAction : int32
 {
     GoTo       = 1,
     Select     = 2,
-    ChangeBase = 4
+    ChangeBase = 4,
+    FindSymbol = 8
 };
 
 StaticSymbols::StaticSymbols(Reference<ELFFile> _elf, Reference<GView::View::WindowInterface> _win) : TabPage("St&aticSymbols")
@@ -18,20 +19,18 @@ StaticSymbols::StaticSymbols(Reference<ELFFile> _elf, Reference<GView::View::Win
     win  = _win;
     Base = 16;
 
-    list = Factory::ListView::Create(
-          this,
+    // only the visible rows are formatted --> the names are demangled when they are shown
+    list = this->CreateChildControl<GView::View::VirtualList>(
           "d:c",
-          { "n:#,a:r,w:6",
-            "n:Name,a:l,w:40",
-            "n:Name Index,a:r,w:12",
-            "n:Value,a:r,w:10",
-            "n:Size,a:r,w:8",
-            "n:(b/t/v) Info,a:r,w:40",
-            "n:Other,a:r,w:12",
-            "n:Section Header Index,a:r,w:24" },
-          ListViewFlags::None);
-
-    Update();
+          this,
+          std::initializer_list<GView::View::VirtualListColumn>{ { "#", 6, false },
+                                                                 { "Name", 40, true },
+                                                                 { "Name Index", 12, false },
+                                                                 { "Value", 10, false },
+                                                                 { "Size", 8, false },
+                                                                 { "(b/t/v) Info", 40, false },
+                                                                 { "Other", 12, false },
+                                                                 { "Section Header Index", 24, false } });
 }
 
 std::string_view StaticSymbols::GetValue(NumericFormatter& n, uint64 value)
@@ -61,8 +60,8 @@ void StaticSymbols::GoToSelectedSection()
       TODO: handle above ^
    */
 
-    auto i = list->GetCurrentItem().GetData(-1);
-    CHECKRET(i != -1, "");
+    const auto i = list->GetCurrentRow();
+    CHECKRET(i != GView::Utils::INVALID_OFFSET, "");
 
     auto offset = 0ULL;
     if (elf->is64)
@@ -84,8 +83,8 @@ void StaticSymbols::SelectCurrentSection()
     auto offset = 0ULL;
     auto size   = 0ULL;
 
-    auto i = list->GetCurrentItem().GetData(-1);
-    CHECKRET(i != -1, "");
+    const auto i = list->GetCurrentRow();
+    CHECKRET(i != GView::Utils::INVALID_OFFSET, "");
 
     if (elf->is64)
     {
@@ -103,89 +102,78 @@ void StaticSymbols::SelectCurrentSection()
     win->GetCurrentView()->Select(offset, size);
 }
 
+void StaticSymbols::FindSymbol()
+{
+    FindSymbolDialog dialog(elf, SymbolTable::Static);
+    CHECKRET(dialog.Show() == Dialogs::Result::Ok, "");
+    list->MoveTo(dialog.GetSymbolIndex());
+}
+
 void StaticSymbols::Update()
 {
-    list->DeleteAllItems();
+    list->Refresh();
+}
 
-    LocalString<128> tmp;
+uint64 StaticSymbols::GetRowsCount()
+{
+    return elf->GetSymbolsCount(SymbolTable::Static);
+}
+
+void StaticSymbols::FormatCell(uint64 row, uint32 column, String& text)
+{
     NumericFormatter n;
-    NumericFormatter n2;
 
-    if (elf->is64)
-    {
-        for (auto i = 0ULL; i < elf->staticSymbols64.size(); i++)
+    auto format = [&](const auto& record) {
+        switch (column)
+        {
+        case 0:
+            text.Set(GetValue(n, row));
+            break;
+        case 1:
+            text.Set(elf->GetSymbolDemangledName(SymbolTable::Static, static_cast<uint32>(row)));
+            break;
+        case 2:
+            text.Set(GetValue(n, record.st_name));
+            break;
+        case 3:
+            text.Set(GetValue(n, record.st_value));
+            break;
+        case 4:
+            text.Set(GetValue(n, record.st_size));
+            break;
+        case 5:
+        {
+            const auto bindName       = ELF::GetNameFromSymbolBinding(ELF_ST_BIND(record.st_info));
+            const auto typeName       = ELF::GetNameFromSymbolType(ELF_ST_TYPE(record.st_info));
+            const auto visibilityName = ELF::GetNameFromSymbolVisibility(ELF_ST_VISIBILITY(record.st_info));
+            text.Format("[%s | %s | %s ] %s", bindName.data(), typeName.data(), visibilityName.data(), GetValue(n, record.st_info).data());
+            break;
+        }
+        case 6:
+            text.Set(GetValue(n, record.st_other));
+            break;
+        case 7:
         {
-            const auto& record = elf->staticSymbols64[i];
-            auto item          = list->AddItem({ tmp.Format("%s", GetValue(n, i).data()) });
-
-            const auto& name = elf->staticSymbolsNames.at(i);
-            item.SetText(1, tmp.Format("%s", name.c_str()));
-
-            item.SetText(2, tmp.Format("%s", GetValue(n, record.st_name).data()));
-            item.SetText(3, tmp.Format("%s", GetValue(n, record.st_value).data()));
-            item.SetText(4, tmp.Format("%s", GetValue(n, record.st_size).data()));
-
-            const auto bind           = ELF_ST_BIND(record.st_info);
-            const auto bindName       = ELF::GetNameFromSymbolBinding(bind);
-            const auto type           = ELF_ST_TYPE(record.st_info);
-            const auto typeName       = ELF::GetNameFromSymbolType(type);
-            const auto visibility     = ELF_ST_VISIBILITY(record.st_info);
-            const auto visibilityName = ELF::GetNameFromSymbolVisibility(visibility);
-
-            item.SetText(
-                  5,
-                  tmp.Format(
-                        "[%s | %s | %s ] %s", bindName.data(), typeName.data(), visibilityName.data(), GetValue(n, record.st_info).data()));
-
-            item.SetText(6, tmp.Format("%s", GetValue(n, record.st_other).data()));
-
             auto sectionType = ELF::GetSectionSpecialIndexFromSymbolIndex(record.st_shndx);
-            if (sectionType == "")
+            if ((sectionType == "") && (record.st_shndx < elf->sectionNames.size()))
             {
-                sectionType = elf->sectionNames.at(record.st_shndx);
+                sectionType = elf->sectionNames[record.st_shndx];
             }
-            item.SetText(7, tmp.Format("[%s] %s", sectionType.data(), GetValue(n, record.st_shndx).data()));
-
-            item.SetData(i);
+            text.Format("[%.*s] %s", static_cast<int32>(sectionType.size()), sectionType.data(), GetValue(n, record.st_shndx).data());
+            break;
+        }
         }
+    };
+
+    if (elf->is64)
+    {
+        CHECKRET(row < elf->staticSymbols64.size(), "");
+        format(elf->staticSymbols64[row]);
     }
     else
     {
-        for (auto i = 0ULL; i < elf->staticSymbols32.size(); i++)
-        {
-            const auto& record = elf->staticSymbols32[i];
-            auto item          = list->AddItem({ tmp.Format("%s", GetValue(n, i).data()) });
-
-            const auto& name = elf->staticSymbolsNames.at(i);
-            item.SetText(1, tmp.Format("%s", name.c_str()));
-
-            item.SetText(2, tmp.Format("%s", GetValue(n, record.st_name).data()));
-            item.SetText(3, tmp.Format("%s", GetValue(n, record.st_value).data()));
-            item.SetText(4, tmp.Format("%s", GetValue(n, record.st_size).data()));
-
-            const auto bind           = ELF_ST_BIND(record.st_info);
-            const auto bindName       = ELF::GetNameFromSymbolBinding(bind);
-            const auto type           = ELF_ST_TYPE(record.st_info);
-            const auto typeName       = ELF::GetNameFromSymbolType(type);
-            const auto visibility     = ELF_ST_VISIBILITY(record.st_info);
-            const auto visibilityName = ELF::GetNameFromSymbolVisibility(visibility);
-
-            item.SetText(
-                  5,
-                  tmp.Format(
-                        "[%s | %s | %s ] %s", bindName.data(), typeName.data(), visibilityName.data(), GetValue(n, record.st_info).data()));
-
-            item.SetText(6, tmp.Format("%s", GetValue(n, record.st_other).data()));
-
-            auto sectionType = ELF::GetSectionSpecialIndexFromSymbolIndex(record.st_shndx);
-            if (sectionType == "")
-            {
-                sectionType = elf->sectionNames.at(record.st_shndx);
-            }
-            item.SetText(7, tmp.Format("[%s] %s", sectionType.data(), GetValue(n, record.st_shndx).data()));
-
-            item.SetData(i);
-        }
+        CHECKRET(row < elf->staticSymbols32.size(), "");
+        format(elf->staticSymbols32[row]);
     }
 }
 
@@ -194,6 +182,7 @@ bool StaticSymbols::OnUpdateCommandBar(AppCUI::Application::CommandBar& commandB
     commandBar.SetCommand(Key::Enter, "GoTo", static_cast<int32>(ObjectAction::GoTo));
     commandBar.SetCommand(Key::F9, "Select", static_cast<int32>(ObjectAction::Select));
     commandBar.SetCommand(Key::F2, Base == 10 ? "Dec" : "Hex", static_cast<int32>(ObjectAction::ChangeBase));
+    commandBar.SetCommand(Key::Ctrl | Key::F, "Find", static_cast<int32>(ObjectAction::FindSymbol));
 
     return true;
 }
@@ -202,12 +191,6 @@ bool StaticSymbols::OnEvent(Reference<Control> ctrl, Event evnt, int controlID)
 {
     CHECK(TabPage::OnEvent(ctrl, evnt, controlID) == false, true, "");
 
-    if (evnt == Event::ListViewItemPressed)
-    {
-        GoToSelectedSection();
-        return true;
-    }
-
     if (evnt == Event::Command)
     {
         switch (static_cast<ObjectAction>(controlID))
@@ -222,6 +205,9 @@ bool StaticSymbols::OnEvent(Reference<Control> ctrl, Event evnt, int controlID)
         case ObjectAction::Select:
             SelectCurrentSection();
             return true;
+        case ObjectAction::FindSymbol:
+            FindSymbol();
+            return true;
         }
     }
 
@@ -156,6 +156,17 @@ extern "C"
         {
             win->AddPanel(Pointer<TabPage>(new ELF::Panels::OpCodes(win->GetObject(), elf)), true);
         }
+        if (elf->HasPanel(ELF::Panels::IDs::Functions))
+        {
+            // the names of the symbols are demangled only when they are shown
+            win->AddPanel(
+                  Pointer<TabPage>(new GView::View::FunctionsPanel(
+                        &elf->functionsAnalyzer,
+                        win,
+                        [elf]() { return elf->StartFunctionsAnalysis(); },
+                        [elf](std::string_view name) { return elf->GetDemangledName(name); })),
+                  false);
+        }
 
         return true;
     }
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "GView.hpp"
+
+namespace GView::Type::GZIP
+{
+constexpr uint8 ID1               = 0x1F;
+constexpr uint8 ID2               = 0x8B;
+constexpr uint8 METHOD_DEFLATE    = 8;
+constexpr uint32 TRAILER_SIZE     = 8;    // CRC32 + ISIZE
+constexpr uint32 MAX_STRING_SIZE  = 1024; // file name & comment
+constexpr uint32 DEFLATE_MAX_RATE = 1032; // the best compression rate of deflate
+
+enum class Flags : uint8
+{
+    Text    = 0x01,
+    HCRC    = 0x02,
+    Extra   = 0x04,
+    Name    = 0x08,
+    Comment = 0x10
+};
+
+#pragma pack(push, 1)
+struct Header
+{
+    uint8 id1;
+    uint8 id2;
+    uint8 method;
+    uint8 flags;
+    uint32 mtime;
+    uint8 extraFlags;
+    uint8 os;
+};
+#pragma pack(pop)
+
+constexpr std::string_view GetNameForOS(uint8 os)
+{
+    switch (os)
+    {
+    case 0:
+        return "FAT";
+    case 1:
+        return "Amiga";
+    case 2:
+        return "VMS";
+    case 3:
+        return "Unix";
+    case 4:
+        return "VM/CMS";
+    case 5:
+        return "Atari TOS";
+    case 6:
+        return "HPFS";
+    case 7:
+        return "Macintosh";
+    case 8:
+        return "Z-System";
+    case 9:
+        return "CP/M";
+    case 10:
+        return "TOPS-20";
+    case 11:
+        return "NTFS";
+    case 12:
+        return "QDOS";
+    case 13:
+        return "Acorn RISCOS";
+    default:
+        return "Unknown";
+    }
+}
+
+class GZIPFile : public TypeInterface,
+                 public View::ContainerViewer::EnumerateInterface,
+                 public View::ContainerViewer::OpenItemInterface
+{
+  public:
+    Header header{};
+    uint16 extraSize{ 0 };
+    std::string name;
+    std::string comment;
+    std::u16string contentName; // the original file name (or the name of the object without the extension)
+    uint64 dataOffset{ 0 };
+    uint32 crc32{ 0 };
+    uint32 uncompressedSize{ 0 }; // of the last member (modulo 2^32)
+
+  public:
+    GZIPFile()          = default;
+    virtual ~GZIPFile() = default;
+
+    bool Update();
+    // all the members of the file are decompressed one after another (their data is concatenated)
+    bool Decompress(Buffer& output);
+
+    std::string_view GetTypeName() override
+    {
+        return "GZIP";
+    }
+    void RunCommand(std::string_view) override;
+
+    virtual bool BeginIteration(std::u16string_view path, AppCUI::Controls::TreeViewItem parent) override;
+    virtual bool PopulateItem(TreeViewItem item) override;
+    virtual void OnOpenItem(std::u16string_view path, AppCUI::Controls::TreeViewItem item) override;
+
+  private:
+    bool ReadString(uint64& offset, std::string& value);
+};
+
+namespace Panels
+{
+    class Information : public AppCUI::Controls::TabPage
+    {
+        inline static const auto dec = NumericFormat{ NumericFormatFlags::None, 10, 3, ',' };
+        inline static const auto hex = NumericFormat{ NumericFormatFlags::HexPrefix, 16 };
+
+        Reference<Object> object;
+        Reference<GView::Type::GZIP::GZIPFile> gzip;
+        Reference<AppCUI::Controls::ListView> general;
+
+        void UpdateGeneralInformation();
+        void RecomputePanelsPositions();
+
+        template <typename T>
+        void AddDecAndHexElement(std::string_view name, T value)
+        {
+            LocalString<1024> ls;
+            NumericFormatter nf;
+            NumericFormatter nf2;
+
+            const auto v    = nf.ToString(value, dec);
+            const auto vHex = nf2.ToString(value, hex);
+            general->AddItem({ name, ls.Format("%-14s (%s)", v.data(), vHex.data()) });
+        }
+
+      public:
+        Information(Reference<Object> _object, Reference<GView::Type::GZIP::GZIPFile> _gzip);
+
+        void Update();
+        virtual void OnAfterResize(int newWidth, int newHeight) override
+        {
+            RecomputePanelsPositions();
+        }
+    };
+}; // namespace Panels
+} // namespace GView::Type::GZIP
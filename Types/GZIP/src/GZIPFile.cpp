@@ -0,0 +1,143 @@
+#include "gzip.hpp"
+
+namespace GView::Type::GZIP
+{
+bool GZIPFile::ReadString(uint64& offset, std::string& value)
+{
+    const auto buffer = obj->GetData().Get(offset, MAX_STRING_SIZE, false);
+    CHECK(buffer.IsValid(), false, "");
+
+    const auto text = std::string_view{ reinterpret_cast<const char*>(buffer.GetData()), buffer.GetLength() };
+    const auto end  = text.find('\0');
+    CHECK(end != std::string_view::npos, false, "String without a terminator (or longer than %u bytes) !", MAX_STRING_SIZE);
+
+    value = text.substr(0, end);
+    offset += end + 1;
+    return true;
+}
+
+bool GZIPFile::Update()
+{
+    auto& cache = obj->GetData();
+    CHECK(cache.Copy<Header>(0, header), false, "");
+
+    uint64 offset = sizeof(Header);
+    if (header.flags & static_cast<uint8>(Flags::Extra))
+    {
+        CHECK(cache.Copy<uint16>(offset, extraSize), false, "");
+        offset += sizeof(uint16) + extraSize;
+    }
+    if (header.flags & static_cast<uint8>(Flags::Name))
+    {
+        CHECK(ReadString(offset, name), false, "");
+    }
+    if (header.flags & static_cast<uint8>(Flags::Comment))
+    {
+        CHECK(ReadString(offset, comment), false, "");
+    }
+    if (header.flags & static_cast<uint8>(Flags::HCRC))
+    {
+        offset += sizeof(uint16);
+    }
+    dataOffset = offset;
+
+    const auto size = cache.GetSize();
+    if (size >= dataOffset + TRAILER_SIZE)
+    {
+        CHECK(cache.Copy<uint32>(size - TRAILER_SIZE, crc32), false, "");
+        CHECK(cache.Copy<uint32>(size - sizeof(uint32), uncompressedSize), false, "");
+    }
+
+    if (!name.empty())
+    {
+        contentName.assign(name.begin(), name.end());
+    }
+    else
+    {
+        // "file.gz" --> "file" & "file.tgz" --> "file.tar"
+        contentName = obj->GetName();
+        const auto dot = contentName.rfind(u'.');
+        if (dot != std::u16string::npos)
+        {
+            const auto extension = contentName.substr(dot + 1);
+            contentName.resize(dot);
+            if (extension == u"tgz")
+                contentName += u".tar";
+        }
+    }
+
+    return true;
+}
+
+bool GZIPFile::Decompress(Buffer& output)
+{
+    auto& cache     = obj->GetData();
+    const auto size = cache.GetSize();
+
+    // ISIZE is only a hint (it can lie and it is the size of the last member)
+    output.Resize(0);
+    if (uncompressedSize <= size * DEFLATE_MAX_RATE)
+        output.Reserve(uncompressedSize);
+
+    GView::ZLIB::Inflater inflater;
+    CHECK(inflater.Init(GView::ZLIB::StreamFormat::GZIP), false, "");
+    const auto onOutput = [&output](BufferView chunk) {
+        output.Add(chunk);
+        return true;
+    };
+
+    uint64 offset = 0;
+    while (offset < size)
+    {
+        CHECK(inflater.Inflate(cache, offset, size - offset, onOutput), false, "");
+        CHECK(inflater.IsFinished(), false, "Truncated member at offset %llu (%llu bytes decompressed) !", offset, inflater.GetProduced());
+        offset += inflater.GetConsumed();
+
+        // anything else than a new member (e.g. padding) ends the file
+        const auto next = cache.Get(offset, 2, true);
+        if ((!next.IsValid()) || (next.GetData()[0] != ID1) || (next.GetData()[1] != ID2))
+            break;
+        CHECK(inflater.Reset(), false, "");
+    }
+
+    return true;
+}
+
+void GZIPFile::RunCommand(std::string_view commandName)
+{
+    if (commandName == "Decompress")
+    {
+        Buffer output;
+        CHECKRET(Decompress(output), "");
+        GView::App::OpenBuffer(output, contentName, GView::App::OpenMethod::BestMatch);
+    }
+}
+
+bool GZIPFile::BeginIteration(std::u16string_view path, AppCUI::Controls::TreeViewItem parent)
+{
+    // a single item: the decompressed content
+    return true;
+}
+
+bool GZIPFile::PopulateItem(TreeViewItem item)
+{
+    const static auto dec = NumericFormat{ NumericFormatFlags::None, 10, 3, '.' };
+    NumericFormatter n;
+
+    item.SetText(contentName);
+    item.SetText(1, n.ToString(obj->GetData().GetSize() - dataOffset, dec));
+    item.SetText(2, n.ToString(static_cast<uint64>(uncompressedSize), dec));
+    item.SetPriority(0);
+    item.SetExpandable(false);
+
+    return false;
+}
+
+void GZIPFile::OnOpenItem(std::u16string_view path, AppCUI::Controls::TreeViewItem item)
+{
+    // the content is decompressed only when it is opened
+    Buffer output;
+    CHECKRET(Decompress(output), "");
+    GView::App::OpenBuffer(output, contentName, path, GView::App::OpenMethod::BestMatch);
+}
+} // namespace GView::Type::GZIP
@@ -0,0 +1,77 @@
+#include "gzip.hpp"
+
+#include <ctime>
+
+using namespace AppCUI::Controls;
+
+namespace GView::Type::GZIP::Panels
+{
+Information::Information(Reference<Object> _object, Reference<GView::Type::GZIP::GZIPFile> _gzip)
+    : TabPage("Informa&tion"), object(_object), gzip(_gzip)
+{
+    general = CreateChildControl<ListView>(
+          "x:0,y:0,w:100%,h:10", std::initializer_list<ConstString>{ "n:Field,w:24", "n:Value,w:100" }, ListViewFlags::None);
+
+    Update();
+}
+
+void Information::UpdateGeneralInformation()
+{
+    LocalString<1024> ls;
+
+    general->AddItem("Info").SetType(ListViewItem::Type::Category);
+    general->AddItem({ "File", object->GetName() });
+    AddDecAndHexElement("Size", gzip->obj->GetData().GetSize());
+
+    general->AddItem("Header").SetType(ListViewItem::Type::Category);
+    const auto& header = gzip->header;
+    general->AddItem({ "Method", ls.Format("%s (%u)", header.method == METHOD_DEFLATE ? "Deflate" : "Unknown", header.method) });
+
+    ls.Format("0x%02X", header.flags);
+    const std::initializer_list<std::pair<Flags, std::string_view>> flags = {
+        { Flags::Text, "Text" }, { Flags::HCRC, "HCRC" }, { Flags::Extra, "Extra" }, { Flags::Name, "Name" }, { Flags::Comment, "Comment" }
+    };
+    for (const auto& [flag, flagName] : flags)
+    {
+        if (header.flags & static_cast<uint8>(flag))
+            ls.AddFormat(" %.*s", static_cast<int32>(flagName.size()), flagName.data());
+    }
+    general->AddItem({ "Flags", ls.GetText() });
+
+    if (header.mtime != 0)
+    {
+        const auto time = static_cast<std::time_t>(header.mtime);
+        char text[64]{ 0 };
+        std::strftime(text, sizeof(text), "%Y-%m-%d %H:%M:%S UTC", std::gmtime(&time));
+        general->AddItem({ "Modified", ls.Format("%s (%u)", text, header.mtime) });
+    }
+    AddDecAndHexElement("Extra Flags", static_cast<uint32>(header.extraFlags));
+    const auto os = GetNameForOS(header.os);
+    general->AddItem({ "OS", ls.Format("%.*s (%u)", static_cast<int32>(os.size()), os.data(), header.os) });
+    if (header.flags & static_cast<uint8>(Flags::Extra))
+        AddDecAndHexElement("Extra Size", static_cast<uint32>(gzip->extraSize));
+    if (!gzip->name.empty())
+        general->AddItem({ "Name", gzip->name });
+    if (!gzip->comment.empty())
+        general->AddItem({ "Comment", gzip->comment });
+    AddDecAndHexElement("Data Offset", gzip->dataOffset);
+
+    general->AddItem("Trailer").SetType(ListViewItem::Type::Category);
+    general->AddItem({ "CRC32", ls.Format("0x%08X", gzip->crc32) });
+    AddDecAndHexElement("Uncompressed Size", gzip->uncompressedSize);
+}
+
+void Information::RecomputePanelsPositions()
+{
+    CHECKRET(general.IsValid(), "");
+    general->Resize(GetWidth(), general->GetItemsCount() + 3);
+}
+
+void Information::Update()
+{
+    general->DeleteAllItems();
+
+    UpdateGeneralInformation();
+    RecomputePanelsPositions();
+}
+} // namespace GView::Type::GZIP::Panels
@@ -0,0 +1,107 @@
+#include "gzip.hpp"
+
+using namespace AppCUI;
+using namespace AppCUI::Utils;
+using namespace AppCUI::Application;
+using namespace AppCUI::Controls;
+using namespace GView::Utils;
+using namespace GView::Type;
+using namespace GView;
+using namespace GView::View;
+
+constexpr string_view GZIP_ICON = "................"  // 1
+                                  "................"  // 2
+                                  "................"  // 3
+                                  "................"  // 4
+                                  "WWWWWW..WWWWWWW."  // 5
+                                  "WW..........WW.."  // 6
+                                  "WW.........WW..."  // 7
+                                  "WW.WWW....WW...."  // 8
+                                  "WW..WW...WW....."  // 9
+                                  "WW..WW..WW......"  // 10
+                                  "WWWWWW..WWWWWWW."  // 11
+                                  "................"  // 12
+                                  "................"  // 13
+                                  "................"  // 14
+                                  "................"  // 15
+                                  "................"; // 16
+
+extern "C"
+{
+    PLUGIN_EXPORT bool Validate(const AppCUI::Utils::BufferView& buf, const std::string_view& extension)
+    {
+        auto header = buf.GetObject<GZIP::Header>(0);
+        CHECK(header.IsValid(), false, "");
+        CHECK(header->id1 == GZIP::ID1 && header->id2 == GZIP::ID2, false, "");
+        CHECK(header->method == GZIP::METHOD_DEFLATE, false, "");
+
+        return true;
+    }
+
+    PLUGIN_EXPORT TypeInterface* CreateInstance()
+    {
+        return new GZIP::GZIPFile();
+    }
+
+    void CreateBufferView(Reference<GView::View::WindowInterface> win, Reference<GZIP::GZIPFile> gzip)
+    {
+        BufferViewer::Settings settings;
+
+        const auto size = win->GetObject()->GetData().GetSize();
+        settings.AddZone(0, gzip->dataOffset, ColorPair{ Color::Magenta, Color::DarkBlue }, "Header");
+        if (size >= gzip->dataOffset + GZIP::TRAILER_SIZE)
+        {
+            settings.AddZone(
+                  gzip->dataOffset,
+                  size - gzip->dataOffset - GZIP::TRAILER_SIZE,
+                  ColorPair{ Color::DarkGreen, Color::DarkBlue },
+                  "Content");
+            settings.AddZone(size - GZIP::TRAILER_SIZE, GZIP::TRAILER_SIZE, ColorPair{ Color::Pink, Color::DarkBlue }, "Trailer");
+        }
+
+        win->CreateViewer("BufferView", settings);
+    }
+
+    void CreateContainerView(Reference<GView::View::WindowInterface> win, Reference<GZIP::GZIPFile> gzip)
+    {
+        ContainerViewer::Settings settings;
+
+        settings.SetIcon(GZIP_ICON);
+        settings.SetColumns({
+              "n:&Name,a:l,w:80",
+              "n:&Compressed Size,a:r,w:20",
+              "n:&Size,a:r,w:20",
+        });
+
+        settings.SetEnumerateCallback(
+              win->GetObject()->GetContentType<GZIP::GZIPFile>().ToObjectRef<ContainerViewer::EnumerateInterface>());
+        settings.SetOpenItemCallback(
+              win->GetObject()->GetContentType<GZIP::GZIPFile>().ToObjectRef<ContainerViewer::OpenItemInterface>());
+
+        win->CreateViewer("ContainerView", settings);
+    }
+
+    PLUGIN_EXPORT bool PopulateWindow(Reference<GView::View::WindowInterface> win)
+    {
+        auto gzip = win->GetObject()->GetContentType<GZIP::GZIPFile>();
+        gzip->Update();
+
+        // add views
+        CreateBufferView(win, gzip);
+        CreateContainerView(win, gzip);
+
+        // add panels
+        win->AddPanel(Pointer<TabPage>(new GZIP::Panels::Information(win->GetObject(), gzip)), true);
+
+        return true;
+    }
+
+    PLUGIN_EXPORT void UpdateSettings(IniSection sect)
+    {
+        sect["Pattern"]            = "magic:1F 8B 08";
+        sect["Extension"]          = { "gz", "gzip", "tgz" };
+        sect["Priority"]           = 1;
+        sect["Description"]        = "GZIP file format (*.gz)";
+        sect["Command.Decompress"] = AppCUI::Input::Key::Shift | AppCUI::Input::Key::F10;
+    }
+}
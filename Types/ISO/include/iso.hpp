@@ -3,8 +3,54 @@
 #include "Common.hpp"
 #include "ECMA119.hpp"
 
+#include <atomic>
+#include <deque>
+#include <thread>
+#include <unordered_map>
+
 namespace GView::Type::ISO
 {
+enum class NamesSource : uint8
+{
+    ISO9660,  // the identifiers of the primary volume descriptor (without the version)
+    Joliet,   // the identifiers of the supplementary volume descriptor (UCS-2)
+    RockRidge // the NM entries from the System Use area of the records (SUSP)
+};
+
+#pragma pack(push, 1)
+struct SUSP_ContinuationEntry // "CE"
+{
+    char signature[2];
+    uint8 length;
+    uint8 version;
+    int32_LSB_MSB block;
+    int32_LSB_MSB offset;
+    int32_LSB_MSB size;
+};
+#pragma pack(pop)
+
+struct ContinuationArea
+{
+    uint32 block; // logical block
+    uint32 offset;
+    uint32 size;
+};
+
+using ContinuationBlocks = std::unordered_map<uint32, Buffer>; // Rock Ridge CE blocks (logical block --> data)
+
+struct IndexEntry
+{
+    uint64 recordOffset; // where the directory record is in the file
+    uint32 location;     // logical block of the data (extent)
+    uint32 dataLength;
+    uint8 fileFlags;
+    unsigned char recordingDateAndTime[7];
+    bool expanded;     // the children are added when the directory is expanded for the first time
+    uint32 firstChild; // the children of a directory are consecutive entries
+    uint32 childrenCount;
+    std::u16string name;
+};
+
 class ISOFile : public TypeInterface, public View::ContainerViewer::EnumerateInterface, public View::ContainerViewer::OpenItemInterface
 {
   public:
@@ -15,23 +61,50 @@ class ISOFile : public TypeInterface, public View::ContainerViewer::EnumerateInt
     };
 
     std::vector<MyVolumeDescriptorHeader> headers;
-    std::vector<ECMA_119_DirectoryRecord> records;
 
     ECMA_119_PrimaryVolumeDescriptor pvd{};
+    ECMA_119_SupplementaryVolumeDescriptor svd{}; // Joliet
     ECMA_119_DirectoryRecord root{};
-    std::vector<ECMA_119_DirectoryRecord> objects;
+    uint32 blockSize{ static_cast<uint32>(ECMA_119_SECTOR_SIZE) };
+    NamesSource namesSource{ NamesSource::ISO9660 };
+    uint32 suspSkip{ 0 }; // bytes skipped at the start of every System Use area (from the SP entry)
 
-    std::map<uint64, ECMA_119_DirectoryRecord> itemsCache;
+    // the directories of the container view (read when they are expanded) --> entries[0] is the root directory
+    // a deque: the tree items keep pointers to their entries
+    std::deque<IndexEntry> entries;
 
     uint32 currentItemIndex;
+    uint32 endItemIndex;
+
+  private:
+    ContinuationBlocks continuations; // used by the expanded directories
+    std::thread worker;
+    std::atomic<bool> cancel{ false };
+    std::atomic<bool> indexReady{ false };
+
+    // every record of the image & its name (Joliet / Rock Ridge, UTF-8), indexed in background (with its own reader)
+    std::vector<ECMA_119_DirectoryRecord> records;
+    std::vector<std::string> names;
+
+    bool DetectNamesSource();
+    bool ExpandDirectory(Reference<IndexEntry> directory);
+    void BuildIndex(GView::Utils::DataCache::Reader reader);
+    std::u16string GetName(const uint8* record, const ContinuationBlocks& blocks) const;
+    bool GetRockRidgeName(const uint8* record, const ContinuationBlocks& blocks, std::u16string& name) const;
 
   public:
     ISOFile();
-    virtual ~ISOFile()
-    {
-    }
+    virtual ~ISOFile();
 
     bool Update();
+    // the methods below fail (without waiting) until the index is built
+    inline bool IsIndexReady() const
+    {
+        return indexReady.load(std::memory_order_acquire);
+    }
+    uint32 GetRecordsCount() const;
+    const ECMA_119_DirectoryRecord* GetRecord(uint32 index) const;
+    std::string_view GetRecordName(uint32 index) const;
 
     std::string_view GetTypeName() override
     {
@@ -135,14 +208,15 @@ namespace Panels
         }
     };
 
-    class Objects : public AppCUI::Controls::TabPage
+    class Objects : public AppCUI::Controls::TabPage, public GView::View::VirtualListModel
     {
         Reference<ISOFile> iso;
         Reference<GView::View::WindowInterface> win;
-        Reference<AppCUI::Controls::ListView> list;
+        Reference<GView::View::VirtualList> list;
         int32 Base;
 
         std::string_view GetValue(NumericFormatter& n, uint64 value);
+        const ECMA_119_DirectoryRecord* GetSelectedRecord();
         void GoToSelectedSection();
         void SelectCurrentSection();
 
@@ -152,6 +226,9 @@ namespace Panels
         void Update();
         bool OnUpdateCommandBar(AppCUI::Application::CommandBar& commandBar) override;
         bool OnEvent(Reference<Control>, Event evnt, int controlID) override;
+
+        uint64 GetRowsCount() override;
+        void FormatCell(uint64 row, uint32 column, String& text) override;
     };
 }; // namespace Panels
 } // namespace GView::Type::ISO
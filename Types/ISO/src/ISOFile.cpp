@@ -1,14 +1,183 @@
 #include "iso.hpp"
 
-#include <queue>
-#include <map>
+#include <unordered_set>
 
 using namespace GView::Type::ISO;
 
+constexpr uint32 RECORD_HEADER_SIZE      = offsetof(ECMA_119_DirectoryRecord, fileIdentifier); // 33
+constexpr uint32 MAX_DIRECTORY_SIZE      = 0x4000000;                                          // bigger extents are not read
+constexpr uint32 MAX_CONTINUATION_AREAS  = 16;                                                 // CE entries followed for a name
+constexpr uint8 JOLIET_ESCAPE_SEQUENCE[] = { '%', '/' };
+
 ISOFile::ISOFile()
 {
 }
 
+ISOFile::~ISOFile()
+{
+    cancel.store(true);
+    if (worker.joinable())
+        worker.join();
+}
+
+// calls 'onRecord' for every record of a directory extent (a record never crosses a sector --> a 0 length means the next sector)
+template <typename Callback>
+static void ForEachRecord(const Buffer& data, uint32 sectorSize, Callback&& onRecord)
+{
+    const auto p    = data.GetData();
+    const auto size = data.GetLength();
+    size_t offset   = 0;
+    while (offset + RECORD_HEADER_SIZE < size)
+    {
+        const auto length = p[offset];
+        if (length == 0)
+        {
+            offset = (offset / sectorSize + 1) * sectorSize;
+            continue;
+        }
+        if ((length <= RECORD_HEADER_SIZE) || (offset + length > size))
+            break;
+        const auto idLength = p[offset + RECORD_HEADER_SIZE - 1];
+        if (RECORD_HEADER_SIZE + idLength > length)
+            break;
+
+        // '.' & '..' are skipped
+        if ((idLength != 1) || (p[offset + RECORD_HEADER_SIZE] > 1))
+            onRecord(p + offset, offset);
+        offset += length;
+    }
+}
+
+static inline ECMA_119_DirectoryRecord ToRecord(const uint8* p)
+{
+    ECMA_119_DirectoryRecord dr{};
+    memcpy(&dr, p, p[0]);
+    return dr;
+}
+
+static inline const uint8* GetSystemUseArea(const uint8* record, uint32 suspSkip)
+{
+    const auto idLength = record[RECORD_HEADER_SIZE - 1];
+    return record + RECORD_HEADER_SIZE + idLength + ((idLength % 2 == 0) ? 1 : 0) + suspSkip;
+}
+
+// calls 'onEntry' for every SUSP entry of a System Use area and returns the continuation area (CE) if there is one
+template <typename Callback>
+static bool ForEachSystemUseEntry(const uint8* area, const uint8* end, ContinuationArea& next, Callback&& onEntry)
+{
+    auto found = false;
+    while (area + 4 <= end)
+    {
+        const auto entryLength = area[2];
+        if ((entryLength < 4) || (area + entryLength > end) || ((area[0] == 'S') && (area[1] == 'T')))
+            break;
+
+        if ((area[0] == 'C') && (area[1] == 'E') && (entryLength >= sizeof(SUSP_ContinuationEntry)))
+        {
+            const auto entry = reinterpret_cast<const SUSP_ContinuationEntry*>(area);
+            next.block       = entry->block.LSB;
+            next.offset      = entry->offset.LSB;
+            next.size        = entry->size.LSB;
+            found            = true;
+        }
+        else
+        {
+            onEntry(area, entryLength);
+        }
+        area += entryLength;
+    }
+
+    return found;
+}
+
+static void AppendUTF8(std::u16string& output, const uint8* p, size_t size)
+{
+    for (size_t i = 0; i < size;)
+    {
+        const auto c  = p[i];
+        uint32 value  = c;
+        uint32 extra  = 0;
+        if ((c & 0xE0) == 0xC0)
+        {
+            value = c & 0x1F;
+            extra = 1;
+        }
+        else if ((c & 0xF0) == 0xE0)
+        {
+            value = c & 0x0F;
+            extra = 2;
+        }
+        else if ((c & 0xF8) == 0xF0)
+        {
+            value = c & 0x07;
+            extra = 3;
+        }
+
+        auto valid = (extra > 0) && (i + extra < size);
+        for (auto j = 1U; valid && (j <= extra); j++)
+        {
+            valid = (p[i + j] & 0xC0) == 0x80;
+            value = (value << 6) | (p[i + j] & 0x3F);
+        }
+        if ((extra > 0) && (!valid))
+        {
+            // not UTF-8 --> every byte is a character
+            output.push_back(c);
+            i++;
+            continue;
+        }
+
+        if (value >= 0x10000)
+        {
+            value -= 0x10000;
+            output.push_back(static_cast<char16_t>(0xD800 + (value >> 10)));
+            output.push_back(static_cast<char16_t>(0xDC00 + (value & 0x3FF)));
+        }
+        else
+        {
+            output.push_back(static_cast<char16_t>(value));
+        }
+        i += extra + 1;
+    }
+}
+
+// the names are kept as UTF-8 (the Objects panel shows them)
+static std::string ToUTF8(std::u16string_view name)
+{
+    std::string output;
+    output.reserve(name.size());
+    for (size_t i = 0; i < name.size(); i++)
+    {
+        uint32 value = name[i];
+        if ((value >= 0xD800) && (value < 0xDC00) && (i + 1 < name.size()) && (name[i + 1] >= 0xDC00) && (name[i + 1] < 0xE000))
+            value = 0x10000 + ((value - 0xD800) << 10) + (name[++i] - 0xDC00);
+
+        if (value < 0x80)
+        {
+            output.push_back(static_cast<char>(value));
+        }
+        else if (value < 0x800)
+        {
+            output.push_back(static_cast<char>(0xC0 | (value >> 6)));
+            output.push_back(static_cast<char>(0x80 | (value & 0x3F)));
+        }
+        else if (value < 0x10000)
+        {
+            output.push_back(static_cast<char>(0xE0 | (value >> 12)));
+            output.push_back(static_cast<char>(0x80 | ((value >> 6) & 0x3F)));
+            output.push_back(static_cast<char>(0x80 | (value & 0x3F)));
+        }
+        else
+        {
+            output.push_back(static_cast<char>(0xF0 | (value >> 18)));
+            output.push_back(static_cast<char>(0x80 | ((value >> 12) & 0x3F)));
+            output.push_back(static_cast<char>(0x80 | ((value >> 6) & 0x3F)));
+            output.push_back(static_cast<char>(0x80 | (value & 0x3F)));
+        }
+    }
+    return output;
+}
+
 bool ISOFile::Update()
 {
     {
@@ -23,117 +192,276 @@ bool ISOFile::Update()
         } while (vdh.header.type != SectorType::SetTerminator);
     }
 
+    auto hasPrimary = false;
+    auto hasJoliet  = false;
     for (const auto& entry : headers)
     {
-        if (entry.header.type != SectorType::Primary)
+        if ((entry.header.type == SectorType::Primary) && (!hasPrimary))
         {
-            continue;
+            CHECK(obj->GetData().Copy<ECMA_119_PrimaryVolumeDescriptor>(entry.offsetInFile, pvd), false, "");
+            hasPrimary = true;
+        }
+        else if ((entry.header.type == SectorType::Supplementary) && (!hasJoliet))
+        {
+            CHECK(obj->GetData().Copy<ECMA_119_SupplementaryVolumeDescriptor>(entry.offsetInFile, svd), false, "");
+            const auto escape = reinterpret_cast<const uint8*>(svd.vdd.unusedField2);
+            hasJoliet         = (escape[0] == JOLIET_ESCAPE_SEQUENCE[0]) && (escape[1] == JOLIET_ESCAPE_SEQUENCE[1]) &&
+                        ((escape[2] == '@') || (escape[2] == 'C') || (escape[2] == 'E'));
         }
+    }
+    CHECK(hasPrimary, false, "");
 
-        CHECK(obj->GetData().Copy<ECMA_119_PrimaryVolumeDescriptor>(entry.offsetInFile, pvd), false, "");
+    blockSize = pvd.vdd.logicalBlockSize.LSB;
+    CHECK(blockSize > 0, false, "");
+    root = *reinterpret_cast<ECMA_119_DirectoryRecord*>(&pvd.vdd.directoryEntryForTheRootDirectory);
+    CHECK(DetectNamesSource(), false, "");
 
-        const auto ptrLocation = pvd.vdd.locationOfTypeLPathTable * pvd.vdd.logicalBlockSize.LSB;
-        ECMA_119_PathTableRecord ptr{};
-        obj->GetData().Copy<ECMA_119_PathTableRecord>(ptrLocation, ptr);
+    // Rock Ridge names are long and case sensitive --> they are preferred over the Joliet ones
+    if ((namesSource != NamesSource::RockRidge) && hasJoliet && (svd.vdd.logicalBlockSize.LSB > 0))
+    {
+        namesSource = NamesSource::Joliet;
+        blockSize   = svd.vdd.logicalBlockSize.LSB;
+        root        = *reinterpret_cast<ECMA_119_DirectoryRecord*>(&svd.vdd.directoryEntryForTheRootDirectory);
+    }
 
-        /* you can also parse ECMA_119_PathTableRecords
+    // the container view reads a directory when it is expanded; the records of the whole image are indexed in background
+    IndexEntry rootEntry{};
+    rootEntry.location   = root.locationOfExtent.LSB;
+    rootEntry.dataLength = root.dataLength.LSB;
+    rootEntry.fileFlags  = root.fileFlags;
+    memcpy(rootEntry.recordingDateAndTime, root.recordingDateAndTime, sizeof(root.recordingDateAndTime));
+    entries.push_back(std::move(rootEntry));
 
-        const auto buffer = obj->GetData().CopyToBuffer(ptrLocation, pvd.vdd.pathTableSize.LSB);
-        auto ptrStart     = buffer.GetData();
+    worker = std::thread([this, reader = obj->GetData().GetReader()]() { BuildIndex(reader); });
 
-        ECMA_119_PathTableRecord* ddr = &ptr;
-        do
-        {
-            ptrStart += sizeof(ECMA_119_PathTableRecord) - sizeof(ECMA_119_PathTableRecord::dirID) + ddr->lengthOfDirectoryIdentifier +
-                        (ddr->lengthOfDirectoryIdentifier % 2 == 0 ? 0 : 1);
-            ddr = (ECMA_119_PathTableRecord*) (ptrStart);
-        } while (ptrStart < buffer.GetData() + buffer.GetLength());
+    return true;
+}
 
-         */
+// Rock Ridge --> the System Use area of the '.' record of the root starts with a SP entry
+bool ISOFile::DetectNamesSource()
+{
+    namesSource = NamesSource::ISO9660;
 
-        const auto blockSize = pvd.vdd.logicalBlockSize.LSB;
-        root                 = *reinterpret_cast<ECMA_119_DirectoryRecord*>(&pvd.vdd.directoryEntryForTheRootDirectory);
-        auto fileEntryOffset = root.locationOfExtent.LSB * blockSize;
-        auto block           = 0;
-        CHECK(fileEntryOffset == ptr.locationOfExtent * blockSize, false, "");
+    const auto buffer = obj->GetData().Get(static_cast<uint64>(root.locationOfExtent.LSB) * blockSize, blockSize, true);
+    CHECK(buffer.IsValid(), false, "");
 
-        std::queue<ECMA_119_DirectoryRecord> drs;
-        drs.emplace(root);
+    const auto p      = buffer.GetData();
+    const auto length = p[0];
+    CHECK(length > RECORD_HEADER_SIZE && length <= buffer.GetLength(), false, "");
 
-        do
-        {
-            auto offset = drs.front().locationOfExtent.LSB * pvd.vdd.logicalBlockSize.LSB;
-            drs.pop();
+    const auto suStart = GetSystemUseArea(p, 0) - p;
+    if ((suStart + 7 <= length) && (p[suStart] == 'S') && (p[suStart + 1] == 'P') && (p[suStart + 4] == 0xBE) && (p[suStart + 5] == 0xEF))
+    {
+        namesSource = NamesSource::RockRidge;
+        suspSkip    = p[suStart + 6];
+    }
 
-            auto i = 0ULL;
-            ECMA_119_DirectoryRecord dr{};
-            do
-            {
-                CHECK(obj->GetData().Copy<ECMA_119_DirectoryRecord>(offset, dr), false, "");
+    return true;
+}
 
-                if (i > 1) // skip '.' & '..'
-                {
-                    if (dr.fileFlags & ECMA_119_FileFlags::Directory)
-                    {
-                        drs.emplace(dr);
-                    }
-                }
+// the continuation areas (CE) of a record are usually in a block shared with other records --> every block is read once
+template <typename ReadBlock>
+static void ReadContinuationAreas(const uint8* record, uint32 suspSkip, ContinuationBlocks& blocks, ReadBlock&& readBlock)
+{
+    ContinuationArea area{};
+    auto found = ForEachSystemUseEntry(GetSystemUseArea(record, suspSkip), record + record[0], area, [](const uint8*, uint8) {});
+    for (auto depth = 0U; found && (depth < MAX_CONTINUATION_AREAS); depth++)
+    {
+        auto it = blocks.find(area.block);
+        if (it == blocks.end())
+        {
+            auto buffer = readBlock(area.block);
+            if (!buffer.IsValid())
+                return;
+            it = blocks.emplace(area.block, std::move(buffer)).first;
+        }
 
-                if (dr.lengthOfDirectoryRecord != 0)
-                {
-                    if (i > 1) // skip '.' & '..'
-                    {
-                        records.emplace_back(dr);
-                    }
-                    offset += dr.lengthOfDirectoryRecord;
-                }
+        const auto& block = it->second;
+        if (static_cast<uint64>(area.offset) + area.size > block.GetLength())
+            return;
+        const auto start = block.GetData() + area.offset;
+        found            = ForEachSystemUseEntry(start, start + area.size, area, [](const uint8*, uint8) {});
+    }
+}
 
-                i++;
+static inline uint64 GetExtentSize(uint32 dataLength, uint32 blockSize)
+{
+    return (static_cast<uint64>(dataLength) + blockSize - 1) / blockSize * blockSize;
+}
 
-            } while (dr.lengthOfDirectoryRecord != 0);
-        } while (drs.empty() == false);
+bool ISOFile::GetRockRidgeName(const uint8* record, const ContinuationBlocks& blocks, std::u16string& name) const
+{
+    std::string value;
+    auto found     = false;
+    auto onNMEntry = [&value, &found](const uint8* entry, uint8 entryLength) {
+        // CURRENT & PARENT flags --> no name
+        if ((entry[0] == 'N') && (entry[1] == 'M') && (entryLength >= 5) && ((entry[4] & 0x06) == 0))
+        {
+            value.append(reinterpret_cast<const char*>(entry + 5), entryLength - 5);
+            found = true;
+        }
+    };
 
-        break;
+    ContinuationArea area{};
+    auto next = ForEachSystemUseEntry(GetSystemUseArea(record, suspSkip), record + record[0], area, onNMEntry);
+    for (auto depth = 0U; next && (depth < MAX_CONTINUATION_AREAS); depth++)
+    {
+        const auto it = blocks.find(area.block);
+        if ((it == blocks.end()) || (static_cast<uint64>(area.offset) + area.size > it->second.GetLength()))
+            break;
+        const auto start = it->second.GetData() + area.offset;
+        next             = ForEachSystemUseEntry(start, start + area.size, area, onNMEntry);
     }
 
+    CHECK(found, false, "");
+    name.clear();
+    AppendUTF8(name, reinterpret_cast<const uint8*>(value.data()), value.size());
     return true;
 }
 
-bool ISOFile::BeginIteration(std::u16string_view path, AppCUI::Controls::TreeViewItem parent)
+std::u16string ISOFile::GetName(const uint8* record, const ContinuationBlocks& blocks) const
 {
-    objects.clear();
-    currentItemIndex = 0;
-    ECMA_119_DirectoryRecord current{};
+    std::u16string name;
+    if ((namesSource == NamesSource::RockRidge) && GetRockRidgeName(record, blocks, name))
+        return name;
 
-    int64 currentOffset;
-    if (parent.GetParent().GetHandle() == InvalidItemHandle)
+    const auto idLength   = record[RECORD_HEADER_SIZE - 1];
+    const auto identifier = record + RECORD_HEADER_SIZE;
+    if (namesSource == NamesSource::Joliet)
     {
-        currentOffset = (int64) root.locationOfExtent.LSB * pvd.vdd.logicalBlockSize.LSB;
+        for (auto i = 0U; i + 1 < idLength; i += 2)
+            name.push_back(static_cast<char16_t>((identifier[i] << 8) | identifier[i + 1]));
     }
     else
     {
-        auto data     = parent.GetData<ECMA_119_DirectoryRecord>();
-        currentOffset = (uint64) data->locationOfExtent.LSB * pvd.vdd.logicalBlockSize.LSB;
-        CHECK(currentOffset != pvd.vdd.logicalBlockSize.LSB, false, "");
+        for (auto i = 0U; i < idLength; i++)
+            name.push_back(identifier[i]);
     }
 
-    auto i = 0ULL;
-    do
+    // "NAME.EXT;1" --> "NAME.EXT" & "DIR." --> "DIR"
+    if (const auto version = name.rfind(u';'); version != std::u16string::npos)
+        name.resize(version);
+    if ((!name.empty()) && (name.back() == u'.'))
+        name.pop_back();
+
+    return name;
+}
+
+bool ISOFile::ExpandDirectory(Reference<IndexEntry> directory)
+{
+    // the records of a directory are read (at once) the first time it is expanded --> its children are consecutive entries
+    if (directory->expanded)
+        return true;
+    directory->expanded      = true;
+    directory->firstChild    = static_cast<uint32>(entries.size());
+    directory->childrenCount = 0;
+
+    const auto size = GetExtentSize(directory->dataLength, blockSize);
+    if ((size == 0) || (size > MAX_DIRECTORY_SIZE))
+        return true;
+
+    auto& cache            = obj->GetData();
+    const auto extentStart = static_cast<uint64>(directory->location) * blockSize;
+    const auto data        = cache.CopyToBuffer(extentStart, static_cast<uint32>(size), false);
+    CHECK(data.IsValid(), false, "");
+
+    auto readBlock = [&cache, this](uint32 block) { return cache.CopyToBuffer(static_cast<uint64>(block) * blockSize, blockSize, false); };
+    ForEachRecord(data, blockSize, [&](const uint8* p, size_t offset) {
+        if (namesSource == NamesSource::RockRidge)
+            ReadContinuationAreas(p, suspSkip, continuations, readBlock);
+
+        const auto dr = reinterpret_cast<const ECMA_119_DirectoryRecord*>(p);
+        IndexEntry entry{};
+        entry.recordOffset = extentStart + offset;
+        entry.location     = dr->locationOfExtent.LSB;
+        entry.dataLength   = dr->dataLength.LSB;
+        entry.fileFlags    = dr->fileFlags;
+        entry.name         = GetName(p, continuations);
+        memcpy(entry.recordingDateAndTime, dr->recordingDateAndTime, sizeof(entry.recordingDateAndTime));
+        entries.push_back(std::move(entry)); // a deque --> 'directory' is still valid
+    });
+    directory->childrenCount = static_cast<uint32>(entries.size()) - directory->firstChild;
+
+    return true;
+}
+
+void ISOFile::BuildIndex(GView::Utils::DataCache::Reader reader)
+{
+    // runs in background --> only the reader (and the members set before the thread started) are used
+    struct Directory
     {
-        CHECK(obj->GetData().Copy<ECMA_119_DirectoryRecord>(currentOffset, current), false, "");
+        uint32 location;
+        uint32 dataLength;
+    };
 
-        if (i > 1 && current.lengthOfDirectoryRecord != 0) // skip '.' & '..'
-        {
-            objects.emplace_back(current);
-        }
+    ContinuationBlocks blocks;
+    auto readBlock = [&reader, this](uint32 block) { return reader.Read(static_cast<uint64>(block) * blockSize, blockSize); };
 
-        currentOffset += current.lengthOfDirectoryRecord;
+    // breadth first; a directory referred from more records (or from its own subtree) is read only once
+    std::vector<Directory> directories{ { static_cast<uint32>(root.locationOfExtent.LSB), static_cast<uint32>(root.dataLength.LSB) } };
+    std::unordered_set<uint32> visited{ directories[0].location };
+    for (size_t i = 0; i < directories.size(); i++)
+    {
+        if (cancel.load(std::memory_order_relaxed))
+            return;
+
+        const auto size = GetExtentSize(directories[i].dataLength, blockSize);
+        if ((size == 0) || (size > MAX_DIRECTORY_SIZE))
+            continue;
+        const auto data = reader.Read(static_cast<uint64>(directories[i].location) * blockSize, static_cast<uint32>(size));
+        if (!data.IsValid())
+            continue;
 
-        i++;
+        ForEachRecord(data, blockSize, [&](const uint8* p, size_t) {
+            if (namesSource == NamesSource::RockRidge)
+                ReadContinuationAreas(p, suspSkip, blocks, readBlock);
 
-    } while (current.lengthOfDirectoryRecord != 0);
+            const auto dr = reinterpret_cast<const ECMA_119_DirectoryRecord*>(p);
+            if ((dr->fileFlags & ECMA_119_FileFlags::Directory) && visited.insert(dr->locationOfExtent.LSB).second)
+                directories.push_back({ static_cast<uint32>(dr->locationOfExtent.LSB), static_cast<uint32>(dr->dataLength.LSB) });
 
-    return objects.size() > 0;
+            records.push_back(ToRecord(p));
+            names.push_back(ToUTF8(GetName(p, blocks)));
+        });
+    }
+
+    indexReady.store(true, std::memory_order_release);
+}
+
+uint32 ISOFile::GetRecordsCount() const
+{
+    return IsIndexReady() ? static_cast<uint32>(records.size()) : 0;
+}
+
+const ECMA_119_DirectoryRecord* ISOFile::GetRecord(uint32 index) const
+{
+    if ((!IsIndexReady()) || (index >= records.size()))
+        return nullptr;
+    return &records[index];
+}
+
+std::string_view ISOFile::GetRecordName(uint32 index) const
+{
+    if ((!IsIndexReady()) || (index >= names.size()))
+        return {};
+    return names[index];
+}
+
+bool ISOFile::BeginIteration(std::u16string_view path, AppCUI::Controls::TreeViewItem parent)
+{
+    CHECK(!entries.empty(), false, "");
+
+    auto directory = Reference<IndexEntry>(&entries[0]);
+    if (parent.GetParent().GetHandle() != InvalidItemHandle)
+    {
+        directory = parent.GetData<IndexEntry>();
+        CHECK(directory.IsValid(), false, "");
+    }
+    CHECK(ExpandDirectory(directory), false, "");
+
+    currentItemIndex = directory->firstChild;
+    endItemIndex     = directory->firstChild + directory->childrenCount;
+    return currentItemIndex < endItemIndex;
 }
 
 bool ISOFile::PopulateItem(TreeViewItem item)
@@ -142,8 +470,8 @@ bool ISOFile::PopulateItem(TreeViewItem item)
     const static auto dec = NumericFormat{ NumericFormatFlags::None, 10, 3, '.' };
     const static auto hex = NumericFormat{ NumericFormatFlags::HexPrefix, 16 };
 
-    const auto& currentObject = objects.at(currentItemIndex);
-    item.SetText(std::string_view{ currentObject.fileIdentifier, currentObject.lengthOfFileIdentifier });
+    auto& currentObject = entries.at(currentItemIndex);
+    item.SetText(currentObject.name);
 
     if (currentObject.fileFlags & ECMA_119_FileFlags::Directory)
     {
@@ -159,39 +487,31 @@ bool ISOFile::PopulateItem(TreeViewItem item)
     }
 
     item.SetPriority(currentObject.fileFlags & ECMA_119_FileFlags::Directory);
-    item.SetExpandable(currentObject.fileFlags & ECMA_119_FileFlags::Directory);
+    // the children of a directory are known after it is expanded
+    item.SetExpandable(
+          (currentObject.fileFlags & ECMA_119_FileFlags::Directory) && ((!currentObject.expanded) || (currentObject.childrenCount > 0)));
 
-    item.SetText(1, nf.ToString((uint64) currentObject.dataLength.LSB, dec));
+    item.SetText(1, nf.ToString((uint64) currentObject.dataLength, dec));
     item.SetText(2, RecordingDateAndTimeToString(currentObject.recordingDateAndTime));
-    item.SetText(3, nf.ToString((uint64) currentObject.locationOfExtent.LSB * pvd.vdd.logicalBlockSize.LSB, hex));
+    item.SetText(3, nf.ToString((uint64) currentObject.location * blockSize, hex));
     item.SetText(4, GetECMA_119_FileFlags(currentObject.fileFlags));
 
-    const auto key = DRCRC64(currentObject);
-    const auto it  = itemsCache.find(key);
-    if (it == itemsCache.end())
-    {
-        auto res = itemsCache.emplace(std::pair{ key, currentObject });
-        item.SetData<ECMA_119_DirectoryRecord>(&res.first->second);
-    }
-    else
-    {
-        item.SetData<ECMA_119_DirectoryRecord>(&it->second);
-    }
+    // the entries are only appended (to a deque) --> the pointer remains valid
+    item.SetData<IndexEntry>(&currentObject);
 
     currentItemIndex++;
 
-    return currentItemIndex != objects.size();
+    return currentItemIndex != endItemIndex;
 }
 
 void ISOFile::OnOpenItem(std::u16string_view path, AppCUI::Controls::TreeViewItem item)
 {
     CHECKRET(item.GetParent().GetHandle() != InvalidItemHandle, "");
 
-    auto data         = item.GetData<ECMA_119_DirectoryRecord>();
-    const auto offset = (uint64) data->locationOfExtent.LSB * pvd.vdd.logicalBlockSize.LSB;
-    const auto length = (uint32) data->dataLength.LSB;
-    const auto name   = std::string_view{ data->fileIdentifier, data->lengthOfFileIdentifier };
+    auto data         = item.GetData<IndexEntry>();
+    const auto offset = (uint64) data->location * blockSize;
+    const auto length = (uint32) data->dataLength;
     const auto buffer = obj->GetData().CopyToBuffer(offset, length);
 
-    GView::App::OpenBuffer(buffer, name, name, GView::App::OpenMethod::BestMatch);
+    GView::App::OpenBuffer(buffer, data->name, path, GView::App::OpenMethod::BestMatch);
 }
@@ -26,6 +26,9 @@ void Panels::Information::UpdateGeneralInformation()
     const auto fileSize    = nf.ToString(iso->obj->GetData().GetSize(), dec);
     const auto hexfileSize = nf2.ToString(iso->obj->GetData().GetSize(), hex);
     general->AddItem({ "Size", ls.Format("%-14s (%s)", fileSize.data(), hexfileSize.data()) });
+
+    constexpr std::string_view names[] = { "ISO 9660", "Joliet", "Rock Ridge" };
+    general->AddItem({ "File Names", names[static_cast<uint8>(iso->namesSource)] });
 }
 
 void Panels::Information::UpdateVolumeDescriptors()
@@ -18,23 +18,21 @@ Objects::Objects(Reference<ISOFile> _iso, Reference<GView::View::WindowInterface
     win  = _win;
     Base = 16;
 
-    list = Factory::ListView::Create(
-          this,
+    // the records are indexed in background --> a status row is shown until they are available
+    list = this->CreateChildControl<GView::View::VirtualList>(
           "d:c",
-          { "n:LEN-DR,a:r,w:10",
-            "n:Attr Len,a:r,w:10",
-            "n:Extent Location,a:r,w:17",
-            "n:Data Length,a:r,w:13",
-            "n:Date,a:r,w:25",
-            "n:File Flags,a:r,w:28",
-            "n:File Unit Size,a:r,w:11",
-            "n:Interleave Gap Size,a:r,w:21",
-            "n:Volume Sequence Number,a:r,w:24",
-            "n:LEN-FI,a:r,w:10",
-            "n:File Identifier,a:r,w:100" },
-          ListViewFlags::None);
-
-    Update();
+          this,
+          std::initializer_list<GView::View::VirtualListColumn>{ { "LEN-DR", 10, false },
+                                                                 { "Attr Len", 10, false },
+                                                                 { "Extent Location", 17, false },
+                                                                 { "Data Length", 13, false },
+                                                                 { "Date", 25, false },
+                                                                 { "File Flags", 28, false },
+                                                                 { "File Unit Size", 11, false },
+                                                                 { "Interleave Gap Size", 21, false },
+                                                                 { "Volume Sequence Number", 24, false },
+                                                                 { "LEN-FI", 10, false },
+                                                                 { "File Identifier", 100, true } });
 }
 
 std::string_view Objects::GetValue(NumericFormatter& n, uint64 value)
@@ -47,9 +45,21 @@ std::string_view Objects::GetValue(NumericFormatter& n, uint64 value)
     return n.ToString(value, { NumericFormatFlags::HexPrefix, 16 });
 }
 
+const ECMA_119_DirectoryRecord* Panels::Objects::GetSelectedRecord()
+{
+    // nothing to select while the records are indexed
+    if (!iso->IsIndexReady())
+        return nullptr;
+    const auto row = list->GetCurrentRow();
+    CHECK(row != GView::Utils::INVALID_OFFSET, nullptr, "");
+    return iso->GetRecord(static_cast<uint32>(row));
+}
+
 void Panels::Objects::GoToSelectedSection()
 {
-    auto record       = list->GetCurrentItem().GetData<ECMA_119_DirectoryRecord>();
+    const auto record = GetSelectedRecord();
+    if (record == nullptr)
+        return;
     const auto offset = record->locationOfExtent.LSB * ISO::ECMA_119_SECTOR_SIZE;
 
     win->GetCurrentView()->GoTo(offset);
@@ -57,7 +67,9 @@ void Panels::Objects::GoToSelectedSection()
 
 void Panels::Objects::SelectCurrentSection()
 {
-    auto record       = list->GetCurrentItem().GetData<ECMA_119_DirectoryRecord>();
+    const auto record = GetSelectedRecord();
+    if (record == nullptr)
+        return;
     const auto offset = record->locationOfExtent.LSB * ISO::ECMA_119_SECTOR_SIZE;
     const auto size   = record->dataLength.LSB;
 
@@ -66,27 +78,65 @@ void Panels::Objects::SelectCurrentSection()
 
 void Panels::Objects::Update()
 {
-    list->DeleteAllItems();
+    list->Refresh();
+}
 
-    LocalString<128> tmp;
-    NumericFormatter n;
+uint64 Panels::Objects::GetRowsCount()
+{
+    if (!iso->IsIndexReady())
+        return 1;
+    return iso->GetRecordsCount();
+}
 
-    for (auto i = 0ULL; i < iso->records.size(); i++)
+void Panels::Objects::FormatCell(uint64 row, uint32 column, String& text)
+{
+    if (!iso->IsIndexReady())
     {
-        const auto& record = iso->records[i];
-        auto item          = list->AddItem({ tmp.Format("%s", GetValue(n, record.lengthOfDirectoryRecord).data()) });
-        item.SetText(1, tmp.Format("%s", GetValue(n, record.extendedAttributeRecordLength).data()));
-        item.SetText(2, tmp.Format("%s", GetValue(n, record.locationOfExtent.LSB).data()));
-        item.SetText(3, tmp.Format("%s", GetValue(n, record.dataLength.LSB).data()));
-        item.SetText(4, RecordingDateAndTimeToString(record.recordingDateAndTime).c_str());
-        item.SetText(5, tmp.Format("[%s] %s", GetECMA_119_FileFlags(record.fileFlags).c_str(), GetValue(n, record.fileFlags).data()));
-        item.SetText(6, tmp.Format("%s", GetValue(n, record.fileUnitSize).data()));
-        item.SetText(7, tmp.Format("%s", GetValue(n, record.interleaveGapSize).data()));
-        item.SetText(8, tmp.Format("%s", GetValue(n, record.volumeSequenceNumber).data()));
-        item.SetText(9, tmp.Format("%s", GetValue(n, record.lengthOfFileIdentifier).data()));
-        item.SetText(10, tmp.Format("%.*s", record.lengthOfFileIdentifier, record.fileIdentifier));
-
-        item.SetData<ECMA_119_DirectoryRecord>(&iso->records[i]);
+        if (column == 10)
+            text.Set("Indexing in progress ...");
+        return;
+    }
+
+    const auto record = iso->GetRecord(static_cast<uint32>(row));
+    CHECKRET(record != nullptr, "");
+
+    NumericFormatter n;
+    switch (column)
+    {
+    case 0:
+        text.Set(GetValue(n, record->lengthOfDirectoryRecord));
+        break;
+    case 1:
+        text.Set(GetValue(n, record->extendedAttributeRecordLength));
+        break;
+    case 2:
+        text.Set(GetValue(n, record->locationOfExtent.LSB));
+        break;
+    case 3:
+        text.Set(GetValue(n, record->dataLength.LSB));
+        break;
+    case 4:
+        text.Set(RecordingDateAndTimeToString(record->recordingDateAndTime).c_str());
+        break;
+    case 5:
+        text.Format("[%s] %s", GetECMA_119_FileFlags(record->fileFlags).c_str(), GetValue(n, record->fileFlags).data());
+        break;
+    case 6:
+        text.Set(GetValue(n, record->fileUnitSize));
+        break;
+    case 7:
+        text.Set(GetValue(n, record->interleaveGapSize));
+        break;
+    case 8:
+        text.Set(GetValue(n, record->volumeSequenceNumber));
+        break;
+    case 9:
+        text.Set(GetValue(n, record->lengthOfFileIdentifier));
+        break;
+    case 10:
+        // the name the index resolved (the raw identifier is UCS-2 for Joliet)
+        text.Set(iso->GetRecordName(static_cast<uint32>(row)));
+        break;
     }
 }
 
@@ -103,12 +153,6 @@ bool Panels::Objects::OnEvent(Reference<Control> ctrl, Event evnt, int controlID
 {
     CHECK(TabPage::OnEvent(ctrl, evnt, controlID) == false, true, "");
 
-    if (evnt == Event::ListViewItemPressed)
-    {
-        GoToSelectedSection();
-        return true;
-    }
-
     if (evnt == Event::Command)
     {
         switch (static_cast<ObjectAction>(controlID))
@@ -1080,7 +1080,8 @@ void JSFile::CreateFoldUnfoldLinks(GView::View::LexicalViewer::SyntaxManager& sy
 }
 void JSFile::RemoveLineContinuityCharacter(TextEditor& editor)
 {
-    auto pos = 0;
+    std::vector<TextEditor::Edit> edits;
+    auto pos = 0U;
     do
     {
         auto res = editor.Find(pos, "\\");
@@ -1094,15 +1095,18 @@ void JSFile::RemoveLineContinuityCharacter(TextEditor& editor)
             if (((nextAfterNext == '\n') || (nextAfterNext == '\r')) && (nextAfterNext != next))
             {
                 // case like \CRLF or \LFCR
-                editor.Delete(res.value(), 3);
+                edits.push_back({ res.value(), 3, u"" });
+                pos += 2;
             }
             else
             {
                 // case line \CR or \LF
-                editor.Delete(res.value(), 2);
+                edits.push_back({ res.value(), 2, u"" });
+                pos++;
             }
         }
     } while (true);
+    editor.ApplyEdits(edits);
 }
 void JSFile::PreprocessText(GView::View::LexicalViewer::TextEditor& editor)
 {
@@ -31,6 +31,7 @@ namespace Panels
         DySymTab      = 0x6,
         GoInformation = 0x7,
         OpCodes       = 0x8,
+        Functions     = 0x9,
     };
 };
 
@@ -130,10 +131,12 @@ class MachOFile : public TypeInterface,
         std::string codeDirectoryIdentifier;
         std::string cdHash;
         std::vector<HashPair> cdSlotsHashes; // per normal slots
+        std::vector<uint64> cdSlotsMismatches; // one bit for every normal slot (set --> the page does not match the hash)
         std::vector<MAC::CS_CodeDirectory> alternateDirectories;
         std::vector<std::string> alternateDirectoriesIdentifiers;
         std::vector<std::string> acdHashes;
         std::vector<std::vector<HashPair>> acdSlotsHashes; // per normal slots
+        std::vector<std::vector<uint64>> acdSlotsMismatches;
 
         struct
         {
@@ -200,10 +203,9 @@ class MachOFile : public TypeInterface,
     uint32 showOpcodesMask{ 0 };
     std::vector<std::pair<uint64, uint64>> executableZonesFAs;
     GView::Dissasembly::DissasemblerIntel dissasembler{};
-
-    // these are required here for Fat Containers (can't put them on function level)
-    std::map<uint64, GView::View::BufferViewer::BufferColor> cacheBuffer{};
-    std::map<uint64, bool> cacheDiscard{};
+    GView::Dissasembly::OpcodesCache opcodesCache;
+    GView::Dissasembly::LinearSweepDecoder linearSweep;
+    GView::Dissasembly::FunctionsAnalyzer functionsAnalyzer;
 
   public:
     // OffsetTranslateInterface
@@ -244,6 +246,7 @@ class MachOFile : public TypeInterface,
     bool ParseGoBuild();
     bool ParseGoBuildInfo();
     uint64 VAtoFA(uint64 va);
+    bool StartFunctionsAnalysis();
 
     virtual bool BeginIteration(std::u16string_view path, AppCUI::Controls::TreeViewItem parent) override;
     virtual bool PopulateItem(TreeViewItem item) override;
@@ -251,9 +254,15 @@ class MachOFile : public TypeInterface,
 
   private:
     bool ComputeHash(const Buffer& buffer, uint8 hashType, std::string& output) const;
+    bool ComputeSlotsHashes(
+          std::string_view title,
+          const MAC::CS_CodeDirectory& cd,
+          const Buffer& blobBuffer,
+          std::vector<HashPair>& slotsHashes,
+          std::vector<uint64>& mismatches);
 
     bool GetColorForBuffer(uint64 offset, BufferView buf, GView::View::BufferViewer::BufferColor& result) override;
-    bool GetColorForBufferIntel(uint64 offset, BufferView buf, GView::View::BufferViewer::BufferColor& result);
+    bool GetColorForBufferIntel(uint64 offset, GView::View::BufferViewer::BufferColor& result);
 };
 
 namespace Panels
@@ -477,11 +486,11 @@ namespace Panels
         void OnAfterResize(int newWidth, int newHeight) override;
     };
 
-    class GoFunctions : public AppCUI::Controls::TabPage
+    class GoFunctions : public AppCUI::Controls::TabPage, public GView::View::VirtualListModel
     {
         Reference<MachOFile> macho;
         Reference<GView::View::WindowInterface> win;
-        Reference<AppCUI::Controls::ListView> list;
+        Reference<GView::View::VirtualList> list;
         int32 Base;
 
         std::string_view GetValue(NumericFormatter& n, uint64 value);
@@ -494,6 +503,9 @@ namespace Panels
         void Update();
         bool OnUpdateCommandBar(AppCUI::Application::CommandBar& commandBar) override;
         bool OnEvent(Reference<Control>, Event evnt, int controlID) override;
+
+        uint64 GetRowsCount() override;
+        void FormatCell(uint64 row, uint32 column, String& text) override;
     };
 
     class OpCodes : public AppCUI::Controls::TabPage
@@ -553,6 +565,7 @@ namespace Commands
               const std::string& identifier,
               const std::string& cdHash,
               const std::vector<MachO::MachOFile::HashPair>& slotsHashes,
+              const std::vector<uint64>& slotsMismatches,
               const std::map<MAC::CodeSignMagic, MachO::MachOFile::HashPair>& specialSlotsHashes);
 
         void MoreInfo();
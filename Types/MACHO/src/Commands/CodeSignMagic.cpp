@@ -1,5 +1,7 @@
 #include "MachO.hpp"
 
+#include <bit>
+
 namespace GView::Type::MachO::Commands
 {
 using namespace AppCUI::Controls;
@@ -117,6 +119,7 @@ void CodeSignMagic::UpdateBlobs()
                   machO->codeSignature->cdHash,
                   machO->codeSignature->codeDirectoryIdentifier,
                   machO->codeSignature->cdSlotsHashes,
+                  machO->codeSignature->cdSlotsMismatches,
                   machO->codeSignature->specialSlotsHashes);
         }
         break;
@@ -184,6 +187,7 @@ void CodeSignMagic::UpdateBlobs()
                   machO->codeSignature->acdHashes.at(alternateDirectoryCount),
                   machO->codeSignature->alternateDirectoriesIdentifiers.at(alternateDirectoryCount),
                   machO->codeSignature->acdSlotsHashes.at(alternateDirectoryCount),
+                  machO->codeSignature->acdSlotsMismatches.at(alternateDirectoryCount),
                   machO->codeSignature->alternateSpecialSlotsHashes.at(alternateDirectoryCount));
             alternateDirectoryCount++;
         }
@@ -229,6 +233,7 @@ void CodeSignMagic::UpdateCodeDirectory(
       const std::string& cdHash,
       const std::string& identifier,
       const std::vector<MachO::MachOFile::HashPair>& slotsHashes,
+      const std::vector<uint64>& slotsMismatches,
       const std::map<MAC::CodeSignMagic, MachO::MachOFile::HashPair>& specialSlotsHashes)
 {
     LocalString<1024> ls;
@@ -352,11 +357,24 @@ void CodeSignMagic::UpdateCodeDirectory(
     const auto hexCodeSlots = nf2.ToString(code.nCodeSlots, hex);
     general->AddItem({ "Code Slots", ls.Format("%-26s (%s)", nCodeSlots.data(), hexCodeSlots.data()) });
 
+    auto mismatchesCount = 0U;
+    for (const auto word : slotsMismatches)
+        mismatchesCount += std::popcount(word);
+    if (mismatchesCount == 0)
+    {
+        general->AddItem({ "Modified Pages", "None" }).SetType(ListViewItem::Type::Emphasized_2);
+    }
+    else
+    {
+        ls.Format("%u of %u", mismatchesCount, static_cast<uint32>(slotsHashes.size()));
+        general->AddItem({ "Modified Pages", ls }).SetType(ListViewItem::Type::ErrorInformation);
+    }
+
     {
         auto i = 0U;
         for (const auto& [found, computed] : slotsHashes)
         {
-            if (found == computed)
+            if (((slotsMismatches[i >> 6] >> (i & 63)) & 1ULL) == 0)
             {
                 auto hash = general->AddItem({ "", ls.Format("Slot #(%u) %s", i, found.c_str()) });
                 hash.SetType(ListViewItem::Type::Emphasized_2);
@@ -232,6 +232,14 @@ extern "C"
             {
                 win->AddPanel(Pointer<TabPage>(new MachO::Panels::OpCodes(win->GetObject(), machO)), true);
             }
+
+            if (machO->HasPanel(MachO::Panels::IDs::Functions))
+            {
+                win->AddPanel(
+                      Pointer<TabPage>(new GView::View::FunctionsPanel(
+                            &machO->functionsAnalyzer, win, [machO]() { return machO->StartFunctionsAnalysis(); })),
+                      false);
+            }
         }
 
         return true;
@@ -2,6 +2,8 @@
 
 namespace GView::Type::MachO
 {
+constexpr uint64 MACHO_SLOTS_BATCH_SIZE = 0x1000000; // 16 MB of pages are read at once
+
 MachOFile::MachOFile(Reference<GView::Utils::DataCache> file)
     : header({}), fatHeader({}), isFat(false), isMacho(false), is64(false), shouldSwapEndianess(false), panelsMask(0)
 {
@@ -63,6 +65,7 @@ bool MachOFile::Update()
         case MAC::CPU_TYPE_I386:
         case MAC::CPU_TYPE_X86_64:
             panelsMask |= (1ULL << (uint8) Panels::IDs::OpCodes);
+            panelsMask |= (1ULL << (uint8) Panels::IDs::Functions);
         default:
             break;
         }
@@ -534,16 +537,26 @@ bool MachOFile::SetSymbols()
                     nlist.n_value = nl.n_value;
                 }
 
-                String demangled;
-                const auto str = reinterpret_cast<char*>(stringTable.GetData() + nlist.n_strx);
-                if (GView::Utils::Demangle(str, demangled) == false)
+                dySymTab->objects.emplace_back(nlist);
+            }
+
+            // all the names are demangled at once (the same name is demangled only once)
+            std::vector<std::string_view> names(dySymTab->objects.size());
+            for (auto i = 0U; i < names.size(); i++)
+            {
+                const auto strx = dySymTab->objects[i].n_strx;
+                if (strx < stringTable.GetLength())
                 {
-                    demangled = str;
+                    const auto str = reinterpret_cast<const char*>(stringTable.GetData() + strx);
+                    names[i]       = std::string_view{ str, strnlen(str, stringTable.GetLength() - strx) };
                 }
-
-                nlist.symbolNameDemangled = demangled;
-                dySymTab->objects.emplace_back(nlist);
             }
+
+            GView::Utils::Demangler demangler;
+            std::vector<std::string_view> demangled;
+            CHECK(demangler.Demangle(names, demangled), false, "");
+            for (auto i = 0U; i < names.size(); i++)
+                dySymTab->objects[i].symbolNameDemangled = demangled[i].empty() ? names[i] : demangled[i];
         }
     }
 
@@ -645,8 +658,6 @@ bool MachOFile::SetCodeSignature()
 
     CHECK(codeSignatureCommand.has_value(), false, "");
 
-    LocalString<128> ls;
-
     codeSignature.emplace(CodeSignature{});
     codeSignature->signature.humanReadable.Set("");
 
@@ -696,45 +707,14 @@ bool MachOFile::SetCodeSignature()
                 }
             }
 
-            ProgressStatus::Init(
-                  "Computing code directory slots hashes...",
-                  codeSignature->codeDirectory.nCodeSlots,
-                  ProgressStatus::Flags::DisableDelayedActivation);
-
-            codeSignature->cdSlotsHashes.reserve(codeSignature->codeDirectory.nCodeSlots);
-
-            const auto pageSize = codeSignature->codeDirectory.pageSize ? (1U << codeSignature->codeDirectory.pageSize) : 0U;
-            auto remaining      = codeSignature->codeDirectory.codeLimit;
-            auto processed      = 0ULL;
-            for (auto slot = 0U; slot < codeSignature->codeDirectory.nCodeSlots; slot++)
-            {
-                CHECK(ProgressStatus::Update(slot, ls.Format("Hashes %u/%u...", slot, codeSignature->codeDirectory.nCodeSlots)) == false,
-                      false,
-                      "");
-
-                const auto size             = std::min<>(remaining, pageSize);
-                const auto hashOffset       = codeSignature->codeDirectory.hashOffset + codeSignature->codeDirectory.hashSize * slot;
-                const auto bufferToValidate = obj->GetData().CopyToBuffer(processed, size);
-
-                std::string hashComputed;
-                if (ComputeHash(bufferToValidate, hashType, hashComputed) == false)
-                {
-                    throw std::runtime_error("Unable to validate!");
-                }
-
-                const auto hash = ((unsigned char*) blobBuffer.GetData() + hashOffset);
-                LocalString<128> ls;
-                for (auto i = 0U; i < codeSignature->codeDirectory.hashSize; i++)
-                {
-                    ls.AddFormat("%.2X", hash[i]);
-                }
-                std::string hashFound{ ls };
-
-                codeSignature->cdSlotsHashes.emplace_back(HashPair{ .found{ hashFound }, .computed{ hashComputed } });
-
-                processed += size;
-                remaining -= size;
-            }
+            CHECK(ComputeSlotsHashes(
+                        "Computing code directory slots hashes...",
+                        codeSignature->codeDirectory,
+                        blobBuffer,
+                        codeSignature->cdSlotsHashes,
+                        codeSignature->cdSlotsMismatches),
+                  false,
+                  "");
 
             for (auto slot = 1U; slot <= codeSignature->codeDirectory.nSpecialSlots; slot++)
             {
@@ -827,44 +807,13 @@ bool MachOFile::SetCodeSignature()
                 codeSignature->acdHashes.emplace_back(cdHash);
             }
 
-            ProgressStatus::Init(
-                  "Computing alternate code directory slots hashes...", cd.nCodeSlots, ProgressStatus::Flags::DisableDelayedActivation);
-
-            auto& cdSlotsHashes = codeSignature->acdSlotsHashes.emplace_back();
-            cdSlotsHashes.reserve(cd.nCodeSlots);
-
+            auto& cdSlotsHashes        = codeSignature->acdSlotsHashes.emplace_back();
+            auto& cdSlotsMismatches    = codeSignature->acdSlotsMismatches.emplace_back();
             auto& cdSpecialSlotsHashes = codeSignature->alternateSpecialSlotsHashes.emplace_back();
-
-            const auto pageSize = cd.pageSize ? (1U << cd.pageSize) : 0U;
-            auto remaining      = cd.codeLimit;
-            auto processed      = 0ULL;
-            for (auto slot = 0U; slot < cd.nCodeSlots; slot++)
-            {
-                CHECK(ProgressStatus::Update(slot, ls.Format("Hashes %u/%u...", slot, cd.nCodeSlots)) == false, false, "");
-
-                const auto size             = std::min<>(remaining, pageSize);
-                const auto hashOffset       = cd.hashOffset + cd.hashSize * slot;
-                const auto bufferToValidate = obj->GetData().CopyToBuffer(processed, size);
-
-                std::string hashComputed;
-                if (ComputeHash(bufferToValidate, hashType, hashComputed) == false)
-                {
-                    throw std::runtime_error("Unable to validate!");
-                }
-
-                const auto hash = ((unsigned char*) blobBuffer.GetData() + hashOffset);
-                LocalString<128> ls;
-                for (auto i = 0U; i < cd.hashSize; i++)
-                {
-                    ls.AddFormat("%.2X", hash[i]);
-                }
-                std::string hashFound{ ls };
-
-                cdSlotsHashes.emplace_back(HashPair{ .found{ hashFound }, .computed{ hashComputed } });
-
-                processed += size;
-                remaining -= size;
-            }
+            CHECK(ComputeSlotsHashes(
+                        "Computing alternate code directory slots hashes...", cd, blobBuffer, cdSlotsHashes, cdSlotsMismatches),
+                  false,
+                  "");
 
             for (auto slot = 1U; slot <= cd.nSpecialSlots; slot++)
             {
@@ -1215,6 +1164,123 @@ bool MachOFile::ParseGoBuildInfo()
     return true;
 }
 
+static void HashToHex(const uint8* hash, uint32 size, std::string& output)
+{
+    constexpr std::string_view digits = "0123456789ABCDEF";
+    output.resize(static_cast<size_t>(size) * 2);
+    for (auto i = 0U; i < size; i++)
+    {
+        output[i * 2]     = digits[hash[i] >> 4];
+        output[i * 2 + 1] = digits[hash[i] & 0xF];
+    }
+}
+
+bool MachOFile::ComputeSlotsHashes(
+      std::string_view title,
+      const MAC::CS_CodeDirectory& cd,
+      const Buffer& blobBuffer,
+      std::vector<HashPair>& slotsHashes,
+      std::vector<uint64>& mismatches)
+{
+    Hashes::OpenSSLHashKind kind;
+    switch (static_cast<MAC::CodeSignMagic>(cd.hashType))
+    {
+    case MAC::CodeSignMagic::CS_HASHTYPE_SHA1:
+        kind = Hashes::OpenSSLHashKind::Sha1;
+        break;
+    case MAC::CodeSignMagic::CS_HASHTYPE_SHA256:
+    case MAC::CodeSignMagic::CS_HASHTYPE_SHA256_TRUNCATED:
+        kind = Hashes::OpenSSLHashKind::Sha256;
+        break;
+    case MAC::CodeSignMagic::CS_HASHTYPE_SHA384:
+        kind = Hashes::OpenSSLHashKind::Sha384;
+        break;
+    case MAC::CodeSignMagic::CS_HASHTYPE_SHA512:
+        kind = Hashes::OpenSSLHashKind::Sha512;
+        break;
+    default:
+        RETURNERROR(false, "Hash type not supported (%u)!", cd.hashType);
+    }
+
+    const auto slotsCount = cd.nCodeSlots;
+    const auto hashSize   = static_cast<uint32>(cd.hashSize);
+    CHECK(hashSize > 0 && cd.pageSize < 32, false, "");
+    CHECK(static_cast<uint64>(cd.hashOffset) + static_cast<uint64>(hashSize) * slotsCount <= blobBuffer.GetLength(),
+          false,
+          "Code slots are outside of the code directory!");
+
+    // a page size of 0 means that a single page holds all the code
+    const auto pageSize      = cd.pageSize ? (1ULL << cd.pageSize) : std::max<uint64>(cd.codeLimit, 1);
+    const auto pagesPerBatch = static_cast<uint32>(std::max<uint64>(MACHO_SLOTS_BATCH_SIZE / pageSize, 1));
+    const auto ReadBatch     = [&](uint64 firstSlot)
+    {
+        const auto start = firstSlot * pageSize;
+        if ((firstSlot >= slotsCount) || (start >= cd.codeLimit))
+            return Buffer();
+        return obj->GetData().CopyUncached(start, static_cast<uint32>(std::min<uint64>(pagesPerBatch * pageSize, cd.codeLimit - start)));
+    };
+
+    // every worker reuses its own hash context
+    const auto workersCount = GView::Utils::GetParallelWorkersCount();
+    std::vector<std::unique_ptr<Hashes::OpenSSLHash>> hashes;
+    for (auto i = 0U; i < workersCount; i++)
+        hashes.emplace_back(std::make_unique<Hashes::OpenSSLHash>(kind));
+
+    ProgressStatus::Init(title, slotsCount, ProgressStatus::Flags::DisableDelayedActivation);
+    LocalString<128> ls;
+
+    // the pages of a batch are split between the workers while the next batch is read
+    std::vector<uint8> computed(static_cast<size_t>(slotsCount) * hashSize);
+    auto batch = ReadBatch(0);
+    for (auto first = 0U; first < slotsCount; first += pagesPerBatch)
+    {
+        CHECK(ProgressStatus::Update(first, ls.Format("Hashes %u/%u...", first, slotsCount)) == false, false, "");
+
+        const auto count  = std::min<uint32>(pagesPerBatch, slotsCount - first);
+        const auto length = static_cast<uint64>(batch.IsValid() ? batch.GetLength() : 0);
+        Buffer next;
+        GView::Utils::ParallelFor(
+              workersCount + 1,
+              [&](uint32 task)
+              {
+                  if (task == workersCount)
+                  {
+                      next = ReadBatch(static_cast<uint64>(first) + pagesPerBatch);
+                      return;
+                  }
+
+                  auto& hash      = *hashes[task];
+                  const auto last = static_cast<uint32>(static_cast<uint64>(count) * (task + 1) / workersCount);
+                  for (auto page = static_cast<uint32>(static_cast<uint64>(count) * task / workersCount); page < last; page++)
+                  {
+                      // the pages after the end of the file (or of the code) are hashed as empty
+                      const auto start = std::min<uint64>(page * pageSize, length);
+                      const auto end   = std::min<uint64>(start + pageSize, length);
+                      hash.Reset();
+                      hash.Update(batch.GetData() + start, static_cast<uint32>(end - start));
+                      hash.Final();
+                      const auto slot = static_cast<size_t>(first) + page;
+                      memcpy(computed.data() + slot * hashSize, hash.Get(), std::min<>(hashSize, hash.GetSize()));
+                  }
+              });
+        batch = std::move(next);
+    }
+
+    const auto found = blobBuffer.GetData() + cd.hashOffset;
+    mismatches.assign((slotsCount + 63) / 64, 0);
+    slotsHashes.resize(slotsCount);
+    for (auto slot = 0U; slot < slotsCount; slot++)
+    {
+        const auto offset = static_cast<size_t>(slot) * hashSize;
+        if (memcmp(found + offset, computed.data() + offset, hashSize) != 0)
+            mismatches[slot >> 6] |= 1ULL << (slot & 63);
+        HashToHex(found + offset, hashSize, slotsHashes[slot].found);
+        HashToHex(computed.data() + offset, hashSize, slotsHashes[slot].computed);
+    }
+
+    return true;
+}
+
 bool MachOFile::ComputeHash(const Buffer& buffer, uint8 hashType, std::string& output) const
 {
     switch (static_cast<MAC::CodeSignMagic>(hashType))
@@ -1338,123 +1404,103 @@ void MachOFile::OnOpenItem(std::u16string_view path, AppCUI::Controls::TreeViewI
     GView::App::OpenBuffer(buffer, data->info.name, GView::App::OpenMethod::BestMatch);
 }
 
-bool MachOFile::GetColorForBufferIntel(uint64 offset, BufferView buf, GView::View::BufferViewer::BufferColor& result)
+bool MachOFile::StartFunctionsAnalysis()
 {
-    CHECK(dissasembler.Init(is64, !shouldSwapEndianess), false, "");
-
-    static auto previousOpcodeMask = showOpcodesMask;
-    if (previousOpcodeMask != showOpcodesMask)
-    {
-        cacheBuffer.clear();
-        cacheDiscard.clear();
-        previousOpcodeMask = showOpcodesMask;
-    }
-
-    if (cacheBuffer.count(offset) > 0)
-    {
-        result = cacheBuffer.at(offset);
+    if (functionsAnalyzer.IsStarted())
         return true;
-    }
 
-    if (cacheDiscard.count(offset) > 0)
+    std::vector<GView::Dissasembly::ExecutableZone> zones;
+    for (const auto& segment : segments)
     {
-        return false;
+        if ((segment.initprot & (uint32) MAC::VMProtectionFlags::EXECUTE) == (uint32) MAC::VMProtectionFlags::EXECUTE)
+            zones.push_back({ segment.fileoff, segment.filesize, segment.vmaddr });
     }
 
-    GView::Dissasembly::Instruction ins{ 0 };
-    CHECK(dissasembler.DissasembleInstruction(buf, offset, ins), false, "");
-
-    if (((showOpcodesMask & (uint32) GView::Dissasembly::Opcodes::Call) == (uint32) GView::Dissasembly::Opcodes::Call))
+    // known functions first: their names are kept (the others are found by following the calls)
+    if (main.has_value())
     {
-        if (dissasembler.IsCallInstruction(ins))
+        // LC_MAIN keeps the offset of the entry point in file, LC_UNIXTHREAD its address
+        if (main->cmd != MAC::LoadCommandType::MAIN)
         {
-            result.start        = offset;
-            result.end          = offset + ins.size;
-            result.color        = INS_CALL_COLOR;
-            cacheBuffer[offset] = result;
-            return true;
+            functionsAnalyzer.AddEntryPoint(main->entryoff, "EntryPoint");
         }
-    }
-
-    if (((showOpcodesMask & (uint32) GView::Dissasembly::Opcodes::LCall) == (uint32) GView::Dissasembly::Opcodes::LCall))
-    {
-        if (dissasembler.IsLCallInstruction(ins))
+        else
         {
-            result.start        = offset;
-            result.end          = offset + ins.size;
-            result.color        = INS_LCALL_COLOR;
-            cacheBuffer[offset] = result;
-            return true;
+            for (const auto& zone : zones)
+            {
+                if ((main->entryoff >= zone.offset) && (main->entryoff - zone.offset < zone.size))
+                    functionsAnalyzer.AddEntryPoint(zone.address + (main->entryoff - zone.offset), "EntryPoint");
+            }
         }
     }
-
-    if (((showOpcodesMask & (uint32) GView::Dissasembly::Opcodes::Jmp) == (uint32) GView::Dissasembly::Opcodes::Jmp))
+    if (dySymTab.has_value())
     {
-        if (dissasembler.IsJmpInstruction(ins))
+        for (const auto& symbol : dySymTab->objects)
         {
-            result.start        = offset;
-            result.end          = offset + ins.size;
-            result.color        = INS_JUMP_COLOR;
-            cacheBuffer[offset] = result;
-            return true;
+            const auto isDebug   = (symbol.n_type & (uint8) MAC::N_TYPE::STAB) != 0;
+            const auto isDefined = (symbol.n_type & (uint8) MAC::N_TYPE::TYPE) == (uint8) MAC::N_TYPE_BITS::SECT;
+            if (!isDebug && isDefined)
+                functionsAnalyzer.AddEntryPoint(symbol.n_value, symbol.symbolNameDemangled);
         }
     }
-
-    if (((showOpcodesMask & (uint32) GView::Dissasembly::Opcodes::LJmp) == (uint32) GView::Dissasembly::Opcodes::LJmp))
+    const auto goFunctionsCount = pcLnTab.GetFunctionsCount();
+    for (auto i = 0ULL; i < goFunctionsCount; i++)
     {
-        if (dissasembler.IsLJmpInstruction(ins))
-        {
-            result.start        = offset;
-            result.end          = offset + ins.size;
-            result.color        = INS_LJUMP_COLOR;
-            cacheBuffer[offset] = result;
-            return true;
-        }
+        Golang::Function f{};
+        if (pcLnTab.GetFunction(i, f))
+            functionsAnalyzer.AddEntryPoint(f.func.entry, f.name != nullptr ? f.name : "");
     }
 
-    if (((showOpcodesMask & (uint32) GView::Dissasembly::Opcodes::Breakpoint) == (uint32) GView::Dissasembly::Opcodes::Breakpoint))
-    {
-        if (dissasembler.IsBreakpointInstruction(ins))
-        {
-            result.start        = offset;
-            result.end          = offset + ins.size;
-            result.color        = INS_BREAKPOINT_COLOR;
-            cacheBuffer[offset] = result;
-            return true;
-        }
-    }
+    return functionsAnalyzer.Start(obj->GetData(), zones, is64, !shouldSwapEndianess);
+}
 
-    if (((showOpcodesMask & (uint32) GView::Dissasembly::Opcodes::FunctionStart) == (uint32) GView::Dissasembly::Opcodes::FunctionStart))
-    {
-        GView::Dissasembly::Instruction ins2{ 0 };
-        const auto offset2 = offset + ins.size;
-        CHECK(dissasembler.DissasembleInstruction({ buf.GetData() + ins.size, buf.GetLength() - ins.size }, offset2, ins2), false, "");
+bool MachOFile::GetColorForBufferIntel(uint64 offset, GView::View::BufferViewer::BufferColor& result)
+{
+    CHECK(dissasembler.Init(is64, !shouldSwapEndianess), false, "");
 
-        if (dissasembler.AreFunctionStartInstructions(ins, ins2))
-        {
-            result.start        = offset;
-            result.end          = offset + ins.size + ins2.size;
-            result.color        = START_FUNCTION_COLOR;
-            cacheBuffer[offset] = result;
-            return true;
-        }
-    }
+    if (!linearSweep.IsStarted())
+        linearSweep.Start(obj->GetData(), executableZonesFAs, is64, !shouldSwapEndianess);
 
-    if (((showOpcodesMask & (uint32) GView::Dissasembly::Opcodes::FunctionEnd) == (uint32) GView::Dissasembly::Opcodes::FunctionEnd))
+    // once the background linear sweep is done only the real instruction starts are highlighted; until then (or outside the
+    // decoded zones) the whole page that contains 'offset' is decoded once (the mask is applied here, so it can change freely)
+    uint32 type = 0;
+    uint32 size = 0;
+    if (!linearSweep.GetInstruction(offset, type, size))
     {
-        if (dissasembler.IsFunctionEndInstruction(ins))
-        {
-            result.start        = offset;
-            result.end          = offset + ins.size;
-            result.color        = END_FUNCTION_COLOR;
-            cacheBuffer[offset] = result;
-            return true;
-        }
+        CHECK(opcodesCache.Get(dissasembler, obj->GetData(), offset, type, size), false, "");
     }
+    CHECK((showOpcodesMask & type) != 0, false, "");
 
-    cacheDiscard[offset] = false;
+    switch (static_cast<GView::Dissasembly::Opcodes>(type))
+    {
+    case GView::Dissasembly::Opcodes::Call:
+        result.color = INS_CALL_COLOR;
+        break;
+    case GView::Dissasembly::Opcodes::LCall:
+        result.color = INS_LCALL_COLOR;
+        break;
+    case GView::Dissasembly::Opcodes::Jmp:
+        result.color = INS_JUMP_COLOR;
+        break;
+    case GView::Dissasembly::Opcodes::LJmp:
+        result.color = INS_LJUMP_COLOR;
+        break;
+    case GView::Dissasembly::Opcodes::Breakpoint:
+        result.color = INS_BREAKPOINT_COLOR;
+        break;
+    case GView::Dissasembly::Opcodes::FunctionStart:
+        result.color = START_FUNCTION_COLOR;
+        break;
+    case GView::Dissasembly::Opcodes::FunctionEnd:
+        result.color = END_FUNCTION_COLOR;
+        break;
+    default:
+        return false;
+    }
 
-    return false;
+    result.start = offset;
+    result.end   = offset + size;
+    return true;
 }
 
 bool MachOFile::GetColorForBuffer(uint64 offset, BufferView buf, GView::View::BufferViewer::BufferColor& result)
@@ -1491,7 +1537,7 @@ bool MachOFile::GetColorForBuffer(uint64 offset, BufferView buf, GView::View::Bu
             {
                 if (offset >= start && offset < end)
                 {
-                    return GetColorForBufferIntel(offset, buf, result);
+                    return GetColorForBufferIntel(offset, result);
                 }
             }
             break;
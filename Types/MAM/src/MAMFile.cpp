@@ -26,23 +26,33 @@ bool MAMFile::Decompress()
     Buffer uncompressed;
     uncompressed.Resize(uncompressedSize);
 
-    const auto chunk = obj->GetData().GetCacheSize();
-    uint64 pos       = 8ULL;
-    const auto size  = obj->GetData().GetSize() - pos;
-
-    Buffer compressed;
-    compressed.Resize(size);
+    // the compressed data is read one cache window at a time (the decoder keeps only the part it did not consume yet)
+    GView::Compression::LZXPRESS::Huffman::Decoder decoder;
+    decoder.Reset(uncompressedSize);
 
-    while (pos < obj->GetData().GetSize())
+    auto& cache      = obj->GetData();
+    const auto chunk = cache.GetCacheSize();
+    uint64 pos       = 8ULL;
+    size_t offset    = 0;
+    while (!decoder.IsFinished())
     {
-        auto toRead    = std::min<uint64>((uint64) chunk, obj->GetData().GetSize() - pos);
-        const Buffer b = obj->GetData().CopyToBuffer(pos, chunk, false);
-        memcpy(compressed.GetData() + pos - 8ULL, b.GetData(), toRead);
-        pos += toRead;
+        if (decoder.NeedsInput())
+        {
+            CHECK(pos < cache.GetSize(), false, "");
+            const auto toRead = static_cast<uint32>(std::min<uint64>(chunk, cache.GetSize() - pos));
+            const auto b      = cache.Get(pos, toRead, true);
+            CHECK(b.IsValid(), false, "");
+            pos += b.GetLength();
+            CHECK(decoder.AddInput(b, pos >= cache.GetSize()), false, "");
+            continue;
+        }
+
+        BufferView block;
+        CHECK(decoder.DecodeBlock(block), false, "");
+        memcpy(uncompressed.GetData() + offset, block.GetData(), block.GetLength());
+        offset += block.GetLength();
     }
 
-    CHECK(GView::Compression::LZXPRESS::Huffman::Decompress(compressed, uncompressed), false, "");
-
     GView::App::OpenBuffer(uncompressed, obj->GetName(), GView::App::OpenMethod::BestMatch);
 
     return true;
@@ -23,13 +23,17 @@ namespace GView::Type::PCAP
 
 enum class Magic : uint32
 {
-    Identical = 0xA1B2C3D4,
-    Swapped   = 0xD4C3B2A1
+    Identical     = 0xA1B2C3D4,
+    Swapped       = 0xD4C3B2A1,
+    IdenticalNano = 0xA1B23C4D, // timestamps in nanoseconds
+    SwappedNano   = 0x4D3CB2A1
 };
 
 static const std::map<Magic, std::string_view> MagicNames{
     GET_PAIR_FROM_ENUM(Magic::Identical),
     GET_PAIR_FROM_ENUM(Magic::Swapped),
+    GET_PAIR_FROM_ENUM(Magic::IdenticalNano),
+    GET_PAIR_FROM_ENUM(Magic::SwappedNano),
 };
 
 enum class LinkType : uint32
@@ -482,6 +486,166 @@ struct PacketHeader
 
 static_assert(sizeof(PacketHeader) == 16);
 
+static void Swap(PacketHeader& packetHeader)
+{
+    packetHeader.tsSec   = AppCUI::Endian::BigToNative(packetHeader.tsSec);
+    packetHeader.tsUsec  = AppCUI::Endian::BigToNative(packetHeader.tsUsec);
+    packetHeader.inclLen = AppCUI::Endian::BigToNative(packetHeader.inclLen);
+    packetHeader.origLen = AppCUI::Endian::BigToNative(packetHeader.origLen);
+}
+
+/*
+    PCAPNG
+    Section Header Block
+    Interface Description Block(s)
+    Enhanced / Simple Packet Block(s) (and other blocks)
+    Section Header Block
+    ....
+*/
+
+constexpr uint32 PCAPNG_BYTE_ORDER_MAGIC         = 0x1A2B3C4D;
+constexpr uint32 PCAPNG_BYTE_ORDER_MAGIC_SWAPPED = 0x4D3C2B1A;
+
+enum class BlockType : uint32
+{
+    InterfaceDescription = 0x00000001,
+    Packet               = 0x00000002, // obsolete
+    SimplePacket         = 0x00000003,
+    NameResolution       = 0x00000004,
+    InterfaceStatistics  = 0x00000005,
+    EnhancedPacket       = 0x00000006,
+    DecryptionSecrets    = 0x0000000A,
+    SectionHeader        = 0x0A0D0D0A
+};
+
+enum class InterfaceOption : uint16
+{
+    EndOfOptions = 0,
+    Name         = 2,
+    Description  = 3,
+    TsResolution = 9,
+    TsOffset     = 14
+};
+
+#pragma pack(push, 1)
+struct BlockHeader
+{
+    BlockType type;
+    uint32 totalLength; /* size of the whole block (including the header and the trailing length) */
+};
+
+struct SectionHeaderBlock
+{
+    BlockHeader header;
+    uint32 byteOrderMagic; /* 0x1A2B3C4D written in the native byte ordering of the writer */
+    uint16 versionMajor;
+    uint16 versionMinor;
+    int64 sectionLength; /* -1 if not specified */
+};
+
+struct InterfaceDescriptionBlock
+{
+    BlockHeader header;
+    uint16 linkType;
+    uint16 reserved;
+    uint32 snaplen;
+};
+
+struct EnhancedPacketBlock
+{
+    BlockHeader header;
+    uint32 interfaceID;
+    uint32 timestampHigh; /* timestamp in units of the interface resolution (default microseconds) */
+    uint32 timestampLow;
+    uint32 capturedLength;
+    uint32 originalLength;
+};
+
+struct SimplePacketBlock
+{
+    BlockHeader header;
+    uint32 originalLength;
+};
+
+struct PacketBlock
+{
+    BlockHeader header;
+    uint16 interfaceID;
+    uint16 dropsCount;
+    uint32 timestampHigh;
+    uint32 timestampLow;
+    uint32 capturedLength;
+    uint32 originalLength;
+};
+
+struct OptionHeader
+{
+    uint16 code;
+    uint16 length; /* value length (without padding) */
+};
+#pragma pack(pop)
+
+static_assert(sizeof(SectionHeaderBlock) == 24);
+static_assert(sizeof(InterfaceDescriptionBlock) == 16);
+static_assert(sizeof(EnhancedPacketBlock) == 28);
+static_assert(sizeof(SimplePacketBlock) == 12);
+static_assert(sizeof(PacketBlock) == 28);
+
+static void Swap(BlockHeader& header)
+{
+    header.type        = (BlockType) AppCUI::Endian::BigToNative((uint32) header.type);
+    header.totalLength = AppCUI::Endian::BigToNative(header.totalLength);
+}
+
+static void Swap(SectionHeaderBlock& shb)
+{
+    Swap(shb.header);
+    shb.byteOrderMagic = AppCUI::Endian::BigToNative(shb.byteOrderMagic);
+    shb.versionMajor   = AppCUI::Endian::BigToNative(shb.versionMajor);
+    shb.versionMinor   = AppCUI::Endian::BigToNative(shb.versionMinor);
+    shb.sectionLength  = (int64) AppCUI::Endian::BigToNative((uint64) shb.sectionLength);
+}
+
+static void Swap(InterfaceDescriptionBlock& idb)
+{
+    Swap(idb.header);
+    idb.linkType = AppCUI::Endian::BigToNative(idb.linkType);
+    idb.snaplen  = AppCUI::Endian::BigToNative(idb.snaplen);
+}
+
+static void Swap(EnhancedPacketBlock& epb)
+{
+    Swap(epb.header);
+    epb.interfaceID    = AppCUI::Endian::BigToNative(epb.interfaceID);
+    epb.timestampHigh  = AppCUI::Endian::BigToNative(epb.timestampHigh);
+    epb.timestampLow   = AppCUI::Endian::BigToNative(epb.timestampLow);
+    epb.capturedLength = AppCUI::Endian::BigToNative(epb.capturedLength);
+    epb.originalLength = AppCUI::Endian::BigToNative(epb.originalLength);
+}
+
+static void Swap(SimplePacketBlock& spb)
+{
+    Swap(spb.header);
+    spb.originalLength = AppCUI::Endian::BigToNative(spb.originalLength);
+}
+
+static void Swap(PacketBlock& pb)
+{
+    Swap(pb.header);
+    pb.interfaceID    = AppCUI::Endian::BigToNative(pb.interfaceID);
+    pb.dropsCount     = AppCUI::Endian::BigToNative(pb.dropsCount);
+    pb.timestampHigh  = AppCUI::Endian::BigToNative(pb.timestampHigh);
+    pb.timestampLow   = AppCUI::Endian::BigToNative(pb.timestampLow);
+    pb.capturedLength = AppCUI::Endian::BigToNative(pb.capturedLength);
+    pb.originalLength = AppCUI::Endian::BigToNative(pb.originalLength);
+}
+
+static void Swap(OptionHeader& option)
+{
+    option.code   = AppCUI::Endian::BigToNative(option.code);
+    option.length = AppCUI::Endian::BigToNative(option.length);
+}
+
 enum class EtherType : uint16 // https://www.liveaction.com/resources/glossary/ethertype-values
 {
     Unknown                                      = 0,
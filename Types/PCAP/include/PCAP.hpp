@@ -4,13 +4,234 @@
 
 namespace GView::Type::PCAP
 {
-class PCAPFile : public TypeInterface
+// one entry for each packet from the capture (packet data is read on demand) - the same for PCAP and PCAPNG
+struct PacketIndexEntry
+{
+    uint64 offset;         // file offset of the packet data
+    uint64 timestamp;      // nanoseconds since epoch
+    uint32 inclLen;        // number of octets of packet saved in file
+    uint32 origLen;        // actual length of packet
+    uint32 recordSize;     // size of the record that contains the packet (packet header / block)
+    uint16 headerSize;     // size of the record header (the packet data starts after it)
+    uint16 interfaceIndex; // index in PCAPFile::interfaces
+};
+
+static_assert(sizeof(PacketIndexEntry) == 32);
+
+enum class Format : uint8
+{
+    PCAP,
+    PCAPNG
+};
+
+struct Interface
 {
+    LinkType linkType;
+    uint32 snaplen;
+    uint8 tsResolution; // if_tsresol: power of 10 (or power of 2 if the most significant bit is set) - 6 means microseconds
+    int64 tsOffset;     // if_tsoffset: seconds added to each timestamp
+    uint32 section;     // index of the section (PCAPNG) that contains the interface
+};
+
+// endpoints of a packet (IPv4 addresses are stored in the first 4 bytes)
+struct FlowKey
+{
+    uint8 source[16];
+    uint8 destination[16];
+    uint16 sourcePort;
+    uint16 destinationPort;
+    IP_Protocol protocol;
+    uint8 ipVersion;
+    uint16 reserved; // always 0 (the key is hashed / compared as raw bytes)
+
+    bool operator==(const FlowKey& other) const
+    {
+        return memcmp(this, &other, sizeof(FlowKey)) == 0;
+    }
+};
+
+static_assert(sizeof(FlowKey) == 40);
+
+// result of a light dissection of a packet (link layer --> IPv4 / IPv6 --> TCP / UDP)
+struct PacketSummary
+{
+    FlowKey key;
+    uint32 payloadOffset; // offset (in the packet data) of the TCP / UDP payload
+    uint32 payloadSize;   // size of the payload (could be bigger than the captured data)
+    uint32 tcpSequence;
+    uint32 tcpAcknowledgement;
+    uint8 tcpFlags;
+    bool hasPorts;
+};
+
+bool ParsePacket(LinkType linkType, const uint8* data, uint32 size, PacketSummary& summary);
+
+constexpr uint32 INVALID_FLOW = 0xFFFFFFFF;
+
+// a conversation between two endpoints: direction 0 is key.source --> key.destination, direction 1 is the other way
+struct Flow
+{
+    FlowKey key;
+    uint64 packets[2];
+    uint64 bytes[2];
+    uint64 firstTimestamp;
+    uint64 lastTimestamp;
+    uint64 firstPacket; // index (in PCAPFile::packets) of the first packet of the flow
+    uint64 lastPacket;
+    uint8 tcpFlags;     // all the TCP flags seen in the flow
+};
+
+// open addressing (linear probing) hash table of flows
+class FlowTable
+{
+    std::vector<Flow> flows;
+    std::vector<uint32> slots; // index of the flow + 1 (0 means an empty slot)
+    uint32 mask;
+
+    uint32 GetOrCreate(const FlowKey& key);
+    void Grow();
+
   public:
-    Buffer data; // it's maximum 0xFFFF so just save it here
+    FlowTable();
 
-    Header header;
-    std::vector<std::pair<PacketHeader*, uint32>> packetHeaders;
+    // the key must be normalized (see NormalizeFlowKey)
+    uint32 Add(const FlowKey& key, uint32 direction, uint64 packetIndex, uint64 timestamp, uint64 bytes, uint8 tcpFlags);
+    uint32 Merge(const Flow& flow);
+
+    inline uint32 GetCount() const
+    {
+        return static_cast<uint32>(flows.size());
+    }
+    inline std::vector<Flow>& GetFlows()
+    {
+        return flows;
+    }
+};
+
+// orders the endpoints of a key (the same flow key for both directions) - returns the direction of the packet
+uint32 NormalizeFlowKey(FlowKey& key);
+
+// one direction of a TCP flow rebuilt from the payload of its segments (in sequence order)
+class TcpStream
+{
+    std::vector<uint8> data;                      // stream offset 0 is the first byte after the SYN (or the first segment seen)
+    std::map<uint64, std::vector<uint8>> pending; // out of order segments (stream offset --> payload)
+    uint64 pendingSize;
+    uint32 initialSequence;
+    bool started;
+
+    void Append(const uint8* payload, uint32 size);
+    void FillGap(uint64 offset);
+    void Flush();
+
+  public:
+    uint32 segments;
+    uint32 retransmissions;
+    uint32 gaps;         // missing (or not captured) ranges - filled with zeros
+    uint64 missingBytes; // size of all the gaps
+    bool truncated;      // the stream is bigger than the maximum size of a reassembled stream
+
+    TcpStream();
+
+    void AddSegment(uint32 sequence, uint8 flags, const uint8* payload, uint32 size);
+    void Finish();
+
+    inline BufferView GetData() const
+    {
+        return { data.data(), data.size() };
+    }
+};
+
+// display filter (a subset of the tcpdump syntax) compiled into a postfix program
+enum class FilterOpcode : uint8
+{
+    Host,
+    Net,
+    Port,
+    Protocol,
+    IPVersion,
+    TcpFlags,
+    Length,
+    And,
+    Or,
+    Not,
+};
+
+enum class FilterDirection : uint8
+{
+    Any,
+    Source,
+    Destination,
+};
+
+enum class FilterComparison : uint8
+{
+    Equal,
+    NotEqual,
+    Less,
+    LessOrEqual,
+    Greater,
+    GreaterOrEqual,
+};
+
+struct FilterInstruction
+{
+    FilterOpcode opcode;
+    FilterDirection direction;
+    FilterComparison comparison;
+    uint8 ipVersion;
+    uint8 prefix; // number of bits compared (host and net)
+    uint32 value; // port, protocol, TCP flags or length
+    uint8 address[16];
+};
+
+// what the filter knows about a packet (key is nullptr if the packet is not part of a flow)
+struct FilterContext
+{
+    const FlowKey* key;
+    uint32 direction;
+    uint32 length;
+    uint8 tcpFlags;
+};
+
+class PacketFilter
+{
+    std::vector<FilterInstruction> program;
+
+  public:
+    constexpr static uint32 MAX_STACK_DEPTH = 64;
+
+    // an empty expression matches all the packets
+    bool Compile(std::string_view expression, std::string& error);
+    bool Matches(const FilterContext& context) const;
+
+    inline bool IsEmpty() const
+    {
+        return program.empty();
+    }
+};
+
+class PCAPFile : public TypeInterface
+{
+    bool BuildPcapPacketIndex(uint64 offset);
+    bool BuildPcapNgPacketIndex(uint64 offset);
+
+  public:
+    Format format;
+    Header header; // only for PCAP
+    std::vector<Interface> interfaces;
+    std::vector<PacketIndexEntry> packets;
+    std::vector<Flow> flows;         // sorted by the timestamp of the first packet
+    std::vector<uint32> packetFlows; // for each packet --> index in flows (or INVALID_FLOW)
+    std::vector<uint16> packetDetails; // for each packet --> TCP flags (bits 0-7) and direction in the flow (bit 8)
+    std::vector<uint32> filteredPackets; // indexes of the packets that match the filter (in capture order)
+    std::vector<uint32> filteredFlows;   // indexes of the flows with at least one packet that matches the filter
+    std::string filterExpression;
+    bool filtered;
+    uint32 sectionsCount;
+    bool swapped;       // the capture (first section for PCAPNG) was written with a different byte order
+    bool indexComplete; // false if the capture is truncated / corrupted or the indexing was canceled
+    bool flowsBuilt;    // the flows are built (once: a canceled build is not restarted) the first time they are needed
 
     PCAPFile();
     virtual ~PCAPFile()
@@ -18,6 +239,28 @@ class PCAPFile : public TypeInterface
     }
 
     bool Update();
+    bool BuildFlows();
+    // builds the flows if they were not built yet (the Flows panel and the filter need them)
+    bool EnsureFlows();
+    bool ReassembleTcpFlow(uint32 flowIndex, TcpStream& forward, TcpStream& backward);
+    // an empty expression removes the filter
+    bool ApplyFilter(std::string_view expression, std::string& error);
+
+    // PacketHeader (in native byte order) followed by the packet data
+    Buffer ReadPacket(const PacketIndexEntry& entry);
+    // offset and size of the packet record (packet header / block)
+    uint64 GetRecordOffset(const PacketIndexEntry& entry) const
+    {
+        return entry.offset - entry.headerSize;
+    }
+    uint64 GetRecordSize(const PacketIndexEntry& entry) const
+    {
+        return entry.recordSize;
+    }
+    LinkType GetLinkType(const PacketIndexEntry& entry) const
+    {
+        return entry.interfaceIndex < interfaces.size() ? interfaces[entry.interfaceIndex].linkType : LinkType::NULL_;
+    }
 
     std::string_view GetTypeName() override
     {
@@ -87,6 +330,7 @@ namespace Panels
 
         void UpdateGeneralInformation();
         void UpdatePcapHeader();
+        void UpdatePcapNgInterfaces();
         void UpdateIssues();
         void RecomputePanelsPositions();
 
@@ -127,25 +371,65 @@ namespace Panels
         bool OnEvent(Reference<Control> ctrl, Event evnt, int controlID) override;
     };
 
-    class Packets : public AppCUI::Controls::TabPage
+    enum class PacketsSortKey : uint8
+    {
+        Index,
+        Timestamp,
+        Length
+    };
+
+    // tcpdump-like expression applied to the Packets and Flows panels
+    class FilterDialog : public Window
+    {
+        Reference<PCAPFile> pcap;
+        Reference<TextField> txExpression;
+        void Validate();
+
+      public:
+        FilterDialog(Reference<PCAPFile> pcap);
+
+        bool OnEvent(Reference<Control>, Event eventType, int ID) override;
+    };
+
+    class Flows;
+
+    class Packets : public AppCUI::Controls::TabPage, public GView::View::VirtualListModel
     {
         Reference<PCAPFile> pcap;
         Reference<GView::View::WindowInterface> win;
-        Reference<AppCUI::Controls::ListView> list;
+        Reference<GView::View::VirtualList> list;
+        Reference<Flows> flowsPanel;
+        std::vector<uint32> order; // row --> index of the packet (empty if all the packets are shown in the capture order)
+        PacketsSortKey sortKey;
+        bool sortAscending;
         int32 Base;
 
         std::string_view GetValue(NumericFormatter& n, uint64 value);
+        uint64 GetPacketIndex(uint64 row) const;
+        const PacketIndexEntry* GetCurrentPacket();
+        void Sort(PacketsSortKey key, bool ascending, uint64& row);
         void GoToSelectedSection();
         void SelectCurrentSection();
         void OpenPacket();
+        void ShowFilterDialog();
 
       public:
         Packets(Reference<PCAPFile> _pcap, Reference<GView::View::WindowInterface> win);
 
         void Update();
+        void UpdateFilter();
+        inline void SetFlowsPanel(Reference<Flows> panel)
+        {
+            flowsPanel = panel;
+        }
         bool OnUpdateCommandBar(AppCUI::Application::CommandBar& commandBar) override;
         bool OnEvent(Reference<Control>, Event evnt, int controlID) override;
 
+        uint64 GetRowsCount() override;
+        void FormatCell(uint64 row, uint32 column, String& text) override;
+        bool SortByColumn(uint32 column, uint64& row) override;
+        bool GetSortColumn(uint32& column, bool& ascending) override;
+
         class PacketDialog : public Window
         {
             Reference<GView::Object> object;
@@ -174,5 +458,53 @@ namespace Panels
                   int32 _base);
         };
     };
+
+    class Flows : public AppCUI::Controls::TabPage, public GView::View::VirtualListModel
+    {
+        Reference<PCAPFile> pcap;
+        Reference<GView::View::WindowInterface> win;
+        Reference<GView::View::VirtualList> list;
+        Reference<Packets> packetsPanel;
+        int32 Base;
+
+        std::string_view GetValue(NumericFormatter& n, uint64 value);
+        uint32 GetFlowIndex(uint64 row) const; // INVALID_FLOW if there is no such row
+        void ShowFlowPackets();
+        void ReassembleStreams();
+        void ShowFilterDialog();
+
+      public:
+        Flows(Reference<PCAPFile> _pcap, Reference<GView::View::WindowInterface> win);
+
+        void Update();
+        inline void SetPacketsPanel(Reference<Packets> panel)
+        {
+            packetsPanel = panel;
+        }
+        bool OnUpdateCommandBar(AppCUI::Application::CommandBar& commandBar) override;
+        bool OnEvent(Reference<Control>, Event evnt, int controlID) override;
+
+        uint64 GetRowsCount() override;
+        void FormatCell(uint64 row, uint32 column, String& text) override;
+
+        class FlowPacketsDialog : public Window
+        {
+            Reference<PCAPFile> pcap;
+            Reference<ListView> list;
+            uint64 selectedPacket;
+
+          public:
+            FlowPacketsDialog(Reference<PCAPFile> _pcap, uint32 flowIndex);
+
+            bool OnEvent(Reference<Control>, Event eventType, int ID) override;
+            inline uint64 GetSelectedPacket() const
+            {
+                return selectedPacket;
+            }
+        };
+    };
+
+    std::string_view FormatEndpoint(LocalString<128>& text, const FlowKey& key, bool source);
+    std::string_view FormatTCPFlags(LocalString<64>& text, uint8 flags);
 }; // namespace Panels
 } // namespace GView::Type::PCAP
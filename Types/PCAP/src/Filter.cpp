@@ -0,0 +1,780 @@
+#include "PCAP.hpp"
+
+using namespace GView::Type::PCAP;
+
+constexpr uint32 MAX_TCP_FLAG_NAMES = 8;
+
+namespace
+{
+enum class TokenType : uint8
+{
+    End,
+    Word,
+    LeftParenthesis,
+    RightParenthesis,
+    And,
+    Or,
+    Not,
+    Comparison,
+    Invalid,
+};
+
+struct Token
+{
+    TokenType type;
+    std::string_view text;
+    FilterComparison comparison;
+};
+
+struct ProtocolName
+{
+    std::string_view name;
+    IP_Protocol protocol;
+};
+
+static constexpr ProtocolName PROTOCOL_NAMES[] = {
+    { "tcp", IP_Protocol::TCP },         { "udp", IP_Protocol::UDP },   { "icmp", IP_Protocol::ICMP },
+    { "icmp6", IP_Protocol::IPv6_ICMP }, { "sctp", IP_Protocol::SCTP }, { "gre", IP_Protocol::GRE },
+};
+
+struct TcpFlagName
+{
+    std::string_view name;
+    uint8 flag;
+};
+
+static constexpr TcpFlagName TCP_FLAG_NAMES[MAX_TCP_FLAG_NAMES] = {
+    { "fin", TCPHeader_Flags::FIN }, { "syn", TCPHeader_Flags::SYN }, { "rst", TCPHeader_Flags::RST }, { "psh", TCPHeader_Flags::PSH },
+    { "ack", TCPHeader_Flags::ACK }, { "urg", TCPHeader_Flags::URG }, { "ece", TCPHeader_Flags::ECE }, { "cwr", TCPHeader_Flags::CWR },
+};
+
+static inline bool IsWordCharacter(char c)
+{
+    return ((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')) || ((c >= '0') && (c <= '9')) || (c == '.') || (c == ':') ||
+           (c == '/') || (c == '-') || (c == '_') || (c == ',');
+}
+
+static bool ParseNumber(std::string_view text, uint32& value)
+{
+    auto base = 10U;
+    if ((text.size() > 2) && (text[0] == '0') && ((text[1] == 'x') || (text[1] == 'X')))
+    {
+        base = 16;
+        text = text.substr(2);
+    }
+    if (text.empty())
+        return false;
+
+    uint64 result = 0;
+    for (auto c : text)
+    {
+        uint32 digit;
+        if ((c >= '0') && (c <= '9'))
+            digit = c - '0';
+        else if ((base == 16) && (c >= 'a') && (c <= 'f'))
+            digit = c - 'a' + 10;
+        else if ((base == 16) && (c >= 'A') && (c <= 'F'))
+            digit = c - 'A' + 10;
+        else
+            return false;
+        result = result * base + digit;
+        if (result > 0xFFFFFFFFULL)
+            return false;
+    }
+    value = static_cast<uint32>(result);
+    return true;
+}
+
+// "a.b.c.d" (or "a.b" for a network) --> number of bytes that were specified
+static uint32 ParseIPv4(std::string_view text, uint8 address[16])
+{
+    auto count = 0U;
+    while (!text.empty())
+    {
+        if (count == 4)
+            return 0;
+        const auto dot = text.find('.');
+        uint32 value;
+        if (!ParseNumber(text.substr(0, dot), value) || (value > 255))
+            return 0;
+        address[count++] = static_cast<uint8>(value);
+        if (dot == std::string_view::npos)
+            break;
+        text = text.substr(dot + 1);
+        if (text.empty())
+            return 0;
+    }
+    return count;
+}
+
+static bool ParseIPv6Groups(std::string_view text, uint16* groups, uint32& count)
+{
+    count = 0;
+    while (!text.empty())
+    {
+        if (count == 8)
+            return false;
+        const auto colon = text.find(':');
+        const auto group = text.substr(0, colon);
+        uint64 value     = 0;
+        if (group.empty() || (group.size() > 4))
+            return false;
+        for (auto c : group)
+        {
+            if ((c >= '0') && (c <= '9'))
+                value = value * 16 + (c - '0');
+            else if ((c >= 'a') && (c <= 'f'))
+                value = value * 16 + (c - 'a' + 10);
+            else if ((c >= 'A') && (c <= 'F'))
+                value = value * 16 + (c - 'A' + 10);
+            else
+                return false;
+        }
+        groups[count++] = static_cast<uint16>(value);
+        if (colon == std::string_view::npos)
+            break;
+        text = text.substr(colon + 1);
+        if (text.empty())
+            return false;
+    }
+    return true;
+}
+
+static bool ParseIPv6(std::string_view text, uint8 address[16])
+{
+    uint16 head[8], tail[8];
+    uint32 headCount = 0, tailCount = 0;
+
+    // at most one "::" (a run of zero groups)
+    const auto gap = text.find("::");
+    if (gap == std::string_view::npos)
+    {
+        if (!ParseIPv6Groups(text, head, headCount) || (headCount != 8))
+            return false;
+    }
+    else
+    {
+        if (!ParseIPv6Groups(text.substr(0, gap), head, headCount) || !ParseIPv6Groups(text.substr(gap + 2), tail, tailCount))
+            return false;
+        if (headCount + tailCount > 7)
+            return false;
+    }
+
+    memset(address, 0, 16);
+    for (auto i = 0U; i < headCount; i++)
+    {
+        address[i * 2]     = static_cast<uint8>(head[i] >> 8);
+        address[i * 2 + 1] = static_cast<uint8>(head[i]);
+    }
+    for (auto i = 0U; i < tailCount; i++)
+    {
+        const auto index       = 8 - tailCount + i;
+        address[index * 2]     = static_cast<uint8>(tail[i] >> 8);
+        address[index * 2 + 1] = static_cast<uint8>(tail[i]);
+    }
+    return true;
+}
+
+class FilterParser
+{
+    std::string_view expression;
+    size_t position;
+    Token current;
+    uint32 depth;
+    uint32 maxDepth;
+    std::vector<FilterInstruction>& program;
+    std::string& error;
+
+    void Next();
+    bool Fail(std::string_view message);
+    void Emit(const FilterInstruction& instruction);
+    void EmitOperator(FilterOpcode opcode);
+
+    bool ParseOr();
+    bool ParseAnd();
+    bool ParseUnary();
+    bool ParsePrimitive();
+    bool ParseAddress(FilterDirection direction, bool network);
+    bool ParsePort(FilterDirection direction);
+    bool ParseProtocol();
+    bool ParseTcpFlags();
+    bool ParseLength(FilterComparison comparison);
+
+  public:
+    FilterParser(std::string_view _expression, std::vector<FilterInstruction>& _program, std::string& _error)
+        : expression(_expression), position(0), current{}, depth(0), maxDepth(0), program(_program), error(_error)
+    {
+    }
+
+    bool Parse();
+};
+
+void FilterParser::Next()
+{
+    while ((position < expression.size()) && ((expression[position] == ' ') || (expression[position] == '\t')))
+        position++;
+
+    current = { TokenType::End, {}, FilterComparison::Equal };
+    if (position >= expression.size())
+        return;
+
+    const auto start = position;
+    const auto c     = expression[position];
+    const auto next  = position + 1 < expression.size() ? expression[position + 1] : 0;
+    switch (c)
+    {
+    case '(':
+        current.type = TokenType::LeftParenthesis;
+        position++;
+        break;
+    case ')':
+        current.type = TokenType::RightParenthesis;
+        position++;
+        break;
+    case '&':
+        current.type = next == '&' ? TokenType::And : TokenType::Invalid;
+        position += 2;
+        break;
+    case '|':
+        current.type = next == '|' ? TokenType::Or : TokenType::Invalid;
+        position += 2;
+        break;
+    case '!':
+        current.type       = next == '=' ? TokenType::Comparison : TokenType::Not;
+        current.comparison = FilterComparison::NotEqual;
+        position += next == '=' ? 2 : 1;
+        break;
+    case '=':
+        current.type       = TokenType::Comparison;
+        current.comparison = FilterComparison::Equal;
+        position += next == '=' ? 2 : 1;
+        break;
+    case '<':
+        current.type       = TokenType::Comparison;
+        current.comparison = next == '=' ? FilterComparison::LessOrEqual : FilterComparison::Less;
+        position += next == '=' ? 2 : 1;
+        break;
+    case '>':
+        current.type       = TokenType::Comparison;
+        current.comparison = next == '=' ? FilterComparison::GreaterOrEqual : FilterComparison::Greater;
+        position += next == '=' ? 2 : 1;
+        break;
+    default:
+        if (!IsWordCharacter(c))
+        {
+            current.type = TokenType::Invalid;
+            position++;
+            break;
+        }
+        while ((position < expression.size()) && IsWordCharacter(expression[position]))
+            position++;
+        current.type = TokenType::Word;
+        // keywords
+        const auto word = expression.substr(start, position - start);
+        if (word == "and")
+            current.type = TokenType::And;
+        else if (word == "or")
+            current.type = TokenType::Or;
+        else if (word == "not")
+            current.type = TokenType::Not;
+        break;
+    }
+    current.text = expression.substr(start, std::min<size_t>(position, expression.size()) - start);
+}
+
+bool FilterParser::Fail(std::string_view message)
+{
+    error = message;
+    if (current.type != TokenType::End)
+    {
+        error += " (near '";
+        error += current.text;
+        error += "')";
+    }
+    return false;
+}
+
+void FilterParser::Emit(const FilterInstruction& instruction)
+{
+    program.push_back(instruction);
+    depth++;
+    maxDepth = std::max<>(maxDepth, depth);
+}
+
+void FilterParser::EmitOperator(FilterOpcode opcode)
+{
+    FilterInstruction instruction{};
+    instruction.opcode = opcode;
+    program.push_back(instruction);
+    if (opcode != FilterOpcode::Not)
+        depth--; // two values are replaced by one
+}
+
+bool FilterParser::Parse()
+{
+    program.clear();
+    Next();
+    if (current.type == TokenType::End)
+        return true; // no filter
+    if (!ParseOr())
+        return false;
+    if (current.type != TokenType::End)
+        return Fail("Unexpected token");
+    if (maxDepth > PacketFilter::MAX_STACK_DEPTH)
+    {
+        error = "Expression is too complex";
+        return false;
+    }
+    return true;
+}
+
+bool FilterParser::ParseOr()
+{
+    if (!ParseAnd())
+        return false;
+    while (current.type == TokenType::Or)
+    {
+        Next();
+        if (!ParseAnd())
+            return false;
+        EmitOperator(FilterOpcode::Or);
+    }
+    return true;
+}
+
+bool FilterParser::ParseAnd()
+{
+    if (!ParseUnary())
+        return false;
+    while (true)
+    {
+        // like in tcpdump, two primitives next to each other are joined by an implicit 'and' ("tcp port 80")
+        if (current.type == TokenType::And)
+            Next();
+        else if ((current.type != TokenType::Word) && (current.type != TokenType::Not) && (current.type != TokenType::LeftParenthesis))
+            break;
+        if (!ParseUnary())
+            return false;
+        EmitOperator(FilterOpcode::And);
+    }
+    return true;
+}
+
+bool FilterParser::ParseUnary()
+{
+    switch (current.type)
+    {
+    case TokenType::Not:
+        Next();
+        if (!ParseUnary())
+            return false;
+        EmitOperator(FilterOpcode::Not);
+        return true;
+    case TokenType::LeftParenthesis:
+        Next();
+        if (!ParseOr())
+            return false;
+        if (current.type != TokenType::RightParenthesis)
+            return Fail("Expecting ')'");
+        Next();
+        return true;
+    case TokenType::Word:
+        return ParsePrimitive();
+    case TokenType::End:
+        return Fail("Unexpected end of expression");
+    default:
+        return Fail("Unexpected token");
+    }
+}
+
+bool FilterParser::ParsePrimitive()
+{
+    auto direction = FilterDirection::Any;
+    if ((current.text == "src") || (current.text == "dst"))
+    {
+        direction = current.text == "src" ? FilterDirection::Source : FilterDirection::Destination;
+        Next();
+        if (current.type != TokenType::Word)
+            return Fail("Expecting 'host', 'net', 'port' or an address");
+        if ((current.text != "host") && (current.text != "net") && (current.text != "port"))
+            return ParseAddress(direction, false); // "src 10.0.0.1" is the same as "src host 10.0.0.1"
+    }
+
+    const auto keyword = current.text;
+    if (keyword == "host")
+    {
+        Next();
+        return ParseAddress(direction, false);
+    }
+    if (keyword == "net")
+    {
+        Next();
+        return ParseAddress(direction, true);
+    }
+    if (keyword == "port")
+    {
+        Next();
+        return ParsePort(direction);
+    }
+    if (direction != FilterDirection::Any)
+        return Fail("Expecting 'host', 'net' or 'port'");
+
+    if ((keyword == "ip") || (keyword == "ip6"))
+    {
+        FilterInstruction instruction{};
+        instruction.opcode = FilterOpcode::IPVersion;
+        instruction.value  = keyword == "ip" ? 4 : 6;
+        Emit(instruction);
+        Next();
+        // "ip proto N"
+        if ((current.type == TokenType::Word) && (current.text == "proto"))
+        {
+            Next();
+            if (!ParseProtocol())
+                return false;
+            EmitOperator(FilterOpcode::And);
+        }
+        return true;
+    }
+    if (keyword == "proto")
+    {
+        Next();
+        return ParseProtocol();
+    }
+    for (const auto& entry : PROTOCOL_NAMES)
+    {
+        if (entry.name == keyword)
+            return ParseProtocol();
+    }
+    if (keyword == "tcpflags")
+    {
+        Next();
+        return ParseTcpFlags();
+    }
+    if (keyword == "len")
+    {
+        Next();
+        if (current.type != TokenType::Comparison)
+            return Fail("Expecting a comparison operator");
+        const auto comparison = current.comparison;
+        Next();
+        return ParseLength(comparison);
+    }
+    if ((keyword == "less") || (keyword == "greater"))
+    {
+        Next();
+        return ParseLength(keyword == "less" ? FilterComparison::LessOrEqual : FilterComparison::GreaterOrEqual);
+    }
+
+    return Fail("Unknown primitive");
+}
+
+bool FilterParser::ParseAddress(FilterDirection direction, bool network)
+{
+    if (current.type != TokenType::Word)
+        return Fail("Expecting an address");
+
+    FilterInstruction instruction{};
+    instruction.opcode    = network ? FilterOpcode::Net : FilterOpcode::Host;
+    instruction.direction = direction;
+
+    auto text       = current.text;
+    auto prefix     = 0xFFFFFFFFU;
+    const auto mask = text.find('/');
+    if (mask != std::string_view::npos)
+    {
+        if (!network || !ParseNumber(text.substr(mask + 1), prefix))
+            return Fail("Invalid network prefix");
+        text = text.substr(0, mask);
+    }
+
+    if (text.find(':') != std::string_view::npos)
+    {
+        if (!ParseIPv6(text, instruction.address))
+            return Fail("Invalid IPv6 address");
+        instruction.ipVersion = 6;
+        instruction.prefix    = 128;
+    }
+    else
+    {
+        const auto bytes = ParseIPv4(text, instruction.address);
+        if ((bytes == 0) || (!network && (bytes != 4)))
+            return Fail("Invalid IPv4 address");
+        instruction.ipVersion = 4;
+        instruction.prefix    = static_cast<uint8>(bytes * 8); // "net 10.1" is "net 10.1.0.0/16"
+    }
+    if (prefix != 0xFFFFFFFFU)
+    {
+        if (prefix > instruction.prefix)
+            return Fail("Invalid network prefix");
+        instruction.prefix = static_cast<uint8>(prefix);
+    }
+
+    Emit(instruction);
+    Next();
+    return true;
+}
+
+bool FilterParser::ParsePort(FilterDirection direction)
+{
+    FilterInstruction instruction{};
+    instruction.opcode    = FilterOpcode::Port;
+    instruction.direction = direction;
+    if ((current.type != TokenType::Word) || !ParseNumber(current.text, instruction.value) || (instruction.value > 0xFFFF))
+        return Fail("Expecting a port number");
+    Emit(instruction);
+    Next();
+    return true;
+}
+
+bool FilterParser::ParseProtocol()
+{
+    if (current.type != TokenType::Word)
+        return Fail("Expecting a protocol");
+
+    FilterInstruction instruction{};
+    instruction.opcode = FilterOpcode::Protocol;
+    auto found         = false;
+    for (const auto& entry : PROTOCOL_NAMES)
+    {
+        if (entry.name == current.text)
+        {
+            instruction.value = static_cast<uint32>(entry.protocol);
+            found             = true;
+            break;
+        }
+    }
+    if (!found && (!ParseNumber(current.text, instruction.value) || (instruction.value > 255)))
+        return Fail("Unknown protocol");
+
+    Emit(instruction);
+    Next();
+    return true;
+}
+
+bool FilterParser::ParseTcpFlags()
+{
+    if (current.type != TokenType::Word)
+        return Fail("Expecting TCP flags");
+
+    // "syn,ack" (or "tcp-syn,tcp-ack") matches the packets with any of these flags
+    FilterInstruction instruction{};
+    instruction.opcode = FilterOpcode::TcpFlags;
+    auto text          = current.text;
+    while (!text.empty())
+    {
+        const auto comma = text.find(',');
+        auto name        = text.substr(0, comma);
+        if (name.starts_with("tcp-"))
+            name = name.substr(4);
+        auto found = false;
+        for (const auto& entry : TCP_FLAG_NAMES)
+        {
+            if (entry.name == name)
+            {
+                instruction.value |= entry.flag;
+                found = true;
+                break;
+            }
+        }
+        if (!found)
+            return Fail("Unknown TCP flag");
+        if (comma == std::string_view::npos)
+            break;
+        text = text.substr(comma + 1);
+    }
+    if (instruction.value == 0)
+        return Fail("Expecting TCP flags");
+
+    Emit(instruction);
+    Next();
+    return true;
+}
+
+bool FilterParser::ParseLength(FilterComparison comparison)
+{
+    FilterInstruction instruction{};
+    instruction.opcode     = FilterOpcode::Length;
+    instruction.comparison = comparison;
+    if ((current.type != TokenType::Word) || !ParseNumber(current.text, instruction.value))
+        return Fail("Expecting a length");
+    Emit(instruction);
+    Next();
+    return true;
+}
+
+static inline bool MatchAddress(const uint8* address, const FilterInstruction& instruction)
+{
+    const auto bytes = instruction.prefix / 8U;
+    if (memcmp(address, instruction.address, bytes) != 0)
+        return false;
+    const auto bits = instruction.prefix % 8U;
+    if (bits == 0)
+        return true;
+    const auto mask = static_cast<uint8>(0xFF << (8 - bits));
+    return ((address[bytes] ^ instruction.address[bytes]) & mask) == 0;
+}
+
+static inline bool MatchLength(uint32 length, const FilterInstruction& instruction)
+{
+    switch (instruction.comparison)
+    {
+    case FilterComparison::Equal:
+        return length == instruction.value;
+    case FilterComparison::NotEqual:
+        return length != instruction.value;
+    case FilterComparison::Less:
+        return length < instruction.value;
+    case FilterComparison::LessOrEqual:
+        return length <= instruction.value;
+    case FilterComparison::Greater:
+        return length > instruction.value;
+    case FilterComparison::GreaterOrEqual:
+        return length >= instruction.value;
+    default:
+        return false;
+    }
+}
+} // namespace
+
+bool PacketFilter::Compile(std::string_view expression, std::string& error)
+{
+    std::vector<FilterInstruction> result;
+    FilterParser parser(expression, result, error);
+    if (!parser.Parse())
+        return false;
+    program = std::move(result);
+    return true;
+}
+
+bool PacketFilter::Matches(const FilterContext& context) const
+{
+    // the stack of the program is kept in the bits of an integer (the depth is checked when compiled)
+    uint64 stack    = 0;
+    const auto* key = context.key;
+    for (const auto& instruction : program)
+    {
+        auto result = false;
+        switch (instruction.opcode)
+        {
+        case FilterOpcode::And:
+            result = (stack & 1) & ((stack >> 1) & 1);
+            stack >>= 2;
+            break;
+        case FilterOpcode::Or:
+            result = (stack & 1) | ((stack >> 1) & 1);
+            stack >>= 2;
+            break;
+        case FilterOpcode::Not:
+            stack ^= 1;
+            continue;
+        case FilterOpcode::Host:
+        case FilterOpcode::Net:
+            if (key && (key->ipVersion == instruction.ipVersion))
+            {
+                // flow keys are normalized: the source of the packet is key->source only for direction 0
+                const auto* source      = context.direction == 0 ? key->source : key->destination;
+                const auto* destination = context.direction == 0 ? key->destination : key->source;
+                const auto matchSource  = instruction.direction != FilterDirection::Destination;
+                const auto matchDest    = instruction.direction != FilterDirection::Source;
+                result = (matchSource && MatchAddress(source, instruction)) || (matchDest && MatchAddress(destination, instruction));
+            }
+            break;
+        case FilterOpcode::Port:
+            if (key && ((key->protocol == IP_Protocol::TCP) || (key->protocol == IP_Protocol::UDP)))
+            {
+                const auto source      = context.direction == 0 ? key->sourcePort : key->destinationPort;
+                const auto destination = context.direction == 0 ? key->destinationPort : key->sourcePort;
+                result                 = ((instruction.direction != FilterDirection::Destination) && (source == instruction.value)) ||
+                         ((instruction.direction != FilterDirection::Source) && (destination == instruction.value));
+            }
+            break;
+        case FilterOpcode::Protocol:
+            result = key && (static_cast<uint32>(key->protocol) == instruction.value);
+            break;
+        case FilterOpcode::IPVersion:
+            result = key && (key->ipVersion == instruction.value);
+            break;
+        case FilterOpcode::TcpFlags:
+            result = key && (key->protocol == IP_Protocol::TCP) && ((context.tcpFlags & instruction.value) != 0);
+            break;
+        case FilterOpcode::Length:
+            result = MatchLength(context.length, instruction);
+            break;
+        }
+        stack = (stack << 1) | (result ? 1 : 0);
+    }
+    return program.empty() || ((stack & 1) != 0);
+}
+
+bool PCAPFile::ApplyFilter(std::string_view expression, std::string& error)
+{
+    PacketFilter filter;
+    if (!filter.Compile(expression, error))
+        return false;
+
+    // the filter uses the keys of the flows of the packets
+    if (!filter.IsEmpty())
+        EnsureFlows();
+
+    filterExpression = expression;
+    filtered         = !filter.IsEmpty();
+    filteredPackets.clear();
+    filteredFlows.clear();
+    if (!filtered)
+    {
+        filteredPackets.shrink_to_fit();
+        filteredFlows.shrink_to_fit();
+        return true;
+    }
+
+    // only the packet index and the flows are used (the file is not read): each worker filters a contiguous range of packets
+    const auto count     = static_cast<uint64>(packets.size());
+    const auto hasFlows  = packetFlows.size() == count;
+    const auto workers   = GView::Utils::GetParallelWorkersCount();
+    const auto perWorker = (count + workers - 1) / workers;
+    std::vector<std::vector<uint32>> results(workers);
+    GView::Utils::ParallelFor(workers, [&](uint32 worker) {
+        const auto start = std::min<uint64>(count, perWorker * worker);
+        const auto end   = std::min<uint64>(count, start + perWorker);
+        auto& result     = results[worker];
+        FilterContext context{};
+        for (auto index = start; index < end; index++)
+        {
+            const auto flow   = hasFlows ? packetFlows[index] : INVALID_FLOW;
+            context.key       = flow != INVALID_FLOW ? &flows[flow].key : nullptr;
+            context.direction = hasFlows ? (packetDetails[index] >> 8) : 0;
+            context.tcpFlags  = hasFlows ? static_cast<uint8>(packetDetails[index]) : 0;
+            context.length    = packets[index].origLen;
+            if (filter.Matches(context))
+                result.push_back(static_cast<uint32>(index));
+        }
+    });
+
+    auto total = 0ULL;
+    for (const auto& result : results)
+        total += result.size();
+    filteredPackets.reserve(total);
+    for (auto& result : results)
+    {
+        filteredPackets.insert(filteredPackets.end(), result.begin(), result.end());
+        std::vector<uint32>().swap(result);
+    }
+
+    if (hasFlows)
+    {
+        std::vector<bool> matched(flows.size(), false);
+        for (const auto index : filteredPackets)
+        {
+            const auto flow = packetFlows[index];
+            if (flow != INVALID_FLOW)
+                matched[flow] = true;
+        }
+        for (auto i = 0U; i < matched.size(); i++)
+        {
+            if (matched[i])
+                filteredFlows.push_back(i);
+        }
+    }
+    return true;
+}
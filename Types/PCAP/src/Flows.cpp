@@ -0,0 +1,428 @@
+#include "PCAP.hpp"
+
+#include <numeric>
+
+using namespace GView::Type::PCAP;
+
+constexpr uint16 ETHER_TYPE_IPV4       = 0x0800;
+constexpr uint16 ETHER_TYPE_IPV6       = 0x86DD;
+constexpr uint16 ETHER_TYPE_VLAN       = 0x8100;
+constexpr uint16 ETHER_TYPE_QINQ       = 0x88A8;
+constexpr uint32 LINUX_SLL_HEADER_SIZE = 16;
+constexpr uint32 NULL_HEADER_SIZE      = 4;
+constexpr uint32 MAX_IPV6_EXTENSIONS   = 8;
+constexpr uint32 MAX_HEADERS_SIZE      = 256; // only the first bytes of a packet are needed to find its flow
+constexpr uint32 INITIAL_FLOW_SLOTS    = 0x400;
+
+static inline uint16 ReadUInt16(const uint8* p)
+{
+    return static_cast<uint16>((p[0] << 8) | p[1]);
+}
+
+static inline uint32 ReadUInt32(const uint8* p)
+{
+    return (static_cast<uint32>(p[0]) << 24) | (static_cast<uint32>(p[1]) << 16) | (static_cast<uint32>(p[2]) << 8) | p[3];
+}
+
+static bool ParseTransport(const uint8* data, uint32 size, uint32 offset, uint32 end, PacketSummary& summary)
+{
+    switch (summary.key.protocol)
+    {
+    case IP_Protocol::TCP:
+    {
+        if (offset + sizeof(TCPHeader) > size)
+            return true; // truncated --> only the IP layer is known
+        const auto* tcp             = data + offset;
+        const auto headerSize       = static_cast<uint32>(tcp[12] >> 4) * 4;
+        summary.key.sourcePort      = ReadUInt16(tcp);
+        summary.key.destinationPort = ReadUInt16(tcp + 2);
+        summary.tcpSequence         = ReadUInt32(tcp + 4);
+        summary.tcpAcknowledgement  = ReadUInt32(tcp + 8);
+        summary.tcpFlags            = tcp[13];
+        summary.hasPorts            = true;
+        summary.payloadOffset       = offset + std::max<uint32>(headerSize, sizeof(TCPHeader));
+        summary.payloadSize         = end > summary.payloadOffset ? end - summary.payloadOffset : 0;
+        return true;
+    }
+    case IP_Protocol::UDP:
+    {
+        if (offset + sizeof(UDPHeader) > size)
+            return true;
+        const auto* udp             = data + offset;
+        summary.key.sourcePort      = ReadUInt16(udp);
+        summary.key.destinationPort = ReadUInt16(udp + 2);
+        summary.hasPorts            = true;
+        summary.payloadOffset       = offset + sizeof(UDPHeader);
+        summary.payloadSize         = end > summary.payloadOffset ? end - summary.payloadOffset : 0;
+        return true;
+    }
+    default:
+        summary.payloadOffset = offset;
+        summary.payloadSize   = end > offset ? end - offset : 0;
+        return true;
+    }
+}
+
+static bool ParseIPv4(const uint8* data, uint32 size, uint32 offset, PacketSummary& summary)
+{
+    if (offset + sizeof(IPv4Header) > size)
+        return false;
+    const auto* ip         = data + offset;
+    const auto headerSize  = static_cast<uint32>(ip[0] & 0x0F) * 4;
+    const auto totalLength = static_cast<uint32>(ReadUInt16(ip + 2));
+    if (((ip[0] >> 4) != 4) || (headerSize < sizeof(IPv4Header)))
+        return false;
+
+    summary.key.ipVersion = 4;
+    summary.key.protocol  = static_cast<IP_Protocol>(ip[9]);
+    memcpy(summary.key.source, ip + 12, 4);
+    memcpy(summary.key.destination, ip + 16, 4);
+
+    // only the first fragment contains the ports
+    const auto fragmentOffset = ReadUInt16(ip + 6) & 0x1FFF;
+    const auto end            = offset + std::max<uint32>(totalLength, headerSize);
+    if (fragmentOffset != 0)
+    {
+        summary.payloadOffset = offset + headerSize;
+        summary.payloadSize   = end - summary.payloadOffset;
+        return true;
+    }
+    return ParseTransport(data, size, offset + headerSize, end, summary);
+}
+
+static bool ParseIPv6(const uint8* data, uint32 size, uint32 offset, PacketSummary& summary)
+{
+    if (offset + sizeof(IPv6Header) > size)
+        return false;
+    const auto* ip = data + offset;
+    if ((ip[0] >> 4) != 6)
+        return false;
+
+    summary.key.ipVersion = 6;
+    memcpy(summary.key.source, ip + 8, 16);
+    memcpy(summary.key.destination, ip + 24, 16);
+    const auto end = offset + sizeof(IPv6Header) + ReadUInt16(ip + 4);
+
+    // skip the extension headers
+    auto nextHeader = static_cast<IP_Protocol>(ip[6]);
+    offset += sizeof(IPv6Header);
+    for (auto i = 0U; i < MAX_IPV6_EXTENSIONS; i++)
+    {
+        if (nextHeader == IP_Protocol::IPv6_Frag)
+        {
+            if (offset + 8 > size)
+                return false;
+            const auto fragmentOffset = ReadUInt16(data + offset + 2) >> 3;
+            nextHeader                = static_cast<IP_Protocol>(data[offset]);
+            offset += 8;
+            if (fragmentOffset != 0)
+            {
+                summary.key.protocol  = nextHeader;
+                summary.payloadOffset = offset;
+                summary.payloadSize   = end > offset ? static_cast<uint32>(end - offset) : 0;
+                return true;
+            }
+            continue;
+        }
+        if ((nextHeader != IP_Protocol::HOPOPT) && (nextHeader != IP_Protocol::IPv6_Route) && (nextHeader != IP_Protocol::IPv6_Opts))
+        {
+            break;
+        }
+        if (offset + 8 > size)
+            return false;
+        nextHeader = static_cast<IP_Protocol>(data[offset]);
+        offset += (static_cast<uint32>(data[offset + 1]) + 1) * 8;
+    }
+    summary.key.protocol = nextHeader;
+    return ParseTransport(data, size, offset, static_cast<uint32>(end), summary);
+}
+
+bool GView::Type::PCAP::ParsePacket(LinkType linkType, const uint8* data, uint32 size, PacketSummary& summary)
+{
+    memset(&summary, 0, sizeof(summary));
+    auto offset    = 0U;
+    auto etherType = 0U;
+
+    switch (linkType)
+    {
+    case LinkType::ETHERNET:
+        if (size < sizeof(Package_EthernetHeader))
+            return false;
+        etherType = ReadUInt16(data + 12);
+        offset    = sizeof(Package_EthernetHeader);
+        // 802.1Q / 802.1ad tags
+        while (((etherType == ETHER_TYPE_VLAN) || (etherType == ETHER_TYPE_QINQ)) && (offset + 4 <= size))
+        {
+            etherType = ReadUInt16(data + offset + 2);
+            offset += 4;
+        }
+        break;
+    case LinkType::LINUX_SLL:
+        if (size < LINUX_SLL_HEADER_SIZE)
+            return false;
+        etherType = ReadUInt16(data + 14);
+        offset    = LINUX_SLL_HEADER_SIZE;
+        break;
+    case LinkType::NULL_:
+    case LinkType::LOOP:
+        // the address family is in the byte order of the host that captured the packet
+        if (size <= NULL_HEADER_SIZE)
+            return false;
+        etherType = (data[NULL_HEADER_SIZE] >> 4) == 6 ? ETHER_TYPE_IPV6 : ETHER_TYPE_IPV4;
+        offset    = NULL_HEADER_SIZE;
+        break;
+    case LinkType::RAW:
+    case LinkType::IPV4:
+    case LinkType::IPV6:
+        if (size == 0)
+            return false;
+        etherType = (data[0] >> 4) == 6 ? ETHER_TYPE_IPV6 : ETHER_TYPE_IPV4;
+        break;
+    default:
+        return false;
+    }
+
+    if (etherType == ETHER_TYPE_IPV4)
+    {
+        return ParseIPv4(data, size, offset, summary);
+    }
+    if (etherType == ETHER_TYPE_IPV6)
+    {
+        return ParseIPv6(data, size, offset, summary);
+    }
+    return false;
+}
+
+uint32 GView::Type::PCAP::NormalizeFlowKey(FlowKey& key)
+{
+    const auto result = memcmp(key.source, key.destination, sizeof(key.source));
+    if ((result < 0) || ((result == 0) && (key.sourcePort <= key.destinationPort)))
+    {
+        return 0;
+    }
+    uint8 temp[sizeof(key.source)];
+    memcpy(temp, key.source, sizeof(temp));
+    memcpy(key.source, key.destination, sizeof(temp));
+    memcpy(key.destination, temp, sizeof(temp));
+    std::swap(key.sourcePort, key.destinationPort);
+    return 1;
+}
+
+static inline uint64 HashFlowKey(const FlowKey& key)
+{
+    uint64 words[sizeof(FlowKey) / sizeof(uint64)];
+    memcpy(words, &key, sizeof(FlowKey));
+    auto hash = 0x9E3779B97F4A7C15ULL;
+    for (auto word : words)
+    {
+        hash ^= word;
+        hash *= 0xFF51AFD7ED558CCDULL;
+        hash ^= hash >> 32;
+    }
+    return hash;
+}
+
+FlowTable::FlowTable() : slots(INITIAL_FLOW_SLOTS, 0), mask(INITIAL_FLOW_SLOTS - 1)
+{
+}
+
+void FlowTable::Grow()
+{
+    slots.assign(slots.size() * 2, 0);
+    mask = static_cast<uint32>(slots.size() - 1);
+    for (auto i = 0U; i < flows.size(); i++)
+    {
+        auto slot = static_cast<uint32>(HashFlowKey(flows[i].key)) & mask;
+        while (slots[slot] != 0)
+            slot = (slot + 1) & mask;
+        slots[slot] = i + 1;
+    }
+}
+
+uint32 FlowTable::GetOrCreate(const FlowKey& key)
+{
+    auto slot = static_cast<uint32>(HashFlowKey(key)) & mask;
+    while (slots[slot] != 0)
+    {
+        const auto index = slots[slot] - 1;
+        if (flows[index].key == key)
+        {
+            return index;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    const auto index = static_cast<uint32>(flows.size());
+    auto& flow       = flows.emplace_back();
+    memset(&flow, 0, sizeof(Flow));
+    flow.key            = key;
+    flow.firstTimestamp = 0xFFFFFFFFFFFFFFFFULL;
+    flow.firstPacket    = 0xFFFFFFFFFFFFFFFFULL;
+    slots[slot]         = index + 1;
+
+    // keep the load factor under 50%
+    if (flows.size() * 2 > slots.size())
+    {
+        Grow();
+    }
+    return index;
+}
+
+uint32 FlowTable::Add(const FlowKey& key, uint32 direction, uint64 packetIndex, uint64 timestamp, uint64 bytes, uint8 tcpFlags)
+{
+    const auto index = GetOrCreate(key);
+    auto& flow       = flows[index];
+    flow.packets[direction]++;
+    flow.bytes[direction] += bytes;
+    flow.firstTimestamp = std::min<>(flow.firstTimestamp, timestamp);
+    flow.lastTimestamp  = std::max<>(flow.lastTimestamp, timestamp);
+    flow.firstPacket    = std::min<>(flow.firstPacket, packetIndex);
+    flow.lastPacket     = std::max<>(flow.lastPacket, packetIndex);
+    flow.tcpFlags |= tcpFlags;
+    return index;
+}
+
+uint32 FlowTable::Merge(const Flow& other)
+{
+    const auto index = GetOrCreate(other.key);
+    auto& flow       = flows[index];
+    for (auto direction = 0U; direction < 2; direction++)
+    {
+        flow.packets[direction] += other.packets[direction];
+        flow.bytes[direction] += other.bytes[direction];
+    }
+    flow.firstTimestamp = std::min<>(flow.firstTimestamp, other.firstTimestamp);
+    flow.lastTimestamp  = std::max<>(flow.lastTimestamp, other.lastTimestamp);
+    flow.firstPacket    = std::min<>(flow.firstPacket, other.firstPacket);
+    flow.lastPacket     = std::max<>(flow.lastPacket, other.lastPacket);
+    flow.tcpFlags |= other.tcpFlags;
+    return index;
+}
+
+bool PCAPFile::EnsureFlows()
+{
+    if (!flowsBuilt)
+    {
+        flowsBuilt = true;
+        BuildFlows();
+    }
+    return packetFlows.size() == packets.size();
+}
+
+bool PCAPFile::BuildFlows()
+{
+    // packets that were processed by a worker (the index of the flow is local to the flow table of that worker)
+    struct Shard
+    {
+        uint64 start;
+        uint64 end;
+        uint32 worker;
+    };
+
+    auto& cache          = obj->GetData();
+    const auto cacheSize = cache.GetCacheSize();
+    const auto count     = static_cast<uint64>(packets.size());
+    const auto workers   = GView::Utils::GetParallelWorkersCount();
+    std::vector<FlowTable> tables(workers);
+    std::vector<Shard> shards;
+    LocalString<128> ls;
+
+    flows.clear();
+    packetFlows.assign(count, INVALID_FLOW);
+    packetDetails.assign(count, 0);
+
+    // the cache is used only from this thread: each block is read here and its packets are split between workers
+    ProgressStatus::Init("Building flows...", count);
+    auto first = 0ULL;
+    while (first < count)
+    {
+        const auto blockStart = packets[first].offset;
+        const auto block      = cache.Get(blockStart, cacheSize, false);
+        CHECK(block.IsValid(), false, "Fail to read packets from offset %llu", blockStart);
+        const auto blockEnd = blockStart + block.GetLength();
+
+        auto last = first;
+        while ((last < count) && (packets[last].offset + std::min<uint32>(packets[last].inclLen, MAX_HEADERS_SIZE) <= blockEnd))
+            last++;
+        if (last == first)
+        {
+            first++; // the packet is outside of the file
+            continue;
+        }
+
+        const auto perWorker = (last - first + workers - 1) / workers;
+        GView::Utils::ParallelFor(workers, [&](uint32 worker) {
+            const auto start = first + std::min<uint64>(last - first, perWorker * worker);
+            const auto end   = std::min<uint64>(last, start + perWorker);
+            PacketSummary summary;
+            for (auto index = start; index < end; index++)
+            {
+                const auto& packet = packets[index];
+                const auto* data   = block.GetData() + (packet.offset - blockStart);
+                if (!ParsePacket(GetLinkType(packet), data, std::min<uint32>(packet.inclLen, MAX_HEADERS_SIZE), summary))
+                    continue;
+                const auto direction = NormalizeFlowKey(summary.key);
+                auto& table          = tables[worker];
+                packetFlows[index]   = table.Add(summary.key, direction, index, packet.timestamp, packet.origLen, summary.tcpFlags);
+                packetDetails[index] = static_cast<uint16>(summary.tcpFlags | (direction << 8));
+            }
+        });
+        for (auto worker = 0U; worker < workers; worker++)
+        {
+            const auto start = first + std::min<uint64>(last - first, perWorker * worker);
+            shards.push_back({ start, std::min<uint64>(last, start + perWorker), worker });
+        }
+
+        first = last;
+        if (ProgressStatus::Update(first, ls.Format("Building flows (%llu / %llu packets)...", first, count)))
+        {
+            flows.clear();
+            packetFlows.clear();
+            packetDetails.clear();
+            return false;
+        }
+    }
+
+    // merge the tables of all workers
+    FlowTable global;
+    std::vector<std::vector<uint32>> localToGlobal(workers);
+    for (auto worker = 0U; worker < workers; worker++)
+    {
+        auto& local = tables[worker].GetFlows();
+        localToGlobal[worker].resize(local.size());
+        for (auto i = 0U; i < local.size(); i++)
+            localToGlobal[worker][i] = global.Merge(local[i]);
+        local.clear();
+        local.shrink_to_fit();
+    }
+
+    // flows are sorted by the time they started
+    auto& merged = global.GetFlows();
+    std::vector<uint32> order(merged.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&merged](uint32 a, uint32 b) {
+        if (merged[a].firstTimestamp != merged[b].firstTimestamp)
+            return merged[a].firstTimestamp < merged[b].firstTimestamp;
+        return merged[a].firstPacket < merged[b].firstPacket;
+    });
+    std::vector<uint32> globalToFinal(merged.size());
+    flows.resize(merged.size());
+    for (auto i = 0U; i < order.size(); i++)
+    {
+        globalToFinal[order[i]] = i;
+        flows[i]                = merged[order[i]];
+    }
+
+    // packet --> flow
+    GView::Utils::ParallelFor(static_cast<uint32>(shards.size()), [&](uint32 index) {
+        const auto& shard = shards[index];
+        const auto& map   = localToGlobal[shard.worker];
+        for (auto i = shard.start; i < shard.end; i++)
+        {
+            if (packetFlows[i] != INVALID_FLOW)
+                packetFlows[i] = globalToFinal[map[packetFlows[i]]];
+        }
+    });
+
+    return true;
+}
@@ -18,10 +18,20 @@ extern "C"
     {
         CHECK(buf.GetLength() > sizeof(PCAP::Header), false, "");
 
+        auto shb = buf.GetObject<PCAP::SectionHeaderBlock>(0);
+        if (shb.IsValid() && shb->header.type == PCAP::BlockType::SectionHeader)
+        {
+            return shb->byteOrderMagic == PCAP::PCAPNG_BYTE_ORDER_MAGIC || shb->byteOrderMagic == PCAP::PCAPNG_BYTE_ORDER_MAGIC_SWAPPED;
+        }
+
         auto header = buf.GetObject<PCAP::Header>(0);
         CHECK(header.IsValid(), false, "");
 
-        CHECK(header->magicNumber == PCAP::Magic::Identical || header->magicNumber == PCAP::Magic::Swapped, false, "");
+        const auto magic = header->magicNumber;
+        CHECK(magic == PCAP::Magic::Identical || magic == PCAP::Magic::Swapped || magic == PCAP::Magic::IdenticalNano ||
+                    magic == PCAP::Magic::SwappedNano,
+              false,
+              "");
 
         return true;
     }
@@ -35,21 +45,25 @@ extern "C"
     static constexpr auto DarkRedBlue   = ColorPair{ Color::DarkRed, Color::DarkBlue };
     constexpr static auto colors        = std::array<ColorPair, 2>{ DarkGreenBlue, DarkRedBlue };
 
+    // a zone for each packet would use too much memory for large captures
+    constexpr uint32 MAX_PACKET_ZONES = 0x10000;
+
     void CreateBufferView(Reference<GView::View::WindowInterface> win, Reference<PCAP::PCAPFile> pcap)
     {
         BufferViewer::Settings settings;
 
-        auto offset = 0ULL;
-        settings.AddZone(offset, sizeof(pcap->header), ColorPair{ Color::Magenta, Color::DarkBlue }, "Header");
-        offset += sizeof(pcap->header);
+        if (pcap->format == PCAP::Format::PCAP)
+        {
+            settings.AddZone(0, sizeof(pcap->header), ColorPair{ Color::Magenta, Color::DarkBlue }, "Header");
+        }
 
-        auto count = 0;
         LocalString<32> ls;
-        for (const auto& [header, offset] : pcap->packetHeaders)
+        const auto count = std::min<size_t>(pcap->packets.size(), MAX_PACKET_ZONES);
+        for (auto i = 0U; i < count; i++)
         {
-            const auto& c = *(colors.begin() + (count % 2));
-            settings.AddZone(offset, sizeof(PCAP::PacketHeader) + header->inclLen, c, ls.Format("Packet_%u", count));
-            count++;
+            const auto& packet = pcap->packets[i];
+            const auto& c      = *(colors.begin() + (i % 2));
+            settings.AddZone(pcap->GetRecordOffset(packet), pcap->GetRecordSize(packet), c, ls.Format("Packet_%u", i));
         }
 
         win->CreateViewer("BufferView", settings);
@@ -65,15 +79,22 @@ extern "C"
 
         // add panels
         win->AddPanel(Pointer<TabPage>(new PCAP::Panels::Information(win->GetObject(), pcap)), true);
-        win->AddPanel(Pointer<TabPage>(new PCAP::Panels::Packets(pcap, win)), false);
+
+        // both panels show the result of the filter (and each one can change it)
+        auto packets = new PCAP::Panels::Packets(pcap, win);
+        auto flows   = new PCAP::Panels::Flows(pcap, win);
+        packets->SetFlowsPanel(flows);
+        flows->SetPacketsPanel(packets);
+        win->AddPanel(Pointer<TabPage>(packets), false);
+        win->AddPanel(Pointer<TabPage>(flows), false);
 
         return true;
     }
 
     PLUGIN_EXPORT void UpdateSettings(IniSection sect)
     {
-        sect["Pattern"]     = { "magic:A1 B2 C3 D4", "magic:D4 C3 B2 A1" };
-        sect["Extension"]   = "pcap";
+        sect["Pattern"]     = { "magic:A1 B2 C3 D4", "magic:D4 C3 B2 A1", "magic:A1 B2 3C 4D", "magic:4D 3C B2 A1", "magic:0A 0D 0D 0A" };
+        sect["Extension"]   = { "pcap", "pcapng" };
         sect["Priority"]    = 1;
         sect["Description"] = "Network Packet capture file format";
     }
@@ -2,29 +2,376 @@
 
 using namespace GView::Type::PCAP;
 
+constexpr uint32 MAX_PACKET_SIZE      = 0x10000000; // 256 MB - bigger values mean a corrupted capture
+constexpr uint32 PROGRESS_UPDATE_MASK = 0xFFFF;
+constexpr uint64 NANOSECONDS          = 1000000000ULL;
+constexpr uint32 MAX_INTERFACES       = 0xFFFF;
+constexpr uint32 MAX_OPTIONS_SIZE     = 0x10000;
+constexpr uint8 DEFAULT_TS_RESOLUTION = 6; // microseconds
+
 PCAPFile::PCAPFile()
+    : format(Format::PCAP), header{}, filtered(false), sectionsCount(0), swapped(false), indexComplete(false), flowsBuilt(false)
 {
 }
 
 bool PCAPFile::Update()
 {
-    auto offset = 0;
+    uint32 magic = 0;
+    CHECK(obj->GetData().Copy<uint32>(0, magic), false, "");
+    if (magic == static_cast<uint32>(BlockType::SectionHeader))
+    {
+        format = Format::PCAPNG;
+        return BuildPcapNgPacketIndex(0);
+    }
+
+    format      = Format::PCAP;
+    auto offset = 0ULL;
     CHECK(obj->GetData().Copy<Header>(offset, header), false, "");
     offset += sizeof(Header);
-    if (header.magicNumber == Magic::Swapped)
+    swapped = header.magicNumber == Magic::Swapped || header.magicNumber == Magic::SwappedNano;
+    if (swapped)
     {
         Swap(header);
     }
 
-    data = obj->GetData().CopyToBuffer(offset, (uint32) obj->GetData().GetSize() - offset);
-    CHECK(data.IsValid(), false, "");
+    // a classic capture has a single interface
+    interfaces.push_back({ header.network, header.snaplen, DEFAULT_TS_RESOLUTION, 0, 0 });
+    sectionsCount = 1;
+
+    return BuildPcapPacketIndex(offset);
+}
+
+bool PCAPFile::BuildPcapPacketIndex(uint64 offset)
+{
+    auto& cache            = obj->GetData();
+    const auto fileSize    = cache.GetSize();
+    const auto blockSize   = cache.GetCacheSize();
+    const auto nanoseconds = header.magicNumber == Magic::IdenticalNano; // (the magic is already in native byte order)
+    LocalString<128> ls;
+
+    packets.clear();
+    indexComplete = false;
 
-    const auto delta = offset;
-    do
+    // the capture is never copied in memory: each block is read through the cache and only the packet headers are parsed
+    ProgressStatus::Init("Indexing packets...", fileSize);
+    while (offset + sizeof(PacketHeader) <= fileSize)
     {
-        const auto& [header, _] = packetHeaders.emplace_back((PacketHeader*) (data.GetData() + offset - delta), offset);
-        offset += (sizeof(PacketHeader) + header->origLen);
-    } while (offset < obj->GetData().GetSize());
+        const auto block = cache.Get(offset, blockSize, false);
+        CHECK(block.IsValid() && block.GetLength() >= sizeof(PacketHeader), false, "Fail to read packets from offset %llu", offset);
+
+        const auto* data = block.GetData();
+        const auto size  = static_cast<uint64>(block.GetLength());
+        auto pos         = 0ULL;
+        while (pos + sizeof(PacketHeader) <= size)
+        {
+            PacketHeader packetHeader;
+            memcpy(&packetHeader, data + pos, sizeof(PacketHeader));
+            if (swapped)
+            {
+                Swap(packetHeader);
+            }
+
+            const auto dataOffset = offset + pos + sizeof(PacketHeader);
+            // a corrupted / truncated packet ends the index (the packets found so far are kept)
+            if ((packetHeader.inclLen > MAX_PACKET_SIZE) || (dataOffset + packetHeader.inclLen > fileSize))
+            {
+                packets.shrink_to_fit();
+                return true;
+            }
+
+            const auto timestamp = static_cast<uint64>(packetHeader.tsSec) * NANOSECONDS +
+                                   static_cast<uint64>(packetHeader.tsUsec) * (nanoseconds ? 1 : 1000);
+            packets.push_back({ dataOffset,
+                                timestamp,
+                                packetHeader.inclLen,
+                                packetHeader.origLen,
+                                static_cast<uint32>(sizeof(PacketHeader) + packetHeader.inclLen),
+                                static_cast<uint16>(sizeof(PacketHeader)),
+                                0 });
+            pos += sizeof(PacketHeader) + packetHeader.inclLen;
+
+            if (((packets.size() & PROGRESS_UPDATE_MASK) == 0) &&
+                (ProgressStatus::Update(offset + pos, ls.Format("Indexing packets (%llu MB)...", (offset + pos) >> 20))))
+            {
+                packets.shrink_to_fit();
+                return true;
+            }
+        }
+        // the next packet header starts after this block (or it is split between this block and the next one)
+        offset += pos;
+    }
+    packets.shrink_to_fit();
+    indexComplete = offset == fileSize;
 
     return true;
 }
+
+// converts a timestamp (in the resolution of the interface) to nanoseconds
+static uint64 ToNanoseconds(uint64 value, const Interface& iface)
+{
+    auto result         = 0ULL;
+    const auto exponent = static_cast<uint32>(iface.tsResolution & 0x7F);
+    if (iface.tsResolution & 0x80)
+    {
+        // 2^-exponent seconds
+        if (exponent >= 64)
+        {
+            return static_cast<uint64>(iface.tsOffset) * NANOSECONDS;
+        }
+        auto fraction = value & ((1ULL << exponent) - 1);
+        auto shift    = exponent;
+        if (shift > 34) // fraction * NANOSECONDS must fit in 64 bits
+        {
+            fraction >>= (shift - 34);
+            shift = 34;
+        }
+        result = (value >> exponent) * NANOSECONDS + ((fraction * NANOSECONDS) >> shift);
+    }
+    else
+    {
+        // 10^-exponent seconds
+        auto exp = exponent;
+        result   = value;
+        for (; exp < 9; exp++)
+            result *= 10;
+        for (; exp > 9; exp--)
+            result /= 10;
+    }
+    return result + static_cast<uint64>(iface.tsOffset) * NANOSECONDS;
+}
+
+bool PCAPFile::BuildPcapNgPacketIndex(uint64 offset)
+{
+    auto& cache                 = obj->GetData();
+    const auto fileSize         = cache.GetSize();
+    auto sectionSwapped         = false;
+    auto sectionFirstInterface  = 0U;
+    auto sectionInterfacesCount = 0U;
+    auto blocksCount            = 0ULL;
+    LocalString<128> ls;
+
+    packets.clear();
+    interfaces.clear();
+    sectionsCount = 0;
+    indexComplete = false;
+
+    // blocks are parsed one by one, through the cache (only the fixed part of each packet block is read)
+    ProgressStatus::Init("Indexing packets...", fileSize);
+    while (offset + sizeof(BlockHeader) + sizeof(uint32) <= fileSize)
+    {
+        const auto view = cache.Get(offset, static_cast<uint32>(std::min<uint64>(sizeof(EnhancedPacketBlock), fileSize - offset)), false);
+        CHECK(view.IsValid() && view.GetLength() >= sizeof(BlockHeader), false, "Fail to read block from offset %llu", offset);
+
+        BlockHeader blockHeader;
+        memcpy(&blockHeader, view.GetData(), sizeof(BlockHeader));
+        if (blockHeader.type == BlockType::SectionHeader)
+        {
+            // the byte order can change from one section to another
+            CHECKBK(view.GetLength() >= sizeof(SectionHeaderBlock), "");
+            SectionHeaderBlock shb;
+            memcpy(&shb, view.GetData(), sizeof(SectionHeaderBlock));
+            CHECKBK(shb.byteOrderMagic == PCAPNG_BYTE_ORDER_MAGIC || shb.byteOrderMagic == PCAPNG_BYTE_ORDER_MAGIC_SWAPPED, "");
+            sectionSwapped = shb.byteOrderMagic == PCAPNG_BYTE_ORDER_MAGIC_SWAPPED;
+            if (sectionsCount == 0)
+            {
+                swapped = sectionSwapped;
+            }
+            sectionFirstInterface  = static_cast<uint32>(interfaces.size());
+            sectionInterfacesCount = 0;
+            sectionsCount++;
+        }
+        if (sectionsCount == 0)
+        {
+            break; // a PCAPNG file must start with a section header block
+        }
+        if (sectionSwapped)
+        {
+            Swap(blockHeader);
+        }
+        if ((blockHeader.totalLength < sizeof(BlockHeader) + sizeof(uint32)) || (blockHeader.totalLength % 4 != 0) ||
+            (offset + blockHeader.totalLength > fileSize))
+        {
+            break; // corrupted or truncated block
+        }
+
+        switch (blockHeader.type)
+        {
+        case BlockType::InterfaceDescription:
+        {
+            CHECKBK(blockHeader.totalLength >= sizeof(InterfaceDescriptionBlock) + sizeof(uint32), "");
+            const auto size    = std::min<uint32>(blockHeader.totalLength, sizeof(InterfaceDescriptionBlock) + MAX_OPTIONS_SIZE);
+            const auto idbView = cache.Get(offset, size, true);
+            CHECKBK(idbView.IsValid(), "");
+
+            InterfaceDescriptionBlock idb;
+            memcpy(&idb, idbView.GetData(), sizeof(InterfaceDescriptionBlock));
+            if (sectionSwapped)
+            {
+                Swap(idb);
+            }
+            Interface iface{ static_cast<LinkType>(idb.linkType), idb.snaplen, DEFAULT_TS_RESOLUTION, 0, sectionsCount - 1 };
+
+            // options (only the ones related to timestamps are used)
+            auto pos       = static_cast<uint32>(sizeof(InterfaceDescriptionBlock));
+            const auto end = std::min<uint32>(size, blockHeader.totalLength - sizeof(uint32));
+            while (pos + sizeof(OptionHeader) <= end)
+            {
+                OptionHeader option;
+                memcpy(&option, idbView.GetData() + pos, sizeof(OptionHeader));
+                if (sectionSwapped)
+                {
+                    Swap(option);
+                }
+                pos += sizeof(OptionHeader);
+                if ((option.code == static_cast<uint16>(InterfaceOption::EndOfOptions)) || (pos + option.length > end))
+                {
+                    break;
+                }
+                if ((option.code == static_cast<uint16>(InterfaceOption::TsResolution)) && (option.length >= 1))
+                {
+                    iface.tsResolution = idbView.GetData()[pos];
+                }
+                else if ((option.code == static_cast<uint16>(InterfaceOption::TsOffset)) && (option.length >= sizeof(uint64)))
+                {
+                    uint64 value;
+                    memcpy(&value, idbView.GetData() + pos, sizeof(uint64));
+                    iface.tsOffset = static_cast<int64>(sectionSwapped ? AppCUI::Endian::BigToNative(value) : value);
+                }
+                pos += (option.length + 3) & ~3U; // options are padded to 32 bits
+            }
+            if (interfaces.size() < MAX_INTERFACES)
+            {
+                interfaces.push_back(iface);
+                sectionInterfacesCount++;
+            }
+            break;
+        }
+        case BlockType::EnhancedPacket:
+        case BlockType::Packet:
+        {
+            CHECKBK(view.GetLength() >= sizeof(EnhancedPacketBlock), "");
+            CHECKBK(blockHeader.totalLength >= sizeof(EnhancedPacketBlock) + sizeof(uint32), "");
+            uint32 interfaceID, timestampHigh, timestampLow, capturedLength, originalLength;
+            if (blockHeader.type == BlockType::EnhancedPacket)
+            {
+                EnhancedPacketBlock epb;
+                memcpy(&epb, view.GetData(), sizeof(EnhancedPacketBlock));
+                if (sectionSwapped)
+                {
+                    Swap(epb);
+                }
+                interfaceID    = epb.interfaceID;
+                timestampHigh  = epb.timestampHigh;
+                timestampLow   = epb.timestampLow;
+                capturedLength = epb.capturedLength;
+                originalLength = epb.originalLength;
+            }
+            else
+            {
+                PacketBlock pb;
+                memcpy(&pb, view.GetData(), sizeof(PacketBlock));
+                if (sectionSwapped)
+                {
+                    Swap(pb);
+                }
+                interfaceID    = pb.interfaceID;
+                timestampHigh  = pb.timestampHigh;
+                timestampLow   = pb.timestampLow;
+                capturedLength = pb.capturedLength;
+                originalLength = pb.originalLength;
+            }
+            // packets from unknown interfaces or with an invalid length are skipped
+            if ((interfaceID >= sectionInterfacesCount) ||
+                (capturedLength > blockHeader.totalLength - sizeof(EnhancedPacketBlock) - sizeof(uint32)))
+            {
+                break;
+            }
+            const auto& iface = interfaces[sectionFirstInterface + interfaceID];
+            packets.push_back({ offset + sizeof(EnhancedPacketBlock),
+                                ToNanoseconds((static_cast<uint64>(timestampHigh) << 32) | timestampLow, iface),
+                                capturedLength,
+                                originalLength,
+                                blockHeader.totalLength,
+                                static_cast<uint16>(sizeof(EnhancedPacketBlock)),
+                                static_cast<uint16>(sectionFirstInterface + interfaceID) });
+            break;
+        }
+        case BlockType::SimplePacket:
+        {
+            CHECKBK(view.GetLength() >= sizeof(SimplePacketBlock), "");
+            if (sectionInterfacesCount == 0)
+            {
+                break; // simple packets belong to the first interface of the section
+            }
+            SimplePacketBlock spb;
+            memcpy(&spb, view.GetData(), sizeof(SimplePacketBlock));
+            if (sectionSwapped)
+            {
+                Swap(spb);
+            }
+            // the captured length is not stored --> min(original length, snaplen, block size)
+            const auto& iface     = interfaces[sectionFirstInterface];
+            const auto maxCapture = static_cast<uint32>(blockHeader.totalLength - sizeof(SimplePacketBlock) - sizeof(uint32));
+            auto capturedLength   = std::min<uint32>(spb.originalLength, maxCapture);
+            if (iface.snaplen > 0)
+            {
+                capturedLength = std::min<uint32>(capturedLength, iface.snaplen);
+            }
+            packets.push_back({ offset + sizeof(SimplePacketBlock),
+                                0, // no timestamp
+                                capturedLength,
+                                spb.originalLength,
+                                blockHeader.totalLength,
+                                static_cast<uint16>(sizeof(SimplePacketBlock)),
+                                static_cast<uint16>(sectionFirstInterface) });
+            break;
+        }
+        default:
+            break;
+        }
+
+        offset += blockHeader.totalLength;
+        if (((++blocksCount & PROGRESS_UPDATE_MASK) == 0) &&
+            (ProgressStatus::Update(offset, ls.Format("Indexing packets (%llu MB)...", offset >> 20))))
+        {
+            packets.shrink_to_fit();
+            return true;
+        }
+    }
+    packets.shrink_to_fit();
+    indexComplete = offset == fileSize;
+
+    // the type of the link and the snaplen of the first interface are used to describe the capture
+    if (!interfaces.empty())
+    {
+        header.network = interfaces[0].linkType;
+        header.snaplen = interfaces[0].snaplen;
+    }
+
+    return sectionsCount > 0;
+}
+
+Buffer PCAPFile::ReadPacket(const PacketIndexEntry& entry)
+{
+    Buffer packetData;
+    if (entry.inclLen > 0)
+    {
+        packetData = obj->GetData().CopyToBuffer(entry.offset, entry.inclLen);
+        CHECK(packetData.IsValid(), Buffer(), "Fail to read packet from offset %llu", entry.offset);
+    }
+
+    Buffer buffer;
+    buffer.Resize(sizeof(PacketHeader) + entry.inclLen);
+
+    auto* packetHeader    = reinterpret_cast<PacketHeader*>(buffer.GetData());
+    packetHeader->tsSec   = static_cast<uint32>(entry.timestamp / NANOSECONDS);
+    packetHeader->tsUsec  = static_cast<uint32>((entry.timestamp % NANOSECONDS) / 1000);
+    packetHeader->inclLen = entry.inclLen;
+    packetHeader->origLen = entry.origLen;
+    if (entry.inclLen > 0)
+    {
+        memcpy(buffer.GetData() + sizeof(PacketHeader), packetData.GetData(), entry.inclLen);
+    }
+
+    return buffer;
+}
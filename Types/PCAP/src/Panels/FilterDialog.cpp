@@ -0,0 +1,76 @@
+#include "PCAP.hpp"
+
+using namespace GView::Type::PCAP;
+using namespace GView::Type::PCAP::Panels;
+using namespace AppCUI::Input;
+
+constexpr int32 BTN_ID_OK     = 1;
+constexpr int32 BTN_ID_CANCEL = 2;
+
+FilterDialog::FilterDialog(Reference<PCAPFile> _pcap) : Window("Filter", "d:c,w:76,h:16", WindowFlags::ProcessReturn), pcap(_pcap)
+{
+    Factory::Label::Create(this, "&Expression", "x:1,y:1,w:12");
+    txExpression = Factory::TextField::Create(this, std::string_view{ pcap->filterExpression }, "x:14,y:1,w:58");
+    txExpression->SetHotKey('E');
+
+    Factory::Label::Create(this, "[src|dst] host <ip>       [src|dst] net <ip>[/bits]", "x:1,y:3,w:72");
+    Factory::Label::Create(this, "[src|dst] port <n>        tcp, udp, icmp, icmp6, sctp, ip, ip6", "x:1,y:4,w:72");
+    Factory::Label::Create(this, "proto <name|n>            tcpflags <syn,ack,fin,rst,psh,urg,ece,cwr>", "x:1,y:5,w:72");
+    Factory::Label::Create(this, "len <op> <n>, less <n>, greater <n>  (op: == != < <= > >=)", "x:1,y:6,w:72");
+    Factory::Label::Create(this, "and (&&), or (||), not (!) and parentheses", "x:1,y:7,w:72");
+    Factory::Label::Create(this, "An empty expression shows all the packets.", "x:1,y:9,w:72");
+
+    Factory::Button::Create(this, "&OK", "l:23,b:0,w:13", BTN_ID_OK);
+    Factory::Button::Create(this, "&Cancel", "l:38,b:0,w:13", BTN_ID_CANCEL);
+
+    txExpression->SetFocus();
+}
+
+void FilterDialog::Validate()
+{
+    LocalString<512> tmp;
+    if (tmp.Set(txExpression->GetText()) == false)
+    {
+        Dialogs::MessageBox::ShowError("Error", "Invalid expression (expecting ascii characters) !");
+        txExpression->SetFocus();
+        return;
+    }
+
+    // the dialog stays open until the expression compiles
+    std::string error;
+    if (pcap->ApplyFilter(tmp.ToStringView(), error) == false)
+    {
+        Dialogs::MessageBox::ShowError("Error", std::string_view{ error });
+        txExpression->SetFocus();
+        return;
+    }
+    Exit(Dialogs::Result::Ok);
+}
+
+bool FilterDialog::OnEvent(Reference<Control> control, Event eventType, int ID)
+{
+    if (eventType == Event::ButtonClicked)
+    {
+        switch (ID)
+        {
+        case BTN_ID_CANCEL:
+            Exit(Dialogs::Result::Cancel);
+            return true;
+        case BTN_ID_OK:
+            Validate();
+            return true;
+        }
+    }
+
+    switch (eventType)
+    {
+    case Event::WindowAccept:
+        Validate();
+        return true;
+    case Event::WindowClose:
+        Exit(Dialogs::Result::Cancel);
+        return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,355 @@
+#include "PCAP.hpp"
+
+namespace GView::Type::PCAP::Panels
+{
+using namespace AppCUI::Controls;
+using namespace AppCUI::Input;
+
+constexpr uint64 NANOSECONDS      = 1000000000ULL;
+constexpr uint32 MAX_FLOW_PACKETS = 100000; // packets shown in the dialog of a flow
+constexpr uint32 MAX_HEADERS_SIZE = 256;
+constexpr int32 BTN_ID_GOTO       = 1;
+constexpr int32 BTN_ID_CANCEL     = 2;
+constexpr uint64 INVALID_PACKET   = 0xFFFFFFFFFFFFFFFFULL;
+
+enum class FlowAction : int32
+{
+    ShowPackets = 1,
+    ChangeBase  = 2,
+    Reassemble  = 3,
+    Filter      = 4,
+};
+
+std::string_view FormatEndpoint(LocalString<128>& text, const FlowKey& key, bool source)
+{
+    const auto* ip   = source ? key.source : key.destination;
+    const auto port  = source ? key.sourcePort : key.destinationPort;
+    const auto ports = (key.protocol == IP_Protocol::TCP) || (key.protocol == IP_Protocol::UDP);
+    if (key.ipVersion == 4)
+    {
+        text.Format("%u.%u.%u.%u", ip[0], ip[1], ip[2], ip[3]);
+        if (ports)
+            text.AddFormat(":%u", port);
+        return text.ToStringView();
+    }
+
+    text.Set(ports ? "[" : "");
+    for (auto i = 0U; i < 16; i += 2)
+        text.AddFormat(i == 0 ? "%x" : ":%x", (ip[i] << 8) | ip[i + 1]);
+    if (ports)
+        text.AddFormat("]:%u", port);
+    return text.ToStringView();
+}
+
+std::string_view FormatTCPFlags(LocalString<64>& text, uint8 flags)
+{
+    text.Clear();
+    for (const auto& [flag, name] : TCPHeader_FlagsNames)
+    {
+        if ((flag != TCPHeader_Flags::NONE) && ((flags & flag) == flag))
+        {
+            if (text.Len() > 0)
+                text.AddChar(',');
+            text.Add(name);
+        }
+    }
+    return text.ToStringView();
+}
+
+Flows::Flows(Reference<PCAPFile> _pcap, Reference<GView::View::WindowInterface> _win) : TabPage("&Flows")
+{
+    pcap = _pcap;
+    win  = _win;
+    Base = 10;
+
+    // rows are formatted only when they are visible (captures can have millions of flows)
+    list = this->CreateChildControl<GView::View::VirtualList>(
+          "d:c",
+          this,
+          std::initializer_list<GView::View::VirtualListColumn>{ { "#", 8, false },
+                                                                 { "Protocol", 10, true },
+                                                                 { "Endpoint A", 46, true },
+                                                                 { "Endpoint B", 46, true },
+                                                                 { "Packets A->B", 14, false },
+                                                                 { "Packets B->A", 14, false },
+                                                                 { "Bytes A->B", 16, false },
+                                                                 { "Bytes B->A", 16, false },
+                                                                 { "Start", 20, true },
+                                                                 { "Duration (ms)", 16, false },
+                                                                 { "TCP Flags", 32, true } });
+
+    Update();
+}
+
+std::string_view Flows::GetValue(NumericFormatter& n, uint64 value)
+{
+    if (Base == 10)
+    {
+        return n.ToString(value, { NumericFormatFlags::None, 10, 3, ',' });
+    }
+
+    return n.ToString(value, { NumericFormatFlags::HexPrefix, 16 });
+}
+
+void Flows::Update()
+{
+    list->Refresh();
+}
+
+uint32 Flows::GetFlowIndex(uint64 row) const
+{
+    // with a filter, only the flows with at least one matching packet are shown
+    if (pcap->filtered)
+        return row < pcap->filteredFlows.size() ? pcap->filteredFlows[row] : INVALID_FLOW;
+    return row < pcap->flows.size() ? static_cast<uint32>(row) : INVALID_FLOW;
+}
+
+uint64 Flows::GetRowsCount()
+{
+    return pcap->filtered ? pcap->filteredFlows.size() : pcap->flows.size();
+}
+
+void Flows::FormatCell(uint64 row, uint32 column, String& text)
+{
+    const auto i = GetFlowIndex(row);
+    CHECKRET(i != INVALID_FLOW, "");
+    const auto& flow = pcap->flows[i];
+
+    LocalString<128> tmp;
+    LocalString<64> flags;
+    NumericFormatter n;
+    switch (column)
+    {
+    case 0:
+        text.Set(GetValue(n, i));
+        break;
+    case 1:
+        if (const auto protocol = IP_ProtocolNames.find(flow.key.protocol); protocol != IP_ProtocolNames.end())
+            text.Set(protocol->second);
+        else
+            text.Format("%u", (uint32) flow.key.protocol);
+        break;
+    case 2:
+        text.Set(FormatEndpoint(tmp, flow.key, true));
+        break;
+    case 3:
+        text.Set(FormatEndpoint(tmp, flow.key, false));
+        break;
+    case 4:
+        text.Set(GetValue(n, flow.packets[0]));
+        break;
+    case 5:
+        text.Set(GetValue(n, flow.packets[1]));
+        break;
+    case 6:
+        text.Set(GetValue(n, flow.bytes[0]));
+        break;
+    case 7:
+        text.Set(GetValue(n, flow.bytes[1]));
+        break;
+    case 8:
+    {
+        AppCUI::OS::DateTime dt;
+        dt.CreateFromTimestamp(flow.firstTimestamp / NANOSECONDS);
+        text.Set(dt.GetStringRepresentation());
+        break;
+    }
+    case 9:
+        text.Set(GetValue(n, (flow.lastTimestamp - flow.firstTimestamp) / 1000000));
+        break;
+    case 10:
+        if (flow.key.protocol == IP_Protocol::TCP)
+            text.Set(FormatTCPFlags(flags, flow.tcpFlags));
+        break;
+    }
+}
+
+void Flows::ShowFlowPackets()
+{
+    const auto flowIndex = GetFlowIndex(list->GetCurrentRow());
+    CHECKRET(flowIndex != INVALID_FLOW, "");
+
+    FlowPacketsDialog dialog(pcap, flowIndex);
+    CHECKRET(dialog.Show() == Dialogs::Result::Ok, "");
+    const auto packetIndex = dialog.GetSelectedPacket();
+    CHECKRET(packetIndex < pcap->packets.size(), "");
+
+    const auto& packet = pcap->packets[packetIndex];
+    win->GetCurrentView()->Select(pcap->GetRecordOffset(packet), pcap->GetRecordSize(packet));
+}
+
+void Flows::ReassembleStreams()
+{
+    const auto flowIndex = GetFlowIndex(list->GetCurrentRow());
+    CHECKRET(flowIndex != INVALID_FLOW, "");
+    if (pcap->flows[flowIndex].key.protocol != IP_Protocol::TCP)
+    {
+        AppCUI::Dialogs::MessageBox::ShowError("Error", "Only TCP flows can be reassembled !");
+        return;
+    }
+
+    TcpStream forward, backward;
+    CHECKRET(pcap->ReassembleTcpFlow(flowIndex, forward, backward), "");
+
+    // each direction is opened as a new object (so that its content can be identified by the other type plugins)
+    LocalString<64> name;
+    const TcpStream* streams[] = { &forward, &backward };
+    for (auto direction = 0U; direction < 2; direction++)
+    {
+        const auto data = streams[direction]->GetData();
+        if (data.GetLength() == 0)
+            continue;
+        name.Format("flow_%u_%s.bin", flowIndex, direction == 0 ? "a_to_b" : "b_to_a");
+        GView::App::OpenBuffer(data, name, GView::App::OpenMethod::BestMatch);
+    }
+    if ((forward.GetData().GetLength() == 0) && (backward.GetData().GetLength() == 0))
+    {
+        AppCUI::Dialogs::MessageBox::ShowError("Error", "The flow has no payload !");
+        return;
+    }
+
+    // the streams are incomplete if segments were lost (or not captured) --> say so
+    LocalString<512> report;
+    for (auto direction = 0U; direction < 2; direction++)
+    {
+        const auto& stream = *streams[direction];
+        if ((stream.gaps == 0) && (stream.retransmissions == 0) && (!stream.truncated))
+            continue;
+        report.AddFormat(
+              "%s: %u segments, %u retransmitted, %u gaps (%llu bytes missing)%s\n",
+              direction == 0 ? "A -> B" : "B -> A",
+              stream.segments,
+              stream.retransmissions,
+              stream.gaps,
+              stream.missingBytes,
+              stream.truncated ? ", truncated" : "");
+    }
+    if (report.Len() > 0)
+    {
+        AppCUI::Dialogs::MessageBox::ShowNotification("TCP reassembly", report.ToStringView());
+    }
+}
+
+void Flows::ShowFilterDialog()
+{
+    FilterDialog dialog(pcap);
+    CHECKRET(dialog.Show() == Dialogs::Result::Ok, "");
+
+    Update();
+    if (packetsPanel.IsValid())
+        packetsPanel->UpdateFilter();
+}
+
+bool Flows::OnUpdateCommandBar(AppCUI::Application::CommandBar& commandBar)
+{
+    // called when the panel is activated --> the flows are built the first time
+    pcap->EnsureFlows();
+
+    commandBar.SetCommand(Key::Enter, "Packets", static_cast<int32_t>(FlowAction::ShowPackets));
+    commandBar.SetCommand(Key::F2, Base == 10 ? "Dec" : "Hex", static_cast<int32_t>(FlowAction::ChangeBase));
+    commandBar.SetCommand(Key::Ctrl | Key::Enter, "Reassemble", static_cast<int32_t>(FlowAction::Reassemble));
+    commandBar.SetCommand(Key::F6, "Filter", static_cast<int32_t>(FlowAction::Filter));
+
+    return true;
+}
+
+bool Flows::OnEvent(Reference<Control> ctrl, Event evnt, int controlID)
+{
+    CHECK(TabPage::OnEvent(ctrl, evnt, controlID) == false, true, "");
+
+    if (evnt == Event::Command)
+    {
+        switch (static_cast<FlowAction>(controlID))
+        {
+        case FlowAction::ShowPackets:
+            ShowFlowPackets();
+            return true;
+        case FlowAction::ChangeBase:
+            Base = 26 - Base;
+            Update();
+            return true;
+        case FlowAction::Reassemble:
+            ReassembleStreams();
+            return true;
+        case FlowAction::Filter:
+            ShowFilterDialog();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+Flows::FlowPacketsDialog::FlowPacketsDialog(Reference<PCAPFile> _pcap, uint32 flowIndex)
+    : Window("Flow packets", "d:c,w:90,h:30", WindowFlags::ProcessReturn), pcap(_pcap), selectedPacket(INVALID_PACKET)
+{
+    LocalString<128> tmp;
+    LocalString<128> endpoint;
+    LocalString<64> flags;
+    PacketSummary summary;
+    const auto& flow = pcap->flows[flowIndex];
+
+    Factory::Label::Create(this, tmp.Format("A: %s", FormatEndpoint(endpoint, flow.key, true).data()), "x:1,y:1,w:86");
+    Factory::Label::Create(this, tmp.Format("B: %s", FormatEndpoint(endpoint, flow.key, false).data()), "x:1,y:2,w:86");
+    list = Factory::ListView::Create(
+          this,
+          "l:1,t:4,r:1,b:3",
+          { "n:#,a:r,w:14", "n:Timestamp,w:20", "n:Direction,w:10", "n:Length,a:r,w:12", "n:TCP Flags,w:20" },
+          ListViewFlags::None);
+    Factory::Button::Create(this, "&Go to", "l:28,b:0,w:15", BTN_ID_GOTO);
+    Factory::Button::Create(this, "&Cancel", "l:46,b:0,w:15", BTN_ID_CANCEL);
+
+    // the packets of a flow are found using the packet --> flow map (only the packets that are shown are dissected)
+    auto added = 0U;
+    const auto end = std::min<uint64>(flow.lastPacket + 1, pcap->packetFlows.size());
+    for (auto i = flow.firstPacket; (i < end) && (added < MAX_FLOW_PACKETS); i++)
+    {
+        if (pcap->packetFlows[i] != flowIndex)
+            continue;
+        const auto& packet = pcap->packets[i];
+
+        AppCUI::OS::DateTime dt;
+        dt.CreateFromTimestamp(packet.timestamp / NANOSECONDS);
+
+        auto item = list->AddItem({ tmp.Format("%llu", (unsigned long long) i) });
+        item.SetText(1, tmp.Format("%s", dt.GetStringRepresentation().data()));
+        item.SetText(3, tmp.Format("%u", packet.origLen));
+
+        Buffer headers;
+        if (packet.inclLen > 0)
+            headers = pcap->obj->GetData().CopyToBuffer(packet.offset, std::min<uint32>(packet.inclLen, MAX_HEADERS_SIZE));
+        if ((headers.GetLength() > 0) && ParsePacket(pcap->GetLinkType(packet), headers.GetData(), (uint32) headers.GetLength(), summary))
+        {
+            item.SetText(2, NormalizeFlowKey(summary.key) == 0 ? "A -> B" : "B -> A");
+            if (summary.key.protocol == IP_Protocol::TCP)
+            {
+                item.SetText(4, FormatTCPFlags(flags, summary.tcpFlags));
+            }
+        }
+        item.SetData(i);
+        added++;
+    }
+    list->SetFocus();
+}
+
+bool Flows::FlowPacketsDialog::OnEvent(Reference<Control> control, Event eventType, int ID)
+{
+    if ((eventType == Event::ListViewItemPressed) || ((eventType == Event::ButtonClicked) && (ID == BTN_ID_GOTO)) ||
+        (eventType == Event::WindowAccept))
+    {
+        if (list->GetItemsCount() > 0)
+        {
+            selectedPacket = list->GetCurrentItem().GetData(INVALID_PACKET);
+            Exit(Dialogs::Result::Ok);
+        }
+        return true;
+    }
+    if (((eventType == Event::ButtonClicked) && (ID == BTN_ID_CANCEL)) || (eventType == Event::WindowClose))
+    {
+        Exit(Dialogs::Result::Cancel);
+        return true;
+    }
+
+    return false;
+}
+} // namespace GView::Type::PCAP::Panels
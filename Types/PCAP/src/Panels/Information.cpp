@@ -26,10 +26,22 @@ void Information::UpdateGeneralInformation()
     general->AddItem({ "File", object->GetName() });
     AddDecAndHexElement("Size", "%-20s (%s)", pcap->obj->GetData().GetSize());
 
-    general->AddItem("Header").SetType(ListViewItem::Type::Category);
-    UpdatePcapHeader();
+    if (pcap->format == PCAP::Format::PCAPNG)
+    {
+        UpdatePcapNgInterfaces();
+    }
+    else
+    {
+        general->AddItem("Header").SetType(ListViewItem::Type::Category);
+        UpdatePcapHeader();
+    }
 
-    AddDecAndHexElement("Packets #", "%-20s (%s)", (uint32) pcap->packetHeaders.size()).SetType(ListViewItem::Type::Emphasized_1);
+    AddDecAndHexElement("Packets #", "%-20s (%s)", (uint64) pcap->packets.size()).SetType(ListViewItem::Type::Emphasized_1);
+    if (!pcap->indexComplete)
+    {
+        general->AddItem({ "Warning", "Capture is truncated or corrupted (not all packets were indexed)" })
+              .SetType(ListViewItem::Type::WarningInformation);
+    }
 }
 
 void Information::UpdatePcapHeader()
@@ -55,6 +67,35 @@ void Information::UpdatePcapHeader()
           .SetType(ListViewItem::Type::Emphasized_2);
 }
 
+void Information::UpdatePcapNgInterfaces()
+{
+    LocalString<1024> ls;
+    NumericFormatter nf;
+
+    general->AddItem({ "Format", "PCAPNG" }).SetType(ListViewItem::Type::Emphasized_1);
+    AddDecAndHexElement("Sections #", "%-20s (%s)", pcap->sectionsCount);
+    AddDecAndHexElement("Interfaces #", "%-20s (%s)", (uint32) pcap->interfaces.size());
+
+    for (auto i = 0U; i < pcap->interfaces.size(); i++)
+    {
+        const auto& iface = pcap->interfaces[i];
+        general->AddItem(ls.Format("Interface %u", i)).SetType(ListViewItem::Type::Category);
+
+        const auto it         = PCAP::LinkTypeNames.find(iface.linkType);
+        const auto linkName   = it != PCAP::LinkTypeNames.end() ? it->second.data() : "Unknown";
+        const auto networkHex = nf.ToString((uint32) iface.linkType, hexUint32);
+        general->AddItem({ "Network", ls.Format("%-20s (%s)", linkName, networkHex.data()) }).SetType(ListViewItem::Type::Emphasized_2);
+        AddDecAndHexElement("Snaplen", "%-20s (%s)", iface.snaplen);
+        AddDecAndHexElement("Section", "%-20s (%s)", iface.section);
+        general->AddItem({ "Timestamp resolution",
+                           ls.Format("%s%u", (iface.tsResolution & 0x80) ? "2^-" : "10^-", (uint32) (iface.tsResolution & 0x7F)) });
+        if (iface.tsOffset != 0)
+        {
+            AddDecAndHexElement("Timestamp offset", "%-20s (%s)", iface.tsOffset);
+        }
+    }
+}
+
 void Information::UpdateIssues()
 {
 }
@@ -14,24 +14,41 @@ enum class ObjectAction : int32
     Select     = 2,
     ChangeBase = 4,
     OpenPacket = 8,
+    SortIndex  = 16,
+    SortTime   = 32,
+    SortLength = 64,
+    Filter     = 128,
 };
 
-Packets::Packets(Reference<PCAPFile> _pcap, Reference<GView::View::WindowInterface> _win) : TabPage("&Packets")
+constexpr uint64 NANOSECONDS = 1000000000ULL;
+
+// the sort key of each column
+static constexpr PacketsSortKey PACKETS_SORT_KEYS[] = {
+    PacketsSortKey::Index,     // #
+    PacketsSortKey::Timestamp, // Timestamp
+    PacketsSortKey::Timestamp, // Seconds
+    PacketsSortKey::Timestamp, // Microseconds
+    PacketsSortKey::Length,    // Octets Saved
+    PacketsSortKey::Length,    // Actual Length
+};
+
+Packets::Packets(Reference<PCAPFile> _pcap, Reference<GView::View::WindowInterface> _win)
+    : TabPage("&Packets"), sortKey(PacketsSortKey::Index), sortAscending(true)
 {
     pcap = _pcap;
     win  = _win;
     Base = 16;
 
-    list = Factory::ListView::Create(
-          this,
+    // rows are formatted only when they are visible (captures can have millions of packets)
+    list = this->CreateChildControl<GView::View::VirtualList>(
           "d:c",
-          { "n:#,a:r,w:6",
-            "n:Timestamp,a:r,w:20",
-            "n:Seconds,a:r,w:16",
-            "n:Microseconds,a:r,w:16",
-            "n:Octets Saved,a:r,w:16",
-            "n:Actual Length,a:r,w:16" },
-          ListViewFlags::None);
+          this,
+          std::initializer_list<GView::View::VirtualListColumn>{ { "#", 12, false },
+                                                                 { "Timestamp", 20, false },
+                                                                 { "Seconds", 16, false },
+                                                                 { "Microseconds", 16, false },
+                                                                 { "Octets Saved", 16, false },
+                                                                 { "Actual Length", 16, false } });
 
     Update();
 }
@@ -46,19 +63,94 @@ std::string_view Packets::GetValue(NumericFormatter& n, uint64 value)
     return n.ToString(value, { NumericFormatFlags::HexPrefix, 16 });
 }
 
+uint64 Packets::GetPacketIndex(uint64 row) const
+{
+    return order.empty() ? row : order[row];
+}
+
+const PacketIndexEntry* Packets::GetCurrentPacket()
+{
+    const auto row = list->GetCurrentRow();
+    CHECK(row != GView::Utils::INVALID_OFFSET, nullptr, "");
+    return &pcap->packets[GetPacketIndex(row)];
+}
+
+void Packets::Sort(PacketsSortKey key, bool ascending, uint64& row)
+{
+    const auto& packets = pcap->packets;
+    const auto current  = row < GetRowsCount() ? GetPacketIndex(row) : 0;
+
+    sortKey       = key;
+    sortAscending = ascending;
+
+    // the packets are never moved: only a permutation of their indexes is sorted
+    if ((key == PacketsSortKey::Index) && ascending && !pcap->filtered)
+    {
+        order.clear();
+        order.shrink_to_fit();
+    }
+    else
+    {
+        if (pcap->filtered)
+        {
+            order = pcap->filteredPackets;
+        }
+        else
+        {
+            order.resize(packets.size());
+            std::iota(order.begin(), order.end(), 0U);
+        }
+        switch (key)
+        {
+        case PacketsSortKey::Index:
+            if (!ascending)
+                std::reverse(order.begin(), order.end());
+            break;
+        case PacketsSortKey::Timestamp:
+            std::sort(order.begin(), order.end(), [&packets, ascending](uint32 a, uint32 b) {
+                const auto ta = packets[a].timestamp;
+                const auto tb = packets[b].timestamp;
+                if (ta != tb)
+                    return ascending ? ta < tb : ta > tb;
+                return a < b;
+            });
+            break;
+        case PacketsSortKey::Length:
+            std::sort(order.begin(), order.end(), [&packets, ascending](uint32 a, uint32 b) {
+                const auto la = packets[a].origLen;
+                const auto lb = packets[b].origLen;
+                if (la != lb)
+                    return ascending ? la < lb : la > lb;
+                return a < b;
+            });
+            break;
+        }
+    }
+
+    // keep the cursor on the same packet (if it is still visible)
+    row = current;
+    if (!order.empty())
+    {
+        const auto it = std::find(order.begin(), order.end(), static_cast<uint32>(current));
+        row           = it != order.end() ? it - order.begin() : 0;
+    }
+}
+
 void Panels::Packets::GoToSelectedSection()
 {
-    auto record       = list->GetCurrentItem().GetData<const std::pair<PacketHeader*, uint32>>();
-    const auto offset = record->second;
+    auto record = GetCurrentPacket();
+    CHECKRET(record != nullptr, "");
+    const auto offset = pcap->GetRecordOffset(*record);
 
     win->GetCurrentView()->GoTo(offset);
 }
 
 void Panels::Packets::SelectCurrentSection()
 {
-    auto record       = list->GetCurrentItem().GetData<const std::pair<PacketHeader*, uint32>>();
-    const auto offset = record->second;
-    const auto size   = record->first->inclLen + sizeof(PacketHeader);
+    auto record = GetCurrentPacket();
+    CHECKRET(record != nullptr, "");
+    const auto offset = pcap->GetRecordOffset(*record);
+    const auto size   = pcap->GetRecordSize(*record);
 
     win->GetCurrentView()->Select(offset, size);
 }
@@ -95,7 +187,9 @@ void Packets::PacketDialog::Add_PacketHeader(LinkType type, const PacketHeader*
     }
     list->AddItem({ "Original Length", tmp.Format("%s", GetValue(n, packet->origLen).data()) });
 
-    list->AddItem(LinkTypeNames.at(type).data()).SetType(ListViewItem::Type::Category);
+    const auto linkTypeName = LinkTypeNames.find(type);
+    list->AddItem(linkTypeName != LinkTypeNames.end() ? linkTypeName->second.data() : "Unknown link type")
+          .SetType(ListViewItem::Type::Category);
     if (type == LinkType::ETHERNET)
     {
         auto peh = (Package_EthernetHeader*) ((uint8*) packet + sizeof(PacketHeader));
@@ -654,41 +748,112 @@ Panels::Packets::PacketDialog::PacketDialog(
 
 void Panels::Packets::OpenPacket()
 {
-    auto itemData      = list->GetCurrentItem().GetData<const std::pair<PacketHeader*, uint32>>();
-    const auto& packet = itemData->first;
+    auto record = GetCurrentPacket();
+    CHECKRET(record != nullptr, "");
+
+    // the packet is read from the file only when needed
+    auto buffer = pcap->ReadPacket(*record);
+    CHECKRET(buffer.IsValid(), "");
+    const auto packet = reinterpret_cast<const PacketHeader*>(buffer.GetData());
 
     LocalString<128> ls;
     ls.Format("d:c,w:80,h:50", this->GetHeight());
-    PacketDialog dialog(nullptr, PCAP::LinkTypeNames.at(pcap->header.network).data(), ls.GetText(), pcap->header.network, packet, Base);
+    const auto linkType = pcap->GetLinkType(*record);
+    const auto it       = PCAP::LinkTypeNames.find(linkType);
+    PacketDialog dialog(nullptr, it != PCAP::LinkTypeNames.end() ? it->second : "Unknown", ls.GetText(), linkType, packet, Base);
     dialog.Show();
 }
 
 void Panels::Packets::Update()
 {
-    list->DeleteAllItems();
+    list->Refresh();
+}
 
-    LocalString<128> tmp;
-    NumericFormatter n;
+void Panels::Packets::UpdateFilter()
+{
+    auto row = list->GetCurrentRow();
+    Sort(sortKey, sortAscending, row);
+    list->Refresh();
+    list->MoveTo(row);
+}
 
-    for (auto i = 0ULL; i < pcap->packetHeaders.size(); i++)
-    {
-        auto& record                 = pcap->packetHeaders[i];
-        const auto& [header, offset] = record;
+void Panels::Packets::ShowFilterDialog()
+{
+    FilterDialog dialog(pcap);
+    CHECKRET(dialog.Show() == Dialogs::Result::Ok, "");
+
+    UpdateFilter();
+    if (flowsPanel.IsValid())
+        flowsPanel->Update();
+}
+
+uint64 Panels::Packets::GetRowsCount()
+{
+    return order.empty() ? pcap->packets.size() : order.size();
+}
+
+void Panels::Packets::FormatCell(uint64 row, uint32 column, String& text)
+{
+    CHECKRET(row < GetRowsCount(), "");
+    const auto index   = GetPacketIndex(row);
+    const auto& record = pcap->packets[index];
+    const auto seconds = record.timestamp / NANOSECONDS;
 
-        auto timestamp = header->tsSec * (uint64) 1000000 + header->tsUsec;
-        timestamp /= 1000000;
+    NumericFormatter n;
+    switch (column)
+    {
+    case 0:
+        text.Set(GetValue(n, index));
+        break;
+    case 1:
+    {
         AppCUI::OS::DateTime dt;
-        dt.CreateFromTimestamp(timestamp);
+        dt.CreateFromTimestamp(seconds);
+        text.Format("%s", dt.GetStringRepresentation().data());
+        break;
+    }
+    case 2:
+        text.Set(GetValue(n, seconds));
+        break;
+    case 3:
+        text.Set(GetValue(n, (record.timestamp % NANOSECONDS) / 1000));
+        break;
+    case 4:
+        text.Set(GetValue(n, record.inclLen));
+        break;
+    case 5:
+        text.Set(GetValue(n, record.origLen));
+        break;
+    }
+}
+
+bool Panels::Packets::SortByColumn(uint32 column, uint64& row)
+{
+    CHECK(column < std::size(PACKETS_SORT_KEYS), false, "");
 
-        auto item = list->AddItem({ tmp.Format("%s", GetValue(n, i).data()) });
-        item.SetText(1, tmp.Format("%s", dt.GetStringRepresentation().data()));
-        item.SetText(2, tmp.Format("%s", GetValue(n, header->tsSec).data()));
-        item.SetText(3, tmp.Format("%s", GetValue(n, header->tsUsec).data()));
-        item.SetText(4, tmp.Format("%s", GetValue(n, header->inclLen).data()));
-        item.SetText(5, tmp.Format("%s", GetValue(n, header->origLen).data()));
+    // the same key again changes the order
+    const auto key = PACKETS_SORT_KEYS[column];
+    Sort(key, key == sortKey ? !sortAscending : true, row);
+    return true;
+}
 
-        item.SetData<std::pair<PacketHeader*, uint32>>(&record);
+bool Panels::Packets::GetSortColumn(uint32& column, bool& ascending)
+{
+    // the order is shown only once for each sort key
+    switch (sortKey)
+    {
+    case PacketsSortKey::Index:
+        column = 0;
+        break;
+    case PacketsSortKey::Timestamp:
+        column = 1;
+        break;
+    case PacketsSortKey::Length:
+        column = 5;
+        break;
     }
+    ascending = sortAscending;
+    return true;
 }
 
 bool Panels::Packets::OnUpdateCommandBar(AppCUI::Application::CommandBar& commandBar)
@@ -697,6 +862,10 @@ bool Panels::Packets::OnUpdateCommandBar(AppCUI::Application::CommandBar& comman
     commandBar.SetCommand(Key::F9, "Select", static_cast<int32_t>(ObjectAction::Select));
     commandBar.SetCommand(Key::F2, Base == 10 ? "Dec" : "Hex", static_cast<int32_t>(ObjectAction::ChangeBase));
     commandBar.SetCommand(Key::Ctrl | Key::Enter, "Open Packet", static_cast<int32_t>(ObjectAction::OpenPacket));
+    commandBar.SetCommand(Key::F3, "Sort #", static_cast<int32_t>(ObjectAction::SortIndex));
+    commandBar.SetCommand(Key::F4, "Sort time", static_cast<int32_t>(ObjectAction::SortTime));
+    commandBar.SetCommand(Key::F5, "Sort length", static_cast<int32_t>(ObjectAction::SortLength));
+    commandBar.SetCommand(Key::F6, pcap->filtered ? "Filter (on)" : "Filter", static_cast<int32_t>(ObjectAction::Filter));
 
     return true;
 }
@@ -705,12 +874,6 @@ bool Panels::Packets::OnEvent(Reference<Control> ctrl, Event evnt, int controlID
 {
     CHECK(TabPage::OnEvent(ctrl, evnt, controlID) == false, true, "");
 
-    if (evnt == Event::ListViewItemPressed)
-    {
-        GoToSelectedSection();
-        return true;
-    }
-
     if (evnt == Event::Command)
     {
         switch (static_cast<ObjectAction>(controlID))
@@ -728,6 +891,18 @@ bool Panels::Packets::OnEvent(Reference<Control> ctrl, Event evnt, int controlID
         case ObjectAction::OpenPacket:
             OpenPacket();
             return true;
+        case ObjectAction::SortIndex:
+            list->SortByColumn(0);
+            return true;
+        case ObjectAction::SortTime:
+            list->SortByColumn(1);
+            return true;
+        case ObjectAction::SortLength:
+            list->SortByColumn(5);
+            return true;
+        case ObjectAction::Filter:
+            ShowFilterDialog();
+            return true;
         }
     }
 
@@ -0,0 +1,184 @@
+#include "PCAP.hpp"
+
+using namespace GView::Type::PCAP;
+
+constexpr uint64 MAX_STREAM_SIZE      = 0x10000000; // 256 MB for each direction
+constexpr uint64 MAX_PENDING_SIZE     = 0x1000000;  // out of order data kept while waiting for the missing segments
+constexpr uint64 PROGRESS_UPDATE_MASK = 0x3FF;
+
+TcpStream::TcpStream()
+    : pendingSize(0), initialSequence(0), started(false), segments(0), retransmissions(0), gaps(0), missingBytes(0), truncated(false)
+{
+}
+
+void TcpStream::Append(const uint8* payload, uint32 size)
+{
+    if (data.size() + size > MAX_STREAM_SIZE)
+    {
+        size      = static_cast<uint32>(MAX_STREAM_SIZE - data.size());
+        truncated = true;
+    }
+    data.insert(data.end(), payload, payload + size);
+}
+
+void TcpStream::FillGap(uint64 offset)
+{
+    if (offset <= data.size())
+        return;
+    gaps++;
+    missingBytes += offset - data.size();
+    if (offset > MAX_STREAM_SIZE)
+    {
+        offset    = MAX_STREAM_SIZE;
+        truncated = true;
+    }
+    data.resize(offset, 0);
+}
+
+void TcpStream::Flush()
+{
+    while (!pending.empty() && (pending.begin()->first <= data.size()))
+    {
+        auto it           = pending.begin();
+        const auto offset = it->first;
+        const auto& bytes = it->second;
+        const auto end    = offset + bytes.size();
+        if (end > data.size())
+        {
+            const auto skip = static_cast<uint32>(data.size() - offset);
+            Append(bytes.data() + skip, static_cast<uint32>(bytes.size()) - skip);
+        }
+        else
+        {
+            retransmissions++;
+        }
+        pendingSize -= bytes.size();
+        pending.erase(it);
+    }
+}
+
+void TcpStream::AddSegment(uint32 sequence, uint8 flags, const uint8* payload, uint32 size)
+{
+    if (flags & TCPHeader_Flags::SYN)
+    {
+        // the data of a SYN segment (if any) starts after the SYN
+        sequence++;
+        if (!started)
+        {
+            initialSequence = sequence;
+            started         = true;
+        }
+    }
+    if ((size == 0) || truncated)
+        return;
+    if (!started)
+    {
+        // the capture started in the middle of the conversation
+        initialSequence = sequence;
+        started         = true;
+    }
+    segments++;
+
+    // sequence numbers wrap around: the offset is computed relative to the end of the stream
+    const auto nextSequence = initialSequence + static_cast<uint32>(data.size());
+    const auto offset       = static_cast<int64>(data.size()) + static_cast<int32>(sequence - nextSequence);
+    const auto end          = offset + static_cast<int64>(size);
+    if (end <= static_cast<int64>(data.size()))
+    {
+        retransmissions++;
+        return;
+    }
+    if (offset <= static_cast<int64>(data.size()))
+    {
+        const auto skip = static_cast<uint32>(static_cast<int64>(data.size()) - offset);
+        Append(payload + skip, size - skip);
+        Flush();
+        return;
+    }
+    if (static_cast<uint64>(offset) >= MAX_STREAM_SIZE)
+        return;
+
+    // out of order (or after a segment that was not captured)
+    auto& bytes = pending[static_cast<uint64>(offset)];
+    if (bytes.size() >= size)
+    {
+        retransmissions++;
+        return;
+    }
+    pendingSize += size - bytes.size();
+    bytes.assign(payload, payload + size);
+
+    // memory is bounded: if too much data waits for a missing segment, that segment is considered lost
+    while (pendingSize > MAX_PENDING_SIZE)
+    {
+        FillGap(pending.begin()->first);
+        Flush();
+    }
+}
+
+void TcpStream::Finish()
+{
+    while (!pending.empty())
+    {
+        FillGap(pending.begin()->first);
+        Flush();
+    }
+}
+
+bool PCAPFile::ReassembleTcpFlow(uint32 flowIndex, TcpStream& forward, TcpStream& backward)
+{
+    CHECK(flowIndex < flows.size(), false, "");
+    const auto& flow = flows[flowIndex];
+    CHECK(flow.key.protocol == IP_Protocol::TCP, false, "");
+
+    auto& cache          = obj->GetData();
+    const auto total     = flow.packets[0] + flow.packets[1];
+    auto processed       = 0ULL;
+    TcpStream* streams[] = { &forward, &backward };
+    PacketSummary summary;
+    LocalString<128> ls;
+
+    // only the packets of the flow are read (one at a time)
+    ProgressStatus::Init("Reassembling TCP stream...", total);
+    const auto end = std::min<uint64>(flow.lastPacket + 1, packets.size());
+    for (auto i = flow.firstPacket; (i < end) && (processed < total); i++)
+    {
+        if (packetFlows[i] != flowIndex)
+            continue;
+        processed++;
+
+        // nothing was captured from this packet
+        const auto& packet = packets[i];
+        if (packet.inclLen == 0)
+            continue;
+
+        Buffer buffer;
+        BufferView view = cache.Get(packet.offset, packet.inclLen, true);
+        if (!view.IsValid())
+        {
+            // bigger than the cache
+            buffer = cache.CopyToBuffer(packet.offset, packet.inclLen);
+            view   = buffer;
+        }
+        if (view.IsValid() && ParsePacket(GetLinkType(packet), view.GetData(), static_cast<uint32>(view.GetLength()), summary) &&
+            summary.hasPorts)
+        {
+            // only the captured part of the payload is available (the rest will be a gap)
+            const auto length    = static_cast<uint32>(view.GetLength());
+            const auto captured  = length > summary.payloadOffset ? length - summary.payloadOffset : 0;
+            const auto size      = std::min<uint32>(summary.payloadSize, captured);
+            const auto direction = NormalizeFlowKey(summary.key);
+            streams[direction]->AddSegment(summary.tcpSequence, summary.tcpFlags, view.GetData() + summary.payloadOffset, size);
+        }
+
+        if (((processed & PROGRESS_UPDATE_MASK) == 0) &&
+            ProgressStatus::Update(processed, ls.Format("Reassembling TCP stream (%llu / %llu packets)...", processed, total)))
+        {
+            return false;
+        }
+    }
+
+    forward.Finish();
+    backward.Finish();
+    return true;
+}
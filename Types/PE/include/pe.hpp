@@ -2,6 +2,8 @@
 
 #include "GView.hpp"
 
+#include <unordered_map>
+
 constexpr auto MAX_NR_SECTIONS    = 256;
 constexpr auto MAX_DLL_NAME       = 64;
 constexpr auto MAX_PDB_NAME       = 128;
@@ -111,7 +113,8 @@ namespace Type
                 TLS,
                 Symbols,
                 GoInformation,
-                OpCodes
+                OpCodes,
+                Functions
             };
         };
         class VersionInformation
@@ -683,11 +686,16 @@ namespace Type
                        public GView::View::BufferViewer::PositionToColorInterface
         {
           public:
+            struct NameRef
+            {
+                uint32 offset; // in PEFile::names
+                uint32 size;
+            };
             struct ExportedFunction
             {
                 uint32 RVA;
                 uint16 Ordinal;
-                String Name;
+                NameRef Name;
             };
             struct PEColors
             {
@@ -727,15 +735,24 @@ namespace Type
             {
                 uint64 RVA;
                 uint32 dllIndex;
-                String Name;
+                NameRef Name;
             };
 
             struct SymbolInformation
             {
-                String name; // this can be either short or long name that needs to be located
+                NameRef name; // this can be either short or long name that needs to be located
                 ImageSymbol is;
             };
 
+            struct ImageIntegrity
+            {
+                bool computed{ false };
+                uint32 checksum{ 0 }; // computed over the entire file (the CheckSum field is considered 0)
+                bool hasSignature{ false };
+                bool digestMatches{ false }; // the Authenticode digest of the image is the signed one
+                GView::DigitalSignature::AuthenticodeDigest authenticode;
+            };
+
           public:
             // PE informations
             ImageDOSHeader dos;
@@ -762,6 +779,17 @@ namespace Type
             std::vector<ImportFunctionInformation> impFunc;
             std::vector<SymbolInformation> symbols;
 
+            // all the names of the exports, imports and symbols are stored one after another
+            std::string names;
+            std::vector<NameRef> mangledNames; // added by AddDemangledName (demangled all at once by DemangleNames)
+            std::unordered_map<std::string_view, uint32> exportsByName;
+            std::unordered_map<std::string_view, uint32> importsByName;
+            std::unordered_map<std::string_view, uint32> symbolsByName;
+            std::unordered_map<uint64, uint32> exportsByRVA;
+            std::unordered_map<uint64, uint32> importsByRVA;
+            std::vector<Buffer> sectionsData; // raw data of the sections used by ReadString (released once the file is parsed)
+            ImageIntegrity integrity;
+
             ImageTLSDirectory32 tlsDir;
             PEColors peCols;
             VersionInformation Ver;
@@ -772,6 +800,9 @@ namespace Type
             uint32 showOpcodesMask{ 0 };
             std::vector<std::pair<uint64, uint64>> executableZonesFAs;
             GView::Dissasembly::DissasemblerIntel dissasembler{};
+            GView::Dissasembly::OpcodesCache opcodesCache;
+            GView::Dissasembly::LinearSweepDecoder linearSweep;
+            GView::Dissasembly::FunctionsAnalyzer functionsAnalyzer;
 
             bool hdr64;
             bool isMetroApp;
@@ -779,6 +810,10 @@ namespace Type
             bool hasOverlay;
 
             std::string_view ReadString(uint32 RVA, uint32 maxSize);
+            NameRef AddName(std::string_view name);
+            NameRef AddDemangledName(std::string_view name);
+            void DemangleNames();
+            void BuildNameIndexes();
             bool ReadUnicodeLengthString(uint32 FileAddress, char* text, uint32 maxSize);
 
             // GO
@@ -827,7 +862,24 @@ namespace Type
             bool ParseGoData();
             bool ParseGoBuild();
             bool ParseGoBuildInfo();
-            std::vector<uint64> FindPcLnTabSigsCandidates() const;
+            std::vector<uint64> FindPcLnTabSigsCandidates() const; // file offsets
+
+            bool StartFunctionsAnalysis();
+            bool VerifyImageIntegrity();
+            inline uint32 GetHeaderChecksum() const
+            {
+                return hdr64 ? nth64.OptionalHeader.CheckSum : nth32.OptionalHeader.CheckSum;
+            }
+
+            inline std::string_view GetName(NameRef name) const
+            {
+                return std::string_view{ names }.substr(name.offset, name.size);
+            }
+            bool FindExport(std::string_view name, uint32& index) const;
+            bool FindExportByRVA(uint64 RVA, uint32& index) const;
+            bool FindImport(std::string_view name, uint32& index) const;
+            bool FindImportByRVA(uint64 RVA, uint32& index) const;
+            bool FindSymbol(std::string_view name, uint32& index) const;
 
             bool HasPanel(Panels::IDs id);
 
@@ -838,7 +890,7 @@ namespace Type
             bool LoadIcon(const ResourceInformation& r, Image& img);
 
             bool GetColorForBuffer(uint64 offset, BufferView buf, GView::View::BufferViewer::BufferColor& result) override;
-            bool GetColorForBufferIntel(uint64 offset, BufferView buf, GView::View::BufferViewer::BufferColor& result);
+            bool GetColorForBufferIntel(uint64 offset, GView::View::BufferViewer::BufferColor& result);
 
             std::string_view GetTypeName() override
             {
@@ -913,6 +965,24 @@ namespace Type
                 bool OnUpdateCommandBar(AppCUI::Application::CommandBar& commandBar) override;
                 bool OnEvent(Reference<Control>, Event evnt, int controlID) override;
             };
+            // asks for the name (or the RVA) of an import/export and finds it with the lookups of PEFile
+            class FindDialog : public Window
+            {
+                Reference<GView::Type::PE::PEFile> pe;
+                Reference<AppCUI::Controls::TextField> txName;
+                bool exports;
+                uint32 index;
+                void Validate();
+
+              public:
+                FindDialog(Reference<GView::Type::PE::PEFile> pe, bool exports);
+
+                bool OnEvent(Reference<Control>, Event eventType, int ID) override;
+                inline uint32 GetIndex() const
+                {
+                    return index;
+                }
+            };
             class Imports : public TabPage
             {
                 Reference<GView::Type::PE::PEFile> pe;
@@ -921,11 +991,16 @@ namespace Type
                 Reference<AppCUI::Controls::ListView> info;
                 Reference<AppCUI::Controls::ListView> dlls;
 
+                void GoToImport(uint32 index);
+                void FindImport();
+
               public:
                 Imports(Reference<GView::Type::PE::PEFile> pe, Reference<GView::View::WindowInterface> win);
 
                 void Update();
                 void OnAfterResize(int newWidth, int newHeight) override;
+                bool OnUpdateCommandBar(AppCUI::Application::CommandBar& commandBar) override;
+                bool OnEvent(Reference<Control>, Event evnt, int controlID) override;
             };
             class Exports : public TabPage
             {
@@ -933,6 +1008,8 @@ namespace Type
                 Reference<GView::View::WindowInterface> win;
                 Reference<AppCUI::Controls::ListView> list;
 
+                void FindExport();
+
               public:
                 Exports(Reference<GView::Type::PE::PEFile> pe, Reference<GView::View::WindowInterface> win);
 
@@ -1086,11 +1163,11 @@ namespace Type
                 void OnAfterResize(int newWidth, int newHeight) override;
             };
 
-            class GoFunctions : public AppCUI::Controls::TabPage
+            class GoFunctions : public AppCUI::Controls::TabPage, public GView::View::VirtualListModel
             {
                 Reference<PEFile> pe;
                 Reference<GView::View::WindowInterface> win;
-                Reference<AppCUI::Controls::ListView> list;
+                Reference<GView::View::VirtualList> list;
                 int32 Base;
 
                 std::string_view GetValue(NumericFormatter& n, uint64 value);
@@ -1103,6 +1180,9 @@ namespace Type
                 void Update();
                 bool OnUpdateCommandBar(AppCUI::Application::CommandBar& commandBar) override;
                 bool OnEvent(Reference<Control>, Event evnt, int controlID) override;
+
+                uint64 GetRowsCount() override;
+                void FormatCell(uint64 row, uint32 column, String& text) override;
             };
 
             class OpCodes : public AppCUI::Controls::TabPage
@@ -24,6 +24,9 @@ struct CV_INFO_PDB70
 
 #define ADD_PANEL(id) this->panelsMask |= (1ULL << (uint8) id);
 
+constexpr uint32 PE_MAX_SECTION_READ_SIZE = 0x4000000; // 64 MB (the strings from bigger sections are read one by one)
+constexpr uint32 PE_INTEGRITY_CHUNK_SIZE  = 0x1000000; // 16 MB (a multiple of 4 --> every chunk starts with a whole checksum word)
+
 static std::string_view peDirsNames[15] = { "Export",      "Import",       "Resource",     "Exceptions",        "Security",
                                             "Base Reloc",  "Debug",        "Architecture", "Global Ptr",        "TLS",
                                             "Load Config", "Bound Import", "IAT",          "Delay Import Desc", "COM+ Runtime" };
@@ -259,8 +262,30 @@ PEFile::PEFile()
 
 std::string_view PEFile::ReadString(uint32 RVA, uint32 maxSize)
 {
-    const auto fa = RVAtoFilePointer(RVA);
-    auto buf      = obj->GetData().Get(fa, maxSize, true);
+    // the names of the imports / exports are usually stored one after another in the same section
+    // --> the whole section is read once instead of a small read for every name
+    BufferView buf;
+    const auto index = RVAToSectionIndex(RVA);
+    if (index >= 0)
+    {
+        if (sectionsData.size() < nrSections)
+            sectionsData.resize(nrSections);
+        const auto& section = sect[index];
+        auto& data          = sectionsData[index];
+        auto size           = section.SizeOfRawData;
+        if ((section.Misc.VirtualSize > 0) && (section.Misc.VirtualSize < size))
+            size = section.Misc.VirtualSize;
+        if ((!data.IsValid()) && (size <= PE_MAX_SECTION_READ_SIZE))
+            data = obj->GetData().CopyToBuffer(section.PointerToRawData, size, false);
+
+        const auto offset = RVA - section.VirtualAddress;
+        if (data.IsValid() && (offset < data.GetLength()))
+            buf = BufferView{ data.GetData() + offset, std::min<size_t>(maxSize, data.GetLength() - offset) };
+    }
+    if (!buf.IsValid())
+    {
+        buf = obj->GetData().Get(RVAtoFilePointer(RVA), maxSize, true);
+    }
     if (buf.IsValid() == false || buf.Empty())
     {
         return std::string_view{};
@@ -276,6 +301,147 @@ std::string_view PEFile::ReadString(uint32 RVA, uint32 maxSize)
     return std::string_view{ reinterpret_cast<const char*>(buf.GetData()), static_cast<size_t>(p - buf.GetData()) };
 }
 
+// reads a whole table (at most 'maxSize' bytes, without going past the end of the section that contains it)
+static Buffer CopyTable(PEFile& pe, uint64 RVA, uint64 maxSize)
+{
+    const auto fa = pe.RVAtoFilePointer(RVA);
+    CHECK(fa != PE_INVALID_ADDRESS, Buffer(), "");
+
+    const auto index = pe.RVAToSectionIndex(RVA);
+    if (index >= 0)
+    {
+        const auto sectionEnd = (uint64) pe.sect[index].VirtualAddress + pe.sect[index].SizeOfRawData;
+        if (sectionEnd > RVA)
+            maxSize = std::min<uint64>(maxSize, sectionEnd - RVA);
+    }
+    CHECK(maxSize <= PE_MAX_SECTION_READ_SIZE, Buffer(), "");
+    return pe.obj->GetData().CopyToBuffer(fa, static_cast<uint32>(maxSize), false);
+}
+
+PEFile::NameRef PEFile::AddName(std::string_view name)
+{
+    const NameRef ref{ static_cast<uint32>(names.size()), static_cast<uint32>(name.size()) };
+    names.append(name);
+    return ref;
+}
+
+PEFile::NameRef PEFile::AddDemangledName(std::string_view name)
+{
+    // the name is replaced by its demangled form later (DemangleNames)
+    const auto ref = AddName(name);
+    mangledNames.push_back(ref);
+    return ref;
+}
+
+void PEFile::DemangleNames()
+{
+    CHECKRET(!mangledNames.empty(), "");
+
+    // the views in 'names' are used only by the demangler (the results are in its own arena)
+    std::vector<std::string_view> mangled(mangledNames.size());
+    for (auto i = 0U; i < mangledNames.size(); i++)
+        mangled[i] = GetName(mangledNames[i]);
+
+    GView::Utils::Demangler demangler;
+    std::vector<std::string_view> demangled;
+    CHECKRET(demangler.Demangle(mangled, demangled), "");
+
+    std::unordered_map<uint32, NameRef> replacements; // offset of a mangled name --> its demangled form
+    for (auto i = 0U; i < mangledNames.size(); i++)
+    {
+        if (!demangled[i].empty())
+            replacements.try_emplace(mangledNames[i].offset, AddName(demangled[i]));
+    }
+
+    const auto replace = [&replacements](NameRef& name) {
+        const auto it = replacements.find(name.offset);
+        if (it != replacements.end())
+            name = it->second;
+    };
+    for (auto& e : exp)
+        replace(e.Name);
+    for (auto& f : impFunc)
+        replace(f.Name);
+    for (auto& s : symbols)
+        replace(s.name);
+
+    mangledNames.clear();
+    mangledNames.shrink_to_fit();
+}
+
+void PEFile::BuildNameIndexes()
+{
+    // no name is added after this point --> the views used as keys remain valid
+    exportsByName.clear();
+    exportsByRVA.clear();
+    importsByName.clear();
+    importsByRVA.clear();
+    symbolsByName.clear();
+
+    exportsByName.reserve(exp.size());
+    exportsByRVA.reserve(exp.size());
+    for (auto i = 0U; i < exp.size(); i++)
+    {
+        exportsByName.try_emplace(GetName(exp[i].Name), i);
+        exportsByRVA.try_emplace(exp[i].RVA, i);
+    }
+
+    importsByName.reserve(impFunc.size());
+    importsByRVA.reserve(impFunc.size());
+    for (auto i = 0U; i < impFunc.size(); i++)
+    {
+        importsByName.try_emplace(GetName(impFunc[i].Name), i);
+        importsByRVA.try_emplace(impFunc[i].RVA, i);
+    }
+
+    symbolsByName.reserve(symbols.size());
+    for (auto i = 0U; i < symbols.size(); i++)
+        symbolsByName.try_emplace(GetName(symbols[i].name), i);
+}
+
+static bool FindName(const std::unordered_map<std::string_view, uint32>& index, std::string_view name, uint32& result)
+{
+    const auto it = index.find(name);
+    if (it == index.end())
+        return false;
+    result = it->second;
+    return true;
+}
+
+static bool FindRVA(const std::unordered_map<uint64, uint32>& index, uint64 RVA, uint32& result)
+{
+    const auto it = index.find(RVA);
+    if (it == index.end())
+        return false;
+    result = it->second;
+    return true;
+}
+
+bool PEFile::FindExport(std::string_view name, uint32& index) const
+{
+    return FindName(exportsByName, name, index);
+}
+
+bool PEFile::FindExportByRVA(uint64 RVA, uint32& index) const
+{
+    return FindRVA(exportsByRVA, RVA, index);
+}
+
+bool PEFile::FindImport(std::string_view name, uint32& index) const
+{
+    return FindName(importsByName, name, index);
+}
+
+bool PEFile::FindImportByRVA(uint64 RVA, uint32& index) const
+{
+    return FindRVA(importsByRVA, RVA, index);
+}
+
+bool PEFile::FindSymbol(std::string_view name, uint32& index) const
+{
+    return FindName(symbolsByName, name, index);
+}
+
 bool PEFile::ReadUnicodeLengthString(uint32 FileAddress, char* text, uint32 maxSize)
 {
     uint16 sz, tr;
@@ -607,30 +773,47 @@ bool PEFile::BuildExport()
         return false;
     }
 
+    // the three tables are read at once (one read for each table instead of three reads for every export)
+    const auto functionsTable = CopyTable(*this, exportDir.AddressOfFunctions, exportDir.NumberOfFunctions * 4ULL);
+    const auto namesTable     = CopyTable(*this, exportDir.AddressOfNames, exportDir.NumberOfNames * 4ULL);
+    const auto ordinalsTable  = CopyTable(*this, exportDir.AddressOfNameOrdinals, exportDir.NumberOfNames * 2ULL);
+    if ((exportDir.NumberOfFunctions > 0) &&
+        ((!functionsTable.IsValid()) || (functionsTable.GetLength() < exportDir.NumberOfFunctions * 4ULL)))
+    {
+        errList.AddError("Unable to read export function address");
+        return false;
+    }
+    if ((exportDir.NumberOfNames > 0) && ((!namesTable.IsValid()) || (namesTable.GetLength() < exportDir.NumberOfNames * 4ULL)))
+    {
+        errList.AddError("Unable to read export function name");
+        return false;
+    }
+    if ((exportDir.NumberOfNames > 0) && ((!ordinalsTable.IsValid()) || (ordinalsTable.GetLength() < exportDir.NumberOfNames * 2ULL)))
+    {
+        errList.AddError("Unable to read export function ordinal");
+        return false;
+    }
+    const auto functionsRVAs = reinterpret_cast<const uint32*>(functionsTable.GetData());
+    const auto namesRVAs     = reinterpret_cast<const uint32*>(namesTable.GetData());
+    const auto namesOrdinals = reinterpret_cast<const uint16*>(ordinalsTable.GetData());
+
     if (exportDir.NumberOfNames < exportDir.NumberOfFunctions)
     {
         ordinals.resize(exportDir.NumberOfFunctions);
         for (uint32 tr = 0; tr < exportDir.NumberOfFunctions; tr++)
             ordinals[tr] = false;
     }
-    for (uint32 tr = 0; tr < exportDir.NumberOfNames; tr++, naddr += 4, oaddr += 2)
+    exp.reserve(std::max<size_t>(exportDir.NumberOfNames, exportDir.NumberOfFunctions));
+    for (uint32 tr = 0; tr < exportDir.NumberOfNames; tr++)
     {
-        if (obj->GetData().Copy<uint32>(naddr, RVA) == false)
-        {
-            errList.AddError("Unable to read export function name");
-            return false;
-        }
-        if (obj->GetData().Copy<uint16>(oaddr, exportOrdinal) == false)
-        {
-            errList.AddError("Unable to read export function ordinal");
-            return false;
-        }
-        if (obj->GetData().Copy<uint32>(faddr + ((uint64) exportOrdinal) * 4, export_RVA) == false)
+        exportOrdinal = namesOrdinals[tr];
+        if (exportOrdinal >= exportDir.NumberOfFunctions)
         {
             errList.AddError("Unable to read export function address");
             return false;
         }
-        auto exportName = ReadString(RVA, MAX_EXPORTFNC_SIZE);
+        export_RVA      = functionsRVAs[exportOrdinal];
+        auto exportName = ReadString(namesRVAs[tr], MAX_EXPORTFNC_SIZE);
         if (exportName.empty())
         {
             errList.AddError("Unable to read export function name");
@@ -646,10 +829,7 @@ bool PEFile::BuildExport()
         auto& item   = exp.emplace_back();
         item.RVA     = export_RVA;
         item.Ordinal = exportOrdinal;
-        if (GView::Utils::Demangle(exportName, item.Name) == false)
-        {
-            item.Name.Set(exportName.data(), (uint32) exportName.size());
-        }
+        item.Name    = AddDemangledName(exportName);
     }
 
     // adaug si ordinalii
@@ -660,11 +840,7 @@ bool PEFile::BuildExport()
         {
             if (ordinals[tr] == false)
             {
-                if (obj->GetData().Copy<uint32>(faddr + ((uint64) tr) * 4, export_RVA) == false)
-                {
-                    errList.AddError("Unable to read export function ordinal ID");
-                    return false;
-                }
+                export_RVA = functionsRVAs[tr];
                 if (export_RVA > 0)
                 {
                     exportOrdinal = tr;
@@ -676,7 +852,7 @@ bool PEFile::BuildExport()
                     auto& item   = exp.emplace_back();
                     item.RVA     = export_RVA;
                     item.Ordinal = exportOrdinal;
-                    item.Name.Set(ordinal_name.GetText(), ordinal_name.Len());
+                    item.Name    = AddName(ordinal_name.ToStringView());
                 }
             }
         }
@@ -1028,16 +1204,13 @@ bool PEFile::BuildResources()
 bool PEFile::BuildImportDLLFunctions(uint32_t index, ImageImportDescriptor* impD)
 {
     uint64 addr, IATaddr;
-    ImageThunkData32 rvaFName32;
-    ImageThunkData64 rvaFName64;
     LocalString<64> tempStr;
-    uint32 count_f = 0;
 
     if (impD->OriginalFirstThunk == 0)
-        addr = RVAtoFilePointer(impD->FirstThunk);
+        addr = impD->FirstThunk;
     else
-        addr = RVAtoFilePointer(impD->OriginalFirstThunk);
-    if (addr == PE_INVALID_ADDRESS)
+        addr = impD->OriginalFirstThunk;
+    if (RVAtoFilePointer(addr) == PE_INVALID_ADDRESS)
     {
         errList.AddError("Invalid RVA for OriginalFirstThunk (0x%X)", (uint32_t) impD->OriginalFirstThunk);
         return false;
@@ -1050,77 +1223,51 @@ bool PEFile::BuildImportDLLFunctions(uint32_t index, ImageImportDescriptor* impD
         return false;
     }
 
+    // the thunks are read at once (the table ends with a null thunk or at the end of its section)
+    const auto thunkSize   = hdr64 ? sizeof(ImageThunkData64) : sizeof(ImageThunkData32);
+    const auto ordinalFlag = hdr64 ? (uint64) __IMAGE_ORDINAL_FLAG64 : (uint64) __IMAGE_ORDINAL_FLAG32;
+    const auto thunks      = CopyTable(*this, addr, (MAX_IMPORTED_FUNCTIONS + 1ULL) * thunkSize);
+    if (!thunks.IsValid())
+    {
+        errList.AddError("Unable to read the thunks from RVA (0x%X)", (uint32_t) addr);
+        return false;
+    }
+
     std::string_view importName;
-    if (hdr64)
+    const auto thunksCount = thunks.GetLength() / thunkSize;
+    for (auto tr = 0U; tr < thunksCount; tr++, IATaddr += thunkSize)
     {
-        while ((obj->GetData().Copy<ImageThunkData64>(addr, rvaFName64)) && (rvaFName64.u1.AddressOfData != 0) &&
-               (count_f < MAX_IMPORTED_FUNCTIONS))
+        const uint64 value = hdr64 ? reinterpret_cast<const ImageThunkData64*>(thunks.GetData())[tr].u1.AddressOfData
+                                   : reinterpret_cast<const ImageThunkData32*>(thunks.GetData())[tr].u1.AddressOfData;
+        if (value == 0)
+            break;
+        if (tr >= MAX_IMPORTED_FUNCTIONS)
         {
-            if ((rvaFName64.u1.AddressOfData & __IMAGE_ORDINAL_FLAG64) != 0) // imported by ordinal
-            {
-                tempStr.SetFormat("Ordinal:%u", (rvaFName64.u1.Ordinal - __IMAGE_ORDINAL_FLAG64));
-                importName = tempStr.ToStringView();
-            }
-            else
-            {
-                importName = ReadString((uint32_t) (rvaFName64.u1.AddressOfData + 2), MAX_IMPORTFNC_SIZE);
-                if (importName.empty())
-                {
-                    errList.AddError("Invalid RVA import name (0x%X)", (uint32_t) rvaFName64.u1.AddressOfData + 2);
-                    return false;
-                }
-            }
-
-            auto& item = impFunc.emplace_back();
-            if (GView::Utils::Demangle(importName.data(), item.Name) == false)
-            {
-                item.Name = importName.data();
-            }
+            errList.AddError("Too many imported functions (0x%X)", tr);
+            return false;
+        }
 
-            item.dllIndex = index;
-            item.RVA      = IATaddr;
-            count_f++;
-            addr += sizeof(ImageThunkData64);
-            IATaddr += sizeof(ImageThunkData64);
+        NameRef name;
+        if ((value & ordinalFlag) != 0) // imported by ordinal
+        {
+            tempStr.SetFormat("Ordinal:%u", (uint32_t) (value - ordinalFlag));
+            name = AddName(tempStr.ToStringView());
         }
-    }
-    else
-    {
-        while ((obj->GetData().Copy<ImageThunkData32>(addr, rvaFName32)) && (rvaFName32.u1.AddressOfData != 0) &&
-               (count_f < MAX_IMPORTED_FUNCTIONS))
+        else
         {
-            if ((rvaFName32.u1.AddressOfData & __IMAGE_ORDINAL_FLAG32) != 0) // avem functie importata prin ordinal:
+            importName = ReadString((uint32_t) (value + 2), MAX_IMPORTFNC_SIZE);
+            if (importName.empty())
             {
-                tempStr.SetFormat("Ordinal:%u", (rvaFName32.u1.Ordinal - __IMAGE_ORDINAL_FLAG32));
-                importName = tempStr.ToStringView();
+                errList.AddError("Invalid RVA import name (0x%X)", (uint32_t) value + 2);
+                return false;
             }
-            else
-            {
-                importName = ReadString(rvaFName32.u1.AddressOfData + 2, MAX_IMPORTFNC_SIZE);
-                if (importName.empty())
-                {
-                    errList.AddError("Invalid RVA import name (0x%X)", (uint32_t) rvaFName32.u1.AddressOfData + 2);
-                    return false;
-                }
-            }
-
-            auto& item = impFunc.emplace_back();
-            if (GView::Utils::Demangle(importName.data(), item.Name) == false)
-            {
-                item.Name = importName.data();
-            }
-
-            item.dllIndex = index;
-            item.RVA      = IATaddr;
-            count_f++;
-            addr += sizeof(ImageThunkData32);
-            IATaddr += sizeof(ImageThunkData32);
+            name = AddDemangledName(importName);
         }
-    }
-    if (count_f >= MAX_IMPORTED_FUNCTIONS)
-    {
-        errList.AddError("Too many imported functions (0x%X)", (uint32_t) rvaFName32.u1.AddressOfData + 2);
-        return false;
+
+        auto& item    = impFunc.emplace_back();
+        item.Name     = name;
+        item.dllIndex = index;
+        item.RVA      = IATaddr;
     }
     return true;
 }
@@ -1396,6 +1543,7 @@ bool PEFile::Update()
     LocalString<128> tempStr;
 
     errList.Clear();
+    names.clear();
     isMetroApp       = false;
     this->panelsMask = 0;
     if (!obj->GetData().Copy<ImageDOSHeader>(0, dos))
@@ -1544,6 +1692,7 @@ bool PEFile::Update()
     BuildResources();   // cu erori setate
     BuildExport();      // cu erori setate
     BuildImport();      // cu erori setate
+    sectionsData.clear();
     BuildVersionInfo(); // cu erori setate
     BuildTLS();
     BuildDebugData();
@@ -1699,9 +1848,13 @@ bool PEFile::Update()
     switch ((PE::MachineType) nth32.FileHeader.Machine)
     {
     case PE::MachineType::I386:
-    case PE::MachineType::IA64:
     case PE::MachineType::AMD64:
         ADD_PANEL(Panels::IDs::OpCodes);
+        ADD_PANEL(Panels::IDs::Functions); // only x86/x64 code is analyzed
+        break;
+    case PE::MachineType::IA64:
+        ADD_PANEL(Panels::IDs::OpCodes);
+        break;
     default:
         break;
     }
@@ -1743,11 +1896,16 @@ bool PEFile::Update()
         }
     }
 
+    DemangleNames();
+    BuildNameIndexes();
+
     if (ParseGoData())
     {
         ADD_PANEL(Panels::IDs::GoInformation);
     }
 
+    VerifyImageIntegrity();
+
     return true;
 }
 
@@ -1782,6 +1940,7 @@ bool PEFile::BuildSymbols()
     const auto stringsBuffer = this->obj->GetData().CopyToBuffer(strTableOffset, strTableSize);
     CHECK(stringsBuffer.IsValid(), false, "");
 
+    String demangled, fullName;
     this->symbols.reserve(symbolsNo);
     for (decltype(symbolsNo) i = 0ULL; i < symbolsNo; i++)
     {
@@ -1796,7 +1955,8 @@ bool PEFile::BuildSymbols()
 
         if (is->N.Name.Short != 0)
         {
-            CHECK(s.name.Set((char*) is->N.ShortName, sizeof(is->N.ShortName) / sizeof(is->N.ShortName[0])), false, "");
+            const auto shortName = std::string_view{ (char*) is->N.ShortName, sizeof(is->N.ShortName) / sizeof(is->N.ShortName[0]) };
+            s.name               = AddName(shortName.substr(0, shortName.find('\0')));
         }
         else if (is->N.Name.Long >= sizeof(strTableSize) && is->N.Name.Long < strTableSize)
         {
@@ -1805,19 +1965,19 @@ bool PEFile::BuildSymbols()
             if (dolarPos != std::string::npos)
             {
                 const auto fname = std::string_view{ name.data() + dolarPos + 1, name.size() - 1 - dolarPos };
-                String sName;
-                if (GView::Utils::Demangle(fname.data(), sName))
+                if (GView::Utils::Demangle(fname, demangled))
                 {
-                    s.name.Format("[%.*s]: %s", dolarPos, name.data(), sName.GetText());
+                    fullName.Format("[%.*s]: %s", (int32) dolarPos, name.data(), demangled.GetText());
                 }
                 else
                 {
-                    s.name.Format("[%.*s]: %.*s", dolarPos, name.data(), name.size() - dolarPos + 1, name.data() + dolarPos + 1);
+                    fullName.Format("[%.*s]: %.*s", (int32) dolarPos, name.data(), (int32) fname.size(), fname.data());
                 }
+                s.name = AddName(fullName.ToStringView());
             }
-            else if (GView::Utils::Demangle(name.data(), s.name) == false)
+            else
             {
-                s.name = name.data();
+                s.name = AddDemangledName(name);
             }
         }
     }
@@ -1837,14 +1997,12 @@ bool PEFile::ParseGoData()
             { "runtime.pclntab", { 0 } }, { "runtime.epclntab", { 0 } }, { "pclntab", { 0 } }, { "epclntab", { 0 } }
         };
 
-        for (const auto& symbol : symbols)
+        for (auto& [pclntabSymbol, value] : pclntabSymbols)
         {
-            for (auto& [pclntabSymbol, value] : pclntabSymbols)
+            uint32 index = 0;
+            if (FindSymbol(pclntabSymbol, index))
             {
-                if (symbol.name.Equals(pclntabSymbol.data()))
-                {
-                    value = symbol.is;
-                }
+                value = symbols[index].is;
             }
         }
 
@@ -1868,19 +2026,23 @@ bool PEFile::ParseGoData()
         }
     }
 
-    // parse raw
-    const auto pcLnTabSigsCandidates = FindPcLnTabSigsCandidates();
-    CHECK(pcLnTabSigsCandidates.empty() == false, false, "");
-
-    bool found = false;
-    for (const auto& candidatesVA : pcLnTabSigsCandidates)
+    // parse raw: only the header of a candidate is read, the whole table is read for the first valid one
+    const auto arch = hdr64 ? Golang::Architecture::x64 : Golang::Architecture::x86;
+    for (const auto fa : FindPcLnTabSigsCandidates())
     {
-        const auto cacheSize = obj->GetData().GetCacheSize();
-        const auto fa        = VAtoFA(candidatesVA);
-        const auto fileView  = obj->GetData().CopyToBuffer(fa, cacheSize, false);
-        if (pcLnTab.Process(fileView, hdr64 ? Golang::Architecture::x64 : Golang::Architecture::x86))
+        if (!Golang::IsValidPcLnTabHeader(obj->GetData().Get(fa, Golang::PCLNTAB_HEADER_MAX_SIZE, false), arch))
+            continue;
+
+        for (auto i = 0U; i < nrSections; i++)
         {
-            return true;
+            const uint64 start = sect[i].PointerToRawData;
+            const uint64 end   = start + sect[i].SizeOfRawData;
+            if ((fa >= start) && (fa < end))
+            {
+                if (pcLnTab.Process(obj->GetData().CopyToBuffer(fa, static_cast<uint32>(end - fa), false), arch))
+                    return true;
+                break;
+            }
         }
     }
 
@@ -2014,156 +2176,100 @@ bool PEFile::ParseGoBuildInfo()
 
 std::vector<uint64> PEFile::FindPcLnTabSigsCandidates() const
 {
-    constexpr std::string_view pclntabSigs[6]{ { "\xFB\xFF\xFF\xFF\x00\x00", 6 }, { "\xFA\xFF\xFF\xFF\x00\x00", 6 },
-                                               { "\xF0\xFF\xFF\xFF\x00\x00", 6 }, { "\xFF\xFF\xFF\xFB\x00\x00", 6 },
-                                               { "\xFF\xFF\xFF\xFA\x00\x00", 6 }, { "\xFF\xFF\xFF\xF0\x00\x00", 6 } };
-
-    std::vector<uint64> indexes;
-    indexes.reserve(10); // usually not that many sigs found matching
-
+    std::vector<std::pair<uint64, uint64>> ranges;
+    ranges.reserve(nrSections);
     for (uint32 i = 0; i < nrSections; i++)
     {
-        const auto sectionBuffer = obj->GetData().CopyToBuffer(sect[i].PointerToRawData, sect[i].SizeOfRawData);
-        CHECK(sectionBuffer.IsValid(), indexes, "");
-        const auto section = std::string_view{ reinterpret_cast<char*>(sectionBuffer.GetData()), sectionBuffer.GetLength() };
-
-        for (const auto& sig : pclntabSigs)
-        {
-            uint64 index = 0;
-            while ((index = section.find(sig, index)) != std::string::npos)
-            {
-                if (index != std::string::npos && index < sect[i].SizeOfRawData)
-                {
-                    indexes.push_back(index + sect[i].VirtualAddress + imageBase);
-                }
-                index += sig.size();
-            }
-        }
+        ranges.emplace_back(sect[i].PointerToRawData, (uint64) sect[i].PointerToRawData + sect[i].SizeOfRawData);
     }
 
-    return indexes;
+    return Golang::FindPcLnTabSigsCandidates(obj->GetData(), ranges);
 }
 
-bool PEFile::GetColorForBufferIntel(uint64 offset, BufferView buf, GView::View::BufferViewer::BufferColor& result)
+bool PEFile::StartFunctionsAnalysis()
 {
-    CHECK(dissasembler.Init(hdr64, true), false, "");
-
-    static auto previousOpcodeMask = showOpcodesMask;
-    static std::map<uint64, GView::View::BufferViewer::BufferColor> cacheBuffer{};
-    static std::map<uint64, bool> cacheDiscard{};
-
-    if (previousOpcodeMask != showOpcodesMask)
-    {
-        cacheBuffer.clear();
-        cacheDiscard.clear();
-        previousOpcodeMask = showOpcodesMask;
-    }
-
-    if (cacheBuffer.count(offset) > 0)
-    {
-        result = cacheBuffer.at(offset);
+    if (functionsAnalyzer.IsStarted())
         return true;
-    }
 
-    if (cacheDiscard.count(offset) > 0)
+    // known functions first: their names are kept (the others are found by following the calls)
+    functionsAnalyzer.AddEntryPoint(imageBase + rvaEntryPoint, "EntryPoint");
+    for (const auto& e : exp)
+        functionsAnalyzer.AddEntryPoint(imageBase + e.RVA, GetName(e.Name));
+    for (const auto& symbol : symbols)
     {
-        return false;
-    }
-
-    GView::Dissasembly::Instruction ins{ 0 };
-    CHECK(dissasembler.DissasembleInstruction(buf, offset, ins), false, "");
-
-    if (((showOpcodesMask & (uint32) GView::Dissasembly::Opcodes::Call) == (uint32) GView::Dissasembly::Opcodes::Call))
-    {
-        if (dissasembler.IsCallInstruction(ins))
+        const auto& is = symbol.is;
+        if ((is.Type == SYM_FUNCTION) && (is.SectionNumber > 0) && (static_cast<uint32>(is.SectionNumber) <= nrSections))
         {
-            result.start        = offset;
-            result.end          = offset + ins.size;
-            result.color        = INS_CALL_COLOR;
-            cacheBuffer[offset] = result;
-            return true;
+            const auto address = imageBase + sect[is.SectionNumber - 1].VirtualAddress + is.Value;
+            functionsAnalyzer.AddEntryPoint(address, GetName(symbol.name));
         }
     }
-
-    if (((showOpcodesMask & (uint32) GView::Dissasembly::Opcodes::LCall) == (uint32) GView::Dissasembly::Opcodes::LCall))
+    const auto goFunctionsCount = pcLnTab.GetFunctionsCount();
+    for (auto i = 0ULL; i < goFunctionsCount; i++)
     {
-        if (dissasembler.IsLCallInstruction(ins))
-        {
-            result.start        = offset;
-            result.end          = offset + ins.size;
-            result.color        = INS_LCALL_COLOR;
-            cacheBuffer[offset] = result;
-            return true;
-        }
+        Golang::Function f{};
+        if (pcLnTab.GetFunction(i, f))
+            functionsAnalyzer.AddEntryPoint(f.func.entry, f.name != nullptr ? f.name : "");
     }
 
-    if (((showOpcodesMask & (uint32) GView::Dissasembly::Opcodes::Jmp) == (uint32) GView::Dissasembly::Opcodes::Jmp))
+    std::vector<GView::Dissasembly::ExecutableZone> zones;
+    for (auto i = 0U; i < nrSections; i++)
     {
-        if (dissasembler.IsJmpInstruction(ins))
-        {
-            result.start        = offset;
-            result.end          = offset + ins.size;
-            result.color        = INS_JUMP_COLOR;
-            cacheBuffer[offset] = result;
-            return true;
-        }
+        const auto& section = sect[i];
+        if ((section.Characteristics & __IMAGE_SCN_MEM_EXECUTE) == __IMAGE_SCN_MEM_EXECUTE)
+            zones.push_back({ section.PointerToRawData, section.SizeOfRawData, imageBase + section.VirtualAddress });
     }
 
-    if (((showOpcodesMask & (uint32) GView::Dissasembly::Opcodes::LJmp) == (uint32) GView::Dissasembly::Opcodes::LJmp))
-    {
-        if (dissasembler.IsLJmpInstruction(ins))
-        {
-            result.start        = offset;
-            result.end          = offset + ins.size;
-            result.color        = INS_LJUMP_COLOR;
-            cacheBuffer[offset] = result;
-            return true;
-        }
-    }
+    return functionsAnalyzer.Start(obj->GetData(), zones, hdr64, true);
+}
 
-    if (((showOpcodesMask & (uint32) GView::Dissasembly::Opcodes::Breakpoint) == (uint32) GView::Dissasembly::Opcodes::Breakpoint))
-    {
-        if (dissasembler.IsBreakpointInstruction(ins))
-        {
-            result.start        = offset;
-            result.end          = offset + ins.size;
-            result.color        = INS_BREAKPOINT_COLOR;
-            cacheBuffer[offset] = result;
-            return true;
-        }
-    }
+bool PEFile::GetColorForBufferIntel(uint64 offset, GView::View::BufferViewer::BufferColor& result)
+{
+    CHECK(dissasembler.Init(hdr64, true), false, "");
 
-    if (((showOpcodesMask & (uint32) GView::Dissasembly::Opcodes::FunctionStart) == (uint32) GView::Dissasembly::Opcodes::FunctionStart))
-    {
-        GView::Dissasembly::Instruction ins2{ 0 };
-        const auto offset2 = offset + ins.size;
-        CHECK(dissasembler.DissasembleInstruction({ buf.GetData() + ins.size, buf.GetLength() - ins.size }, offset2, ins2), false, "");
+    if (!linearSweep.IsStarted())
+        linearSweep.Start(obj->GetData(), executableZonesFAs, hdr64, true);
 
-        if (dissasembler.AreFunctionStartInstructions(ins, ins2))
-        {
-            result.start        = offset;
-            result.end          = offset + ins.size + ins2.size;
-            result.color        = START_FUNCTION_COLOR;
-            cacheBuffer[offset] = result;
-            return true;
-        }
+    // once the background linear sweep is done only the real instruction starts are highlighted; until then (or outside the
+    // decoded zones) the whole page that contains 'offset' is decoded once (the mask is applied here, so it can change freely)
+    uint32 type = 0;
+    uint32 size = 0;
+    if (!linearSweep.GetInstruction(offset, type, size))
+    {
+        CHECK(opcodesCache.Get(dissasembler, obj->GetData(), offset, type, size), false, "");
     }
+    CHECK((showOpcodesMask & type) != 0, false, "");
 
-    if (((showOpcodesMask & (uint32) GView::Dissasembly::Opcodes::FunctionEnd) == (uint32) GView::Dissasembly::Opcodes::FunctionEnd))
+    switch (static_cast<GView::Dissasembly::Opcodes>(type))
     {
-        if (dissasembler.IsFunctionEndInstruction(ins))
-        {
-            result.start        = offset;
-            result.end          = offset + ins.size;
-            result.color        = END_FUNCTION_COLOR;
-            cacheBuffer[offset] = result;
-            return true;
-        }
+    case GView::Dissasembly::Opcodes::Call:
+        result.color = INS_CALL_COLOR;
+        break;
+    case GView::Dissasembly::Opcodes::LCall:
+        result.color = INS_LCALL_COLOR;
+        break;
+    case GView::Dissasembly::Opcodes::Jmp:
+        result.color = INS_JUMP_COLOR;
+        break;
+    case GView::Dissasembly::Opcodes::LJmp:
+        result.color = INS_LJUMP_COLOR;
+        break;
+    case GView::Dissasembly::Opcodes::Breakpoint:
+        result.color = INS_BREAKPOINT_COLOR;
+        break;
+    case GView::Dissasembly::Opcodes::FunctionStart:
+        result.color = START_FUNCTION_COLOR;
+        break;
+    case GView::Dissasembly::Opcodes::FunctionEnd:
+        result.color = END_FUNCTION_COLOR;
+        break;
+    default:
+        return false;
     }
 
-    cacheDiscard[offset] = false;
-
-    return false;
+    result.start = offset;
+    result.end   = offset + size;
+    return true;
 }
 
 bool PEFile::GetColorForBuffer(uint64 offset, BufferView buf, GView::View::BufferViewer::BufferColor& result)
@@ -2215,7 +2321,7 @@ bool PEFile::GetColorForBuffer(uint64 offset, BufferView buf, GView::View::Buffe
             {
                 if (offset >= start && offset < end)
                 {
-                    return GetColorForBufferIntel(offset, buf, result);
+                    return GetColorForBufferIntel(offset, result);
                 }
             }
             break;
@@ -2227,10 +2333,180 @@ bool PEFile::GetColorForBuffer(uint64 offset, BufferView buf, GView::View::Buffe
     return false;
 }
 
+// the CheckSum is a sum of 16 bit words with the carries folded back --> the 32 bit words can be added and folded at the end
+static uint64 ChecksumSum(BufferView data)
+{
+    uint64 sum        = 0;
+    const auto* p     = data.GetData();
+    const auto length = data.GetLength();
+    size_t index      = 0;
+    for (; index + sizeof(uint32) <= length; index += sizeof(uint32))
+    {
+        uint32 value;
+        memcpy(&value, p + index, sizeof(value));
+        sum += value;
+    }
+    for (; index < length; index++)
+        sum += static_cast<uint64>(p[index]) << ((index & 3) * 8);
+    return sum;
+}
+
+// adds the bytes from [offset, end) of the chunk to the digest, except for the excluded ranges (sorted)
+static void DigestChunk(
+      Hashes::OpenSSLHash& hash, BufferView chunk, uint64 offset, uint64 end, const std::pair<uint64, uint64> (&excluded)[2])
+{
+    const auto chunkEnd = std::min<uint64>(offset + chunk.GetLength(), end);
+    const auto add      = [&](uint64 from, uint64 to)
+    {
+        if (to > from)
+            hash.Update(chunk.GetData() + (from - offset), static_cast<uint32>(to - from));
+    };
+
+    auto position = offset;
+    for (const auto& [start, stop] : excluded)
+    {
+        add(position, std::min<uint64>(start, chunkEnd));
+        position = std::max<uint64>(position, stop);
+    }
+    add(position, chunkEnd);
+}
+
+bool PEFile::VerifyImageIntegrity()
+{
+    auto& cache               = obj->GetData();
+    const auto fileSize       = cache.GetSize();
+    integrity.computed        = false;
+    integrity.hasSignature    = false;
+    integrity.digestMatches   = false;
+    const auto& securityEntry = GetDirectory(DirectoryType::Security);
+    CHECK(fileSize > 0, false, "");
+
+    // the signature (at the end of the file) is not part of the digest
+    auto digestEnd = fileSize;
+    if ((securityEntry.VirtualAddress > 0) && (static_cast<uint64>(securityEntry.VirtualAddress) + securityEntry.Size <= fileSize))
+    {
+        WinCertificate cert{};
+        if (cache.Copy<WinCertificate>(securityEntry.VirtualAddress, cert) && (cert.wCertificateType == __WIN_CERT_TYPE_PKCS_SIGNED_DATA) &&
+            (cert.dwLength > offsetof(WinCertificate, bCertificate)) && (cert.dwLength <= securityEntry.Size))
+        {
+            const auto signature = cache.CopyToBuffer(
+                  securityEntry.VirtualAddress + offsetof(WinCertificate, bCertificate),
+                  cert.dwLength - static_cast<uint32>(offsetof(WinCertificate, bCertificate)));
+            integrity.hasSignature = signature.IsValid() && DigitalSignature::AuthenticodeToDigest(signature, integrity.authenticode);
+            digestEnd              = securityEntry.VirtualAddress;
+        }
+    }
+    if ((GetHeaderChecksum() == 0) && (!integrity.hasSignature))
+        return true; // nothing to verify
+
+    // neither the digest nor the CheckSum include the CheckSum field and the digest does not include the security directory entry
+    const auto checksumOffset = dos.e_lfanew + (hdr64 ? offsetof(ImageNTHeaders64, OptionalHeader.CheckSum)
+                                                      : offsetof(ImageNTHeaders32, OptionalHeader.CheckSum));
+    const auto securityOffset = dos.e_lfanew +
+                                (hdr64 ? offsetof(ImageNTHeaders64, OptionalHeader.DataDirectory)
+                                       : offsetof(ImageNTHeaders32, OptionalHeader.DataDirectory)) +
+                                (uint8) DirectoryType::Security * sizeof(ImageDataDirectory);
+    const std::pair<uint64, uint64> excluded[2] = { { checksumOffset, checksumOffset + sizeof(uint32) },
+                                                    { securityOffset, securityOffset + sizeof(ImageDataDirectory) } };
+
+    std::unique_ptr<Hashes::OpenSSLHash> hash;
+    if (integrity.hasSignature)
+        hash = std::make_unique<Hashes::OpenSSLHash>(integrity.authenticode.kind);
+
+    // the file is read one chunk at a time: the digest, the CheckSum and the read of the next chunk run in parallel
+    uint64 sum   = 0;
+    auto current = cache.CopyUncached(0, static_cast<uint32>(std::min<uint64>(PE_INTEGRITY_CHUNK_SIZE, fileSize)));
+    for (uint64 offset = 0; offset < fileSize;)
+    {
+        CHECK(current.IsValid(), false, "Unable to read the file from offset %llu", offset);
+        const auto next = offset + current.GetLength();
+        Buffer following;
+        GView::Utils::ParallelFor(
+              3,
+              [&](uint32 task)
+              {
+                  switch (task)
+                  {
+                  case 0:
+                      if (hash && (offset < digestEnd))
+                          DigestChunk(*hash, current, offset, digestEnd, excluded);
+                      break;
+                  case 1:
+                      sum += ChecksumSum(current);
+                      for (auto position = checksumOffset; position < checksumOffset + sizeof(uint32); position++)
+                      {
+                          if ((position >= offset) && (position < next))
+                              sum -= static_cast<uint64>(current.GetData()[position - offset]) << ((position & 3) * 8);
+                      }
+                      break;
+                  case 2:
+                      if (next < fileSize)
+                          following =
+                                cache.CopyUncached(next, static_cast<uint32>(std::min<uint64>(PE_INTEGRITY_CHUNK_SIZE, fileSize - next)));
+                      break;
+                  }
+              });
+        offset  = next;
+        current = std::move(following);
+    }
+
+    while (sum >> 16)
+        sum = (sum & 0xFFFF) + (sum >> 16);
+    integrity.checksum = static_cast<uint32>(sum + fileSize);
+    integrity.computed = true;
+    if ((GetHeaderChecksum() != 0) && (GetHeaderChecksum() != integrity.checksum))
+    {
+        errList.AddWarning("CheckSum (0x%08X) is different from the computed one (0x%08X)", GetHeaderChecksum(), integrity.checksum);
+    }
+
+    if (hash)
+    {
+        CHECK(hash->Final(), false, "");
+        integrity.digestMatches = (hash->GetSize() == integrity.authenticode.digestSize) &&
+                                  (memcmp(hash->Get(), integrity.authenticode.digest, integrity.authenticode.digestSize) == 0);
+        if (!integrity.digestMatches)
+        {
+            errList.AddError("The Authenticode digest does not match the image (the file was modified after it was signed)");
+        }
+        if (!integrity.authenticode.signatureVerified)
+        {
+            errList.AddError("The Authenticode signature is not valid (%s)", integrity.authenticode.errorMessage.GetText());
+        }
+    }
+
+    return true;
+}
+
 void PEFile::RunCommand(std::string_view commandName)
 {
     if (commandName == "CheckSignature")
     {
-        AppCUI::Dialogs::MessageBox::ShowError("Error", "This need to be implemented !");
+        LocalString<512> message;
+        if (!integrity.computed)
+        {
+            message.Set("Neither a CheckSum nor an Authenticode signature to verify !");
+        }
+        else
+        {
+            if (GetHeaderChecksum() == 0)
+                message.SetFormat("CheckSum: not set (computed: 0x%08X)\n", integrity.checksum);
+            else
+                message.SetFormat(
+                      "CheckSum: 0x%08X (%s)\n", integrity.checksum, GetHeaderChecksum() == integrity.checksum ? "valid" : "invalid");
+
+            if (integrity.hasSignature)
+            {
+                message.AddFormat(
+                      "Authenticode digest (%s): %s\nSignature: %s",
+                      integrity.authenticode.algorithm.GetText(),
+                      integrity.digestMatches ? "matches the image" : "does not match the image",
+                      integrity.authenticode.signatureVerified ? "valid (the certificates chain was not verified)" : "invalid");
+            }
+            else
+            {
+                message.Add("No Authenticode signature");
+            }
+        }
+        AppCUI::Dialogs::MessageBox::ShowNotification("Signature", message);
     }
 }
@@ -5,6 +5,7 @@ using namespace AppCUI::Controls;
 using namespace AppCUI::Input;
 
 constexpr uint32 PE_EXP_GOTO = 1;
+constexpr uint32 PE_EXP_FIND = 2;
 
 Panels::Exports::Exports(Reference<GView::Type::PE::PEFile> _pe, Reference<GView::View::WindowInterface> _win) : TabPage("&Exports")
 {
@@ -23,19 +24,34 @@ void Panels::Exports::Update()
     list->DeleteAllItems();
     for (auto& exp : pe->exp)
     {
-        list->AddItem({ exp.Name, n.ToDec(exp.Ordinal), temp.Format("%u (0x%08X)", exp.RVA, exp.RVA) })
+        list->AddItem({ pe->GetName(exp.Name), n.ToDec(exp.Ordinal), temp.Format("%u (0x%08X)", exp.RVA, exp.RVA) })
               .SetData((uint64) pe->ConvertAddress(exp.RVA, AddressType::RVA, AddressType::FileOffset));
     }
 }
+void Panels::Exports::FindExport()
+{
+    FindDialog dialog(pe, true);
+    CHECKRET(dialog.Show() == Dialogs::Result::Ok, "");
+
+    const auto offset = pe->ConvertAddress(pe->exp[dialog.GetIndex()].RVA, AddressType::RVA, AddressType::FileOffset);
+    CHECKRET(offset != PE_INVALID_ADDRESS, "");
+    win->GetCurrentView()->GoTo(offset);
+}
 bool Panels::Exports::OnUpdateCommandBar(AppCUI::Application::CommandBar& commandBar)
 {
     commandBar.SetCommand(Key::Enter, "GoTo", PE_EXP_GOTO);
+    commandBar.SetCommand(Key::Ctrl | Key::F, "Find", PE_EXP_FIND);
     return true;
 }
 bool Panels::Exports::OnEvent(Reference<Control> ctrl, Event evnt, int controlID)
 {
     if (TabPage::OnEvent(ctrl, evnt, controlID))
         return true;
+    if ((evnt == Event::Command) && (controlID == PE_EXP_FIND))
+    {
+        FindExport();
+        return true;
+    }
     if ((evnt == Event::ListViewItemPressed) || ((evnt == Event::Command) && (controlID == PE_EXP_GOTO)))
     {
         auto addr = list->GetCurrentItem().GetData(GView::Utils::INVALID_OFFSET);
@@ -0,0 +1,86 @@
+#include "pe.hpp"
+
+using namespace GView::Type::PE;
+using namespace AppCUI::Controls;
+using namespace AppCUI::Input;
+
+constexpr int32 BTN_ID_OK     = 1;
+constexpr int32 BTN_ID_CANCEL = 2;
+
+Panels::FindDialog::FindDialog(Reference<GView::Type::PE::PEFile> _pe, bool _exports)
+    : Window(_exports ? "Find export" : "Find import", "d:c,w:60,h:9", WindowFlags::ProcessReturn), pe(_pe), exports(_exports), index(0)
+{
+    Factory::Label::Create(this, "&Name", "x:1,y:1,w:6");
+    txName = Factory::TextField::Create(this, "", "x:8,y:1,w:48");
+    txName->SetHotKey('N');
+    Factory::Label::Create(this, "A name or an RVA (a number, e.g. 0x1000)", "x:1,y:3,w:56");
+
+    Factory::Button::Create(this, "&OK", "l:15,b:0,w:13", BTN_ID_OK);
+    Factory::Button::Create(this, "&Cancel", "l:30,b:0,w:13", BTN_ID_CANCEL);
+
+    txName->SetFocus();
+}
+void Panels::FindDialog::Validate()
+{
+    LocalString<512> tmp;
+    if ((tmp.Set(txName->GetText()) == false) || (tmp.Len() == 0))
+    {
+        Dialogs::MessageBox::ShowError("Error", "Invalid name (expecting ascii characters) !");
+        txName->SetFocus();
+        return;
+    }
+
+    // names can not start with a digit --> anything that does is an RVA
+    bool found      = false;
+    const auto text = tmp.ToStringView();
+    if ((text[0] >= '0') && (text[0] <= '9'))
+    {
+        auto rva = Number::ToUInt64(text, NumberParseFlags::BaseAuto);
+        if (!rva.has_value())
+        {
+            Dialogs::MessageBox::ShowError("Error", "Invalid RVA !");
+            txName->SetFocus();
+            return;
+        }
+        found = exports ? pe->FindExportByRVA(rva.value(), index) : pe->FindImportByRVA(rva.value(), index);
+    }
+    else
+    {
+        found = exports ? pe->FindExport(text, index) : pe->FindImport(text, index);
+    }
+
+    if (!found)
+    {
+        Dialogs::MessageBox::ShowError("Error", exports ? "Export not found !" : "Import not found !");
+        txName->SetFocus();
+        return;
+    }
+    Exit(Dialogs::Result::Ok);
+}
+bool Panels::FindDialog::OnEvent(Reference<Control> control, Event eventType, int ID)
+{
+    if (eventType == Event::ButtonClicked)
+    {
+        switch (ID)
+        {
+        case BTN_ID_CANCEL:
+            Exit(Dialogs::Result::Cancel);
+            return true;
+        case BTN_ID_OK:
+            Validate();
+            return true;
+        }
+    }
+
+    switch (eventType)
+    {
+    case Event::WindowAccept:
+        Validate();
+        return true;
+    case Event::WindowClose:
+        Exit(Dialogs::Result::Cancel);
+        return true;
+    }
+
+    return false;
+}
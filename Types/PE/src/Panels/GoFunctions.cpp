@@ -18,21 +18,22 @@ GoFunctions::GoFunctions(Reference<PEFile> _pe, Reference<GView::View::WindowInt
     win  = _win;
     Base = 16;
 
-    list = Factory::ListView::Create(
-          this,
+    // the rows are formatted (and their source lines resolved) only when they are visible
+    list = this->CreateChildControl<GView::View::VirtualList>(
           "d:c",
-          { "n:#,a:r,w:6",
-            "n:Entry,a:r,w:16",
-            "n:Name,a:l,w:60",
-            "n:Name Offset,a:r,w:20",
-            "n:Args,a:r,w:10",
-            "n:Frame,a:r,w:8",
-            "n:Pcsp,a:r,w:12",
-            "n:Pcfile,a:r,w:12",
-            "n:Pcln,a:r,w:12",
-            "n:Nfuncdata,a:r,w:12",
-            "n:Npcdata,a:r,w:12" },
-          ListViewFlags::None);
+          this,
+          std::initializer_list<GView::View::VirtualListColumn>{ { "#", 6, false },
+                                                                 { "Entry", 16, false },
+                                                                 { "Name", 60, true },
+                                                                 { "Name Offset", 20, false },
+                                                                 { "Args", 10, false },
+                                                                 { "Frame", 8, false },
+                                                                 { "Pcsp", 12, false },
+                                                                 { "Pcfile", 12, false },
+                                                                 { "Pcln", 12, false },
+                                                                 { "Nfuncdata", 12, false },
+                                                                 { "Npcdata", 12, false },
+                                                                 { "Source", 60, true } });
 
     Update();
 }
@@ -49,8 +50,8 @@ std::string_view GoFunctions::GetValue(NumericFormatter& n, uint64 value)
 
 void GoFunctions::GoToSelectedSection()
 {
-    auto i = list->GetCurrentItem().GetData(-1);
-    CHECKRET(i != -1, "");
+    const auto i = list->GetCurrentRow();
+    CHECKRET(i != GView::Utils::INVALID_OFFSET, "");
 
     Golang::Function f{};
     CHECKRET(pe->pcLnTab.GetFunction(i, f), "");
@@ -60,8 +61,8 @@ void GoFunctions::GoToSelectedSection()
 
 void GoFunctions::SelectCurrentSection()
 {
-    auto i = list->GetCurrentItem().GetData(-1);
-    CHECKRET(i != -1, "");
+    const auto i = list->GetCurrentRow();
+    CHECKRET(i != GView::Utils::INVALID_OFFSET, "");
 
     Golang::Function f1{};
     CHECKRET(pe->pcLnTab.GetFunction(i, f1), "");
@@ -76,33 +77,61 @@ void GoFunctions::SelectCurrentSection()
 
 void GoFunctions::Update()
 {
-    list->DeleteAllItems();
-
-    LocalString<128> tmp;
-    NumericFormatter n;
-    NumericFormatter n2;
-
-    const auto fCount = pe->pcLnTab.GetFunctionsCount();
-    for (auto i = 0ULL; i < fCount; i++)
-    {
-        Golang::Function f{};
-        CHECKRET(pe->pcLnTab.GetFunction(i, f), "");
-        auto item = list->AddItem({ tmp.Format("%s", GetValue(n, i).data()) });
-
-        item.SetText(1, tmp.Format("%s", GetValue(n, f.func.entry).data()));
+    list->Refresh();
+}
 
-        item.SetText(2, tmp.Format("%s", f.name));
+uint64 GoFunctions::GetRowsCount()
+{
+    return pe->pcLnTab.GetFunctionsCount();
+}
 
-        item.SetText(3, tmp.Format("%s", GetValue(n, f.func.name).data()));
-        item.SetText(4, tmp.Format("%s", GetValue(n, f.func.args).data()));
-        item.SetText(5, tmp.Format("%s", GetValue(n, f.func.frame).data()));
-        item.SetText(6, tmp.Format("%s", GetValue(n, f.func.pcsp).data()));
-        item.SetText(7, tmp.Format("%s", GetValue(n, f.func.pcfile).data()));
-        item.SetText(8, tmp.Format("%s", GetValue(n, f.func.pcln).data()));
-        item.SetText(9, tmp.Format("%s", GetValue(n, f.func.nfuncdata).data()));
-        item.SetText(10, tmp.Format("%s", GetValue(n, f.func.npcdata).data()));
+void GoFunctions::FormatCell(uint64 row, uint32 column, String& text)
+{
+    Golang::Function f{};
+    CHECKRET(pe->pcLnTab.GetFunction(row, f), "");
 
-        item.SetData(i);
+    NumericFormatter n;
+    std::string_view file;
+    uint32 line = 0;
+    switch (column)
+    {
+    case 0:
+        text.Set(GetValue(n, row));
+        break;
+    case 1:
+        text.Set(GetValue(n, f.func.entry));
+        break;
+    case 2:
+        text.Set(f.name != nullptr ? f.name : "");
+        break;
+    case 3:
+        text.Set(GetValue(n, f.func.name));
+        break;
+    case 4:
+        text.Set(GetValue(n, f.func.args));
+        break;
+    case 5:
+        text.Set(GetValue(n, f.func.frame));
+        break;
+    case 6:
+        text.Set(GetValue(n, f.func.pcsp));
+        break;
+    case 7:
+        text.Set(GetValue(n, f.func.pcfile));
+        break;
+    case 8:
+        text.Set(GetValue(n, f.func.pcln));
+        break;
+    case 9:
+        text.Set(GetValue(n, f.func.nfuncdata));
+        break;
+    case 10:
+        text.Set(GetValue(n, f.func.npcdata));
+        break;
+    case 11:
+        if (pe->pcLnTab.GetSourceLine(f.func.entry, file, line))
+            text.Format("%.*s:%u", static_cast<int32>(file.size()), file.data(), line);
+        break;
     }
 }
 
@@ -119,12 +148,6 @@ bool GoFunctions::OnEvent(Reference<Control> ctrl, Event evnt, int controlID)
 {
     CHECK(TabPage::OnEvent(ctrl, evnt, controlID) == false, true, "");
 
-    if (evnt == Event::ListViewItemPressed)
-    {
-        GoToSelectedSection();
-        return true;
-    }
-
     if (evnt == Event::Command)
     {
         switch (static_cast<ObjectAction>(controlID))
@@ -4,6 +4,9 @@ using namespace GView::Type::PE;
 using namespace AppCUI::Controls;
 using namespace AppCUI::Input;
 
+constexpr uint32 PE_IMP_GOTO = 1;
+constexpr uint32 PE_IMP_FIND = 2;
+
 Panels::Imports::Imports(Reference<GView::Type::PE::PEFile> _pe, Reference<GView::View::WindowInterface> _win) : TabPage("&Imports")
 {
     pe  = _pe;
@@ -24,14 +27,17 @@ void Panels::Imports::Update()
 
     // imports
     list->DeleteAllItems();
-    for (auto& ifnc : pe->impFunc)
+    for (auto i = 0U; i < pe->impFunc.size(); i++)
     {
+        const auto& ifnc = pe->impFunc[i];
         if (ifnc.dllIndex != lastDLLIndex)
         {
             list->AddItem(pe->impDLL[ifnc.dllIndex].Name).SetType(ListViewItem::Type::Highlighted);
             lastDLLIndex = ifnc.dllIndex;
         }
-        list->AddItem({ ifnc.Name, temp.Format("%u (0x%08X)", ifnc.RVA, ifnc.RVA) }).SetXOffset(2);
+        auto item = list->AddItem({ pe->GetName(ifnc.Name), temp.Format("%u (0x%08X)", ifnc.RVA, ifnc.RVA) });
+        item.SetXOffset(2);
+        item.SetData(i);
     }
 
     // dlls
@@ -59,4 +65,44 @@ void Panels::Imports::OnAfterResize(int newWidth, int newHeight)
         info->MoveTo(0, h1 + h2);
         info->Resize(newWidth, h3);
     };
-}
\ No newline at end of file
+}
+void Panels::Imports::GoToImport(uint32 index)
+{
+    CHECKRET(index < pe->impFunc.size(), "");
+
+    // the RVA of an import is its slot in the import address table
+    const auto offset = pe->ConvertAddress(pe->impFunc[index].RVA, AddressType::RVA, AddressType::FileOffset);
+    CHECKRET(offset != PE_INVALID_ADDRESS, "");
+    win->GetCurrentView()->GoTo(offset);
+}
+void Panels::Imports::FindImport()
+{
+    FindDialog dialog(pe, false);
+    CHECKRET(dialog.Show() == Dialogs::Result::Ok, "");
+    GoToImport(dialog.GetIndex());
+}
+bool Panels::Imports::OnUpdateCommandBar(AppCUI::Application::CommandBar& commandBar)
+{
+    commandBar.SetCommand(Key::Enter, "GoTo", PE_IMP_GOTO);
+    commandBar.SetCommand(Key::Ctrl | Key::F, "Find", PE_IMP_FIND);
+    return true;
+}
+bool Panels::Imports::OnEvent(Reference<Control> ctrl, Event evnt, int controlID)
+{
+    if (TabPage::OnEvent(ctrl, evnt, controlID))
+        return true;
+    if ((evnt == Event::Command) && (controlID == PE_IMP_FIND))
+    {
+        FindImport();
+        return true;
+    }
+    if (((evnt == Event::ListViewItemPressed) && (ctrl == list)) || ((evnt == Event::Command) && (controlID == PE_IMP_GOTO)))
+    {
+        // the rows of the dlls have no data
+        const auto index = list->GetCurrentItem().GetData(GView::Utils::INVALID_OFFSET);
+        if (index != GView::Utils::INVALID_OFFSET)
+            GoToImport(static_cast<uint32>(index));
+        return true;
+    }
+    return false;
+}
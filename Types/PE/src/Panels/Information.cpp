@@ -131,6 +131,34 @@ void Information::SetCertificate()
             general->AddItem({ "Certificate", tmp }).SetType(ListViewItem::Type::Emphasized_1);
         }
     }
+
+    CHECKRET(pe->integrity.computed, "");
+    const auto checksum = pe->GetHeaderChecksum();
+    if (checksum == 0)
+    {
+        general->AddItem({ "CheckSum", tmp.Format("Not set (computed: 0x%08X)", pe->integrity.checksum) });
+    }
+    else if (checksum == pe->integrity.checksum)
+    {
+        general->AddItem({ "CheckSum", tmp.Format("0x%08X (valid)", checksum) });
+    }
+    else
+    {
+        general->AddItem({ "CheckSum", tmp.Format("0x%08X (invalid, computed: 0x%08X)", checksum, pe->integrity.checksum) })
+              .SetType(ListViewItem::Type::ErrorInformation);
+    }
+
+    if (pe->integrity.hasSignature)
+    {
+        const auto valid = pe->integrity.digestMatches && pe->integrity.authenticode.signatureVerified;
+        tmp.Format(
+              "%s digest %s, signature %s",
+              pe->integrity.authenticode.algorithm.GetText(),
+              pe->integrity.digestMatches ? "matches" : "does not match",
+              pe->integrity.authenticode.signatureVerified ? "valid" : "invalid");
+        general->AddItem({ "Authenticode", tmp })
+              .SetType(valid ? ListViewItem::Type::Emphasized_2 : ListViewItem::Type::ErrorInformation);
+    }
 }
 
 void Information::SetStringTable()
@@ -160,7 +160,7 @@ void Panels::Symbols::Update()
         auto item = list->AddItem(GetValue(n, i));
         item.SetData<PE::PEFile::SymbolInformation>(&pe->symbols.at(i));
 
-        item.SetText(1, s.name);
+        item.SetText(1, pe->GetName(s.name));
         item.SetText(2, GetValue(n, s.is.N.Name.Short));
         item.SetText(3, GetValue(n, s.is.N.Name.Long));
         item.SetText(4, GetValue(n, s.is.Value));
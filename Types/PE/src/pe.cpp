@@ -146,6 +146,7 @@ extern "C"
     void CreateDissasmView(Reference<GView::View::WindowInterface> win, Reference<PE::PEFile> pe)
     {
         DissasmViewer::Settings settings;
+        settings.SetDefaultDisassemblyLanguage(pe->hdr64 ? DissasmViewer::DissasemblyLanguage::x64 : DissasmViewer::DissasemblyLanguage::x86);
 
         if (pe->HasPanel(PE::Panels::IDs::Sections))
         {
@@ -235,6 +236,11 @@ UInt16 e_res[4];)");
         {
             win->AddPanel(Pointer<TabPage>(new PE::Panels::OpCodes(win->GetObject(), pe)), true);
         }
+        if (pe->HasPanel(PE::Panels::IDs::Functions))
+            win->AddPanel(
+                  Pointer<TabPage>(
+                        new GView::View::FunctionsPanel(&pe->functionsAnalyzer, win, [pe]() { return pe->StartFunctionsAnalysis(); })),
+                  false);
 
         return true;
     }
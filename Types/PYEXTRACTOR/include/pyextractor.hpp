@@ -2,6 +2,9 @@
 
 #include "GView.hpp"
 
+#include <deque>
+#include <unordered_map>
+
 namespace GView::Type::PYEXTRACTOR
 {
 enum class Magic : uint16
@@ -48,9 +51,20 @@ struct TOCEntry
     uint8 typeCmprsData{ 0 };
 #pragma pack(pop)
     Buffer name;
+    uint32 index{ 0 };
 };
 
 constexpr auto TOC_ENTRY_KNOWN_SIZE = 18;
+constexpr uint64 EXTRACT_BATCH_SIZE = 0x4000000; // compressed bytes read before they are decompressed in parallel
+constexpr uint64 COOKIE_SEARCH_SIZE = 0x800000;  // the cookie is searched only in the last 8 MB of the file
+constexpr uint64 ENTRIES_CACHE_SIZE = 0x10000000; // decompressed entries kept in memory (the oldest ones are released first)
+
+struct EntriesReport
+{
+    uint32 entries;
+    uint32 failures;
+    uint64 decompressedSize;
+};
 
 struct Archive
 {
@@ -101,15 +115,24 @@ class PYEXTRACTORFile : public TypeInterface,
     {
         return "PYEXTRACTOR";
     }
-    void RunCommand(std::string_view) override
-    {
-    }
+    void RunCommand(std::string_view) override;
+
+    // every entry is decompressed (read in the order of their position and decompressed in parallel, one batch at a time)
+    // the results are cached (up to ENTRIES_CACHE_SIZE) --> OpenEntry does not decompress them again
+    bool DecompressEntries(EntriesReport& report);
+    // the content is taken from the cache or decompressed (and cached) now
+    bool OpenEntry(uint32 index);
 
     virtual bool BeginIteration(std::u16string_view path, AppCUI::Controls::TreeViewItem parent) override;
     virtual bool PopulateItem(TreeViewItem item) override;
     virtual void OnOpenItem(std::u16string_view path, AppCUI::Controls::TreeViewItem item) override;
 
   private:
+    std::unordered_map<uint32, Buffer> entriesCache; // index --> decompressed content
+    std::deque<uint32> entriesCacheOrder;            // the order in which the entries were cached
+    uint64 entriesCacheSize{ 0 };
+
+    void CacheEntry(uint32 index, Buffer&& data);
     bool SetCookiePosition();
     bool SetInstallerVersion();
     bool SetInfo();
@@ -61,17 +61,9 @@ void TOCEntries::SelectCurrentEntry()
 
 void TOCEntries::OpenCurrentEntry()
 {
-    auto entry       = list->GetCurrentItem().GetData<PYEXTRACTOR::TOCEntry>();
-    const auto& pos  = entry->entryPos;
-    const auto& size = entry->cmprsdDataSize;
-
-    const auto bufferCompressed = py->obj->GetData().CopyToBuffer(pos, size);
-    CHECKRET(bufferCompressed.IsValid(), "");
-
-    Buffer bufferDecompressed{};
-    CHECKRET(ZLIB::Decompress(bufferCompressed, bufferCompressed.GetLength(), bufferDecompressed, entry->uncmprsdDataSize), "");
-
-    GView::App::OpenBuffer(BufferView{ bufferDecompressed }, entry->name, GView::App::OpenMethod::BestMatch);
+    auto entry = list->GetCurrentItem().GetData<PYEXTRACTOR::TOCEntry>();
+    CHECKRET(entry.IsValid(), "");
+    CHECKRET(py->OpenEntry(entry->index), "");
 }
 
 void TOCEntries::Update()
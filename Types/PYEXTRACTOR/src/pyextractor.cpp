@@ -94,8 +94,9 @@ extern "C"
 
     PLUGIN_EXPORT void UpdateSettings(IniSection sect)
     {
-        sect["Pattern"]     = { "magic:78 01", "magic:78 9C", "magic:78 DA" };
-        sect["Priority"]    = 1;
-        sect["Description"] = "PyExtractor file format";
+        sect["Pattern"]               = { "magic:78 01", "magic:78 9C", "magic:78 DA" };
+        sect["Priority"]              = 1;
+        sect["Description"]           = "PyExtractor file format";
+        sect["Command.DecompressAll"] = AppCUI::Input::Key::Shift | AppCUI::Input::Key::F10;
     }
 }
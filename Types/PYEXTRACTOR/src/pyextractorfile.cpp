@@ -1,5 +1,7 @@
 #include "pyextractor.hpp"
 
+#include <algorithm>
+
 namespace GView::Type::PYEXTRACTOR
 {
 PYEXTRACTORFile::PYEXTRACTORFile()
@@ -26,19 +28,30 @@ bool PYEXTRACTORFile::HasPanel(Panels::IDs id)
 
 bool PYEXTRACTORFile::SetCookiePosition()
 {
-    const auto fullBuffer = obj->GetData().GetEntireFile();
-    if (fullBuffer.IsValid())
+    // the cookie is at the end of the archive (only followed by data like a signature) --> the tail of the file is searched backwards,
+    // one cache window at a time
+    auto& cache        = obj->GetData();
+    const auto window  = static_cast<uint64>(cache.GetCacheSize());
+    const auto overlap = PYINSTALLER_MAGIC.size() - 1;
+    CHECK(window > overlap, false, "");
+
+    uint64 end         = cache.GetSize();
+    const auto minimum = end > COOKIE_SEARCH_SIZE ? end - COOKIE_SEARCH_SIZE : 0;
+    while (end > minimum)
     {
-        const std::string_view fullView{ reinterpret_cast<char*>(const_cast<uint8*>(fullBuffer.GetData())), fullBuffer.GetLength() };
-        if (const auto index = fullView.find(PYINSTALLER_MAGIC, 0); index != std::string::npos)
+        const auto start  = end - minimum > window ? end - window : minimum;
+        const auto buffer = cache.Get(start, static_cast<uint32>(end - start), true);
+        CHECK(buffer.IsValid(), false, "");
+
+        const std::string_view view{ reinterpret_cast<const char*>(buffer.GetData()), buffer.GetLength() };
+        if (const auto index = view.rfind(PYINSTALLER_MAGIC); index != std::string_view::npos)
         {
-            archive.cookiePosition = index;
+            archive.cookiePosition = start + index;
             return true;
         }
-    }
-    else
-    {
-        throw std::runtime_error("Not implemented!");
+        if (start == minimum)
+            break;
+        end = start + overlap; // a magic split between two windows is found in the next one
     }
 
     return false;
@@ -100,25 +113,34 @@ inline void Swap(TOCEntry& entry)
 
 bool PYEXTRACTORFile::SetTableOfContentEntries()
 {
-    const auto a = obj->GetData().CopyToBuffer(archive.info.tableOfContentPosition, archive.info.tableOfContentSize);
-    const auto b = a.GetData();
+    CHECK(archive.info.tableOfContentSize > 0, true, "");
+
+    // the whole table is read at once
+    const auto toc = obj->GetData().CopyToBuffer(archive.info.tableOfContentPosition, archive.info.tableOfContentSize, true);
+    CHECK(toc.IsValid(), false, "");
 
-    uint64 i             = archive.info.tableOfContentPosition;
-    const auto maxOffset = archive.info.tableOfContentPosition + archive.info.tableOfContentSize;
-    while (i < maxOffset)
+    const auto b    = toc.GetData();
+    const auto size = toc.GetLength();
+    size_t i        = 0;
+    while (i < size)
     {
-        const auto bufferView = obj->GetData().CopyToBuffer(i, TOC_ENTRY_KNOWN_SIZE);
-        CHECK(bufferView.IsValid(), false, "");
+        CHECK(i + TOC_ENTRY_KNOWN_SIZE <= size, false, "Truncated TOC entry at offset %llu!", (uint64) i);
 
         auto& entry = tocEntries.emplace_back();
-        memcpy(&entry, bufferView.GetData(), TOC_ENTRY_KNOWN_SIZE);
+        memcpy(&entry, b + i, TOC_ENTRY_KNOWN_SIZE);
         Swap(entry);
+        CHECK(entry.entrySize >= TOC_ENTRY_KNOWN_SIZE && entry.entrySize <= size - i,
+              false,
+              "Invalid TOC entry size: %u!",
+              entry.entrySize);
+        entry.index = static_cast<uint32>(tocEntries.size() - 1);
 
         const auto nameLen = entry.entrySize - TOC_ENTRY_KNOWN_SIZE;
 
         if (nameLen != 0)
         {
-            entry.name = obj->GetData().CopyToBuffer(i + TOC_ENTRY_KNOWN_SIZE, static_cast<uint32>(nameLen));
+            entry.name.Resize(nameLen);
+            memcpy(entry.name.GetData(), b + i + TOC_ENTRY_KNOWN_SIZE, nameLen);
         }
         else
         {
@@ -133,6 +155,143 @@ bool PYEXTRACTORFile::SetTableOfContentEntries()
     return true;
 }
 
+static bool DecompressEntry(const TOCEntry& entry, Buffer& compressed, Buffer& output)
+{
+    if ((entry.cmprsFlag == 0) || (entry.cmprsdDataSize == 0))
+    {
+        output = std::move(compressed);
+        return true;
+    }
+    return ZLIB::DecompressStream(compressed, output, ZLIB::StreamFormat::ZLIB, entry.uncmprsdDataSize);
+}
+
+void PYEXTRACTORFile::CacheEntry(uint32 index, Buffer&& data)
+{
+    const auto size = static_cast<uint64>(data.GetLength());
+    if ((size > ENTRIES_CACHE_SIZE) || (entriesCache.find(index) != entriesCache.end()))
+        return;
+
+    while (entriesCacheSize + size > ENTRIES_CACHE_SIZE)
+    {
+        const auto it = entriesCache.find(entriesCacheOrder.front());
+        entriesCacheSize -= it->second.GetLength();
+        entriesCache.erase(it);
+        entriesCacheOrder.pop_front();
+    }
+    entriesCacheSize += size;
+    entriesCacheOrder.push_back(index);
+    entriesCache.emplace(index, std::move(data));
+}
+
+bool PYEXTRACTORFile::DecompressEntries(EntriesReport& report)
+{
+    std::vector<uint32> pending(tocEntries.size());
+    for (auto i = 0U; i < pending.size(); i++)
+        pending[i] = i;
+    std::sort(pending.begin(), pending.end(), [this](uint32 a, uint32 b) { return tocEntries[a].entryPos < tocEntries[b].entryPos; });
+
+    auto& cache = obj->GetData();
+    std::vector<Buffer> compressed;
+    std::vector<Buffer> outputs;
+    std::vector<uint8> decompressed;
+    report = {};
+    for (size_t start = 0; start < pending.size();)
+    {
+        // the cache is not thread safe --> the compressed data of a batch is read first and only the decompression runs in parallel
+        compressed.clear();
+        uint64 batchSize = 0;
+        auto end         = start;
+        while ((end < pending.size()) && ((end == start) || (batchSize + tocEntries[pending[end]].cmprsdDataSize <= EXTRACT_BATCH_SIZE)))
+        {
+            const auto& entry = tocEntries[pending[end]];
+            compressed.emplace_back();
+            if (entry.cmprsdDataSize > 0)
+            {
+                compressed.back() = cache.CopyToBuffer(entry.entryPos, entry.cmprsdDataSize, true);
+                CHECK(compressed.back().IsValid(), false, "");
+            }
+            batchSize += entry.cmprsdDataSize;
+            end++;
+        }
+
+        const auto count = static_cast<uint32>(end - start);
+        outputs.clear();
+        outputs.resize(count);
+        decompressed.assign(count, 0);
+        GView::Utils::ParallelFor(count, [&](uint32 i) {
+            if (DecompressEntry(tocEntries[pending[start + i]], compressed[i], outputs[i]))
+                decompressed[i] = 1;
+        });
+
+        // the workers only fill their own outputs --> the cache is updated by this thread
+        for (auto i = 0U; i < count; i++)
+        {
+            if (decompressed[i] == 0)
+            {
+                report.failures++;
+                continue;
+            }
+            report.decompressedSize += outputs[i].GetLength();
+            CacheEntry(pending[start + i], std::move(outputs[i]));
+        }
+        start = end;
+    }
+
+    report.entries = static_cast<uint32>(pending.size());
+    return true;
+}
+
+bool PYEXTRACTORFile::OpenEntry(uint32 index)
+{
+    CHECK(index < tocEntries.size(), false, "");
+    const auto& entry = tocEntries[index];
+    const auto name   = std::string_view{ reinterpret_cast<const char*>(entry.name.GetData()), entry.name.GetLength() };
+
+    if (const auto it = entriesCache.find(index); it != entriesCache.end())
+    {
+        GView::App::OpenBuffer(it->second, name, name, GView::App::OpenMethod::BestMatch);
+        return true;
+    }
+
+    Buffer compressed;
+    if (entry.cmprsdDataSize > 0)
+    {
+        compressed = obj->GetData().CopyToBuffer(entry.entryPos, entry.cmprsdDataSize, true);
+        CHECK(compressed.IsValid(), false, "");
+    }
+    Buffer data;
+    CHECK(DecompressEntry(entry, compressed, data), false, "Failed to decompress entry %u!", index);
+
+    GView::App::OpenBuffer(data, name, name, GView::App::OpenMethod::BestMatch);
+    CacheEntry(index, std::move(data));
+
+    return true;
+}
+
+void PYEXTRACTORFile::RunCommand(std::string_view commandName)
+{
+    if (commandName == "DecompressAll")
+    {
+        EntriesReport report{};
+        if (!DecompressEntries(report))
+        {
+            AppCUI::Dialogs::MessageBox::ShowError("Error", "Failed to read the compressed entries!");
+            return;
+        }
+
+        LocalString<256> message;
+        NumericFormatter n;
+        const auto size = n.ToString(report.decompressedSize, { NumericFormatFlags::None, 10, 3, ',' });
+        message.Format(
+              "Entries: %u\nDecompressed size: %s bytes\nFailed: %u\nKept in memory: %u",
+              report.entries,
+              size.data(),
+              report.failures,
+              static_cast<uint32>(entriesCache.size()));
+        AppCUI::Dialogs::MessageBox::ShowNotification("Decompress all", message);
+    }
+}
+
 bool PYEXTRACTORFile::BeginIteration(std::u16string_view path, AppCUI::Controls::TreeViewItem parent)
 {
     CHECK(tocEntries.empty() == false, false, "");
@@ -166,30 +325,11 @@ bool PYEXTRACTORFile::PopulateItem(TreeViewItem item)
     return currentItemIndex != tocEntries.size();
 }
 
-/*
-    const auto& pos  = entry->entryPos;
-    const auto& size = entry->cmprsdDataSize;
-
-    const auto bufferCompressed = py->obj->GetData().CopyToBuffer(pos, size);
-    CHECKRET(bufferCompressed.IsValid(), "");
-
-    Buffer bufferDecompressed{};
-    CHECKRET(ZLIB::Decompress(bufferCompressed, bufferCompressed.GetLength(), bufferDecompressed, entry->uncmprsdDataSize), "");
-
-    GView::App::OpenBuffer(BufferView{ bufferDecompressed }, entry->name);
-
-*/
-
 void PYEXTRACTORFile::OnOpenItem(std::u16string_view path, AppCUI::Controls::TreeViewItem item)
 {
     CHECKRET(item.GetParent().GetHandle() != InvalidItemHandle, "");
 
-    auto data         = item.GetData<TOCEntry>();
-    const auto offset = (uint64) data->entryPos;
-    const auto length = (uint32) data->cmprsdDataSize;
-    const auto name   = std::string_view{ reinterpret_cast<char*>(data->name.GetData()), data->name.GetLength() };
-    const auto buffer = obj->GetData().CopyToBuffer(offset, length);
-
-    GView::App::OpenBuffer(buffer, name, name, GView::App::OpenMethod::BestMatch);
+    auto data = item.GetData<TOCEntry>();
+    CHECKRET(OpenEntry(data->index), "");
 }
 } // namespace GView::Type::PYEXTRACTOR